@@ -36,6 +36,7 @@
 #include <lanelet2_extension/projection/local_frame_projector.h>
 #include <lanelet2_extension/io/autoware_osm_parser.h>
 #include <carma_wm/CARMAWorldModel.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <boost/format.hpp>
 #include <std_msgs/msg/bool.hpp>
 #include <unordered_map>
@@ -447,7 +448,7 @@ namespace approaching_emergency_vehicle_plugin
     std::unordered_map<std::string, rclcpp::Time> latest_erv_update_times_;
 
     // Pointer for map projector
-    boost::optional<std::string> map_projector_;
+    std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
     // Latest route state
     carma_planning_msgs::msg::RouteState latest_route_state_;
@@ -374,9 +374,6 @@ namespace approaching_emergency_vehicle_plugin
       throw std::invalid_argument("Attempting to get ERV's current position in map before map projection was set");
     }
       
-    // Build map projector
-    lanelet::projection::LocalFrameProjector projector(map_projector_.get().c_str());
-
     // Create vector to hold ERV's projected current position
     std::vector<lanelet::BasicPoint3d> erv_current_position_projected_vec;
 
@@ -386,7 +383,7 @@ namespace approaching_emergency_vehicle_plugin
     current_erv_location.lon = current_longitude;
 
     // Convert ERV's projected position to its position in the map frame
-    erv_current_position_projected_vec.emplace_back(projector.forward(current_erv_location));
+    erv_current_position_projected_vec.emplace_back(map_projector_->forward(current_erv_location));
     auto erv_current_position_in_map_vec = lanelet::utils::transform(erv_current_position_projected_vec, [](auto a) { return lanelet::traits::to2D(a); });
 
     // Conduct size check since only the first element is being returned
@@ -613,8 +610,8 @@ namespace approaching_emergency_vehicle_plugin
 
   void ApproachingEmergencyVehiclePlugin::georeferenceCallback(const std_msgs::msg::String::UniquePtr msg) 
   {
-    // Build projector from proj string
-    map_projector_ = msg->data;
+    // Projectors are shared between all users of the same proj string
+    map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);
   }
 
   void ApproachingEmergencyVehiclePlugin::incomingEmergencyVehicleAckCallback(const carma_v2x_msgs::msg::EmergencyVehicleAck::UniquePtr msg) 
@@ -637,11 +634,9 @@ namespace approaching_emergency_vehicle_plugin
       throw std::invalid_argument("Attempting to generate an ERV's route before map projection was set");
     }
       
-    // Build map projector
-    lanelet::projection::LocalFrameProjector projector(map_projector_.get().c_str());
-
     // Create vector to hold ERV's destination points
-    std::vector<lanelet::BasicPoint3d> erv_destination_points_projected;
+    std::vector<lanelet::GPSPoint> erv_destination_points_gps;
+    erv_destination_points_gps.reserve(erv_destination_points.size());
 
     // Add ERV's current location to the beginning of erv_destination_points
     lanelet::GPSPoint current_erv_location;
@@ -664,14 +659,17 @@ namespace approaching_emergency_vehicle_plugin
           erv_destination_point.ele = position_3d_point.elevation;
         }
 
-        erv_destination_points_projected.emplace_back(projector.forward(erv_destination_point));
+        erv_destination_points_gps.emplace_back(erv_destination_point);
       }
     }
 
+    // Project all destination points in a single batch
+    std::vector<lanelet::BasicPoint3d> erv_destination_points_projected = map_projector_->forward(erv_destination_points_gps);
+
     // Convert ERV destination points to map frame
     auto erv_destination_points_in_map = lanelet::utils::transform(erv_destination_points_projected, [](auto a) { return lanelet::traits::to2D(a); });
 
-    auto cmv_location = lanelet::traits::to2D(projector.forward(current_erv_location));
+    auto cmv_location = lanelet::traits::to2D(map_projector_->forward(current_erv_location));
     auto shortened_erv_destination_points_in_map = filter_points_ahead(cmv_location, erv_destination_points_in_map);
 
     if(shortened_erv_destination_points_in_map.empty())
@@ -18,10 +18,59 @@
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <stdexcept>
 
 namespace approximate_intersection
 {
 
+  /**
+   * \brief The storage used by LookupGrid to track occupied cells
+   */
+  enum class GridBackend
+  {
+    //! Hash set of occupied cell indices. Memory scales with the number of occupied cells.
+    HASH,
+    //! Dense bitmap with one bit per cell covering the full grid bounds. Fastest lookup.
+    DENSE,
+    //! Bitmap split into square tiles which are only allocated once a cell inside them is occupied. Suited to very large sparse maps.
+    TILED
+  };
+
+  /**
+   * \brief Convert a backend name (hash, dense, tiled) into a GridBackend
+   * 
+   * \param name The lower case backend name
+   * 
+   * \throw std::invalid_argument if the name does not match a known backend
+   * 
+   * \return The matching GridBackend
+   */
+  inline GridBackend grid_backend_from_string(const std::string& name)
+  {
+    if (name == "hash")
+      return GridBackend::HASH;
+    if (name == "dense")
+      return GridBackend::DENSE;
+    if (name == "tiled")
+      return GridBackend::TILED;
+
+    throw std::invalid_argument("Unknown approximate_intersection grid backend: " + name);
+  }
+
+  inline std::ostream &operator<<(std::ostream &output, const GridBackend &b)
+  {
+    switch (b)
+    {
+      case GridBackend::HASH:
+        return output << "hash";
+      case GridBackend::DENSE:
+        return output << "dense";
+      default:
+        return output << "tiled";
+    }
+  }
+
   /**
    * \brief Stuct containing the algorithm configuration values for approximate_intersection
    */
@@ -43,6 +92,12 @@ namespace approximate_intersection
     //! Cell size length
     size_t cell_side_length = 100;
 
+    //! Storage used to track occupied cells
+    GridBackend backend = GridBackend::HASH;
+
+    //! Side length of a tile in cells when using the TILED backend. Values below 1 are treated as 1
+    size_t tile_side_cells = 64;
+
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const Config &c)
     {
@@ -52,6 +107,8 @@ namespace approximate_intersection
            << "min_y: " << c.min_y << std::endl
            << "max_y: " << c.max_y << std::endl
            << "cell_side_length: " << c.cell_side_length << std::endl
+           << "backend: " << c.backend << std::endl
+           << "tile_side_cells: " << c.tile_side_cells << std::endl
            << "}" << std::endl;
       return output;
     }
@@ -17,6 +17,10 @@
 #pragma once
 
 #include <unordered_set>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <geometry/spatial_hash.hpp>
 #include <geometry/spatial_hash_config.hpp>
 #include "approximate_intersection/config.hpp"
@@ -31,6 +35,11 @@ namespace approximate_intersection
    *        Once the grid is populated, intersections can be checked against.
    *        If the queried point lands in an occupied cell the intersection is reported as true.
    * 
+   *        Occupied cells are stored according to Config::backend. The DENSE backend keeps one bit per cell of the grid bounds
+   *        which makes a lookup a single index computation and memory read. The TILED backend only allocates the bits of tiles
+   *        which contain occupied cells and is intended for very large maps. The HASH backend stores occupied cells in a hash set.
+   *        Points outside the grid bounds are clamped to the nearest edge cell by all backends.
+   * 
    * \tparam PointT The type of 2d point which the grid will be built from. Must have publicly accessible .x and .y members. 
    */
   template<class PointT>
@@ -47,12 +56,74 @@ namespace approximate_intersection
     //! Spatial hasher which defines the grid
     Hasher hasher_;
 
-    //! The set of occupied cells identified by their hash index
+    //! The set of occupied cells identified by their hash index. Used by the HASH backend.
     std::unordered_set<HashIndex> occupied_cells_;
 
+    //! Number of cells along the x and y axes of the grid
+    size_t cols_ = 0;
+    size_t rows_ = 0;
+
+    //! Inverse of the cell side length
+    float32_t inv_cell_side_ = 1.0f;
+
+    //! One bit per cell in row major order. Used by the DENSE backend.
+    std::vector<uint64_t> dense_bits_;
+
+    //! Number of tiles along the x axis and the number of 64 bit words in each tile. Used by the TILED backend.
+    size_t tile_cols_ = 0;
+    size_t tile_words_ = 0;
+
+    //! Row major tiles, each holding one bit per cell in row major order. Empty tiles contain no occupied cells. Used by the TILED backend.
+    std::vector<std::vector<uint64_t>> tiles_;
+
     //! Static placeholder value for the Autoware.Auto Hasher in use which requires this value but does not utilize it.
     static constexpr size_t PLACE_HOLDER_CAPACITY = 1;
 
+    //! Largest number of cells the DENSE and TILED backends will cover (32 MB of bits for DENSE)
+    static constexpr size_t MAX_BITMAP_CELLS = size_t(1) << 28;
+
+    /**
+     * \brief Compute the column of the cell containing the provided x coordinate, clamped to the grid bounds.
+     *        NaN coordinates map to the first column.
+     */
+    inline size_t cell_col(float32_t x) const {
+      float32_t clamped = x > config_.min_x ? (x < config_.max_x ? x : config_.max_x) : config_.min_x;
+      return std::min(static_cast<size_t>((clamped - config_.min_x) * inv_cell_side_), cols_ - 1);
+    }
+
+    /**
+     * \brief Compute the row of the cell containing the provided y coordinate, clamped to the grid bounds.
+     *        NaN coordinates map to the first row.
+     */
+    inline size_t cell_row(float32_t y) const {
+      float32_t clamped = y > config_.min_y ? (y < config_.max_y ? y : config_.max_y) : config_.min_y;
+      return std::min(static_cast<size_t>((clamped - config_.min_y) * inv_cell_side_), rows_ - 1);
+    }
+
+    /**
+     * \brief Check the DENSE backend for the cell containing the provided point
+     */
+    inline bool dense_test(const PointT& point) const {
+      size_t bit = cell_row(point.y) * cols_ + cell_col(point.x);
+      return (dense_bits_[bit >> 6] >> (bit & 63)) & 1u;
+    }
+
+    /**
+     * \brief Check the TILED backend for the cell containing the provided point
+     */
+    inline bool tiled_test(const PointT& point) const {
+      size_t col = cell_col(point.x);
+      size_t row = cell_row(point.y);
+      const auto& tile = tiles_[(row / config_.tile_side_cells) * tile_cols_ + (col / config_.tile_side_cells)];
+
+      if (tile.empty()) {
+        return false;
+      }
+
+      size_t bit = (row % config_.tile_side_cells) * config_.tile_side_cells + (col % config_.tile_side_cells);
+      return (tile[bit >> 6] >> (bit & 63)) & 1u;
+    }
+
   public:
 
     /**
@@ -71,18 +142,61 @@ namespace approximate_intersection
       config_(config),
       hasher_(config.min_x, config.max_x, config.min_y, config.max_y, config.cell_side_length, PLACE_HOLDER_CAPACITY)
     {
-      double dx = config.max_x - config.min_x;
-      double dy = config.max_y - config.min_y;
-      
-      double rough_cell_side_count = 0;
-      
-      if (dx > dy) {
-        rough_cell_side_count = dx / config.cell_side_length;
-      } else {
-        rough_cell_side_count = dy / config.cell_side_length;
+      double dx = static_cast<double>(config.max_x) - static_cast<double>(config.min_x);
+      double dy = static_cast<double>(config.max_y) - static_cast<double>(config.min_y);
+
+      // The bitmap backends size their storage from the bounds. Bounds which are inverted, non-finite or would need
+      // more than MAX_BITMAP_CELLS cells (such as those of an empty map) use the HASH backend instead.
+      if (config_.backend != GridBackend::HASH) {
+        bool valid_bounds = std::isfinite(dx) && std::isfinite(dy) && dx >= 0 && dy >= 0 && config.cell_side_length > 0;
+
+        if (!valid_bounds
+            || (dx / config.cell_side_length + 1) * (dy / config.cell_side_length + 1) > static_cast<double>(MAX_BITMAP_CELLS)) {
+          config_.backend = GridBackend::HASH;
+        }
+      }
+
+      if (config_.backend != GridBackend::HASH) {
+        inv_cell_side_ = 1.0f / static_cast<float32_t>(config.cell_side_length);
+        cols_ = static_cast<size_t>(dx / config.cell_side_length) + 1;
+        rows_ = static_cast<size_t>(dy / config.cell_side_length) + 1;
       }
 
-      occupied_cells_.reserve(rough_cell_side_count * rough_cell_side_count);
+      switch (config_.backend) {
+        case GridBackend::DENSE:
+          dense_bits_.assign((cols_ * rows_ + 63) / 64, 0);
+          break;
+
+        case GridBackend::TILED:
+        {
+          // A tile must hold at least one cell
+          config_.tile_side_cells = std::max<size_t>(config_.tile_side_cells, 1);
+          size_t tile_side = config_.tile_side_cells;
+          tile_cols_ = (cols_ + tile_side - 1) / tile_side;
+          size_t tile_rows = (rows_ + tile_side - 1) / tile_side;
+          tile_words_ = (tile_side * tile_side + 63) / 64;
+          tiles_.resize(tile_cols_ * tile_rows);
+          break;
+        }
+
+        default:
+        {
+          double rough_cell_side_count = 0;
+          
+          if (dx > dy) {
+            rough_cell_side_count = dx / config.cell_side_length;
+          } else {
+            rough_cell_side_count = dy / config.cell_side_length;
+          }
+
+          // Bounds which fell back from a bitmap backend may not give a usable estimate
+          double rough_cell_count = rough_cell_side_count * rough_cell_side_count;
+          if (std::isfinite(rough_cell_count) && rough_cell_count > 0) {
+            occupied_cells_.reserve(static_cast<size_t>(std::min(rough_cell_count, static_cast<double>(MAX_BITMAP_CELLS))));
+          }
+          break;
+        }
+      }
     }
 
     /**
@@ -103,13 +217,55 @@ namespace approximate_intersection
      */ 
     bool intersects(PointT point) const {
 
-      HashIndex cell = hasher_.bin(point.x, point.y, 0);
+      switch (config_.backend) {
+        case GridBackend::DENSE:
+          return dense_test(point);
+
+        case GridBackend::TILED:
+          return tiled_test(point);
+
+        default:
+        {
+          HashIndex cell = hasher_.bin(point.x, point.y, 0);
 
-      if (occupied_cells_.find(cell) != occupied_cells_.end()) {
-        return true;
+          if (occupied_cells_.find(cell) != occupied_cells_.end()) {
+            return true;
+          }
+
+          return false;
+        }
       }
+    }
 
-      return false;
+    /**
+     * \brief Checks a contiguous array of points for intersection with occupied cells of the grid.
+     *        The backend is resolved once per call so the per point loop contains only the cell lookup.
+     * 
+     * \param points Pointer to the first of n points to check
+     * \param n The number of points to check
+     * \param out Pointer to an array of at least n values. Set to 1 for each point which lies within an occupied cell, 0 otherwise
+     */ 
+    void intersects(const PointT* points, size_t n, uint8_t* out) const {
+
+      switch (config_.backend) {
+        case GridBackend::DENSE:
+          for (size_t i = 0; i < n; ++i) {
+            out[i] = dense_test(points[i]);
+          }
+          break;
+
+        case GridBackend::TILED:
+          for (size_t i = 0; i < n; ++i) {
+            out[i] = tiled_test(points[i]);
+          }
+          break;
+
+        default:
+          for (size_t i = 0; i < n; ++i) {
+            out[i] = occupied_cells_.find(hasher_.bin(points[i].x, points[i].y, 0)) != occupied_cells_.end();
+          }
+          break;
+      }
     }
 
     /**
@@ -119,8 +275,37 @@ namespace approximate_intersection
      * \param point The point to add to the grid
      */
     void insert(PointT point) {
-      HashIndex cell = hasher_.bin(point.x, point.y, 0);
-      occupied_cells_.insert(cell);
+
+      switch (config_.backend) {
+        case GridBackend::DENSE:
+        {
+          size_t bit = cell_row(point.y) * cols_ + cell_col(point.x);
+          dense_bits_[bit >> 6] |= (uint64_t(1) << (bit & 63));
+          break;
+        }
+
+        case GridBackend::TILED:
+        {
+          size_t col = cell_col(point.x);
+          size_t row = cell_row(point.y);
+          auto& tile = tiles_[(row / config_.tile_side_cells) * tile_cols_ + (col / config_.tile_side_cells)];
+
+          if (tile.empty()) {
+            tile.assign(tile_words_, 0);
+          }
+
+          size_t bit = (row % config_.tile_side_cells) * config_.tile_side_cells + (col % config_.tile_side_cells);
+          tile[bit >> 6] |= (uint64_t(1) << (bit & 63));
+          break;
+        }
+
+        default:
+        {
+          HashIndex cell = hasher_.bin(point.x, point.y, 0);
+          occupied_cells_.insert(cell);
+          break;
+        }
+      }
     }
 
   };
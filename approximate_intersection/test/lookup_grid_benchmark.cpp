@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+#include "approximate_intersection/lookup_grid.hpp"
+
+namespace approximate_intersection {
+
+struct BenchmarkPoint {
+    float x = 0;
+    float y = 0;
+    float z = 0;
+    float intensity = 0;
+};
+
+namespace {
+
+/**
+ * Builds a 4km x 4km grid with 3m cells whose occupied cells form a road network
+ * of straight 20m wide roads every 200m in both directions
+ */
+LookupGrid<BenchmarkPoint> build_grid(GridBackend backend) {
+    Config config;
+    config.min_x = -2000;
+    config.max_x = 2000;
+    config.min_y = -2000;
+    config.max_y = 2000;
+    config.cell_side_length = 3;
+    config.backend = backend;
+
+    LookupGrid<BenchmarkPoint> grid(config);
+
+    for (float road = -2000; road <= 2000; road += 200) {
+        for (float along = -2000; along <= 2000; along += 1.0) {
+            for (float across = -10; across <= 10; across += 1.0) {
+                BenchmarkPoint p;
+                p.x = along;
+                p.y = road + across;
+                grid.insert(p);
+                p.x = road + across;
+                p.y = along;
+                grid.insert(p);
+            }
+        }
+    }
+
+    return grid;
+}
+
+/**
+ * Generates a lidar like cloud of points within 150m of a position near the grid center
+ */
+std::vector<BenchmarkPoint> build_cloud(size_t size) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-150, 150);
+    std::vector<BenchmarkPoint> cloud(size);
+    for (auto& p : cloud) {
+        p.x = 100 + dist(gen);
+        p.y = 100 + dist(gen);
+    }
+    return cloud;
+}
+
+} // namespace
+
+static void BM_LookupGridBatch(benchmark::State& state, GridBackend backend) {
+    auto grid = build_grid(backend);
+    auto cloud = build_cloud(state.range(0));
+    std::vector<uint8_t> results(cloud.size());
+
+    for (auto _ : state) {
+        grid.intersects(cloud.data(), cloud.size(), results.data());
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+
+static void BM_LookupGridSingle(benchmark::State& state, GridBackend backend) {
+    auto grid = build_grid(backend);
+    auto cloud = build_cloud(state.range(0));
+
+    for (auto _ : state) {
+        size_t hits = 0;
+        for (const auto& p : cloud) {
+            hits += grid.intersects(p);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+
+    state.SetItemsProcessed(state.iterations() * cloud.size());
+}
+
+BENCHMARK_CAPTURE(BM_LookupGridSingle, hash, GridBackend::HASH)->RangeMultiplier(4)->Range(100000, 1600000)->Arg(2000000);
+BENCHMARK_CAPTURE(BM_LookupGridBatch, hash, GridBackend::HASH)->RangeMultiplier(4)->Range(100000, 1600000)->Arg(2000000);
+BENCHMARK_CAPTURE(BM_LookupGridBatch, dense, GridBackend::DENSE)->RangeMultiplier(4)->Range(100000, 1600000)->Arg(2000000);
+BENCHMARK_CAPTURE(BM_LookupGridBatch, tiled, GridBackend::TILED)->RangeMultiplier(4)->Range(100000, 1600000)->Arg(2000000);
+
+} // approximate_intersection
+
+BENCHMARK_MAIN();
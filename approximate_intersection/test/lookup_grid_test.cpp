@@ -19,6 +19,7 @@
 #include <chrono>
 #include <thread>
 #include <future>
+#include <vector>
 
 #include "approximate_intersection/lookup_grid.hpp"
 
@@ -75,6 +76,120 @@ TEST(approximate_intersection, test){
 
 }
 
+TEST(approximate_intersection, backends){
+
+    for (auto backend : { GridBackend::HASH, GridBackend::DENSE, GridBackend::TILED }) {
+
+        Config config;
+        config.min_x = -10;
+        config.max_x = 10;
+        config.min_y = -10;
+        config.max_y = 10;
+        config.cell_side_length = 1;
+        config.backend = backend;
+        config.tile_side_cells = 8; // Multiple tiles across the grid
+
+        LookupGrid<TestPoint> grid(config);
+
+        // Add some points on the diagonal
+        for (double i = -9.5; i < 10; i += 1.0) {
+            TestPoint p;
+            p.x = i;
+            p.y = i;
+            grid.insert(p);
+        }
+
+        std::vector<TestPoint> points;
+        for (double i = -9.5; i < 10; i += 1.0) {
+            for (double j = -9.5; j < 10; j += 1.0) {
+                TestPoint p;
+                p.x = i;
+                p.y = j;
+                points.push_back(p);
+            }
+        }
+
+        // Verify batch and single point intersection agree
+        std::vector<uint8_t> results(points.size(), 2);
+        grid.intersects(points.data(), points.size(), results.data());
+
+        for (size_t i = 0; i < points.size(); i++) {
+            bool expected = points[i].x == points[i].y;
+            ASSERT_EQ(expected, grid.intersects(points[i])) << "backend: " << backend;
+            ASSERT_EQ(expected, static_cast<bool>(results[i])) << "backend: " << backend;
+        }
+
+        // Points outside the bounds are clamped to the edge cells
+        TestPoint corner;
+        corner.x = -100;
+        corner.y = -100;
+        ASSERT_TRUE(grid.intersects(corner)) << "backend: " << backend;
+    }
+}
+
+TEST(approximate_intersection, backend_from_string){
+    ASSERT_EQ(GridBackend::HASH, grid_backend_from_string("hash"));
+    ASSERT_EQ(GridBackend::DENSE, grid_backend_from_string("dense"));
+    ASSERT_EQ(GridBackend::TILED, grid_backend_from_string("tiled"));
+    ASSERT_THROW(grid_backend_from_string("octree"), std::invalid_argument);
+}
+
+TEST(approximate_intersection, bitmap_backend_fallback){
+    ASSERT_EQ(GridBackend::HASH, Config().backend);
+
+    for (auto backend : { GridBackend::DENSE, GridBackend::TILED }) {
+
+        // Bounds needing far more cells than a bitmap may cover use the hash backend
+        Config config;
+        config.min_x = -1e7;
+        config.max_x = 1e7;
+        config.min_y = -1e7;
+        config.max_y = 1e7;
+        config.cell_side_length = 1;
+        config.backend = backend;
+
+        LookupGrid<TestPoint> grid(config);
+        ASSERT_EQ(GridBackend::HASH, grid.get_config().backend) << "backend: " << backend;
+
+        TestPoint p;
+        p.x = 5000.5;
+        p.y = -5000.5;
+        grid.insert(p);
+        ASSERT_TRUE(grid.intersects(p)) << "backend: " << backend;
+
+        // Bounds a bitmap can cover keep the requested backend
+        config.min_x = -10;
+        config.max_x = 10;
+        config.min_y = -10;
+        config.max_y = 10;
+
+        LookupGrid<TestPoint> small_grid(config);
+        ASSERT_EQ(backend, small_grid.get_config().backend) << "backend: " << backend;
+    }
+}
+
+TEST(approximate_intersection, zero_tile_side_cells){
+    Config config;
+    config.min_x = -10;
+    config.max_x = 10;
+    config.min_y = -10;
+    config.max_y = 10;
+    config.cell_side_length = 1;
+    config.backend = GridBackend::TILED;
+    config.tile_side_cells = 0;
+
+    LookupGrid<TestPoint> grid(config);
+    ASSERT_EQ(GridBackend::TILED, grid.get_config().backend);
+    ASSERT_EQ(1u, grid.get_config().tile_side_cells);
+
+    TestPoint p;
+    p.x = 3.5;
+    p.y = -2.5;
+    ASSERT_FALSE(grid.intersects(p));
+    grid.insert(p);
+    ASSERT_TRUE(grid.intersects(p));
+}
+
 } // approximate_intersection
 
 int main(int argc, char ** argv)
@@ -52,6 +52,13 @@ namespace arbitrator
              * \return The sorted list of up to size beam_width
              */
             std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> prioritize_plans(std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> plans) const;
+
+            /**
+             * \brief Prioritize the plan indices and eliminate those outside the beam width
+             * \param plans The plans to evaluate as (plan index, cost) pairs
+             * \return The sorted list of up to size beam_width
+             */
+            std::vector<std::pair<size_t, double>> prioritize_plan_indices(std::vector<std::pair<size_t, double>> plans) const override;
         private:
             int beam_width_;
     };
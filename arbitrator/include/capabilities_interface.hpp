@@ -26,6 +26,10 @@
 #include <carma_planning_msgs/srv/plugin_list.hpp>
 #include <carma_planning_msgs/srv/get_plugin_api.hpp>
 #include <carma_planning_msgs/srv/plan_maneuvers.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <array>
+#include <chrono>
+#include <mutex>
 
 
 
@@ -44,6 +48,7 @@ namespace arbitrator
              */
             CapabilitiesInterface(std::shared_ptr<carma_ros2_utils::CarmaLifecycleNode> nh): nh_(nh) {
                 sc_s_ = nh_->create_client<carma_planning_msgs::srv::GetPluginApi>("plugins/get_strategic_plugins_by_capability");
+                plugin_latency_pub_ = nh_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("strategic_plugin_latency", 10);
             };
 
             /**
@@ -67,6 +72,12 @@ namespace arbitrator
              *      with a particular capability. Will send the service request to all nodes and
              *      aggregate the responses.
              *
+             *      Requests are dispatched to every available plugin before any response is awaited, and every response
+             *      is collected against a single deadline of PLUGIN_CALL_DEADLINE for the whole call, so one slow plugin
+             *      cannot stall the others. Plugins whose service is not yet available, or whose request fails to send, are
+             *      skipped without waiting and probed again on the next call. Plugins which fail to respond before the
+             *      deadline are left out of the returned map.
+             *
              * \tparam MSrvReq The typename of the service message request
              * \tparam MSrvRes The typename of the service message response
              *
@@ -78,15 +89,65 @@ namespace arbitrator
             std::map<std::string, std::shared_ptr<MSrvRes>> multiplex_service_call_for_capability(const std::string& query_string, std::shared_ptr<MSrvReq> msg);
 
 
+            /**
+             * \brief Publish the per plugin response latency histograms on the strategic_plugin_latency topic
+             */
+            void publish_plugin_latency();
+
             const static std::string STRATEGIC_PLAN_CAPABILITY;
+
+            // Time all plugins have to respond to the requests of one call
+            static constexpr std::chrono::milliseconds PLUGIN_CALL_DEADLINE{500};
+
+            // Upper bounds in milliseconds of the plugin latency histogram buckets. Latencies above the last bound go in an overflow bucket
+            static constexpr std::array<double, 6> LATENCY_BUCKET_BOUNDS_MS{10.0, 25.0, 50.0, 100.0, 250.0, 500.0};
+
+            /**
+             * \brief Response latency statistics for a single plugin
+             */
+            struct PluginLatencyStats
+            {
+                std::array<uint64_t, LATENCY_BUCKET_BOUNDS_MS.size() + 1> bucket_counts{}; // Last element is the overflow bucket
+                uint64_t timeouts = 0;
+                double last_ms = 0;
+                double max_ms = 0;
+            };
+
+            /**
+             * \brief Get the response latency statistics recorded for a plugin
+             * \param topic The plan service topic of the plugin
+             * \return The statistics of the plugin, which are empty if it was never called
+             */
+            PluginLatencyStats get_plugin_latency_stats(const std::string& topic) const;
         protected:
         private:
+
+            /**
+             * \brief Record the response latency of a plugin. Called from the response callback of the request
+             *        so the latency does not depend on the order in which responses are collected. Responses which
+             *        arrive after their deadline are also recorded, in addition to the timeout
+             */
+            void record_plugin_latency(const std::string& topic, double latency_ms);
+
+            /**
+             * \brief Record a plugin which did not respond before the deadline
+             */
+            void record_plugin_timeout(const std::string& topic);
+
             std::shared_ptr<carma_ros2_utils::CarmaLifecycleNode> nh_;
             std::unordered_map<std::string,carma_ros2_utils::ClientPtr<carma_planning_msgs::srv::PlanManeuvers>> registered_strategic_plugins_;
 
             carma_ros2_utils::ClientPtr<carma_planning_msgs::srv::GetPluginApi> sc_s_;
             std::unordered_set <std::string> capabilities_ ;
 
+            // Plugin services which have been confirmed available. Cleared for a plugin when it misses the deadline
+            std::unordered_set<std::string> ready_strategic_plugins_;
+
+            // Responses arrive on executor threads so the statistics are guarded
+            mutable std::mutex plugin_latency_mutex_;
+            std::map<std::string, PluginLatencyStats> plugin_latency_stats_;
+            carma_ros2_utils::PubPtr<diagnostic_msgs::msg::DiagnosticArray> plugin_latency_pub_;
+
 
 
     };
@@ -25,6 +25,8 @@
 #include <rclcpp/exceptions/exceptions.hpp>
 #include <chrono>
 #include <thread>
+#include <utility>
+#include <future>
 namespace arbitrator
 {
     constexpr auto MAX_RETRY_ATTEMPTS {10};
@@ -61,68 +63,90 @@ namespace arbitrator
             return responses;
         }
 
-        std::vector<std::string> topics_to_retry = detected_topics;
-        std::vector<std::string> current_topics_to_check;
-        retry_attempt = 0;
-        while (!topics_to_retry.empty() && retry_attempt < MAX_RETRY_ATTEMPTS)
+        using Clock = std::chrono::steady_clock;
+        using PlanManeuversClient = rclcpp::Client<carma_planning_msgs::srv::PlanManeuvers>;
+
+        struct PendingResponse
+        {
+            std::string topic;
+            PlanManeuversClient::SharedFuture future;
+        };
+
+        // Every response is collected against one deadline for the whole tick, so the total wait is bounded
+        const auto tick_deadline = Clock::now() + PLUGIN_CALL_DEADLINE;
+
+        // Dispatch every request before waiting on any response
+        std::vector<PendingResponse> pending_responses;
+
+        for (const auto & topic : detected_topics)
         {
-            current_topics_to_check = topics_to_retry;
-            topics_to_retry.clear();
-            for (const auto & topic : current_topics_to_check)
+            if (registered_strategic_plugins_.count(topic) == 0)
+                registered_strategic_plugins_[topic] = nh_->create_client<carma_planning_msgs::srv::PlanManeuvers>(topic);
+
+            // Only probe services which have not yet been confirmed available. A plugin which is not ready is skipped
+            // for this tick and probed again on the next one
+            if (ready_strategic_plugins_.count(topic) == 0)
             {
-                try {
-                    using std::literals::chrono_literals::operator""ms;
-
-                    if (registered_strategic_plugins_.count(topic) == 0)
-                        registered_strategic_plugins_[topic] = nh_->create_client<carma_planning_msgs::srv::PlanManeuvers>(topic);
-
-                    auto client = registered_strategic_plugins_[topic];
-
-                    if (client->wait_for_service(500ms))
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "found client: " << topic);
-                    else
-                    {
-                        topics_to_retry.push_back(topic);
-                        RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "Following client timed out: " << topic << ", retrying, attempt no: " << retry_attempt);
-                        continue;
-                    }
-
-                    const auto response = client->async_send_request(msg);
-
-                    switch (const auto status{response.wait_for(500ms)}) {
-                        case std::future_status::ready:
-                            responses.emplace(topic, response.get());
-                            break;
-                        case std::future_status::deferred:
-                            RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is deferred... Please check if the plugin is active");
-                            break;
-                        case std::future_status::timeout:
-                            RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is timed out... Please check if the plugin is active");
-                            break;
-                        default:
-                            RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is failed... Please check if the plugin is active");
-                            break;
-                    }
-                    if (retry_attempt > 0)
-                    {
-                        RCLCPP_INFO_STREAM(rclcpp::get_logger("arbitrator"),"Service call to: " << topic << ", successfully finished after retrying: " << retry_attempt);
-                    }
-
-                } catch(const rclcpp::exceptions::RCLError& error) {
-                    RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"),
-                        "Cannot make service request for service '" << topic << "': " << error.what() <<". So retrying, attempt no: " << retry_attempt);
-                    topics_to_retry.push_back(topic);
+                if (!registered_strategic_plugins_[topic]->service_is_ready())
+                {
+                    RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "Following client is not available, skipping it this tick: " << topic);
+                    continue;
                 }
+                RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "found client: " << topic);
+                ready_strategic_plugins_.insert(topic);
+            }
+
+            try {
+                const auto sent_time = Clock::now();
+
+                // The latency is recorded when the response arrives rather than when it is collected below
+                auto future = registered_strategic_plugins_[topic]->async_send_request(msg,
+                    [this, topic, sent_time](PlanManeuversClient::SharedFuture) {
+                        record_plugin_latency(topic, std::chrono::duration<double, std::milli>(Clock::now() - sent_time).count());
+                    });
+
+                pending_responses.push_back({topic, future});
+            } catch(const rclcpp::exceptions::RCLError& error) {
+                RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"),
+                    "Cannot make service request for service '" << topic << "': " << error.what());
+                ready_strategic_plugins_.erase(topic);
             }
-            retry_attempt ++;
         }
 
-        if (retry_attempt >= MAX_RETRY_ATTEMPTS)
+        for (auto & pending : pending_responses)
+        {
+            const auto & topic = pending.topic;
+
+            switch (const auto status{pending.future.wait_until(tick_deadline)}) {
+                case std::future_status::ready:
+                    responses.emplace(topic, pending.future.get());
+                    break;
+                case std::future_status::deferred:
+                    RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is deferred... Please check if the plugin is active");
+                    record_plugin_timeout(topic);
+                    ready_strategic_plugins_.erase(topic);
+                    break;
+                case std::future_status::timeout:
+                    RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is timed out... Please check if the plugin is active");
+                    record_plugin_timeout(topic);
+                    ready_strategic_plugins_.erase(topic);
+                    break;
+                default:
+                    RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"), "service call to " << topic << " is failed... Please check if the plugin is active");
+                    record_plugin_timeout(topic);
+                    ready_strategic_plugins_.erase(topic);
+                    break;
+            }
+        }
+
+        if (responses.size() < detected_topics.size())
         {
             RCLCPP_WARN_STREAM(rclcpp::get_logger("arbitrator"),
                             "Failed to get a valid response from one or all of the strategic plugins...");
         }
 
+        publish_plugin_latency();
+
         return responses;
     }
 }
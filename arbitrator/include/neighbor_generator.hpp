@@ -38,7 +38,7 @@ namespace arbitrator
              *
              * \return A vector containing the new plans generated from it, if any
              */
-            virtual std::vector<carma_planning_msgs::msg::ManeuverPlan> generate_neighbors(carma_planning_msgs::msg::ManeuverPlan plan, const VehicleState& initial_state) const = 0;
+            virtual std::vector<carma_planning_msgs::msg::ManeuverPlan> generate_neighbors(const carma_planning_msgs::msg::ManeuverPlan& plan, const VehicleState& initial_state) const = 0;
 
             /**
              * \brief Virtual destructor provided for memory safety
@@ -50,7 +50,7 @@ namespace arbitrator
              * \param initial_state The initial state of the vehicle at the start of plan. This will be provided to planners for specific use when plan is empty
              * \return A list of subsequent plans building on top of the input plan
              */
-            std::vector<carma_planning_msgs::msg::ManeuverPlan> generate_neighbors(carma_planning_msgs::msg::ManeuverPlan plan, const VehicleState& initial_state) const;
+            std::vector<carma_planning_msgs::msg::ManeuverPlan> generate_neighbors(const carma_planning_msgs::msg::ManeuverPlan& plan, const VehicleState& initial_state) const;
         private:
             std::shared_ptr<T> ci_;
     };
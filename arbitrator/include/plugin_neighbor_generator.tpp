@@ -21,6 +21,7 @@
 #include "plugin_neighbor_generator.hpp"
 #include <carma_planning_msgs/srv/plan_maneuvers.hpp>
 #include <map>
+#include <utility>
 
 namespace arbitrator
 {   
@@ -28,7 +29,7 @@ namespace arbitrator
     using PlanMvrReq = carma_planning_msgs::srv::PlanManeuvers::Request;
 
     template <class T>
-    std::vector<carma_planning_msgs::msg::ManeuverPlan> PluginNeighborGenerator<T>::generate_neighbors(carma_planning_msgs::msg::ManeuverPlan plan, const VehicleState& initial_state) const
+    std::vector<carma_planning_msgs::msg::ManeuverPlan> PluginNeighborGenerator<T>::generate_neighbors(const carma_planning_msgs::msg::ManeuverPlan& plan, const VehicleState& initial_state) const
     {
         auto msg = std::make_shared<PlanMvrReq>();
         // Set prior plan
@@ -47,10 +48,11 @@ namespace arbitrator
         
         // Convert map to vector of map values
         std::vector<carma_planning_msgs::msg::ManeuverPlan> out;
+        out.reserve(res.size());
         for (auto it = res.begin(); it != res.end(); it++)
         {
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "Pushing response of child: " << it->first << ", which had mvr size: " << it->second->new_plan.maneuvers.size());
-            out.push_back(it->second->new_plan);
+            out.push_back(std::move(it->second->new_plan));
         }
         return out;
     }
@@ -18,6 +18,8 @@
 #define __ARBITRATOR_INCLUDE_SEARCH_STRATEGY_HPP__
 
 #include <map>
+#include <vector>
+#include <algorithm>
 #include <carma_planning_msgs/msg/maneuver_plan.hpp>
 
 namespace arbitrator
@@ -44,6 +46,28 @@ namespace arbitrator
              */
             virtual std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> prioritize_plans(std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> plans) const = 0;
 
+            /**
+             * \brief Sort the open-set of a search whose plans are stored elsewhere
+             *      (e.g. in a planner owned arena) and referenced only by index
+             * 
+             * Used to prioritize and prune the open list at every depth of the search
+             * without copying the plans themselves. The default implementation sorts
+             * by ascending cost and retains every node.
+             * 
+             * \param plans The list of (plan index, cost) pairs to sort
+             * \return A sorted (and/or reduced) list of (plan index, cost) pairs
+             */
+            virtual std::vector<std::pair<size_t, double>> prioritize_plan_indices(std::vector<std::pair<size_t, double>> plans) const
+            {
+                std::stable_sort(plans.begin(), plans.end(),
+                    [] (const std::pair<size_t, double>& a, const std::pair<size_t, double>& b)
+                    {
+                        return a.second < b.second;
+                    }
+                );
+                return plans;
+            }
+
             /**
              * \brief Virtual destructor provided for memory safety
              */
@@ -63,6 +63,12 @@ namespace arbitrator
              * \param start_state The starting state of the vehicle to plan for
              */
             carma_planning_msgs::msg::ManeuverPlan generate_plan(const VehicleState& start_state);
+
+            /**
+             * \brief Number of plans the search arena reserves space for up front.
+             *      The arena grows past this if needed.
+             */
+            static constexpr size_t INITIAL_ARENA_CAPACITY = 64;
         protected:
             std::shared_ptr<CostFunction> cost_function_;
             std::shared_ptr<NeighborGenerator> neighbor_generator_;
@@ -35,4 +35,22 @@ namespace arbitrator
         
         return plans;
     }
+
+    std::vector<std::pair<size_t, double>> BeamSearchStrategy::prioritize_plan_indices(std::vector<std::pair<size_t, double>> plans) const
+    {
+        std::stable_sort(plans.begin(), 
+            plans.end(), 
+            [] (const std::pair<size_t, double>& a, const std::pair<size_t, double>& b) 
+            {
+                return a.second < b.second;
+            }
+        );
+
+        if (plans.size() > static_cast<size_t>(beam_width_))
+        {
+            plans.resize(beam_width_);
+        }
+
+        return plans;
+    }
 }
\ No newline at end of file
@@ -18,10 +18,13 @@
 #include <carma_planning_msgs/srv/plan_maneuvers.hpp>
 #include <exception>
 #include <sstream>
+#include <algorithm>
 
 namespace arbitrator
 {
     const std::string CapabilitiesInterface::STRATEGIC_PLAN_CAPABILITY = "strategic_plan/plan_maneuvers";
+    constexpr std::chrono::milliseconds CapabilitiesInterface::PLUGIN_CALL_DEADLINE;
+    constexpr std::array<double, 6> CapabilitiesInterface::LATENCY_BUCKET_BOUNDS_MS;
     
     std::vector<std::string> CapabilitiesInterface::get_topics_for_capability(const std::string& query_string)
     {
@@ -56,4 +59,90 @@ namespace arbitrator
         return topics;
 
     }
+
+    CapabilitiesInterface::PluginLatencyStats CapabilitiesInterface::get_plugin_latency_stats(const std::string& topic) const
+    {
+        std::lock_guard<std::mutex> lock(plugin_latency_mutex_);
+
+        auto stats = plugin_latency_stats_.find(topic);
+        if (stats == plugin_latency_stats_.end())
+        {
+            return PluginLatencyStats();
+        }
+        return stats->second;
+    }
+
+    void CapabilitiesInterface::record_plugin_latency(const std::string& topic, double latency_ms)
+    {
+        std::lock_guard<std::mutex> lock(plugin_latency_mutex_);
+
+        auto& stats = plugin_latency_stats_[topic];
+
+        size_t bucket = 0;
+        while (bucket < LATENCY_BUCKET_BOUNDS_MS.size() && latency_ms >= LATENCY_BUCKET_BOUNDS_MS[bucket])
+        {
+            bucket++;
+        }
+        stats.bucket_counts[bucket]++;
+        stats.last_ms = latency_ms;
+        stats.max_ms = std::max(stats.max_ms, latency_ms);
+    }
+
+    void CapabilitiesInterface::record_plugin_timeout(const std::string& topic)
+    {
+        std::lock_guard<std::mutex> lock(plugin_latency_mutex_);
+
+        auto& stats = plugin_latency_stats_[topic];
+        stats.timeouts++;
+        stats.last_ms = std::chrono::duration<double, std::milli>(PLUGIN_CALL_DEADLINE).count();
+    }
+
+    void CapabilitiesInterface::publish_plugin_latency()
+    {
+        diagnostic_msgs::msg::DiagnosticArray msg;
+        msg.header.stamp = nh_->now();
+
+        {
+            // Hold the lock only while the statistics are copied into the message
+            std::lock_guard<std::mutex> lock(plugin_latency_mutex_);
+
+            for (const auto& topic_stats : plugin_latency_stats_)
+            {
+                const auto& stats = topic_stats.second;
+
+                diagnostic_msgs::msg::DiagnosticStatus status;
+                status.name = topic_stats.first;
+                status.hardware_id = "arbitrator";
+                status.level = stats.timeouts > 0 ? diagnostic_msgs::msg::DiagnosticStatus::WARN : diagnostic_msgs::msg::DiagnosticStatus::OK;
+                status.message = "Strategic plugin response latency";
+
+                auto add_value = [&status](const std::string& key, const std::string& value) {
+                    diagnostic_msgs::msg::KeyValue kv;
+                    kv.key = key;
+                    kv.value = value;
+                    status.values.push_back(kv);
+                };
+
+                add_value("last_ms", std::to_string(stats.last_ms));
+                add_value("max_ms", std::to_string(stats.max_ms));
+                add_value("timeouts", std::to_string(stats.timeouts));
+
+                double lower_bound = 0.0;
+                for (size_t i = 0; i < LATENCY_BUCKET_BOUNDS_MS.size(); i++)
+                {
+                    std::ostringstream key;
+                    key << "bucket_" << lower_bound << "_" << LATENCY_BUCKET_BOUNDS_MS[i] << "_ms";
+                    add_value(key.str(), std::to_string(stats.bucket_counts[i]));
+                    lower_bound = LATENCY_BUCKET_BOUNDS_MS[i];
+                }
+                std::ostringstream overflow_key;
+                overflow_key << "bucket_" << lower_bound << "_inf_ms";
+                add_value(overflow_key.str(), std::to_string(stats.bucket_counts.back()));
+
+                msg.status.push_back(status);
+            }
+        }
+
+        plugin_latency_pub_->publish(msg);
+    }
 }
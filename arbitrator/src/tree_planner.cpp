@@ -19,34 +19,41 @@
 #include <vector>
 #include <map>
 #include <limits>
+#include <utility>
 
 namespace arbitrator
 {
+    constexpr size_t TreePlanner::INITIAL_ARENA_CAPACITY;
+
     carma_planning_msgs::msg::ManeuverPlan TreePlanner::generate_plan(const VehicleState& start_state)
     {
-        carma_planning_msgs::msg::ManeuverPlan root;
-        std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> open_list_to_evaluate;
-        std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> final_open_list;
+        // Every plan in the search tree is stored once in the arena and referred to by index
+        // from the open lists so that expanding and prioritizing nodes never copies a plan
+        std::vector<carma_planning_msgs::msg::ManeuverPlan> plan_arena;
+        plan_arena.reserve(INITIAL_ARENA_CAPACITY);
+        std::vector<std::pair<size_t, double>> open_list_to_evaluate;
+        std::vector<std::pair<size_t, double>> temp_open_list;
+        std::vector<std::pair<size_t, double>> final_open_list;
 
         const double INF = std::numeric_limits<double>::infinity();
-        open_list_to_evaluate.push_back(std::make_pair(root, INF));
+        plan_arena.emplace_back(); // Root
+        open_list_to_evaluate.push_back(std::make_pair(0, INF));
 
-        carma_planning_msgs::msg::ManeuverPlan longest_plan = root; // Track longest plan in case target length is never reached
+        size_t longest_plan_index = 0; // Track longest plan in case target length is never reached
         rclcpp::Duration longest_plan_duration = rclcpp::Duration(0);
 
 
         while (!open_list_to_evaluate.empty())
         {
-            std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> temp_open_list;
+            temp_open_list.clear();
 
             for (auto it = open_list_to_evaluate.begin(); it != open_list_to_evaluate.end(); it++)
             {
-                // Pop the first element off the open list
-                carma_planning_msgs::msg::ManeuverPlan cur_plan = it->first;
+                const size_t cur_index = it->first;
 
                 RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "START");
 
-                for (auto mvr : cur_plan.maneuvers)
+                for (const auto& mvr : plan_arena[cur_index].maneuvers)
                 {
                     RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "Printing cur_plan: mvr: "<< (int)mvr.type);
                 }
@@ -56,17 +63,17 @@ namespace arbitrator
                 auto plan_duration = rclcpp::Duration(0, 0); // zero duration
 
                 // If we're not at the root, plan_duration is nonzero (our plan should have maneuvers)
-                if (!cur_plan.maneuvers.empty())
+                if (!plan_arena[cur_index].maneuvers.empty())
                 {
                     // get plan duration
-                    plan_duration = arbitrator_utils::get_plan_end_time(cur_plan) - arbitrator_utils::get_plan_start_time(cur_plan);
+                    plan_duration = arbitrator_utils::get_plan_end_time(plan_arena[cur_index]) - arbitrator_utils::get_plan_start_time(plan_arena[cur_index]);
                 }
 
                 // save longest if none of the plans have enough target duration
                 if (plan_duration > longest_plan_duration)
                 {
                     longest_plan_duration = plan_duration;
-                    longest_plan = cur_plan;
+                    longest_plan_index = cur_index;
                 }
 
                 // Evaluate plan_duration is sufficient do not expand more
@@ -74,7 +81,7 @@ namespace arbitrator
                 {
                     final_open_list.push_back((*it));
                     RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "Has enough duration, skipping that which has following mvrs..:");
-                    for (auto mvr : it->first.maneuvers)
+                    for (const auto& mvr : plan_arena[cur_index].maneuvers)
                     {
                         RCLCPP_DEBUG_STREAM(rclcpp::get_logger("arbitrator"), "Printing mvr: "<< (int)mvr.type);
                     }
@@ -82,7 +89,7 @@ namespace arbitrator
                 }
 
                 // Expand it, and reprioritize
-                std::vector<carma_planning_msgs::msg::ManeuverPlan> children = neighbor_generator_->generate_neighbors(cur_plan, start_state);
+                std::vector<carma_planning_msgs::msg::ManeuverPlan> children = neighbor_generator_->generate_neighbors(plan_arena[cur_index], start_state);
 
                 // Compute cost for each child and store in open list
                 for (auto child = children.begin(); child != children.end(); child++)
@@ -94,11 +101,14 @@ namespace arbitrator
                         continue;
                     }
 
-                    temp_open_list.push_back(std::make_pair(*child, cost_function_->compute_cost_per_unit_distance(*child)));
+                    double cost = cost_function_->compute_cost_per_unit_distance(*child);
+                    plan_arena.push_back(std::move(*child));
+                    temp_open_list.push_back(std::make_pair(plan_arena.size() - 1, cost));
                 }
             }
 
-            open_list_to_evaluate = temp_open_list;
+            // Prune the next depth of the search before expanding it
+            open_list_to_evaluate = search_strategy_->prioritize_plan_indices(std::move(temp_open_list));
         }
 
         if (final_open_list.empty())
@@ -107,26 +117,40 @@ namespace arbitrator
             throw std::runtime_error("None of the strategic plugins generated any valid plans! Please check if any is turned and returning valid maneuvers...");
         }
 
-        final_open_list = search_strategy_->prioritize_plans(final_open_list);
+        // Only the finished plans are handed to the search strategy by value, so move them out of the arena.
+        // The longest plan is kept in place as it is the fallback result.
+        std::vector<std::pair<carma_planning_msgs::msg::ManeuverPlan, double>> final_plans;
+        final_plans.reserve(final_open_list.size());
+        for (const auto& entry : final_open_list)
+        {
+            if (entry.first == longest_plan_index)
+            {
+                final_plans.push_back(std::make_pair(plan_arena[entry.first], entry.second));
+            }
+            else
+            {
+                final_plans.push_back(std::make_pair(std::move(plan_arena[entry.first]), entry.second));
+            }
+        }
+
+        final_plans = search_strategy_->prioritize_plans(std::move(final_plans));
 
         // now every plan has enough duration if possible and prioritized
-        for (auto pair : final_open_list)
+        for (auto& pair : final_plans)
         {
-            // Pop the first element off the open list
-            carma_planning_msgs::msg::ManeuverPlan cur_plan = pair.first;
             rclcpp::Duration plan_duration(0,0); // zero duration
 
             // get plan duration
-            plan_duration = arbitrator_utils::get_plan_end_time(cur_plan) - arbitrator_utils::get_plan_start_time(cur_plan);
+            plan_duration = arbitrator_utils::get_plan_end_time(pair.first) - arbitrator_utils::get_plan_start_time(pair.first);
 
             // Evaluate plan_duration is sufficient do not expand more
             if (plan_duration >= target_plan_duration_)
             {
-                return cur_plan;
+                return std::move(pair.first);
             }
         }
 
         // If no perfect match is found, return the longest plan that fit the criteria
-        return longest_plan;
+        return std::move(plan_arena[longest_plan_index]);
     }
 }
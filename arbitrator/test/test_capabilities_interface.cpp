@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
+#include <carma_planning_msgs/srv/get_plugin_api.hpp>
+#include <carma_planning_msgs/srv/plan_maneuvers.hpp>
+#include <chrono>
+#include <thread>
+#include "capabilities_interface.hpp"
+
+namespace arbitrator
+{
+    using PlanManeuvers = carma_planning_msgs::srv::PlanManeuvers;
+
+    TEST(CapabilitiesInterfaceTest, multiplexRecordsLatencyPerPlugin)
+    {
+        const std::string slow_topic = "/slow_plugin/plan_maneuvers";
+        const std::string fast_topic = "/fast_plugin/plan_maneuvers";
+        const std::string missing_topic = "/missing_plugin/plan_maneuvers";
+
+        // Plugin manager which lists the slow plugin first so it is collected first, along with a plugin which never starts
+        auto plugin_manager = std::make_shared<rclcpp::Node>("test_plugin_manager");
+        auto plugin_list_srv = plugin_manager->create_service<carma_planning_msgs::srv::GetPluginApi>(
+            "/plugins/get_strategic_plugins_by_capability",
+            [&](const std::shared_ptr<rmw_request_id_t>, carma_planning_msgs::srv::GetPluginApi::Request::SharedPtr,
+                carma_planning_msgs::srv::GetPluginApi::Response::SharedPtr res) {
+                res->plan_service = { slow_topic, missing_topic, fast_topic };
+            });
+
+        // Each plugin is its own node so the slow plugin does not delay the fast one
+        auto slow_plugin = std::make_shared<rclcpp::Node>("slow_plugin");
+        auto slow_srv = slow_plugin->create_service<PlanManeuvers>(slow_topic,
+            [](const std::shared_ptr<rmw_request_id_t>, PlanManeuvers::Request::SharedPtr, PlanManeuvers::Response::SharedPtr) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            });
+
+        auto fast_plugin = std::make_shared<rclcpp::Node>("fast_plugin");
+        auto fast_srv = fast_plugin->create_service<PlanManeuvers>(fast_topic,
+            [](const std::shared_ptr<rmw_request_id_t>, PlanManeuvers::Request::SharedPtr, PlanManeuvers::Response::SharedPtr) {});
+
+        auto arbitrator_node = std::make_shared<carma_ros2_utils::CarmaLifecycleNode>(rclcpp::NodeOptions());
+        CapabilitiesInterface ci(arbitrator_node);
+
+        rclcpp::executors::MultiThreadedExecutor executor;
+        executor.add_node(plugin_manager);
+        executor.add_node(slow_plugin);
+        executor.add_node(fast_plugin);
+        executor.add_node(arbitrator_node->get_node_base_interface());
+        std::thread spin_thread([&executor]() { executor.spin(); });
+
+        // Plugins which are not yet discovered are skipped rather than waited on, so wait for discovery up front
+        ASSERT_TRUE(arbitrator_node->create_client<PlanManeuvers>(slow_topic)->wait_for_service(std::chrono::seconds(10)));
+        ASSERT_TRUE(arbitrator_node->create_client<PlanManeuvers>(fast_topic)->wait_for_service(std::chrono::seconds(10)));
+
+        auto req = std::make_shared<PlanManeuvers::Request>();
+        auto responses = ci.multiplex_service_call_for_capability<PlanManeuvers::Request, PlanManeuvers::Response>(
+            CapabilitiesInterface::STRATEGIC_PLAN_CAPABILITY, req);
+
+        // The latency is recorded by the response callback, which runs just after the response is made available
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        executor.cancel();
+        spin_thread.join();
+
+        ASSERT_EQ(2u, responses.size());
+        ASSERT_EQ(1u, responses.count(slow_topic));
+        ASSERT_EQ(1u, responses.count(fast_topic));
+        ASSERT_EQ(0u, responses.count(missing_topic));
+
+        auto slow_stats = ci.get_plugin_latency_stats(slow_topic);
+        auto fast_stats = ci.get_plugin_latency_stats(fast_topic);
+
+        ASSERT_EQ(0u, slow_stats.timeouts);
+        ASSERT_EQ(0u, fast_stats.timeouts);
+
+        // The missing plugin was skipped rather than timed out
+        ASSERT_EQ(0u, ci.get_plugin_latency_stats(missing_topic).timeouts);
+        ASSERT_GE(slow_stats.last_ms, 300.0);
+
+        // Collecting the slow response first must not add its wait to the latency of the fast plugin
+        ASSERT_LT(fast_stats.last_ms, 150.0);
+    }
+}
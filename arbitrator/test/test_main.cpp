@@ -15,9 +15,19 @@
  */
 
 #include <gtest/gtest.h>
+#include <rclcpp/rclcpp.hpp>
 
 // Run all the tests
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+
+    //Initialize ROS
+    rclcpp::init(argc, argv);
+
+    bool success = RUN_ALL_TESTS();
+
+    //shutdown ROS
+    rclcpp::shutdown();
+
+    return success;
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
  */
 
 #include "test_utils.h"
+#include "tree_planner_test_utils.h"
 #include "tree_planner.hpp"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -50,7 +51,7 @@ namespace arbitrator
     class MockNeighborGenerator : public NeighborGenerator
     {
         public:
-            MOCK_CONST_METHOD2(generate_neighbors, std::vector<carma_planning_msgs::msg::ManeuverPlan>(carma_planning_msgs::msg::ManeuverPlan, const VehicleState&));
+            MOCK_CONST_METHOD2(generate_neighbors, std::vector<carma_planning_msgs::msg::ManeuverPlan>(const carma_planning_msgs::msg::ManeuverPlan&, const VehicleState&));
             ~MockNeighborGenerator(){};
     };
 
@@ -234,4 +235,27 @@ namespace arbitrator
         ASSERT_EQ(rclcpp::Time(4, 0), rclcpp::Time(plan.maneuvers[2].lane_following_maneuver.start_time, RCL_SYSTEM_TIME));
         ASSERT_EQ(rclcpp::Time(5, 0), rclcpp::Time(plan.maneuvers[2].lane_following_maneuver.end_time, RCL_SYSTEM_TIME));
     }
-}
\ No newline at end of file
+
+    TEST(TreePlannerSearchTest, testBeamAppliedAtEveryDepth)
+    {
+        auto ng = std::make_shared<BranchingNeighborGenerator>();
+        TreePlanner planner(std::make_shared<PluginIndexCostFunction>(), ng, std::make_shared<BeamSearchStrategy>(3), rclcpp::Duration(5, 0));
+
+        VehicleState state;
+        carma_planning_msgs::msg::ManeuverPlan plan = planner.generate_plan(state);
+
+        // With a beam width of 3 applied at every depth only 3 plans are expanded per depth after the root
+        ASSERT_EQ(5, plan.maneuvers.size());
+        ASSERT_EQ(static_cast<size_t>(1 + 3 * 4), ng->calls_);
+        for (const auto& mvr : plan.maneuvers)
+        {
+            ASSERT_EQ("plugin_0", mvr.lane_following_maneuver.parameters.planning_strategic_plugin);
+        }
+
+        // Repeated searches reuse the planner's storage and find the same plan
+        ng->calls_ = 0;
+        plan = planner.generate_plan(state);
+        ASSERT_EQ(5, plan.maneuvers.size());
+        ASSERT_EQ(static_cast<size_t>(1 + 3 * 4), ng->calls_);
+    }
+}
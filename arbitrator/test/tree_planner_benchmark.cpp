@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+#include "beam_search_strategy.hpp"
+#include "tree_planner.hpp"
+#include "tree_planner_test_utils.h"
+
+namespace {
+
+// Heap allocation counter. This executable only holds the tree planner benchmark so the global
+// allocation functions can be replaced without affecting any test
+std::atomic<bool> count_allocations{false};
+std::atomic<size_t> allocation_count{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (count_allocations.load(std::memory_order_relaxed)) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace arbitrator {
+
+static void BM_TreePlannerGeneratePlan(benchmark::State& state) {
+    auto ng = std::make_shared<BranchingNeighborGenerator>();
+    TreePlanner planner(std::make_shared<PluginIndexCostFunction>(), ng, std::make_shared<BeamSearchStrategy>(state.range(0)),
+                        rclcpp::Duration(5, 0));
+    VehicleState vehicle_state;
+
+    ng->calls_ = 0;
+    allocation_count = 0;
+    count_allocations = true;
+
+    for (auto _ : state) {
+        auto plan = planner.generate_plan(vehicle_state);
+        benchmark::DoNotOptimize(plan);
+    }
+
+    count_allocations = false;
+
+    state.SetItemsProcessed(ng->calls_ * BranchingNeighborGenerator::BRANCHING_FACTOR);
+    state.counters["allocations_per_plan"] = benchmark::Counter(static_cast<double>(allocation_count), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_TreePlannerGeneratePlan)->Arg(1)->Arg(3)->Arg(9);
+
+} // arbitrator
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#ifndef __ARBITRATOR_INCLUDE_TREE_PLANNER_TEST_UTILS_HPP__
+#define __ARBITRATOR_INCLUDE_TREE_PLANNER_TEST_UTILS_HPP__
+
+#include <string>
+#include <vector>
+#include <rclcpp/rclcpp.hpp>
+#include <carma_planning_msgs/msg/maneuver_plan.hpp>
+#include "neighbor_generator.hpp"
+#include "cost_function.hpp"
+#include "vehicle_state.hpp"
+
+namespace arbitrator
+{
+    /**
+     * Neighbor generator which extends every plan with BRANCHING_FACTOR one second lane following maneuvers.
+     * Used to exercise the tree search without gmock overhead.
+     */
+    class BranchingNeighborGenerator : public NeighborGenerator
+    {
+        public:
+            static constexpr int BRANCHING_FACTOR = 3;
+
+            std::vector<carma_planning_msgs::msg::ManeuverPlan> generate_neighbors(const carma_planning_msgs::msg::ManeuverPlan& plan, const VehicleState&) const override
+            {
+                calls_++;
+                std::vector<carma_planning_msgs::msg::ManeuverPlan> children;
+                children.reserve(BRANCHING_FACTOR);
+
+                int32_t start_sec = plan.maneuvers.empty() ? 0 : plan.maneuvers.back().lane_following_maneuver.end_time.sec;
+
+                for (int i = 0; i < BRANCHING_FACTOR; i++)
+                {
+                    carma_planning_msgs::msg::Maneuver mvr;
+                    mvr.type = carma_planning_msgs::msg::Maneuver::LANE_FOLLOWING;
+                    mvr.lane_following_maneuver.start_time = rclcpp::Time(start_sec, 0);
+                    mvr.lane_following_maneuver.end_time = rclcpp::Time(start_sec + 1, 0);
+                    mvr.lane_following_maneuver.parameters.planning_strategic_plugin = "plugin_" + std::to_string(i);
+
+                    children.push_back(plan);
+                    children.back().maneuvers.push_back(mvr);
+                }
+                return children;
+            }
+
+            mutable size_t calls_ = 0;
+    };
+
+    /**
+     * Cost function which prefers plans built from lower numbered plugins
+     */
+    class PluginIndexCostFunction : public CostFunction
+    {
+        public:
+            double compute_total_cost(const carma_planning_msgs::msg::ManeuverPlan& plan) override
+            {
+                double cost = 0.0;
+                for (const auto& mvr : plan.maneuvers)
+                {
+                    cost += mvr.lane_following_maneuver.parameters.planning_strategic_plugin.back() - '0';
+                }
+                return cost;
+            }
+
+            double compute_cost_per_unit_distance(const carma_planning_msgs::msg::ManeuverPlan& plan) override
+            {
+                return compute_total_cost(plan) / plan.maneuvers.size();
+            }
+    };
+}
+
+#endif //__ARBITRATOR_INCLUDE_TREE_PLANNER_TEST_UTILS_HPP__
@@ -39,6 +39,7 @@
 #include <basic_autonomy/smoothing/filters.hpp>
 #include <carma_debug_ros2_msgs/msg/trajectory_curvature_speeds.hpp>
 #include <autoware_auto_msgs/msg/trajectory.hpp>
+#include <basic_autonomy/geometry_profile_cache.hpp>
 
 /**
  * \brief Macro definition to enable easier access to fields shared across the maneuver types
@@ -180,6 +181,29 @@ namespace basic_autonomy
         */
         std::unique_ptr<basic_autonomy::smoothing::SplineI> compute_fit(const std::vector<lanelet::BasicPoint2d> &basic_points);
 
+       /**
+        * \brief Fits a spline to the provided points and resamples it at the provided step size
+        * \param curve_points The points to use for fitting the spline
+        * \param speed_limits The speed limit at each of curve_points
+        * \param curve_resample_step_size The distance between resampled points
+        *
+        * \return The resampled points along with their curvature, orientation and distributed speed limit
+        */
+        ResampledCurve resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const std::vector<double> &speed_limits,
+                                      double curve_resample_step_size);
+
+       /**
+        * \brief Fits a spline to the provided points and resamples it at the provided step size into caller owned buffers.
+        *        The buffers keep their capacity so repeated calls do not reallocate them.
+        * \param curve_points The points to use for fitting the spline
+        * \param speed_limits The speed limit at each of curve_points
+        * \param curve_resample_step_size The distance between resampled points
+        * \param samples Buffer the spline is resampled into
+        * \param curve Output of the resampled points along with their curvature, orientation and distributed speed limit
+        */
+        void resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const std::vector<double> &speed_limits,
+                            double curve_resample_step_size, smoothing::SplineSamples* samples, ResampledCurve* curve);
+
        /**
         * \brief Given the curvature fit, computes the curvature at the given step along the curve
         * \param step_along_the_curve Value in double from 0.0 (curvature start) to 1.0 (curvature end) representing where to calculate the curvature
@@ -199,12 +223,13 @@ namespace basic_autonomy
         * \param state The vehicle state at the time the function is called
         * \param general_config Basic autonomy struct defined to load general config parameters from tactical plugins
         * \param detailed_config Basic autonomy struct defined to load detailed config parameters from tactical plugins
+        * \param cache Optional cache owned by the caller which keeps lane follow geometry across planning ticks. Nothing is cached if null
         * \return A vector of point speed pair struct which contains geometry points as basicpoint::lanelet2d and speed as a double for the maneuver
         */
         std::vector<PointSpeedPair> create_geometry_profile(const std::vector<carma_planning_msgs::msg::Maneuver> &maneuvers, double max_starting_downtrack, const carma_wm::WorldModelConstPtr &wm,
                                                                    carma_planning_msgs::msg::VehicleState &ending_state_before_buffer,
                                                                    const carma_planning_msgs::msg::VehicleState& state,const GeneralTrajConfig &general_config,
-                                                                   const DetailedTrajConfig &detailed_config);
+                                                                   const DetailedTrajConfig &detailed_config, const std::shared_ptr<GeometryProfileCache>& cache = nullptr);
        /**
         * \brief Converts a set of requested LANE_FOLLOWING maneuvers to point speed limit pairs.
         * \param maneuvers The list of maneuvers to convert geometry points and calculate associated speed
@@ -213,12 +238,15 @@ namespace basic_autonomy
         * \param wm Pointer to intialized world model for semantic map access
         * \param general_config Basic autonomy struct defined to load general config parameters from tactical plugins
         * \param detailed_config Basic autonomy struct defined to load detailed config parameters from tactical plugins
+        * \param visited_lanelets Lanelets already converted by earlier maneuvers. The lanelets converted by this maneuver are added
+        * \param cache Optional cache owned by the caller which keeps downsampled centerlines across planning ticks. Nothing is cached if null
         *
         * \return List of centerline points paired with speed limits
         */
         std::vector<PointSpeedPair> create_lanefollow_geometry(const carma_planning_msgs::msg::Maneuver &maneuver, double max_starting_downtrack,
                                                                    const carma_wm::WorldModelConstPtr &wm, const GeneralTrajConfig &general_config,
-                                                                   const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id>& visited_lanelets);
+                                                                   const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id>& visited_lanelets,
+                                                                   const std::shared_ptr<GeometryProfileCache>& cache = nullptr);
 
        /**
         * \brief Adds extra centerline points beyond required message length to lane follow maneuver points so that there's always enough points to calculate trajectory
@@ -240,6 +268,7 @@ namespace basic_autonomy
         *               These points must be in the same lane as the vehicle and must extend in front of it though it is fine if they also extend behind it.
         * \param state The current state of the vehicle
         * \param state_time The abosolute time which the provided vehicle state corresponds to
+        * \param cache Optional cache owned by the caller. The time spent fitting the spline is added to its compute time
         *
         * \return A list of trajectory points to send to the carma planning stack
         */
@@ -247,7 +276,7 @@ namespace basic_autonomy
         compose_lanefollow_trajectory_from_path(const std::vector<PointSpeedPair> &points, const carma_planning_msgs::msg::VehicleState &state,
                                                       const rclcpp::Time &state_time, const carma_wm::WorldModelConstPtr &wm,
                                                       const carma_planning_msgs::msg::VehicleState &ending_state_before_buffer, carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds& debug_msg,
-                                                      const DetailedTrajConfig &detailed_config);
+                                                      const DetailedTrajConfig &detailed_config, const std::shared_ptr<GeometryProfileCache>& cache = nullptr);
 
        //Functions specific to lane change
        /**
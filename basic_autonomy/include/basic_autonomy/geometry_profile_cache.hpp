@@ -0,0 +1,177 @@
+#pragma once
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+#include <basic_autonomy/smoothing/SplineI.hpp>
+
+namespace basic_autonomy
+{
+namespace waypoint_generation
+{
+    /**
+     * \brief Counters describing how well a geometry profile cache is performing
+     */
+    struct GeometryProfileCacheStats
+    {
+        uint64_t window_hits = 0;           // Total lanelet centerlines reused from a cached lane follow window
+        uint64_t window_misses = 0;         // Total lanelet centerlines which had to be downsampled and appended to a window
+        uint64_t tick_window_hits = 0;      // Window hits during the most recent tick
+        uint64_t tick_window_misses = 0;    // Window misses during the most recent tick
+        double tick_compute_time_ms = 0.0;  // Time spent building the geometry profile and fit during the most recent tick
+        size_t cached_segments = 0;         // Number of lanelet centerlines currently held in windows
+
+        /**
+         * \return The fraction of all window lookups which were served from the cache. 0 if there have been no lookups
+         */
+        double hitRate() const;
+    };
+
+    /**
+     * \brief A spline fit to a set of points resampled at a fixed step size
+     */
+    struct ResampledCurve
+    {
+        std::vector<lanelet::BasicPoint2d> points;  // Resampled points along the curve
+        std::vector<double> curvatures;             // Unfiltered curvature at each resampled point
+        std::vector<double> speed_limits;           // Speed limit distributed to each resampled point
+        std::vector<double> orientations;           // Tangent orientation at each resampled point
+    };
+
+    /**
+     * \brief Cache of the lane follow geometry computed by one planner across its planning ticks.
+     *
+     * Each lane follow window holds the concatenated downsampled centerlines of a sequence of lanelets. As the vehicle
+     * advances the lanelets it has left behind are trimmed from the front of the window and newly planned lanelets are
+     * appended to the back, so only lanelets entering the window are downsampled. Windows are keyed by map, map update count
+     * and downsample ratios, and are dropped once unused for max_idle_ticks. The update count changes on every map update,
+     * including geofence edits which modify lanelets in place, so a window never outlives the map contents it was built from.
+     *
+     * This class is not thread safe. Each planner owns its own instance and passes it to the waypoint generation functions.
+     */
+    class GeometryProfileCache
+    {
+    public:
+        /**
+         * \brief Constructor
+         *
+         * \param max_idle_ticks Number of ticks a window may go unused before it is dropped
+         */
+        explicit GeometryProfileCache(size_t max_idle_ticks = 50);
+
+        /**
+         * \brief Marks the start of a planning tick. Drops windows which have gone unused and resets the per tick counters
+         */
+        void beginTick();
+
+        /**
+         * \brief Adds to the time spent computing geometry during the current tick
+         *
+         * \param compute_time_ms The time in milliseconds
+         */
+        void addComputeTime(double compute_time_ms);
+
+        /**
+         * \brief Returns the concatenated downsampled centerlines of the provided lanelets. Lanelets already in a matching
+         *        window are reused and the rest are downsampled.
+         *
+         * \param lanelets The consecutive lanelets to follow
+         * \param default_downsample_ratio Only every nth centerline point is kept for lanelets which are not turns
+         * \param turn_downsample_ratio Only every nth centerline point is kept for lanelets with a left or right turn_direction
+         * \param map The map the lanelets belong to
+         * \param map_update_count The update count of the map, as returned by carma_wm::WorldModel::getMapUpdateCount
+         *
+         * \return The centerline points. The reference is valid until the next call on this cache
+         */
+        const lanelet::BasicLineString2d& getLaneFollowCenterline(const lanelet::ConstLanelets& lanelets, int default_downsample_ratio,
+                                                                  int turn_downsample_ratio, const lanelet::LaneletMapConstPtr& map, size_t map_update_count);
+
+        /**
+         * \return The buffer the lane follow trajectory spline is resampled into. It is reused across ticks so resampling
+         *         does not reallocate once it has grown to the longest trajectory
+         */
+        smoothing::SplineSamples& getSplineSamples();
+
+        /**
+         * \return The buffer holding the resampled lane follow trajectory curve. It is reused across ticks like the spline samples
+         */
+        ResampledCurve& getResampledCurve();
+
+        /**
+         * \return The current counters of this cache
+         */
+        GeometryProfileCacheStats getStats() const;
+
+        /**
+         * \brief Drops all cached geometry. Counters are kept
+         */
+        void clear();
+
+    private:
+        struct Segment
+        {
+            lanelet::Id id;
+            lanelet::BasicLineString2d points;  // The downsampled centerline of the lanelet
+            size_t offset = 0;                  // Number of leading points dropped to avoid overlapping the previous segment
+        };
+
+        struct Window
+        {
+            std::weak_ptr<const lanelet::LaneletMap> map;
+            size_t map_update_count = 0;
+            int default_downsample_ratio = 0;
+            int turn_downsample_ratio = 0;
+            std::deque<Segment> segments;
+            lanelet::BasicLineString2d points;  // The points each segment contributes, in order
+            size_t last_used_tick = 0;
+        };
+
+        void appendSegment(Window& window, const lanelet::ConstLanelet& lanelet);
+
+        void trimFront(Window& window, size_t count);
+
+        void trimBack(Window& window, size_t count);
+
+        std::vector<Window> windows_;
+        lanelet::BasicLineString2d empty_centerline_;
+
+        smoothing::SplineSamples spline_samples_;
+        ResampledCurve resampled_curve_;
+
+        size_t tick_ = 0;
+        size_t max_idle_ticks_;
+        GeometryProfileCacheStats stats_;
+    };
+
+    /**
+     * \brief Builds a diagnostic status reporting the provided cache counters as key value pairs
+     *
+     * \param stats The counters to report
+     * \param name The name of the status
+     *
+     * \return The status message
+     */
+    diagnostic_msgs::msg::DiagnosticStatus geometry_profile_metrics(const GeometryProfileCacheStats& stats, const std::string& name);
+
+} // namespace waypoint_generation
+} // namespace basic_autonomy
@@ -26,7 +26,8 @@ namespace basic_autonomy
 namespace smoothing
 {
 
-  typedef Eigen::Spline<double, 2> Spline2d;
+  // The degree is fixed at compile time so that evaluating the spline works on fixed size arrays without heap allocation
+  typedef Eigen::Spline<double, 2, 3> Spline2d;
 /**
  * \brief Realization of SplineI that uses the Eigen::Splines library for interpolation 
  */ 
@@ -38,6 +39,7 @@ public:
   lanelet::BasicPoint2d operator()(double t) const override;
   lanelet::BasicPoint2d first_deriv(double t) const override;
   lanelet::BasicPoint2d second_deriv(double t) const override;
+  void resample(size_t steps, SplineSamples* samples) const override;
 private:
   Spline2d spline_;
 };
@@ -17,12 +17,47 @@
  */
 
 #include <vector>
+#include <cmath>
 #include <carma_wm/Geometry.hpp>
 
 namespace basic_autonomy
 {
 namespace smoothing
 {
+/**
+ * \brief Samples of a curve taken at evenly spaced steps. Each quantity is stored in its own array so that
+ *        the buffers can be reused between calls and consumed without conversion
+ */
+struct SplineSamples
+{
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> dx;  // First derivative
+  std::vector<double> dy;
+  std::vector<double> ddx;  // Second derivative
+  std::vector<double> ddy;
+  std::vector<double> curvature;  // (1/meter)
+
+  /**
+   * \brief Resize all buffers to hold the given number of samples. Existing capacity is kept
+   */
+  void resize(size_t size)
+  {
+    x.resize(size);
+    y.resize(size);
+    dx.resize(size);
+    dy.resize(size);
+    ddx.resize(size);
+    ddy.resize(size);
+    curvature.resize(size);
+  }
+
+  size_t size() const
+  {
+    return x.size();
+  }
+};
+
 /**
  * \brief Interface to a spline interpolator that can be used to smoothly interpolate between points
  */ 
@@ -68,6 +103,45 @@ public:
    * \return lanelet::BasicPoint2d with x, y that matches the second_deriv at t-th step along the curve. This is not partial derivatives
    */ 
   virtual lanelet::BasicPoint2d second_deriv(double x) const = 0;
+
+  /**
+   * \brief Sample the curve at steps evenly spaced values of t from 0 (inclusive) to 1 (exclusive).
+   *        Implementations should override this to evaluate the position and derivatives together.
+   *
+   * \param steps The number of samples to take. The i-th sample is taken at t = i / steps
+   * \param samples The buffers to fill. They are resized to steps
+   */
+  virtual void resample(size_t steps, SplineSamples* samples) const
+  {
+    samples->resize(steps);
+
+    for (size_t i = 0; i < steps; i++)
+    {
+      double t = static_cast<double>(i) / steps;
+      lanelet::BasicPoint2d point = (*this)(t);
+      lanelet::BasicPoint2d first = first_deriv(t);
+      lanelet::BasicPoint2d second = second_deriv(t);
+
+      samples->x[i] = point.x();
+      samples->y[i] = point.y();
+      samples->dx[i] = first.x();
+      samples->dy[i] = first.y();
+      samples->ddx[i] = second.x();
+      samples->ddy[i] = second.y();
+      samples->curvature[i] = curvature(first.x(), first.y(), second.x(), second.y());
+    }
+  }
+
+  /**
+   * \brief Curvature of a planar curve from its first and second derivatives
+   *
+   * \return Curvature (k = 1/r, 1/meter)
+   */
+  static double curvature(double dx, double dy, double ddx, double ddy)
+  {
+    double speed = std::sqrt(dx * dx + dy * dy);
+    return std::abs(dx * ddy - dy * ddx) / (speed * speed * speed);
+  }
 };
 } // namespace smoothing
 } // namespace basic_autonomy
\ No newline at end of file
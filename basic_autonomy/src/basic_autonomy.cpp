@@ -16,6 +16,8 @@
 
 #include <basic_autonomy/log/log.hpp>
 #include <basic_autonomy/helper_functions.hpp>
+#include <basic_autonomy/geometry_profile_cache.hpp>
+#include <chrono>
 
 namespace basic_autonomy
 {
@@ -23,7 +25,14 @@ namespace basic_autonomy
     {
          std::vector<PointSpeedPair> create_geometry_profile(const std::vector<carma_planning_msgs::msg::Maneuver> &maneuvers, double max_starting_downtrack,const carma_wm::WorldModelConstPtr &wm,
                                                                    carma_planning_msgs::msg::VehicleState &ending_state_before_buffer,const carma_planning_msgs::msg::VehicleState& state,
-                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config){
+                                                                   const GeneralTrajConfig &general_config, const DetailedTrajConfig &detailed_config,
+                                                                   const std::shared_ptr<GeometryProfileCache>& cache){
+            auto compute_start = std::chrono::steady_clock::now();
+            if (cache)
+            {
+                cache->beginTick();
+            }
+
             std::vector<PointSpeedPair> points_and_target_speeds;
 
             bool first = true;
@@ -42,7 +51,7 @@ namespace basic_autonomy
 
                 if(maneuver.type == carma_planning_msgs::msg::Maneuver::LANE_FOLLOWING){
                     RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER),"Creating Lane Follow Geometry");
-                    std::vector<PointSpeedPair> lane_follow_points = create_lanefollow_geometry(maneuver, starting_downtrack, wm, general_config, detailed_config, visited_lanelets);
+                    std::vector<PointSpeedPair> lane_follow_points = create_lanefollow_geometry(maneuver, starting_downtrack, wm, general_config, detailed_config, visited_lanelets, cache);
                     points_and_target_speeds.insert(points_and_target_speeds.end(), lane_follow_points.begin(), lane_follow_points.end());
                 }
                 else if(maneuver.type == carma_planning_msgs::msg::Maneuver::LANE_CHANGE){
@@ -61,13 +70,21 @@ namespace basic_autonomy
                 points_and_target_speeds = add_lanefollow_buffer(wm, points_and_target_speeds, maneuvers, ending_state_before_buffer, detailed_config);
 
             }
+
+            if (cache)
+            {
+                std::chrono::duration<double, std::milli> compute_time = std::chrono::steady_clock::now() - compute_start;
+                cache->addComputeTime(compute_time.count());
+            }
+
             return points_and_target_speeds;
 
         }
 
         std::vector<PointSpeedPair> create_lanefollow_geometry(const carma_planning_msgs::msg::Maneuver &maneuver, double starting_downtrack,
                                                                 const carma_wm::WorldModelConstPtr &wm, const GeneralTrajConfig &general_config,
-                                                                const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id> &visited_lanelets)
+                                                                const DetailedTrajConfig &detailed_config, std::unordered_set<lanelet::Id> &visited_lanelets,
+                                                                const std::shared_ptr<GeometryProfileCache>& cache)
         {
             if(maneuver.type != carma_planning_msgs::msg::Maneuver::LANE_FOLLOWING){
                 throw std::invalid_argument("Create_lanefollow called on a maneuver type which is not LANE_FOLLOW");
@@ -131,11 +148,6 @@ namespace basic_autonomy
 
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Maneuver");
 
-            lanelet::BasicLineString2d downsampled_centerline;
-            // 400 value here is an arbitrary attempt at improving inlane-cruising performance by reducing copy operations.
-            // Value picked based on annecdotal evidence from STOL system testing
-            downsampled_centerline.reserve(400);
-
             //getLaneletsBetween is inclusive of lanelets between its two boundaries
             //which may return lanechange lanelets, so
             //exclude lanechanges and plan for only the straight part
@@ -174,38 +186,25 @@ namespace basic_autonomy
 
             }
 
-            for (auto l : straight_lanelets)
+            lanelet::ConstLanelets unvisited_lanelets;
+            for (const auto& l : straight_lanelets)
             {
                 RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Processing lanelet ID: " << l.id());
-                if (visited_lanelets.find(l.id()) == visited_lanelets.end())
+                if (visited_lanelets.insert(l.id()).second)
                 {
-
-                    bool is_turn = false;
-                    if(l.hasAttribute("turn_direction")) {
-                        std::string turn_direction = l.attribute("turn_direction").value();
-                        is_turn = turn_direction.compare("left") == 0 || turn_direction.compare("right") == 0;
-                    }
-
-                    lanelet::BasicLineString2d centerline = l.centerline2d().basicLineString();
-                    lanelet::BasicLineString2d downsampled_points;
-                    if (is_turn) {
-                        downsampled_points = carma_ros2_utils::containers::downsample_vector(centerline, general_config.turn_downsample_ratio);
-                    } else {
-                        downsampled_points = carma_ros2_utils::containers::downsample_vector(centerline, general_config.default_downsample_ratio);
-                    }
-
-                    if(downsampled_centerline.size() != 0 && downsampled_points.size() != 0 // If this is not the first lanelet and the points are closer than 1m drop the first point to prevent overlap
-                    && lanelet::geometry::distance2d(downsampled_points.front(), downsampled_centerline.back()) <1.2){
-                        downsampled_points = lanelet::BasicLineString2d(downsampled_points.begin() + 1, downsampled_points.end());
-                    }
-
-                    downsampled_centerline = carma_wm::geometry::concatenate_line_strings(downsampled_centerline, downsampled_points);
-                    visited_lanelets.insert(l.id());
+                    unvisited_lanelets.push_back(l);
                 }
             }
 
+            // Without a caller owned cache the centerline is built from scratch in a cache local to this call
+            GeometryProfileCache local_cache;
+            GeometryProfileCache& centerline_cache = cache ? *cache : local_cache;
+            const lanelet::BasicLineString2d& downsampled_centerline = centerline_cache.getLaneFollowCenterline(unvisited_lanelets,
+                general_config.default_downsample_ratio, general_config.turn_downsample_ratio, wm->getMap(), wm->getMapUpdateCount());
+
+            points_and_target_speeds.reserve(downsampled_centerline.size());
             bool first = true;
-            for (auto p : downsampled_centerline)
+            for (const auto& p : downsampled_centerline)
             {
                 if (first && !points_and_target_speeds.empty())
                 {
@@ -840,19 +839,78 @@ namespace basic_autonomy
             return spl;
         }
 
+        ResampledCurve resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const std::vector<double> &speed_limits,
+                                      double curve_resample_step_size)
+        {
+            smoothing::SplineSamples samples;
+            ResampledCurve curve;
+            resample_curve(curve_points, speed_limits, curve_resample_step_size, &samples, &curve);
+            return curve;
+        }
+
+        void resample_curve(const std::vector<lanelet::BasicPoint2d> &curve_points, const std::vector<double> &speed_limits,
+                            double curve_resample_step_size, smoothing::SplineSamples* samples, ResampledCurve* curve)
+        {
+            std::unique_ptr<smoothing::SplineI> fit_curve = compute_fit(curve_points); // Compute splines based on curve points
+            if (!fit_curve)
+            {
+                throw std::invalid_argument("Could not fit a spline curve along the given trajectory!");
+            }
+
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got fit");
+
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "speed_limits.size() " << speed_limits.size());
+
+            // compute total length of the trajectory to get correct number of points
+            // we expect using curve_resample_step_size
+            double curve_length = 0.0;
+            for (size_t i = 1; i < curve_points.size(); i++)
+            {
+                curve_length += lanelet::geometry::distance2d(curve_points[i - 1], curve_points[i]);
+            }
+
+            auto total_step_along_curve = static_cast<int>(curve_length / curve_resample_step_size);
+
+            // Resample curve at tighter resolution. Points and curvatures are evaluated together in one pass over the spline
+            fit_curve->resample(static_cast<size_t>(std::max(total_step_along_curve, 0)), samples);
+
+            std::vector<lanelet::BasicPoint2d>& all_sampling_points = curve->points;
+            all_sampling_points.clear();
+
+            std::vector<double>& distributed_speed_limits = curve->speed_limits;
+            distributed_speed_limits.clear();
+
+            int current_speed_index = 0;
+            size_t total_point_size = curve_points.size();
+
+            double step_threshold_for_next_speed = (double)total_step_along_curve / (double)total_point_size;
+
+            for (int steps_along_curve = 0; steps_along_curve < total_step_along_curve; steps_along_curve++)
+            {
+                all_sampling_points.emplace_back(samples->x[steps_along_curve], samples->y[steps_along_curve]);
+                if ((double)steps_along_curve > step_threshold_for_next_speed)
+                {
+                    step_threshold_for_next_speed += (double)total_step_along_curve / (double)total_point_size;
+                    current_speed_index++;
+                }
+                distributed_speed_limits.push_back(speed_limits[current_speed_index]); // Identify speed limits for resampled points
+            }
+
+            curve->orientations = carma_wm::geometry::compute_tangent_orientations(all_sampling_points);
+            curve->curvatures.assign(samples->curvature.begin(), samples->curvature.end());
+        }
+
         double compute_curvature_at(const basic_autonomy::smoothing::SplineI &fit_curve, double step_along_the_curve)
         {
             lanelet::BasicPoint2d f_prime_pt = fit_curve.first_deriv(step_along_the_curve);
             lanelet::BasicPoint2d f_prime_prime_pt = fit_curve.second_deriv(step_along_the_curve);
-            // Convert to 3d vector to do 3d vector operations like cross.
-            Eigen::Vector3d f_prime = {f_prime_pt.x(), f_prime_pt.y(), 0};
-            Eigen::Vector3d f_prime_prime = {f_prime_prime_pt.x(), f_prime_prime_pt.y(), 0};
-            return (f_prime.cross(f_prime_prime)).norm() / (pow(f_prime.norm(), 3));
+            return smoothing::SplineI::curvature(f_prime_pt.x(), f_prime_pt.y(), f_prime_prime_pt.x(), f_prime_prime_pt.y());
         }
 
         std::vector<carma_planning_msgs::msg::TrajectoryPlanPoint> compose_lanefollow_trajectory_from_path(
             const std::vector<PointSpeedPair> &points, const carma_planning_msgs::msg::VehicleState &state, const rclcpp::Time &state_time, const carma_wm::WorldModelConstPtr &wm,
-            const carma_planning_msgs::msg::VehicleState &ending_state_before_buffer, carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds& debug_msg, const DetailedTrajConfig &detailed_config)
+            const carma_planning_msgs::msg::VehicleState &ending_state_before_buffer, carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds& debug_msg, const DetailedTrajConfig &detailed_config,
+            const std::shared_ptr<GeometryProfileCache>& cache)
         {
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "VehicleState: "
                              << " x: " << state.x_pos_global << " y: " << state.y_pos_global << " yaw: " << state.orientation
@@ -882,56 +940,28 @@ namespace basic_autonomy
             std::vector<lanelet::BasicPoint2d> curve_points;
             split_point_speed_pairs(back_and_future, &curve_points, &speed_limits);
 
-            std::unique_ptr<smoothing::SplineI> fit_curve = compute_fit(curve_points); // Compute splines based on curve points
-            if (!fit_curve)
-            {
-                throw std::invalid_argument("Could not fit a spline curve along the given trajectory!");
-            }
-
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got fit");
+            // Without a caller owned cache the spline is resampled into buffers local to this call
+            smoothing::SplineSamples local_samples;
+            ResampledCurve local_curve;
+            smoothing::SplineSamples& samples = cache ? cache->getSplineSamples() : local_samples;
+            ResampledCurve& resampled_curve = cache ? cache->getResampledCurve() : local_curve;
 
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "speed_limits.size() " << speed_limits.size());
-
-            std::vector<lanelet::BasicPoint2d> all_sampling_points;
-            all_sampling_points.reserve(1 + curve_points.size() * 2);
-
-            std::vector<double> distributed_speed_limits;
-            distributed_speed_limits.reserve(1 + curve_points.size() * 2);
-
-            // compute total length of the trajectory to get correct number of points
-            // we expect using curve_resample_step_size
-            std::vector<double> downtracks_raw = carma_wm::geometry::compute_arc_lengths(curve_points);
-
-            auto total_step_along_curve = static_cast<int>(downtracks_raw.back() / detailed_config.curve_resample_step_size);
-
-            int current_speed_index = 0;
-            size_t total_point_size = curve_points.size();
-
-            double step_threshold_for_next_speed = (double)total_step_along_curve / (double)total_point_size;
-            double scaled_steps_along_curve = 0.0; // from 0 (start) to 1 (end) for the whole trajectory
-            std::vector<double> better_curvature;
-            better_curvature.reserve(1 + curve_points.size() * 2);
-
-            for (int steps_along_curve = 0; steps_along_curve < total_step_along_curve; steps_along_curve++) // Resample curve at tighter resolution
+            auto fit_start = std::chrono::steady_clock::now();
+            resample_curve(curve_points, speed_limits, detailed_config.curve_resample_step_size, &samples, &resampled_curve);
+            if (cache)
             {
-                lanelet::BasicPoint2d p = (*fit_curve)(scaled_steps_along_curve);
-
-                all_sampling_points.push_back(p);
-                double c = compute_curvature_at((*fit_curve), scaled_steps_along_curve);
-                better_curvature.push_back(c);
-                if ((double)steps_along_curve > step_threshold_for_next_speed)
-                {
-                    step_threshold_for_next_speed += (double)total_step_along_curve / (double)total_point_size;
-                    current_speed_index++;
-                }
-                distributed_speed_limits.push_back(speed_limits[current_speed_index]); // Identify speed limits for resampled points
-                scaled_steps_along_curve += 1.0 / total_step_along_curve;              //adding steps_along_curve_step_size
+                std::chrono::duration<double, std::milli> fit_time = std::chrono::steady_clock::now() - fit_start;
+                cache->addComputeTime(fit_time.count());
             }
 
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got sampled points with size:" << all_sampling_points.size());
-            log::printDebugPerLine(all_sampling_points, &log::basicPointToStream);
+            const std::vector<lanelet::BasicPoint2d>& sampling_points = resampled_curve.points;
+            const std::vector<double>& better_curvature = resampled_curve.curvatures;
+            const std::vector<double>& distributed_speed_limits = resampled_curve.speed_limits;
+
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got sampled points with size:" << sampling_points.size());
+            log::printDebugPerLine(sampling_points, &log::basicPointToStream);
 
-            std::vector<double> final_yaw_values = carma_wm::geometry::compute_tangent_orientations(all_sampling_points);
+            const std::vector<double>& sampling_yaw_values = resampled_curve.orientations;
 
             log::printDoublesPerLineWithPrefix("raw_curvatures[i]: ", better_curvature);
 
@@ -941,13 +971,13 @@ namespace basic_autonomy
 
             log::printDoublesPerLineWithPrefix("curvatures[i]: ", curvatures);
             log::printDoublesPerLineWithPrefix("ideal_speeds: ", ideal_speeds);
-            log::printDoublesPerLineWithPrefix("final_yaw_values[i]: ", final_yaw_values);
+            log::printDoublesPerLineWithPrefix("final_yaw_values[i]: ", sampling_yaw_values);
 
             std::vector<double> constrained_speed_limits = apply_speed_limits(ideal_speeds, distributed_speed_limits);
 
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Processed all points in computed fit");
 
-            if (all_sampling_points.empty())
+            if (sampling_points.empty())
             {
                 RCLCPP_WARN_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "No trajectory points could be generated");
                 return {};
@@ -955,14 +985,14 @@ namespace basic_autonomy
 
             // Add current vehicle point to front of the trajectory
 
-            nearest_pt_index = get_nearest_index_by_downtrack(all_sampling_points, wm, state);
+            nearest_pt_index = get_nearest_index_by_downtrack(sampling_points, wm, state);
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Current state's nearest_pt_index: " << nearest_pt_index);
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Curvature right now: " << better_curvature[nearest_pt_index] << ", at state x: " << state.x_pos_global << ", state y: " << state.y_pos_global);
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Corresponding to point: x: " << all_sampling_points[nearest_pt_index].x() << ", y:" << all_sampling_points[nearest_pt_index].y());
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Corresponding to point: x: " << sampling_points[nearest_pt_index].x() << ", y:" << sampling_points[nearest_pt_index].y());
 
-            int buffer_pt_index = get_nearest_index_by_downtrack(all_sampling_points, wm, ending_state_before_buffer);
+            int buffer_pt_index = get_nearest_index_by_downtrack(sampling_points, wm, ending_state_before_buffer);
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Ending state's index before applying buffer (buffer_pt_index): " << buffer_pt_index);
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Corresponding to point: x: " << all_sampling_points[buffer_pt_index].x() << ", y:" << all_sampling_points[buffer_pt_index].y());
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Corresponding to point: x: " << sampling_points[buffer_pt_index].x() << ", y:" << sampling_points[buffer_pt_index].y());
 
             if(nearest_pt_index + 1 >= buffer_pt_index){
 
@@ -996,16 +1026,16 @@ namespace basic_autonomy
 
             //drop buffer points here
 
-             std::vector<lanelet::BasicPoint2d> future_basic_points(all_sampling_points.begin() + nearest_pt_index + 1,
-                                            all_sampling_points.begin()+ buffer_pt_index);  // Points in front of current vehicle position
+             std::vector<lanelet::BasicPoint2d> future_basic_points(sampling_points.begin() + nearest_pt_index + 1,
+                                            sampling_points.begin()+ buffer_pt_index);  // Points in front of current vehicle position
 
             std::vector<double> future_speeds(constrained_speed_limits.begin() + nearest_pt_index + 1,
                                                         constrained_speed_limits.begin() + buffer_pt_index);  // Points in front of current vehicle position
-            std::vector<double> future_yaw(final_yaw_values.begin() + nearest_pt_index + 1,
-                                                        final_yaw_values.begin() + buffer_pt_index);  // Points in front of current vehicle position
+            std::vector<double> future_yaw(sampling_yaw_values.begin() + nearest_pt_index + 1,
+                                                        sampling_yaw_values.begin() + buffer_pt_index);  // Points in front of current vehicle position
             std::vector<double>  final_actual_speeds = future_speeds;
-            all_sampling_points = future_basic_points;
-            final_yaw_values = future_yaw;
+            std::vector<lanelet::BasicPoint2d> all_sampling_points = future_basic_points;
+            std::vector<double> final_yaw_values = future_yaw;
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Trimmed future points to size: "<< future_basic_points.size());
 
             lanelet::BasicPoint2d cur_veh_point(state.x_pos_global, state.y_pos_global);
@@ -1130,8 +1160,6 @@ namespace basic_autonomy
                 throw std::invalid_argument("Could not fit a spline curve along the given trajectory!");
             }
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got fit");
-            std::vector<lanelet::BasicPoint2d> all_sampling_points;
-            all_sampling_points.reserve(1 + future_geom_points.size() * 2);
 
             lanelet::BasicPoint2d current_vehicle_point(state.x_pos_global, state.y_pos_global);
 
@@ -1143,18 +1171,6 @@ namespace basic_autonomy
             //Compute points to local downtracks
             std::vector<double> downtracks = carma_wm::geometry::compute_arc_lengths(future_geom_points);
 
-            auto total_step_along_curve = static_cast<int>(downtracks.back() /detailed_config.curve_resample_step_size);
-
-            double scaled_steps_along_curve = 0.0; //from 0 (start) to 1 (end) for the whole trajectory
-
-            for(int steps_along_curve = 0; steps_along_curve < total_step_along_curve; steps_along_curve++){
-                lanelet::BasicPoint2d p = (*fit_curve)(scaled_steps_along_curve);
-
-                all_sampling_points.push_back(p);
-
-                scaled_steps_along_curve += 1.0 / total_step_along_curve;
-            }
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger(BASIC_AUTONOMY_LOGGER), "Got sampled points with size:" << all_sampling_points.size());
 
             std::vector<double> final_yaw_values = carma_wm::geometry::compute_tangent_orientations(future_geom_points);
             if(final_yaw_values.size() > 0) {
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <carma_ros2_utils/containers/containers.hpp>
+#include <carma_wm/Geometry.hpp>
+#include <lanelet2_core/geometry/Point.h>
+#include <basic_autonomy/geometry_profile_cache.hpp>
+
+namespace basic_autonomy
+{
+namespace waypoint_generation
+{
+    namespace
+    {
+        // Consecutive centerlines whose end points are closer than this overlap, so the first point of the later one is dropped
+        constexpr double CENTERLINE_OVERLAP_DISTANCE_M = 1.2;
+
+        // Matches the tolerance carma_wm::geometry::concatenate_line_strings uses to drop a duplicated joining point
+        constexpr double CENTERLINE_DUPLICATE_DISTANCE_M = 0.05;
+
+        bool is_turn(const lanelet::ConstLanelet& lanelet)
+        {
+            if (!lanelet.hasAttribute("turn_direction"))
+            {
+                return false;
+            }
+            std::string turn_direction = lanelet.attribute("turn_direction").value();
+            return turn_direction.compare("left") == 0 || turn_direction.compare("right") == 0;
+        }
+
+        /**
+         * Returns the number of leading points of the provided centerline which are dropped when it is concatenated to the
+         * provided points. This matches the lane follow geometry which drops an overlapping first point before concatenating.
+         */
+        size_t overlap_offset(const lanelet::BasicLineString2d& points, const lanelet::BasicLineString2d& centerline)
+        {
+            if (points.empty() || centerline.empty())
+            {
+                return 0;
+            }
+
+            size_t offset = 0;
+            if (lanelet::geometry::distance2d(centerline.front(), points.back()) < CENTERLINE_OVERLAP_DISTANCE_M)
+            {
+                offset++;
+            }
+            if (offset < centerline.size()
+                && carma_wm::geometry::compute_euclidean_distance(points.back(), centerline[offset]) < CENTERLINE_DUPLICATE_DISTANCE_M)
+            {
+                offset++;
+            }
+            return offset;
+        }
+    }
+
+    double GeometryProfileCacheStats::hitRate() const
+    {
+        uint64_t lookups = window_hits + window_misses;
+        if (lookups == 0)
+        {
+            return 0.0;
+        }
+        return static_cast<double>(window_hits) / lookups;
+    }
+
+    GeometryProfileCache::GeometryProfileCache(size_t max_idle_ticks)
+        : max_idle_ticks_(max_idle_ticks) {}
+
+    void GeometryProfileCache::beginTick()
+    {
+        tick_++;
+        stats_.tick_window_hits = 0;
+        stats_.tick_window_misses = 0;
+        stats_.tick_compute_time_ms = 0.0;
+
+        // Drop windows over maps which no longer exist or which the vehicle has not planned over recently
+        windows_.erase(std::remove_if(windows_.begin(), windows_.end(), [this](const Window& w) {
+            return w.map.expired() || tick_ - w.last_used_tick > max_idle_ticks_;
+        }), windows_.end());
+    }
+
+    void GeometryProfileCache::addComputeTime(double compute_time_ms)
+    {
+        stats_.tick_compute_time_ms += compute_time_ms;
+    }
+
+    const lanelet::BasicLineString2d& GeometryProfileCache::getLaneFollowCenterline(const lanelet::ConstLanelets& lanelets, int default_downsample_ratio,
+                                                                                    int turn_downsample_ratio, const lanelet::LaneletMapConstPtr& map, size_t map_update_count)
+    {
+        if (lanelets.empty())
+        {
+            return empty_centerline_;
+        }
+
+        // Windows built before the latest update of this map can no longer be used
+        windows_.erase(std::remove_if(windows_.begin(), windows_.end(), [&map, map_update_count](const Window& w) {
+            return w.map.expired() || (w.map.lock() == map && w.map_update_count != map_update_count);
+        }), windows_.end());
+
+        // Find a window which already holds the first requested lanelet
+        auto window_it = windows_.end();
+        size_t start_idx = 0;
+        for (auto it = windows_.begin(); it != windows_.end() && window_it == windows_.end(); it++)
+        {
+            if (it->map.lock() != map || it->default_downsample_ratio != default_downsample_ratio || it->turn_downsample_ratio != turn_downsample_ratio)
+            {
+                continue;
+            }
+            for (size_t i = 0; i < it->segments.size(); i++)
+            {
+                if (it->segments[i].id == lanelets.front().id())
+                {
+                    window_it = it;
+                    start_idx = i;
+                    break;
+                }
+            }
+        }
+
+        if (window_it == windows_.end())
+        {
+            Window window;
+            window.map = map;
+            window.map_update_count = map_update_count;
+            window.default_downsample_ratio = default_downsample_ratio;
+            window.turn_downsample_ratio = turn_downsample_ratio;
+            windows_.push_back(std::move(window));
+            window_it = windows_.end() - 1;
+        }
+
+        Window& window = *window_it;
+        window.last_used_tick = tick_;
+
+        // Trim the lanelets the vehicle has left behind
+        trimFront(window, start_idx);
+
+        // Keep the longest prefix which matches the requested lanelets and rebuild the rest
+        size_t matching = 0;
+        while (matching < window.segments.size() && matching < lanelets.size() && window.segments[matching].id == lanelets[matching].id())
+        {
+            matching++;
+        }
+        trimBack(window, window.segments.size() - matching);
+
+        stats_.window_hits += matching;
+        stats_.tick_window_hits += matching;
+
+        for (size_t i = matching; i < lanelets.size(); i++)
+        {
+            appendSegment(window, lanelets[i]);
+        }
+
+        return window.points;
+    }
+
+    void GeometryProfileCache::appendSegment(Window& window, const lanelet::ConstLanelet& lanelet)
+    {
+        int downsample_ratio = is_turn(lanelet) ? window.turn_downsample_ratio : window.default_downsample_ratio;
+
+        Segment segment;
+        segment.id = lanelet.id();
+        segment.points = carma_ros2_utils::containers::downsample_vector(lanelet.centerline2d().basicLineString(), downsample_ratio);
+        segment.offset = overlap_offset(window.points, segment.points);
+
+        window.points.insert(window.points.end(), segment.points.begin() + segment.offset, segment.points.end());
+        window.segments.push_back(std::move(segment));
+
+        stats_.window_misses++;
+        stats_.tick_window_misses++;
+    }
+
+    void GeometryProfileCache::trimFront(Window& window, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        size_t trimmed_points = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            trimmed_points += window.segments[i].points.size() - window.segments[i].offset;
+        }
+
+        // The offset of every later segment was computed against the end of the new first segment, so it can only be kept
+        // if the new first segment contributed points. Otherwise the window is rebuilt
+        if (count < window.segments.size() && window.segments[count].points.size() == window.segments[count].offset)
+        {
+            count = window.segments.size();
+            trimmed_points = window.points.size();
+        }
+
+        window.points.erase(window.points.begin(), window.points.begin() + trimmed_points);
+        window.segments.erase(window.segments.begin(), window.segments.begin() + count);
+
+        if (window.segments.empty())
+        {
+            return;
+        }
+
+        // The new first segment no longer follows another, so restore the points it dropped
+        Segment& first = window.segments.front();
+        window.points.insert(window.points.begin(), first.points.begin(), first.points.begin() + first.offset);
+        first.offset = 0;
+    }
+
+    void GeometryProfileCache::trimBack(Window& window, size_t count)
+    {
+        size_t trimmed_points = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const Segment& segment = window.segments.back();
+            trimmed_points += segment.points.size() - segment.offset;
+            window.segments.pop_back();
+        }
+        window.points.resize(window.points.size() - trimmed_points);
+    }
+
+    smoothing::SplineSamples& GeometryProfileCache::getSplineSamples()
+    {
+        return spline_samples_;
+    }
+
+    ResampledCurve& GeometryProfileCache::getResampledCurve()
+    {
+        return resampled_curve_;
+    }
+
+    GeometryProfileCacheStats GeometryProfileCache::getStats() const
+    {
+        GeometryProfileCacheStats stats = stats_;
+        stats.cached_segments = 0;
+        for (const auto& w : windows_)
+        {
+            stats.cached_segments += w.segments.size();
+        }
+        return stats;
+    }
+
+    void GeometryProfileCache::clear()
+    {
+        windows_.clear();
+    }
+
+    diagnostic_msgs::msg::DiagnosticStatus geometry_profile_metrics(const GeometryProfileCacheStats& stats, const std::string& name)
+    {
+        diagnostic_msgs::msg::DiagnosticStatus status;
+        status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+        status.name = name;
+
+        diagnostic_msgs::msg::KeyValue kv;
+        kv.key = "window_hits";
+        kv.value = std::to_string(stats.tick_window_hits);
+        status.values.push_back(kv);
+
+        kv.key = "window_misses";
+        kv.value = std::to_string(stats.tick_window_misses);
+        status.values.push_back(kv);
+
+        kv.key = "hit_rate";
+        kv.value = std::to_string(stats.hitRate());
+        status.values.push_back(kv);
+
+        kv.key = "compute_time_ms";
+        kv.value = std::to_string(stats.tick_compute_time_ms);
+        status.values.push_back(kv);
+
+        kv.key = "cached_segments";
+        kv.value = std::to_string(stats.cached_segments);
+        status.values.push_back(kv);
+
+        return status;
+    }
+
+} // namespace waypoint_generation
+} // namespace basic_autonomy
@@ -65,8 +65,9 @@ namespace waypoint_generation
     int get_nearest_index_by_downtrack(const std::vector<lanelet::BasicPoint2d>& points, const carma_wm::WorldModelConstPtr& wm, double target_downtrack)
     {
         size_t best_index = points.size() - 1;
+        carma_wm::RouteTrackPosCursor cursor; // Points are consecutive so each search can start from the previous match
         for(size_t i = 0;i < points.size(); i++){
-            double downtrack = wm->routeTrackPos(points[i]).downtrack;
+            double downtrack = wm->routeTrackPos(points[i], cursor).downtrack;
             if(downtrack > target_downtrack){
                 //If value is negative, best index should be index 0
                 best_index = std::max((size_t)0, i - 1);
@@ -29,7 +29,7 @@ void BSpline::setPoints(const std::vector<lanelet::BasicPoint2d>& points)
       matrix_points.col(row_index) << point.x(), point.y();
       row_index++;
   }
-  spline_ = Eigen::SplineFitting<Spline2d>::Interpolate(matrix_points,3 );
+  spline_ = Eigen::SplineFitting<Spline2d>::Interpolate(matrix_points, Spline2d::Degree);
 }
 lanelet::BasicPoint2d BSpline::operator()(double t) const
 {
@@ -50,5 +50,24 @@ lanelet::BasicPoint2d  BSpline::second_deriv(double t) const {
   return output;
 }
 
+void BSpline::resample(size_t steps, SplineSamples* samples) const
+{
+  samples->resize(steps);
+
+  for (size_t i = 0; i < steps; i++)
+  {
+    // Column 0 holds the position and columns 1 and 2 the first and second derivatives
+    const auto derivs = spline_.derivatives<2>(static_cast<double>(i) / steps);
+
+    samples->x[i] = derivs(0, 0);
+    samples->y[i] = derivs(1, 0);
+    samples->dx[i] = derivs(0, 1);
+    samples->dy[i] = derivs(1, 1);
+    samples->ddx[i] = derivs(0, 2);
+    samples->ddy[i] = derivs(1, 2);
+    samples->curvature[i] = curvature(derivs(0, 1), derivs(1, 1), derivs(0, 2), derivs(1, 2));
+  }
+}
+
 }  // namespace smoothing
 }  // namespace basic_autonomy
\ No newline at end of file
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <math.h>
+#include <vector>
+
+#include <basic_autonomy/basic_autonomy.hpp>
+
+namespace basic_autonomy {
+
+namespace {
+
+/**
+ * Points along a gentle s-curve spaced one meter apart, similar to a lane centerline
+ */
+std::vector<lanelet::BasicPoint2d> s_curve_points(size_t count) {
+    std::vector<lanelet::BasicPoint2d> points;
+    points.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        points.emplace_back(i, 3.0 * sin(i * 0.05));
+    }
+    return points;
+}
+
+// 400 points is the largest fit compute_fit will produce. Resampled at 0.25 m this is about 1600 samples
+constexpr size_t FIT_POINTS = 400;
+
+} // namespace
+
+static void BM_SplinePerPointEvaluation(benchmark::State& state) {
+    auto fit_curve = waypoint_generation::compute_fit(s_curve_points(FIT_POINTS));
+    size_t steps = state.range(0);
+
+    std::vector<lanelet::BasicPoint2d> sampled_points;
+    std::vector<double> sampled_curvatures;
+
+    for (auto _ : state) {
+        sampled_points.clear();
+        sampled_curvatures.clear();
+        for (size_t i = 0; i < steps; i++) {
+            double t = static_cast<double>(i) / steps;
+            sampled_points.push_back((*fit_curve)(t));
+            sampled_curvatures.push_back(waypoint_generation::compute_curvature_at(*fit_curve, t));
+        }
+        benchmark::DoNotOptimize(sampled_points.data());
+        benchmark::DoNotOptimize(sampled_curvatures.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+
+static void BM_SplineResample(benchmark::State& state) {
+    auto fit_curve = waypoint_generation::compute_fit(s_curve_points(FIT_POINTS));
+    size_t steps = state.range(0);
+
+    smoothing::SplineSamples samples;
+
+    for (auto _ : state) {
+        fit_curve->resample(steps, &samples);
+        benchmark::DoNotOptimize(samples.curvature.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+
+BENCHMARK(BM_SplinePerPointEvaluation)->Arg(400)->Arg(1600);
+BENCHMARK(BM_SplineResample)->Arg(400)->Arg(1600);
+
+} // basic_autonomy
+
+BENCHMARK_MAIN();
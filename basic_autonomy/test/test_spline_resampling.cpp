@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <basic_autonomy/basic_autonomy.hpp>
+#include <gtest/gtest.h>
+#include <math.h>
+
+namespace basic_autonomy
+{
+    namespace
+    {
+        // Points along a gentle s-curve spaced one meter apart, similar to a lane centerline
+        std::vector<lanelet::BasicPoint2d> sCurvePoints(size_t count)
+        {
+            std::vector<lanelet::BasicPoint2d> points;
+            points.reserve(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                points.emplace_back(i, 3.0 * sin(i * 0.05));
+            }
+            return points;
+        }
+    }
+
+    TEST(BasicAutonomyTest, spline_resample_matches_point_evaluation)
+    {
+        auto points = sCurvePoints(100);
+        std::unique_ptr<smoothing::SplineI> fit_curve = waypoint_generation::compute_fit(points);
+        ASSERT_TRUE(!!fit_curve);
+
+        size_t steps = 250;
+        smoothing::SplineSamples samples;
+        fit_curve->resample(steps, &samples);
+
+        ASSERT_EQ(steps, samples.size());
+        ASSERT_EQ(steps, samples.curvature.size());
+
+        for (size_t i = 0; i < steps; i++)
+        {
+            double t = static_cast<double>(i) / steps;
+            lanelet::BasicPoint2d p = (*fit_curve)(t);
+            lanelet::BasicPoint2d first = fit_curve->first_deriv(t);
+            lanelet::BasicPoint2d second = fit_curve->second_deriv(t);
+
+            ASSERT_NEAR(p.x(), samples.x[i], 0.000001);
+            ASSERT_NEAR(p.y(), samples.y[i], 0.000001);
+            ASSERT_NEAR(first.x(), samples.dx[i], 0.000001);
+            ASSERT_NEAR(first.y(), samples.dy[i], 0.000001);
+            ASSERT_NEAR(second.x(), samples.ddx[i], 0.000001);
+            ASSERT_NEAR(second.y(), samples.ddy[i], 0.000001);
+            ASSERT_NEAR(waypoint_generation::compute_curvature_at(*fit_curve, t), samples.curvature[i], 0.000001);
+        }
+
+        // Buffers are resized when reused for a shorter resampling
+        fit_curve->resample(10, &samples);
+        ASSERT_EQ(10u, samples.size());
+        ASSERT_NEAR((*fit_curve)(0.5).x(), samples.x[5], 0.000001);
+
+        fit_curve->resample(0, &samples);
+        ASSERT_EQ(0u, samples.size());
+    }
+
+    TEST(BasicAutonomyTest, resample_curve_into_buffers)
+    {
+        auto points = sCurvePoints(100);
+        std::vector<double> speed_limits(points.size());
+        for (size_t i = 0; i < speed_limits.size(); i++)
+        {
+            speed_limits[i] = 10.0 + i % 3;
+        }
+
+        waypoint_generation::ResampledCurve expected = waypoint_generation::resample_curve(points, speed_limits, 0.25);
+
+        waypoint_generation::GeometryProfileCache cache;
+        smoothing::SplineSamples& samples = cache.getSplineSamples();
+        waypoint_generation::ResampledCurve& curve = cache.getResampledCurve();
+        waypoint_generation::resample_curve(points, speed_limits, 0.25, &samples, &curve);
+
+        ASSERT_EQ(expected.points.size(), curve.points.size());
+        ASSERT_EQ(expected.curvatures.size(), curve.curvatures.size());
+        ASSERT_EQ(expected.speed_limits, curve.speed_limits);
+        ASSERT_EQ(expected.orientations.size(), curve.orientations.size());
+        for (size_t i = 0; i < expected.points.size(); i++)
+        {
+            ASSERT_NEAR(expected.points[i].x(), curve.points[i].x(), 0.000001);
+            ASSERT_NEAR(expected.points[i].y(), curve.points[i].y(), 0.000001);
+            ASSERT_NEAR(expected.curvatures[i], curve.curvatures[i], 0.000001);
+            ASSERT_NEAR(expected.orientations[i], curve.orientations[i], 0.000001);
+        }
+
+        // A shorter curve is resampled into the same storage
+        const double* sample_data = samples.x.data();
+        const lanelet::BasicPoint2d* point_data = curve.points.data();
+
+        std::vector<lanelet::BasicPoint2d> shorter_points(points.begin(), points.begin() + 50);
+        std::vector<double> shorter_speed_limits(speed_limits.begin(), speed_limits.begin() + 50);
+        waypoint_generation::resample_curve(shorter_points, shorter_speed_limits, 0.25, &samples, &curve);
+
+        ASSERT_LT(curve.points.size(), expected.points.size());
+        ASSERT_EQ(curve.points.size(), curve.speed_limits.size());
+        ASSERT_EQ(sample_data, samples.x.data());
+        ASSERT_EQ(point_data, curve.points.data());
+    }
+
+} // namespace basic_autonomy
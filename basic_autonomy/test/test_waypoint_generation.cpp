@@ -16,6 +16,7 @@
 
 #include <basic_autonomy/basic_autonomy.hpp>
 #include <basic_autonomy/helper_functions.hpp>
+#include <basic_autonomy/geometry_profile_cache.hpp>
 #include <gtest/gtest.h>
 #include <carma_wm/CARMAWorldModel.hpp>
 #include <math.h>
@@ -834,6 +835,118 @@ TEST(BasicAutonomyTest, get_nearest_basic_point_index)
     }
 
 
+    TEST(BasicAutonomyTest, geometry_profile_cache)
+    {
+        auto map = carma_wm::test::buildGuidanceTestMap(3.7, 10);
+        lanelet::LaneletMapConstPtr const_map = map;
+        auto get_lanelets = [&map](const std::vector<lanelet::Id>& ids) {
+            lanelet::ConstLanelets lanelets;
+            for (auto id : ids)
+            {
+                lanelets.push_back(map->laneletLayer.get(id));
+            }
+            return lanelets;
+        };
+
+        // Concatenates the centerlines the same way the lane follow geometry did before it was cached
+        auto expected_centerline = [&get_lanelets](const std::vector<lanelet::Id>& ids, int downsample_ratio) {
+            lanelet::BasicLineString2d centerline;
+            for (const auto& llt : get_lanelets(ids))
+            {
+                lanelet::BasicLineString2d points = carma_ros2_utils::containers::downsample_vector(llt.centerline2d().basicLineString(), downsample_ratio);
+                if (!centerline.empty() && !points.empty() && lanelet::geometry::distance2d(points.front(), centerline.back()) < 1.2)
+                {
+                    points = lanelet::BasicLineString2d(points.begin() + 1, points.end());
+                }
+                centerline = carma_wm::geometry::concatenate_line_strings(centerline, points);
+            }
+            return centerline;
+        };
+
+        auto expect_points_eq = [](const lanelet::BasicLineString2d& expected, const lanelet::BasicLineString2d& actual) {
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                ASSERT_NEAR(expected[i].x(), actual[i].x(), 0.000001);
+                ASSERT_NEAR(expected[i].y(), actual[i].y(), 0.000001);
+            }
+        };
+
+        waypoint_generation::GeometryProfileCache cache(2);
+        cache.beginTick();
+
+        expect_points_eq(expected_centerline({1200, 1201, 1202}, 1), cache.getLaneFollowCenterline(get_lanelets({1200, 1201, 1202}), 1, 1, const_map, 1));
+        auto stats = cache.getStats();
+        ASSERT_EQ(0u, stats.tick_window_hits);
+        ASSERT_EQ(3u, stats.tick_window_misses);
+        ASSERT_EQ(3u, stats.cached_segments);
+
+        // As the vehicle advances the lanelet left behind is trimmed and only the new lanelet is downsampled
+        cache.beginTick();
+        expect_points_eq(expected_centerline({1201, 1202, 1203}, 1), cache.getLaneFollowCenterline(get_lanelets({1201, 1202, 1203}), 1, 1, const_map, 1));
+        stats = cache.getStats();
+        ASSERT_EQ(2u, stats.tick_window_hits);
+        ASSERT_EQ(1u, stats.tick_window_misses);
+        ASSERT_EQ(3u, stats.cached_segments);
+
+        cache.beginTick();
+        expect_points_eq(expected_centerline({1201, 1202, 1203}, 1), cache.getLaneFollowCenterline(get_lanelets({1201, 1202, 1203}), 1, 1, const_map, 1));
+        stats = cache.getStats();
+        ASSERT_EQ(3u, stats.tick_window_hits);
+        ASSERT_EQ(0u, stats.tick_window_misses);
+        ASSERT_EQ(5u, stats.window_hits);
+        ASSERT_EQ(4u, stats.window_misses);
+
+        // Lanelets which no longer match the request are trimmed from the back
+        cache.beginTick();
+        expect_points_eq(expected_centerline({1201, 1202}, 1), cache.getLaneFollowCenterline(get_lanelets({1201, 1202}), 1, 1, const_map, 1));
+        ASSERT_EQ(2u, cache.getStats().tick_window_hits);
+        ASSERT_EQ(2u, cache.getStats().cached_segments);
+
+        // A different downsample ratio is kept in a separate window
+        expect_points_eq(expected_centerline({1201, 1202}, 2), cache.getLaneFollowCenterline(get_lanelets({1201, 1202}), 2, 2, const_map, 1));
+        ASSERT_EQ(2u, cache.getStats().tick_window_misses);
+        ASSERT_EQ(4u, cache.getStats().cached_segments);
+
+        // A map update invalidates the cached windows, even when the map itself is edited in place
+        cache.beginTick();
+        expect_points_eq(expected_centerline({1202, 1203}, 1), cache.getLaneFollowCenterline(get_lanelets({1202, 1203}), 1, 1, const_map, 2));
+        ASSERT_EQ(0u, cache.getStats().tick_window_hits);
+        ASSERT_EQ(2u, cache.getStats().tick_window_misses);
+        ASSERT_EQ(2u, cache.getStats().cached_segments);
+
+        ASSERT_TRUE(cache.getLaneFollowCenterline({}, 1, 1, const_map, 2).empty());
+
+        // Windows are dropped once unused for more than max_idle_ticks
+        cache.beginTick();
+        cache.beginTick();
+        ASSERT_EQ(2u, cache.getStats().cached_segments);
+        cache.beginTick();
+        ASSERT_EQ(0u, cache.getStats().cached_segments);
+
+        cache.addComputeTime(1.0);
+        cache.addComputeTime(0.5);
+        stats = cache.getStats();
+        ASSERT_NEAR(1.5, stats.tick_compute_time_ms, 0.000001);
+        ASSERT_NEAR(7.0 / 15.0, stats.hitRate(), 0.000001);
+
+        // The counters of the most recent tick are published as key value pairs
+        auto status = waypoint_generation::geometry_profile_metrics(stats, "inlanecruising_plugin/geometry_profile");
+        ASSERT_EQ("inlanecruising_plugin/geometry_profile", status.name);
+        ASSERT_EQ(diagnostic_msgs::msg::DiagnosticStatus::OK, status.level);
+        std::vector<std::string> keys;
+        for (const auto& kv : status.values)
+        {
+            keys.push_back(kv.key);
+        }
+        ASSERT_EQ((std::vector<std::string>{"window_hits", "window_misses", "hit_rate", "compute_time_ms", "cached_segments"}), keys);
+        ASSERT_EQ("0", status.values[0].value);
+        ASSERT_EQ("0", status.values[4].value);
+
+        cache.clear();
+        ASSERT_EQ(0u, cache.getStats().cached_segments);
+    }
+
     TEST(BasicAutonomyTest, test_verify_yield)
     {
         auto node = std::make_shared<carma_ros2_utils::CarmaLifecycleNode>(rclcpp::NodeOptions());
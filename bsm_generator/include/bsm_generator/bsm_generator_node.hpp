@@ -27,7 +27,7 @@
 #include <sensor_msgs/msg/imu.hpp>
 #include <j2735_v2x_msgs/msg/transmission_state.hpp>
 #include <std_msgs/msg/float64.hpp>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <gps_msgs/msg/gps_fix.hpp>
 #include <vector>
 
@@ -72,7 +72,7 @@ namespace bsm_generator
     // The BSM object that all subscribers make updates to
     carma_v2x_msgs::msg::BSM bsm_;
   
-    std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+    std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
     std::vector<uint8_t> bsm_message_id_;
 
@@ -127,7 +127,7 @@ namespace bsm_generator
   void BSMGenerator::georeferenceCallback(const std_msgs::msg::String::UniquePtr msg)
   {
     // Build projector from proj string
-    map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());
+    map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);
   }
 
   void BSMGenerator::speedCallback(const geometry_msgs::msg::TwistStamped::UniquePtr msg)
@@ -23,8 +23,8 @@
 
 #include <geometry_msgs/msg/pose_stamped.hpp>
 
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <lanelet2_core/geometry/Lanelet.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
 
 #include <memory>
 #include <string>
@@ -67,7 +67,7 @@ private:
   std::string map_georeference_{""};
   geometry_msgs::msg::PoseStamped current_pose_;
 
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_{nullptr};
+  std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_{nullptr};
   OnSetParametersCallbackHandle::SharedPtr on_set_parameters_callback_{nullptr};
 };
 }  // namespace carma_cooperative_perception
@@ -0,0 +1,187 @@
+// Copyright 2023 Leidos
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CARMA_COOPERATIVE_PERCEPTION__GATED_SCORING_HPP_
+#define CARMA_COOPERATIVE_PERCEPTION__GATED_SCORING_HPP_
+
+/**
+ * This file contains functions to score only the track/detection pairs that
+ * are spatially close to each other, instead of every possible pair.
+*/
+
+#include <multiple_object_tracking/scoring.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace carma_cooperative_perception
+{
+/**
+ * @brief Get the 2D position (x, y) of a track or detection in meters
+*/
+template <typename Object>
+auto get_position_2d(const Object & object) -> std::pair<double, double>
+{
+  return {
+    multiple_object_tracking::remove_units(object.state.position_x),
+    multiple_object_tracking::remove_units(object.state.position_y)};
+}
+
+template <typename... Alternatives>
+auto get_position_2d(const std::variant<Alternatives...> & object) -> std::pair<double, double>
+{
+  return std::visit([](const auto & o) { return get_position_2d(o); }, object);
+}
+
+/**
+ * @brief Uniform grid of detection indices used to find the detections near a position
+ *
+ * The cell side length equals the gate distance, so every detection within the gate
+ * distance of a position lies in that position's cell or one of its eight neighbors.
+*/
+class DetectionGrid
+{
+public:
+  template <typename Detection>
+  DetectionGrid(const std::vector<Detection> & detections, double cell_size)
+  : cell_size_{cell_size}
+  {
+    cells_.reserve(std::size(detections));
+
+    for (std::size_t i{0}; i < std::size(detections); ++i) {
+      const auto [x, y]{get_position_2d(detections.at(i))};
+      if (std::isfinite(x) && std::isfinite(y)) {
+        cells_[make_key(to_cell(x), to_cell(y))].push_back(i);
+      }
+    }
+  }
+
+  /**
+   * @brief Call the visitor with the index of every detection in the 3x3 block of cells
+   * around the position
+  */
+  template <typename Visitor>
+  auto for_each_candidate(double x, double y, Visitor && visitor) const -> void
+  {
+    if (!std::isfinite(x) || !std::isfinite(y)) {
+      return;
+    }
+
+    const auto cell_x{to_cell(x)};
+    const auto cell_y{to_cell(y)};
+
+    for (auto dx{-1}; dx <= 1; ++dx) {
+      for (auto dy{-1}; dy <= 1; ++dy) {
+        const auto it{cells_.find(make_key(cell_x + dx, cell_y + dy))};
+        if (it == std::cend(cells_)) {
+          continue;
+        }
+
+        for (const auto index : it->second) {
+          visitor(index);
+        }
+      }
+    }
+  }
+
+private:
+  auto to_cell(double value) const -> std::int64_t
+  {
+    return static_cast<std::int64_t>(std::floor(value / cell_size_));
+  }
+
+  static auto make_key(std::int64_t cell_x, std::int64_t cell_y) -> std::uint64_t
+  {
+    return (static_cast<std::uint64_t>(cell_x) << 32) ^
+           (static_cast<std::uint64_t>(cell_y) & 0xFFFFFFFFULL);
+  }
+
+  double cell_size_;
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells_;
+};
+
+/**
+ * @brief Score the track/detection pairs whose 2D positions are within the gate distance
+ *
+ * Produces the same scores as multiple_object_tracking::score_tracks_and_detections followed by
+ * pruning every score above the gate distance, provided that the scoring function never returns
+ * a score smaller than the 2D distance between the pair. Pairs which are further apart than
+ * gate distance may still be scored and should be pruned by the caller.
+ *
+ * @param tracks The tracks to score
+ * @param detections The detections to score
+ * @param scoring_func Function object returning an optional score for a track/detection pair
+ * @param gate_distance Distance (meters) beyond which pairs do not need to be scored
+ *
+ * @return Scores keyed by (track UUID, detection UUID)
+*/
+template <typename Track, typename Detection, typename ScoringFunction>
+auto score_tracks_and_detections_gated(
+  const std::vector<Track> & tracks, const std::vector<Detection> & detections,
+  const ScoringFunction & scoring_func, double gate_distance)
+{
+  decltype(multiple_object_tracking::score_tracks_and_detections(
+    tracks, detections, scoring_func)) scores;
+
+  const DetectionGrid grid{detections, gate_distance};
+
+  for (const auto & track : tracks) {
+    const auto [x, y]{get_position_2d(track)};
+    grid.for_each_candidate(x, y, [&](std::size_t index) {
+      const auto & detection{detections.at(index)};
+      if (const auto score{scoring_func(track, detection)}; score.has_value()) {
+        auto uuid_pair{std::make_pair(
+          multiple_object_tracking::get_uuid(track),
+          multiple_object_tracking::get_uuid(detection))};
+        scores.emplace(std::move(uuid_pair), score.value());
+      }
+    });
+  }
+
+  return scores;
+}
+
+/**
+ * @brief Find the smallest score of each detection
+ *
+ * @param scores Scores keyed by (track UUID, detection UUID)
+ *
+ * @return Smallest score keyed by detection UUID. Detections without scores are not included.
+*/
+template <typename ScoreMap>
+auto index_min_scores_by_detection(const ScoreMap & scores)
+  -> std::unordered_map<multiple_object_tracking::Uuid, float>
+{
+  std::unordered_map<multiple_object_tracking::Uuid, float> min_scores;
+
+  for (const auto & [uuid_pair, score] : scores) {
+    if (const auto it{min_scores.find(uuid_pair.second)}; it != std::end(min_scores)) {
+      it->second = std::min(it->second, static_cast<float>(score));
+    } else {
+      min_scores.emplace(uuid_pair.second, score);
+    }
+  }
+
+  return min_scores;
+}
+
+}  // namespace carma_cooperative_perception
+
+#endif  // CARMA_COOPERATIVE_PERCEPTION__GATED_SCORING_HPP_
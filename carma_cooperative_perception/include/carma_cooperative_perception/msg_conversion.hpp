@@ -30,8 +30,8 @@
 
 #include <geometry_msgs/msg/pose_stamped.hpp>
 
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <lanelet2_core/geometry/Lanelet.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
 
 #include <tf2/LinearMath/Quaternion.h>
 
@@ -64,7 +64,7 @@ auto calc_relative_position(
 
 auto transform_pose_from_map_to_wgs84(
   const geometry_msgs::msg::PoseStamped & source_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::Position3D;
 
 auto to_detection_list_msg(const carma_v2x_msgs::msg::SensorDataSharingMessage & sdsm)
@@ -104,17 +104,17 @@ auto to_external_object_list_msg(
 auto to_sdsm_msg(
   const carma_perception_msgs::msg::ExternalObjectList & external_object_list,
   const geometry_msgs::msg::PoseStamped & current_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::SensorDataSharingMessage;
 
 auto to_detected_object_data_msg(
   const carma_perception_msgs::msg::ExternalObject & external_object,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::DetectedObjectData;
 
 auto enu_orientation_to_true_heading(
   double yaw, const lanelet::BasicPoint3d & obj_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> units::angle::degree_t;
 
 }  // namespace carma_cooperative_perception
@@ -20,11 +20,15 @@
 
 #include <carma_cooperative_perception_interfaces/msg/detection_list.hpp>
 #include <carma_cooperative_perception_interfaces/msg/track_list.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
 #include <multiple_object_tracking/ctra_model.hpp>
 #include <multiple_object_tracking/ctrv_model.hpp>
 #include <multiple_object_tracking/track_management.hpp>
+#include <atomic>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -65,12 +69,22 @@ public:
   auto execute_pipeline() -> void;
 
 private:
+  /**
+   * @brief Per-stage wall-clock durations (in milliseconds) for one pipeline execution
+  */
+  using StageTimings = std::vector<std::pair<std::string, double>>;
+
+  auto publish_pipeline_diagnostics(const StageTimings & timings) -> void;
+
   rclcpp::Subscription<carma_cooperative_perception_interfaces::msg::DetectionList>::SharedPtr
     detection_list_sub_{nullptr};
 
   rclcpp_lifecycle::LifecyclePublisher<
     carma_cooperative_perception_interfaces::msg::TrackList>::SharedPtr track_list_pub_{nullptr};
 
+  rclcpp_lifecycle::LifecyclePublisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr
+    pipeline_diagnostics_pub_{nullptr};
+
   rclcpp::TimerBase::SharedPtr pipeline_execution_timer_{nullptr};
 
   std::vector<Detection> detections_;
@@ -79,6 +93,7 @@ private:
     multiple_object_tracking::PromotionThreshold{3U},
     multiple_object_tracking::RemovalThreshold{0U}};
   units::time::nanosecond_t execution_period_{1 / units::frequency::hertz_t{2.0}};
+  std::atomic<std::size_t> max_prediction_threads_{4U};
   OnSetParametersCallbackHandle::SharedPtr on_set_parameters_callback_{nullptr};
 };
 
@@ -0,0 +1,80 @@
+// Copyright 2023 Leidos
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CARMA_COOPERATIVE_PERCEPTION__PARALLEL_FOR_EACH_HPP_
+#define CARMA_COOPERATIVE_PERCEPTION__PARALLEL_FOR_EACH_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <vector>
+
+namespace carma_cooperative_perception
+{
+/**
+ * @brief Apply a function to every element in a range, splitting the range across threads
+ *
+ * The range is divided into contiguous chunks, one per thread. The calling thread
+ * processes the last chunk itself. Small ranges (fewer than two chunks' worth of
+ * elements) are processed serially to avoid thread start-up overhead. The function
+ * must be safe to call concurrently on distinct elements.
+ *
+ * @param first Beginning of the range
+ * @param last End of the range
+ * @param max_threads Maximum number of threads (including the calling thread) to use
+ * @param min_elements_per_thread Smallest chunk worth handing to its own thread
+ * @param func Function applied to each element
+*/
+template <typename RandomIt, typename UnaryFunction>
+auto parallel_for_each(
+  RandomIt first, RandomIt last, std::size_t max_threads, std::size_t min_elements_per_thread,
+  UnaryFunction func) -> void
+{
+  const auto element_count{static_cast<std::size_t>(std::distance(first, last))};
+  const auto thread_count{std::clamp(
+    element_count / std::max(min_elements_per_thread, std::size_t{1}), std::size_t{1},
+    std::max(max_threads, std::size_t{1}))};
+
+  if (thread_count == 1) {
+    std::for_each(first, last, func);
+    return;
+  }
+
+  const auto chunk_size{
+    static_cast<std::ptrdiff_t>((element_count + thread_count - 1) / thread_count)};
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(thread_count - 1);
+
+  auto chunk_first{first};
+  for (std::size_t i{0}; i < thread_count - 1 && std::distance(chunk_first, last) > chunk_size;
+       ++i) {
+    const auto chunk_last{std::next(chunk_first, chunk_size)};
+    futures.push_back(std::async(std::launch::async, [chunk_first, chunk_last, &func] {
+      std::for_each(chunk_first, chunk_last, func);
+    }));
+    chunk_first = chunk_last;
+  }
+
+  std::for_each(chunk_first, last, func);
+
+  for (auto & future : futures) {
+    future.get();
+  }
+}
+
+}  // namespace carma_cooperative_perception
+
+#endif  // CARMA_COOPERATIVE_PERCEPTION__PARALLEL_FOR_EACH_HPP_
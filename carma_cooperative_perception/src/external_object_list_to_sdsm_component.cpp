@@ -131,7 +131,7 @@ auto ExternalObjectListToSdsmNode::publish_as_sdsm(const external_objects_msg_ty
 auto ExternalObjectListToSdsmNode::update_georeference(const georeference_msg_type & msg) -> void
 {
   map_georeference_ = msg.data;
-  map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg.data.c_str());
+  map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg.data);
 }
 
 auto ExternalObjectListToSdsmNode::update_current_pose(const pose_msg_type & msg) -> void
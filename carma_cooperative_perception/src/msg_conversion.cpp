@@ -147,7 +147,7 @@ auto heading_to_enu_yaw(const units::angle::degree_t & heading) -> units::angle:
 
 auto enu_orientation_to_true_heading(
   double yaw, const lanelet::BasicPoint3d & obj_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> units::angle::degree_t
 {
   // Get object geodetic position
@@ -155,7 +155,8 @@ auto enu_orientation_to_true_heading(
 
   // Get WGS84 Heading
   gsl::owner<PJ_CONTEXT *> context = proj_context_create();
-  gsl::owner<PJ *> transform = proj_create(context, map_projection->ECEF_PROJ_STR);
+  gsl::owner<PJ *> transform =
+    proj_create(context, lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR);
   units::angle::degree_t grid_heading{std::fmod(90 - yaw + 360, 360)};
 
   const auto factors = proj_factors(
@@ -192,7 +193,7 @@ auto calc_relative_position(
 
 auto transform_pose_from_map_to_wgs84(
   const geometry_msgs::msg::PoseStamped & source_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::Position3D
 {
   carma_v2x_msgs::msg::Position3D ref_pos;
@@ -457,7 +458,7 @@ auto to_external_object_list_msg(
 auto to_sdsm_msg(
   const carma_perception_msgs::msg::ExternalObjectList & external_object_list,
   const geometry_msgs::msg::PoseStamped & current_pose,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::SensorDataSharingMessage
 {
   carma_v2x_msgs::msg::SensorDataSharingMessage sdsm;
@@ -488,7 +489,7 @@ auto to_sdsm_msg(
 
 auto to_detected_object_data_msg(
   const carma_perception_msgs::msg::ExternalObject & external_object,
-  const std::shared_ptr<lanelet::projection::LocalFrameProjector> & map_projection)
+  const std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> & map_projection)
   -> carma_v2x_msgs::msg::DetectedObjectData
 {
   carma_v2x_msgs::msg::DetectedObjectData detected_object_data;
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include "carma_cooperative_perception/multiple_object_tracker_component.hpp"
+#include "carma_cooperative_perception/gated_scoring.hpp"
+#include "carma_cooperative_perception/parallel_for_each.hpp"
 
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <units.h>
@@ -28,6 +30,7 @@
 #include <multiple_object_tracking/gating.hpp>
 #include <multiple_object_tracking/scoring.hpp>
 #include <multiple_object_tracking/temporal_alignment.hpp>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -254,6 +257,9 @@ auto MultipleObjectTrackerNode::handle_on_configure(
   track_list_pub_ = create_publisher<carma_cooperative_perception_interfaces::msg::TrackList>(
     "output/track_list", 1);
 
+  pipeline_diagnostics_pub_ =
+    create_publisher<diagnostic_msgs::msg::DiagnosticArray>("output/pipeline_diagnostics", 1);
+
   detection_list_sub_ = create_subscription<
     carma_cooperative_perception_interfaces::msg::DetectionList>(
     "input/detection_list", 1,
@@ -324,6 +330,14 @@ auto MultipleObjectTrackerNode::handle_on_configure(
                 mot::RemovalThreshold{static_cast<std::size_t>(value)});
             }
           }
+        } else if (parameter.get_name() == "max_prediction_threads") {
+          // Takes effect on the next pipeline execution, so it may also be changed while active
+          if (const auto value{parameter.as_int()}; value < 1) {
+            result.successful = false;
+            result.reason = "parameter must be positive";
+          } else {
+            this->max_prediction_threads_ = static_cast<std::size_t>(value);
+          }
         } else {
           result.successful = false;
           result.reason = "Unexpected parameter name '" + parameter.get_name() + '\'';
@@ -342,6 +356,8 @@ auto MultipleObjectTrackerNode::handle_on_configure(
   declare_parameter(
     "track_removal_threshold", static_cast<int>(track_manager_.get_promotion_threshold().value));
 
+  declare_parameter("max_prediction_threads", static_cast<int>(max_prediction_threads_));
+
   RCLCPP_INFO(get_logger(), "Lifecycle transition: successfully configured");
 
   return carma_ros2_utils::CallbackReturn::SUCCESS;
@@ -439,22 +455,60 @@ auto MultipleObjectTrackerNode::store_new_detections(
   }
 }
 
+// Each propagation runs an unscented transform, so even a few dozen objects are worth
+// splitting across threads.
+static constexpr std::size_t min_propagations_per_thread{16U};
+
 static auto temporally_align_detections(
-  std::vector<Detection> & detections, units::time::second_t end_time) -> void
+  std::vector<Detection> & detections, units::time::second_t end_time, std::size_t max_threads)
+  -> void
 {
-  for (auto & detection : detections) {
-    mot::propagate_to_time(detection, end_time, mot::default_unscented_transform);
-  }
+  parallel_for_each(
+    std::begin(detections), std::end(detections), max_threads, min_propagations_per_thread,
+    [end_time](auto & detection) {
+      mot::propagate_to_time(detection, end_time, mot::default_unscented_transform);
+    });
 }
 
-static auto predict_track_states(std::vector<Track> tracks, units::time::second_t end_time)
+static auto predict_track_states(
+  std::vector<Track> & tracks, units::time::second_t end_time, std::size_t max_threads) -> void
 {
-  for (auto & track : tracks) {
-    mot::propagate_to_time(track, end_time, mot::default_unscented_transform);
+  parallel_for_each(
+    std::begin(tracks), std::end(tracks), max_threads, min_propagations_per_thread,
+    [end_time](auto & track) {
+      mot::propagate_to_time(track, end_time, mot::default_unscented_transform);
+    });
+}
+
+/**
+ * @brief Measures consecutive pipeline stages with a steady clock
+*/
+class StageTimer
+{
+public:
+  /**
+   * @brief Record the time elapsed since the previous stage ended (or since construction)
+   *
+   * @param stage_name Name under which the stage duration is reported
+  */
+  auto end_stage(std::string stage_name) -> void
+  {
+    const auto now{std::chrono::steady_clock::now()};
+    timings_.emplace_back(
+      std::move(stage_name),
+      std::chrono::duration<double, std::milli>(now - stage_start_).count());
+    stage_start_ = now;
   }
 
-  return tracks;
-}
+  auto get_timings() const -> const std::vector<std::pair<std::string, double>> &
+  {
+    return timings_;
+  }
+
+private:
+  std::chrono::steady_clock::time_point stage_start_{std::chrono::steady_clock::now()};
+  std::vector<std::pair<std::string, double>> timings_;
+};
 
 /**
  * @brief Calculate 2D Euclidean distance between track and detection
@@ -588,20 +642,36 @@ auto MultipleObjectTrackerNode::execute_pipeline() -> void
 
   const units::time::second_t current_time{this->now().seconds()};
 
-  temporally_align_detections(detections_, current_time);
+  StageTimer timer;
+
+  // Read once so both stages use the same limit if the parameter changes mid-execution
+  const std::size_t max_threads{max_prediction_threads_};
 
-  const auto predicted_tracks{predict_track_states(track_manager_.get_all_tracks(), current_time)};
-  auto scores{
-    mot::score_tracks_and_detections(predicted_tracks, detections_, SemanticDistance2dScore{})};
+  temporally_align_detections(detections_, current_time, max_threads);
+  timer.end_stage("align");
+
+  // Predict on the manager's returned list directly rather than on a second copy of it
+  auto predicted_tracks{track_manager_.get_all_tracks()};
+  predict_track_states(predicted_tracks, current_time, max_threads);
+  timer.end_stage("predict");
 
   // This pruning distance is an arbitrarily-chosen heuristic. It is working well for our
   // current purposes, but there's no reason it couldn't be restricted or loosened.
-  mot::prune_track_and_detection_scores_if(scores, [](const auto & score) { return score > 5.0; });
+  static constexpr auto max_association_distance{5.0};
+
+  // Only pairs that are close enough to survive pruning are scored
+  auto scores{score_tracks_and_detections_gated(
+    predicted_tracks, detections_, SemanticDistance2dScore{}, max_association_distance)};
+
+  mot::prune_track_and_detection_scores_if(
+    scores, [](const auto & score) { return score > max_association_distance; });
+  timer.end_stage("score");
 
   const auto associations{
     mot::associate_detections_to_tracks(scores, mot::gnn_association_visitor)};
 
   track_manager_.update_track_lists(associations);
+  timer.end_stage("associate");
 
   std::unordered_map<mot::Uuid, Detection> detection_map;
   for (const auto & detection : detections_) {
@@ -631,16 +701,13 @@ auto MultipleObjectTrackerNode::execute_pipeline() -> void
   // We want to remove unassociated tracks that are close enough to existing tracks
   // to avoid creating duplicates. Duplicate tracks will cause association inconsistencies
   // (flip flopping associations between the two tracks).
+  const auto min_scores{index_min_scores_by_detection(scores)};
   auto remove_start{std::remove_if(
     std::begin(unassociated_detections), std::end(unassociated_detections),
-    [&scores](const auto & detection) {
-      const auto uuid{mot::get_uuid(detection)};
-      auto min_score{std::numeric_limits<float>::infinity()};
-      for (const auto & [uuid_pair, score] : scores) {
-        if (uuid_pair.second == uuid) {
-          min_score = std::min(min_score, score);
-        }
-      }
+    [&min_scores](const auto & detection) {
+      const auto it{min_scores.find(mot::get_uuid(detection))};
+      const auto min_score{
+        it == std::cend(min_scores) ? std::numeric_limits<float>::infinity() : it->second};
 
       // This distance is an arbitrarily-chosen heuristic. It is working well for our
       // current purposes, but there's no reason it couldn't be restricted or loosened.
@@ -656,6 +723,7 @@ auto MultipleObjectTrackerNode::execute_pipeline() -> void
     const auto detection{std::cbegin(cluster.get_detections())->second};
     track_manager_.add_tentative_track(std::visit(make_track_visitor, detection));
   }
+  timer.end_stage("fuse");
 
   carma_cooperative_perception_interfaces::msg::TrackList track_list;
   for (const auto & track : track_manager_.get_confirmed_tracks()) {
@@ -663,11 +731,50 @@ auto MultipleObjectTrackerNode::execute_pipeline() -> void
   }
 
   track_list_pub_->publish(track_list);
+  timer.end_stage("publish");
+
+  publish_pipeline_diagnostics(timer.get_timings());
 
   detections_.clear();
   uuid_index_map_.clear();
 }
 
+auto MultipleObjectTrackerNode::publish_pipeline_diagnostics(const StageTimings & timings) -> void
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string{get_name()} + ": tracking pipeline";
+  status.hardware_id = "cpu";
+
+  double total_ms{0.0};
+  for (const auto & [stage_name, duration_ms] : timings) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = stage_name + "_ms";
+    key_value.value = std::to_string(duration_ms);
+    status.values.push_back(key_value);
+
+    total_ms += duration_ms;
+  }
+
+  diagnostic_msgs::msg::KeyValue total;
+  total.key = "total_ms";
+  total.value = std::to_string(total_ms);
+  status.values.push_back(total);
+
+  // Running past the execution period means the timer callbacks start queuing up
+  const auto period_ms{mot::remove_units(units::time::millisecond_t{execution_period_})};
+  if (total_ms > period_ms) {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = "pipeline execution exceeded the execution period";
+  }
+
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = now();
+  msg.status.push_back(status);
+
+  pipeline_diagnostics_pub_->publish(msg);
+}
+
 }  // namespace carma_cooperative_perception
 
 // This is not our macro, so we should not worry about linting it.
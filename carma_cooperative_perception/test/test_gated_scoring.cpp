@@ -0,0 +1,185 @@
+// Copyright 2023 Leidos
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <carma_cooperative_perception/gated_scoring.hpp>
+#include <carma_cooperative_perception/multiple_object_tracker_component.hpp>
+
+#include <multiple_object_tracking/ctrv_model.hpp>
+#include <multiple_object_tracking/scoring.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mot = multiple_object_tracking;
+
+namespace
+{
+struct Distance2dScore
+{
+  template <typename Track, typename Detection>
+  auto operator()(const Track & track, const Detection & detection) const -> std::optional<float>
+  {
+    const auto [track_x, track_y]{carma_cooperative_perception::get_position_2d(track)};
+    const auto [detection_x, detection_y]{carma_cooperative_perception::get_position_2d(detection)};
+
+    return std::hypot(track_x - detection_x, track_y - detection_y);
+  }
+};
+
+auto make_ctrv_detection(const std::string & id, double x, double y)
+  -> carma_cooperative_perception::Detection
+{
+  const mot::CtrvState state{
+    units::length::meter_t{x}, units::length::meter_t{y},
+    units::velocity::meters_per_second_t{5.0}, mot::Angle{units::angle::radian_t{0.0}},
+    units::angular_velocity::radians_per_second_t{0.0}};
+
+  return mot::CtrvDetection{
+    units::time::second_t{0.0}, state, mot::CtrvStateCovariance::Identity(), mot::Uuid{id},
+    mot::SemanticClass::kSmallVehicle};
+}
+
+/**
+ * Builds a busy intersection scene: tracks spread over a 300 m square and two
+ * noisy detections (e.g. from two cooperative sources) near every track.
+*/
+auto make_scene(std::size_t track_count)
+  -> std::pair<
+    std::vector<carma_cooperative_perception::Track>,
+    std::vector<carma_cooperative_perception::Detection>>
+{
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> position{-150.0, 150.0};
+  std::uniform_real_distribution<double> noise{-1.0, 1.0};
+
+  std::vector<carma_cooperative_perception::Track> tracks;
+  std::vector<carma_cooperative_perception::Detection> detections;
+
+  for (std::size_t i{0}; i < track_count; ++i) {
+    const auto x{position(gen)};
+    const auto y{position(gen)};
+
+    const auto track_detection{std::get<mot::CtrvDetection>(
+      make_ctrv_detection("track_" + std::to_string(i), x, y))};
+    tracks.emplace_back(mot::make_track<mot::CtrvTrack>(track_detection));
+
+    for (std::size_t j{0}; j < 2; ++j) {
+      detections.push_back(make_ctrv_detection(
+        "detection_" + std::to_string(i) + "_" + std::to_string(j), x + noise(gen),
+        y + noise(gen)));
+    }
+  }
+
+  return {tracks, detections};
+}
+}  // namespace
+
+TEST(GatedScoring, MatchesPrunedExhaustiveScoring)
+{
+  const auto [tracks, detections]{make_scene(100)};
+
+  auto expected{mot::score_tracks_and_detections(tracks, detections, Distance2dScore{})};
+  mot::prune_track_and_detection_scores_if(
+    expected, [](const auto & score) { return score > 5.0; });
+
+  auto actual{carma_cooperative_perception::score_tracks_and_detections_gated(
+    tracks, detections, Distance2dScore{}, 5.0)};
+  mot::prune_track_and_detection_scores_if(actual, [](const auto & score) { return score > 5.0; });
+
+  ASSERT_EQ(std::size(actual), std::size(expected));
+  for (const auto & [uuid_pair, score] : expected) {
+    ASSERT_EQ(actual.count(uuid_pair), 1U);
+    EXPECT_FLOAT_EQ(actual.at(uuid_pair), score);
+  }
+}
+
+TEST(GatedScoring, IndexMinScoresByDetection)
+{
+  const auto [tracks, detections]{make_scene(50)};
+
+  const auto scores{carma_cooperative_perception::score_tracks_and_detections_gated(
+    tracks, detections, Distance2dScore{}, 5.0)};
+  const auto min_scores{carma_cooperative_perception::index_min_scores_by_detection(scores)};
+
+  for (const auto & detection : detections) {
+    const auto uuid{mot::get_uuid(detection)};
+
+    auto expected{std::numeric_limits<float>::infinity()};
+    for (const auto & [uuid_pair, score] : scores) {
+      if (uuid_pair.second == uuid) {
+        expected = std::min(expected, score);
+      }
+    }
+
+    if (std::isinf(expected)) {
+      EXPECT_EQ(min_scores.count(uuid), 0U);
+    } else {
+      EXPECT_FLOAT_EQ(min_scores.at(uuid), expected);
+    }
+  }
+}
+
+TEST(GatedScoring, ScoresOnlyPairsInNeighboringCells)
+{
+  const auto [tracks, detections]{make_scene(500)};
+  ASSERT_EQ(std::size(detections), 1000U);
+
+  constexpr auto gate_distance{5.0};
+
+  std::size_t scored_pairs{0};
+  const auto counting_score{[&scored_pairs](const auto & track, const auto & detection) {
+    ++scored_pairs;
+    return Distance2dScore{}(track, detection);
+  }};
+
+  auto gated{carma_cooperative_perception::score_tracks_and_detections_gated(
+    tracks, detections, counting_score, gate_distance)};
+  mot::prune_track_and_detection_scores_if(
+    gated, [](const auto & score) { return score > gate_distance; });
+
+  auto exhaustive{mot::score_tracks_and_detections(tracks, detections, Distance2dScore{})};
+  mot::prune_track_and_detection_scores_if(
+    exhaustive, [](const auto & score) { return score > gate_distance; });
+
+  ASSERT_EQ(std::size(gated), std::size(exhaustive));
+  for (const auto & [uuid_pair, score] : exhaustive) {
+    ASSERT_EQ(gated.count(uuid_pair), 1U);
+    EXPECT_FLOAT_EQ(gated.at(uuid_pair), score);
+  }
+
+  // Only the pairs whose grid cells are neighbors reach the scoring function
+  const auto to_cell{[gate_distance](double value) { return std::floor(value / gate_distance); }};
+  std::size_t neighboring_pairs{0};
+  for (const auto & track : tracks) {
+    const auto [track_x, track_y]{carma_cooperative_perception::get_position_2d(track)};
+    for (const auto & detection : detections) {
+      const auto [detection_x, detection_y]{carma_cooperative_perception::get_position_2d(detection)};
+      if (
+        std::abs(to_cell(track_x) - to_cell(detection_x)) <= 1.0 &&
+        std::abs(to_cell(track_y) - to_cell(detection_y)) <= 1.0) {
+        ++neighboring_pairs;
+      }
+    }
+  }
+
+  EXPECT_EQ(scored_pairs, neighboring_pairs);
+  EXPECT_LT(scored_pairs, std::size(tracks) * std::size(detections) / 100);
+}
@@ -432,8 +432,7 @@ TEST(ToDetectedObjectDataMsg, FromExternalObject)
   std::string proj_string{
     "+proj=tmerc +lat_0=42.24375605014171 +lon_0=-83.55739733422793 +k=1 +x_0=0 +y_0=0 "
     "+datum=WGS84 +units=m +vunits=m +no_defs"};
-  auto shared_transform =
-    std::make_shared<lanelet::projection::LocalFrameProjector>(proj_string.c_str());
+  auto shared_transform = carma_wm::projection::getGeoreferenceProjector(proj_string);
   const auto detected_object{
     carma_cooperative_perception::to_detected_object_data_msg(object, shared_transform)};
 
@@ -460,11 +459,9 @@ TEST(ToSdsmMsg, FromExternalObjectList)
   current_pose.pose.position.y = 2;
   current_pose.pose.position.z = 3;
 
-  lanelet::projection::LocalFrameProjector local_projector(
+  const auto map_projection{carma_wm::projection::getGeoreferenceProjector(
     "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 "
-    "+datum=WGS84 +units=m +vunits=m +no_defs");
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projection;
-  map_projection = std::make_shared<lanelet::projection::LocalFrameProjector>(local_projector);
+    "+datum=WGS84 +units=m +vunits=m +no_defs")};
 
   const auto sdsm{
     carma_cooperative_perception::to_sdsm_msg(object_list, current_pose, map_projection)};
@@ -486,8 +483,7 @@ TEST(ToWgsHeading, FromMapYaw)
   obj_map_coordinates.z() = 37.8485517148;
 
   double yaw = 10.0;
-  auto shared_transform =
-    std::make_shared<lanelet::projection::LocalFrameProjector>(proj_string.c_str());
+  auto shared_transform = carma_wm::projection::getGeoreferenceProjector(proj_string);
   double heading = carma_cooperative_perception::remove_units(
     carma_cooperative_perception::enu_orientation_to_true_heading(
       yaw, obj_map_coordinates, shared_transform));
@@ -0,0 +1,80 @@
+// Copyright 2023 Leidos
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <carma_cooperative_perception/parallel_for_each.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ParallelForEach, VisitsEveryElementOnce)
+{
+  for (const auto size : {0U, 1U, 5U, 17U, 100U, 1001U}) {
+    for (const auto max_threads : {1U, 2U, 3U, 8U}) {
+      std::vector<int> values(size, 0);
+
+      carma_cooperative_perception::parallel_for_each(
+        std::begin(values), std::end(values), max_threads, 1U, [](int & value) { ++value; });
+
+      EXPECT_EQ(std::accumulate(std::cbegin(values), std::cend(values), 0U), size)
+        << "size: " << size << ", max_threads: " << max_threads;
+    }
+  }
+}
+
+TEST(ParallelForEach, SmallRangesStayOnCallingThread)
+{
+  std::vector<std::thread::id> thread_ids(10);
+
+  carma_cooperative_perception::parallel_for_each(
+    std::begin(thread_ids), std::end(thread_ids), 4U, 16U,
+    [](std::thread::id & id) { id = std::this_thread::get_id(); });
+
+  for (const auto & id : thread_ids) {
+    EXPECT_EQ(id, std::this_thread::get_id());
+  }
+}
+
+TEST(ParallelForEach, SplitsLargeRanges)
+{
+  std::vector<std::thread::id> thread_ids(64);
+
+  carma_cooperative_perception::parallel_for_each(
+    std::begin(thread_ids), std::end(thread_ids), 4U, 16U,
+    [](std::thread::id & id) { id = std::this_thread::get_id(); });
+
+  const std::set<std::thread::id> unique_ids(std::cbegin(thread_ids), std::cend(thread_ids));
+  EXPECT_EQ(std::size(unique_ids), 4U);
+}
+
+TEST(ParallelForEach, PropagatesExceptions)
+{
+  std::vector<int> values(100);
+  std::iota(std::begin(values), std::end(values), 0);
+
+  EXPECT_THROW(
+    carma_cooperative_perception::parallel_for_each(
+      std::begin(values), std::end(values), 4U, 10U,
+      [](int value) {
+        if (value == 3) {
+          throw std::runtime_error{"failure in worker thread"};
+        }
+      }),
+    std::runtime_error);
+}
@@ -32,6 +32,7 @@
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include "carma_wm/SignalizedIntersectionManager.hpp"
 #include <rosgraph_msgs/msg/clock.hpp>
+#include <unordered_map>
 
 namespace carma_wm
 {
@@ -111,8 +112,16 @@ public:
    *
    * @param spat_msg Msg to update with
    * @param use_sim_time Boolean to indicate if it is currently simulation or not
+   *
+   * @return True if the timing of any traffic signal changed
+   */
+  bool processSpatFromMsg(const carma_v2x_msgs::msg::SPAT& spat_msg, bool use_sim_time = false);
+
+  /*! \brief Enables or disables copy on write of traffic signal timing. When enabled, processSpatFromMsg writes the
+   *         timing into private copies of the map traffic signals so that copies of this world model which share the
+   *         map never observe the update. getTrafficSignal() and getSignalsAlongRoute() return the copies.
    */
-  void processSpatFromMsg(const carma_v2x_msgs::msg::SPAT& spat_msg, bool use_sim_time = false);
+  void setTrafficSignalCopyOnWrite(bool enabled);
 
   /**
    * \brief This function is called by distanceToObjectBehindInLane or distanceToObjectAheadInLane.
@@ -172,7 +181,7 @@ public:
    */
   lanelet::Id getTrafficSignalId(uint16_t intersection_id,uint8_t signal_id);
 
-  /*! \brief helper for getting traffic signal with given lanelet::Id
+  /*! \brief helper for getting traffic signal with given lanelet::Id. The returned signal holds the latest SPaT timing
    */
   lanelet::CarmaTrafficSignalPtr getTrafficSignal(const lanelet::Id& id) const;
 
@@ -211,6 +220,10 @@ public:
 
   TrackPos routeTrackPos(const lanelet::BasicPoint2d& point) const override;
 
+  TrackPos routeTrackPos(const lanelet::BasicPoint2d& point, RouteTrackPosCursor& cursor) const override;
+
+  std::vector<TrackPos> routeTrackPos(const std::vector<lanelet::BasicPoint2d>& points) const override;
+
   std::vector<lanelet::ConstLanelet> getLaneletsBetween(double start, double end, bool shortest_path_only = false,  bool bounds_inclusive = true) const override;
 
   std::vector<lanelet::BasicPoint2d> sampleRoutePoints(double start_downtrack, double end_downtrack, double step_size) const override;
@@ -241,6 +254,8 @@ public:
 
   lanelet::Optional<carma_perception_msgs::msg::RoadwayObstacle> toRoadwayObstacle(const carma_perception_msgs::msg::ExternalObject& object) const override;
 
+  carma_perception_msgs::msg::RoadwayObstacleList toRoadwayObstacles(const carma_perception_msgs::msg::ExternalObjectList& objects, size_t max_threads = 1) const override;
+
   lanelet::Optional<double> distToNearestObjInLane(const lanelet::BasicPoint2d& object_center) const override;
 
   lanelet::Optional<std::tuple<TrackPos,carma_perception_msgs::msg::RoadwayObstacle>> nearestObjectAheadInLane(const lanelet::BasicPoint2d& object_center) const override;
@@ -251,6 +266,8 @@ public:
 
   size_t getMapVersion() const override;
 
+  size_t getMapUpdateCount() const override;
+
   std::vector<lanelet::ConstLanelet> getLaneletsFromPoint(const lanelet::BasicPoint2d& point, const unsigned int n = 10) const override;
 
   std::vector<lanelet::ConstLanelet> nonConnectedAdjacentLeft(const lanelet::BasicPoint2d& input_point, const unsigned int n = 10) const override;
@@ -279,11 +296,68 @@ private:
    *         This function should generally only be called from inside the setRoute function as it uses member variables
    * set in that function
    *
-   *  Sets the shortest_path_centerlines_, shortest_path_centerlines_lengths_, and
-   * shortest_path_filtered_centerline_view_ member variables
+   *  Sets the route_reference_line_ and shortest_path_filtered_centerline_view_ member variables
    */
   void computeDowntrackReferenceLine();
 
+  /*! \brief Helper function which returns the traffic signal with the given id as it is stored in the map
+   *
+   * \return The signal or nullptr if it is not used by any lanelet of the map
+   */
+  lanelet::CarmaTrafficSignalPtr findMapTrafficSignal(const lanelet::Id& id) const;
+
+  /*! \brief Helper function which returns the signal holding the SPaT timing of a map signal. This is the map signal
+   *         itself unless copy on write is enabled and the signal has received a SPaT update.
+   */
+  lanelet::CarmaTrafficSignalPtr signalWithTiming(const lanelet::CarmaTrafficSignalPtr& map_signal) const;
+
+  /*! \brief Helper function which returns a signal whose timing may be modified for the given map signal.
+   *         With copy on write enabled the signal is copied unless the existing copy is referenced only by this object.
+   */
+  lanelet::CarmaTrafficSignalPtr writableTrafficSignal(const lanelet::CarmaTrafficSignalPtr& map_signal);
+
+  /*! \brief Helper function which returns the traffic signal copy table for modification. The table is copied first
+   *         if it is shared with another world model.
+   */
+  std::unordered_map<lanelet::Id, lanelet::CarmaTrafficSignalPtr>& writableTrafficSignalCopies();
+
+  /*! \brief Helper function which moves the traffic signal copies onto the signals of the current map, keeping their
+   *         timing. Copies of signals which are no longer in the map are dropped.
+   */
+  void rebaseTrafficSignalCopies();
+
+  /*! \brief Helper function to compute the downtrack interval covered by each lanelet in the route.
+   *         This function should only be called from inside the setRoute function after computeDowntrackReferenceLine
+   *         as it relies on the route reference line.
+   *
+   *  Sets the route_lanelet_index_ member variable
+   */
+  void computeLaneletDowntrackIndex();
+
+  /*! \brief Helper function to compute the downtrack of every regulatory element along the route shortest path which
+   *         is returned by the getXAlongRoute functions. Should be called whenever the route changes or a map update
+   *         changes the regulatory elements of a route lanelet, as it relies on the route reference line.
+   *
+   *  Sets the route_regulatory_element_index_ member variable
+   */
+  void computeRouteRegulatoryElementIndex();
+
+  /*! \brief Returns true if the regulatory elements of any route shortest path lanelet differ from the ones recorded
+   *         by the last call to computeRouteRegulatoryElementIndex
+   */
+  bool routeRegulatoryElementsChanged() const;
+
+  /*! \brief Helper function which computes the route TrackPos of a point given the route reference line vertex nearest
+   *         to it. Shared by the full search and incremental versions of routeTrackPos
+   *
+   *  \param point The point to compute the TrackPos of
+   *  \param ls_i The index of the reference line segment containing the nearest vertex
+   *  \param p_i The index of the nearest vertex within that segment
+   *
+   *  \return The TrackPos of the point
+   */
+  TrackPos routeTrackPosFromNearestPoint(const lanelet::BasicPoint2d& point, size_t ls_i, size_t p_i) const;
+
   /*! \brief Helper function to perform a deep copy of a LineString and assign new ids to all the elements. Used during
    * route centerline construction
    *
@@ -293,23 +367,176 @@ private:
    */
   lanelet::LineString3d copyConstructLineString(const lanelet::ConstLineString3d& line) const;
 
+  /*! \brief Lanelets matched to an external object and its predictions when converting it to a RoadwayObstacle
+   */
+  struct ObjectLaneletMatch
+  {
+    lanelet::Optional<lanelet::ConstLanelet> object_lanelet;  // Lanelet the object intersects. Empty if off the road
+    std::vector<lanelet::ConstLanelet> prediction_lanelets;   // Lanelet of each prediction
+  };
+
+  /*! \brief Helper function which finds the lanelets of an external object and its predictions. Only evaluates
+   *         lanelet polygons so it is safe to call from several threads at once.
+   *
+   *  The lanelet of each prediction is searched for starting from the lanelet of the previous prediction (or of the
+   *  object for the first one) and its successors. The map is only queried if the prediction is in none of them.
+   *
+   *  \param object The object to match
+   *
+   *  \return The matched lanelets
+   */
+  ObjectLaneletMatch matchObjectLanelets(const carma_perception_msgs::msg::ExternalObject& object) const;
+
+  /*! \brief Helper function which creates the RoadwayObstacle of an external object from its matched lanelets
+   *
+   *  NOTE: Computes the track position of the object along the centerlines of the matched lanelets. Lanelets cache
+   *  their centerline on first access, so concurrent calls must only be made once those centerlines are computed
+   *
+   *  \param object The object to convert
+   *  \param match The lanelets matched to the object by matchObjectLanelets. The object lanelet must be set
+   *
+   *  \return The RoadwayObstacle of the object
+   */
+  carma_perception_msgs::msg::RoadwayObstacle toRoadwayObstacle(const carma_perception_msgs::msg::ExternalObject& object,
+                                                                const ObjectLaneletMatch& match) const;
+
+  /*! \brief Roadway object which belongs to a lanelet of a queried lane
+   */
+  struct InLaneObject
+  {
+    size_t object_index = 0;  // Index of the object in the roadway object list
+    size_t lane_index = 0;    // Index of the lanelet the object belongs to in the queried lane
+    bool adjacent = false;    // True if the object's lanelet is adjacent to that lanelet and the object intersects it
+  };
+
+  struct RoadwayObjects;
+
+  /*! \brief Helper function to compute the lanelet to roadway object index. Must be called whenever the roadway
+   *         objects, map or routing graph change.
+   *
+   *  \param objects The roadway objects to index
+   *
+   *  \return The objects along with their lanelet index
+   */
+  std::shared_ptr<const RoadwayObjects>
+  computeRoadwayObjectIndex(std::vector<carma_perception_msgs::msg::RoadwayObstacle> objects) const;
+
+  /*! \brief Helper function which finds the roadway objects on the given lane using the lanelet to roadway object index.
+   *         Each object is reported once for the first lanelet of the lane it belongs to.
+   *
+   *  \param lane The lanelets of the lane in order
+   *
+   *  \return The objects on the lane ordered by lanelet then by object index
+   */
+  std::vector<InLaneObject> getInLaneObjectIndices(const std::vector<lanelet::ConstLanelet>& lane) const;
+
   std::optional<rclcpp::Time> ros1_clock_ = std::nullopt;
   std::optional<rclcpp::Time> simulation_clock_ = std::nullopt;
 
   std::shared_ptr<lanelet::LaneletMap> semantic_map_;
   LaneletRoutePtr route_;
+  size_t route_version_ = 0; // Incremented on each call to setRoute(). Used to detect stale RouteTrackPosCursor objects
   LaneletRoutingGraphPtr map_routing_graph_;
   double route_length_ = 0;
-  lanelet::LaneletSubmapConstUPtr shortest_path_view_;  // Map containing only lanelets along the shortest path of the
-                                                     // route
-  std::vector<lanelet::LineString3d> shortest_path_centerlines_;  // List of disjoint centerlines seperated by lane
-                                                                  // changes along the shortest path
-  IndexedDistanceMap shortest_path_distance_map_;
-  lanelet::LaneletMapUPtr shortest_path_filtered_centerline_view_;  // Lanelet map view of shortest path center lines
-                                                                    // only
-  std::vector<carma_perception_msgs::msg::RoadwayObstacle> roadway_objects_; //
+  lanelet::LaneletSubmapConstPtr shortest_path_view_;  // Map containing only lanelets along the shortest path of the
+                                                    // route. Shared so copies of the world model can be published as
+                                                    // snapshots. Never modified after setRoute
+
+  /*! \brief Reference line of the route shortest path used to compute route track positions
+   */
+  struct RouteReferenceLine
+  {
+    std::vector<lanelet::LineString3d> centerlines;  // List of disjoint centerlines seperated by lane changes along the
+                                                     // shortest path
+    std::vector<double> half_widths;  // Smallest half width of the lanelets forming each centerline
+    IndexedDistanceMap distance_map;
+  };
+
+  // Never modified once built by computeDowntrackReferenceLine so copies of the world model share it
+  std::shared_ptr<const RouteReferenceLine> route_reference_line_ = std::make_shared<const RouteReferenceLine>();
+  lanelet::LaneletMapPtr shortest_path_filtered_centerline_view_;  // Lanelet map view of shortest path center
+                                                                   // lines only. Never modified after setRoute
+
+  /*! \brief Entry of the lanelet to roadway object index
+   */
+  struct LaneletObjectEntry
+  {
+    size_t object_index = 0;  // Index of the object in RoadwayObjects::objects
+    bool adjacent = false;    // True if the object is on an adjacent lanelet but intersects the indexed lanelet
+  };
+
+  /*! \brief Latest roadway object list along with its lanelet index
+   */
+  struct RoadwayObjects
+  {
+    std::vector<carma_perception_msgs::msg::RoadwayObstacle> objects;
+
+    // Roadway objects which are in lane for each lanelet id, in increasing object index order. An object is indexed under
+    // its own lanelet and under each neighboring lanelet whose left or right neighbor is the object's lanelet and whose
+    // polygon the object intersects, as a lane changing object occupies both lanes
+    std::unordered_map<lanelet::Id, std::vector<LaneletObjectEntry>> lanelet_index;
+  };
+
+  // Replaced as a whole on each update so copies of the world model share it
+  std::shared_ptr<const RoadwayObjects> roadway_objects_ = std::make_shared<const RoadwayObjects>();
+
+  /*! \brief Downtrack interval covered by a single route lanelet. Used to answer getLaneletsBetween queries without
+   *         recomputing the route track position of every lanelet on every call.
+   */
+  struct LaneletDowntrackInterval
+  {
+    lanelet::ConstLanelet lanelet;
+    double start_downtrack = 0;  // Route downtrack of the first centerline point
+    double end_downtrack = 0;    // Route downtrack of the last centerline point
+    int shortest_path_index = -1; // Index of this lanelet in the route shortest path or -1 if it is not on the shortest path
+  };
+
+  /*! \brief Downtrack intervals of all route lanelets
+   */
+  struct RouteLaneletIndex
+  {
+    std::vector<LaneletDowntrackInterval> intervals; // Route lanelet intervals sorted by start_downtrack
+    double max_interval_length = 0; // Longest interval in intervals. Bounds the binary search window
+  };
+
+  // Replaced as a whole by computeLaneletDowntrackIndex so copies of the world model share it
+  std::shared_ptr<const RouteLaneletIndex> route_lanelet_index_ = std::make_shared<const RouteLaneletIndex>();
+
+  /*! \brief Regulatory element of a route shortest path lanelet along with the route downtrack used to decide whether
+   *         it is ahead of a location. Entries are kept in shortest path order.
+   */
+  template <class T>
+  struct RouteRegulatoryElement
+  {
+    std::shared_ptr<T> element;
+    double downtrack = 0;      // Route downtrack of the element's stop line or reference point
+    double max_downtrack = 0;  // Largest downtrack of this and all preceding entries. Non decreasing so it can be binary searched
+  };
+
+  /*! \brief Regulatory elements along the route shortest path
+   */
+  struct RouteRegulatoryElementIndex
+  {
+    std::unordered_map<lanelet::Id, size_t> shortest_path_indices; // Index of each lanelet in the route shortest path
+    std::vector<lanelet::RegulatoryElementPtrs> lanelet_regulatory_elements; // Regulatory elements of each shortest
+                                                                             // path lanelet when the index was computed
+    std::vector<RouteRegulatoryElement<lanelet::CarmaTrafficSignal>> signals;
+    std::vector<RouteRegulatoryElement<lanelet::BusStopRule>> bus_stops;
+    std::vector<RouteRegulatoryElement<lanelet::AllWayStop>> all_way_stops;
+    std::vector<RouteRegulatoryElement<lanelet::SignalizedIntersection>> signalized_intersections;
+  };
+
+  // Replaced as a whole by computeRouteRegulatoryElementIndex so copies of the world model share it
+  std::shared_ptr<const RouteRegulatoryElementIndex> route_regulatory_element_index_ = std::make_shared<const RouteRegulatoryElementIndex>();
 
   size_t map_version_ = 0; // The current map version. This is cached from calls to setMap();
+  size_t map_update_count_ = 0; // Number of calls to setMap()
+
+  bool traffic_signal_copy_on_write_ = false; // If true SPaT timing is written into traffic_signal_copies_ instead of the map
+  // Copies of map traffic signals holding their latest SPaT timing. Neither the table nor a copy is modified once another
+  // world model shares it
+  using TrafficSignalCopies = std::unordered_map<lanelet::Id, lanelet::CarmaTrafficSignalPtr>;
+  std::shared_ptr<TrafficSignalCopies> traffic_signal_copies_ = std::make_shared<TrafficSignalCopies>();
 
   std::string route_name_; // The current route name. This is set from calls to setRouteName();
 
@@ -0,0 +1,167 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <lanelet2_core/primitives/Point.h>
+#include <lanelet2_io/Projection.h>
+#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace carma_wm
+{
+namespace projection
+{
+/*!
+ * \brief Closed form transverse Mercator projection on the WGS84 ellipsoid.
+ *
+ * Uses the 6th order Krüger series (Karney 2011) which is accurate to a few nanometers within 3900 km of the central meridian
+ * and matches the default tmerc implementation of PROJ 6 and later.
+ */
+struct TransverseMercator
+{
+  TransverseMercator(double lat_0, double lon_0, double k_0, double x_0, double y_0);
+
+  /*!
+   * \brief Projects a geodetic position in degrees to easting and northing in meters
+   */
+  void forward(double lat, double lon, double* x, double* y) const;
+
+  /*!
+   * \brief Converts easting and northing in meters to a geodetic position in degrees
+   */
+  void reverse(double x, double y, double* lat, double* lon) const;
+
+private:
+  double conformalTan(double tan_lat) const;
+  void gaussKruger(double lat, double delta_lon, double* xi, double* eta) const;
+
+  double k_0_;
+  double lon_0_;  // (radians)
+  double x_0_;
+  double y_0_;
+  double e_;
+  double e2_;
+  double scaled_radius_;  // k_0 times the rectifying radius
+  double origin_northing_;
+  double alpha_[6];
+  double beta_[6];
+};
+
+/*!
+ * \brief Converts a geodetic position in degrees and ellipsoidal height in meters on the WGS84 ellipsoid to ECEF coordinates
+ */
+lanelet::BasicPoint3d geodeticToECEF(const lanelet::GPSPoint& gps_point);
+
+/*!
+ * \brief Converts ECEF coordinates to a geodetic position on the WGS84 ellipsoid. Closed form solution of Vermeille (2002)
+ */
+lanelet::GPSPoint ecefToGeodetic(const lanelet::BasicPoint3d& ecef_point);
+
+/*!
+ * \brief Conversions between WGS84 geodetic coordinates, ECEF coordinates and the map frame described by a georeference string.
+ *
+ * The interface mirrors lanelet::projection::LocalFrameProjector. When the georeference is a transverse Mercator or geocentric
+ * frame on the WGS84 ellipsoid, conversions are computed in closed form without PROJ. Other georeferences fall back to a
+ * LocalFrameProjector. Instances are immutable and may be shared between threads.
+ *
+ * Use getGeoreferenceProjector to obtain a shared instance instead of constructing one per georeference message or call.
+ */
+class GeoreferenceProjector
+{
+public:
+  /*!
+   * \brief Constructor
+   *
+   * \param georeference The proj string of the map frame
+   */
+  explicit GeoreferenceProjector(const std::string& georeference);
+
+  /*!
+   * \return The proj string of the map frame
+   */
+  const std::string& getGeoreference() const;
+
+  /*!
+   * \return True if conversions are computed in closed form instead of by PROJ
+   */
+  bool hasClosedForm() const;
+
+  /*!
+   * \brief Projects a WGS84 geodetic position into the map frame
+   */
+  lanelet::BasicPoint3d forward(const lanelet::GPSPoint& gps_point) const;
+
+  /*!
+   * \brief Converts a map frame point into a WGS84 geodetic position
+   */
+  lanelet::GPSPoint reverse(const lanelet::BasicPoint3d& map_point) const;
+
+  /*!
+   * \brief Converts between the map frame and ECEF
+   *
+   * \param point The point to convert
+   * \param proj_dir 1 to convert a map frame point to ECEF, -1 to convert an ECEF point to the map frame
+   */
+  lanelet::BasicPoint3d projectECEF(const lanelet::BasicPoint3d& point, int proj_dir) const;
+
+  /*!
+   * \brief Batch version of forward(gps_point)
+   */
+  std::vector<lanelet::BasicPoint3d> forward(const std::vector<lanelet::GPSPoint>& gps_points) const;
+
+  /*!
+   * \brief Batch version of reverse(map_point)
+   */
+  std::vector<lanelet::GPSPoint> reverse(const std::vector<lanelet::BasicPoint3d>& map_points) const;
+
+  /*!
+   * \brief Batch version of projectECEF(point, proj_dir)
+   */
+  std::vector<lanelet::BasicPoint3d> projectECEF(const std::vector<lanelet::BasicPoint3d>& points, int proj_dir) const;
+
+private:
+  enum class Frame
+  {
+    PROJ,
+    TRANSVERSE_MERCATOR,
+    GEOCENTRIC
+  };
+
+  std::string georeference_;
+  Frame frame_ = Frame::PROJ;
+  std::unique_ptr<TransverseMercator> tmerc_;
+
+  // PROJ transformations are not thread safe so the fallback projector is only used under this mutex
+  mutable std::mutex projector_mutex_;
+  std::unique_ptr<lanelet::projection::LocalFrameProjector> projector_;
+};
+
+/*!
+ * \brief Returns the projector for a georeference string. Projectors are cached per georeference string and shared across the process,
+ *        so repeated georeference messages or calls do not rebuild the projection.
+ *
+ * \param georeference The proj string of the map frame
+ *
+ * \throw std::invalid_argument if the georeference cannot be used by PROJ
+ */
+std::shared_ptr<const GeoreferenceProjector> getGeoreferenceProjector(const std::string& georeference);
+
+}  // namespace projection
+}  // namespace carma_wm
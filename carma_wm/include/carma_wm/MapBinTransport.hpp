@@ -0,0 +1,130 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <autoware_lanelet2_msgs/msg/map_bin.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <lanelet2_core/LaneletMap.h>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace carma_wm
+{
+/*!
+ * \brief Compression applied to the boost binary archive stored in the data field of a MapBin message.
+ *
+ * Compressed data starts with a short header so readers can tell it apart from a plain archive.
+ * Plain archives are unchanged so they remain readable by lanelet::utils::conversion::fromBinMsg.
+ */
+enum class MapBinCompression : uint8_t
+{
+  NONE = 0,
+  ZLIB = 1
+};
+
+/*!
+ * \brief Writes a boost binary archive directly into the data field of a MapBin message
+ *
+ * \param write Function which writes the contents of the archive
+ * \param compression The compression to apply to the archive
+ * \param msg The message whose data will be replaced
+ */
+void writeBinArchive(const std::function<void(boost::archive::binary_oarchive&)>& write, MapBinCompression compression,
+                     autoware_lanelet2_msgs::msg::MapBin* msg);
+
+/*!
+ * \brief Reads a boost binary archive directly from the data field of a MapBin message. Compression is detected from
+ *        the data so both compressed and plain archives are accepted.
+ *
+ * \param msg The message to read
+ * \param read Function which reads the contents of the archive
+ */
+void readBinArchive(const autoware_lanelet2_msgs::msg::MapBin& msg,
+                    const std::function<void(boost::archive::binary_iarchive&)>& read);
+
+/*!
+ * \brief Returns the compression used for the data of the provided message
+ */
+MapBinCompression getMapBinCompression(const autoware_lanelet2_msgs::msg::MapBin& msg);
+
+/*!
+ * \brief Serializes a lanelet map into a MapBin message. With MapBinCompression::NONE the result is identical to
+ *        lanelet::utils::conversion::toBinMsg but the archive is written without intermediate string copies.
+ *
+ * \param map The map to serialize
+ * \param msg The message to populate. Only the data field is modified
+ * \param compression The compression to apply
+ */
+void mapToBinMsg(const lanelet::LaneletMapPtr& map, autoware_lanelet2_msgs::msg::MapBin* msg,
+                 MapBinCompression compression = MapBinCompression::NONE);
+
+/*!
+ * \brief Deserializes a lanelet map from a MapBin message produced by mapToBinMsg or
+ *        lanelet::utils::conversion::toBinMsg.
+ *
+ * \param msg The message to read
+ * \param map The map to populate
+ */
+void mapFromBinMsg(const autoware_lanelet2_msgs::msg::MapBin& msg, lanelet::LaneletMapPtr map);
+
+/*!
+ * \brief Splits a MapBin message into chunks whose data is at most max_chunk_size bytes of the original data.
+ *        Every chunk carries the metadata of the original message but only the last one carries the routing graph.
+ *        The chunks must be published in order and can be reassembled with a MapBinChunkAssembler.
+ *
+ * \param msg The message to split
+ * \param max_chunk_size Maximum number of bytes of the original data in a chunk. 0 disables chunking
+ *
+ * \return The chunks in publication order. If the data fits in a single chunk the original message is returned as is
+ */
+std::vector<autoware_lanelet2_msgs::msg::MapBin> splitMapBinMsg(autoware_lanelet2_msgs::msg::MapBin msg,
+                                                               size_t max_chunk_size);
+
+/*!
+ * \brief Returns true if the message is a chunk created by splitMapBinMsg
+ */
+bool isMapBinChunk(const autoware_lanelet2_msgs::msg::MapBin& msg);
+
+/*!
+ * \brief Reassembles MapBin messages split by splitMapBinMsg.
+ *
+ * The data of each chunk is appended to a buffer which is sized for the whole message when the first chunk arrives,
+ * so the message is only copied once regardless of the number of chunks.
+ */
+class MapBinChunkAssembler
+{
+public:
+  /*!
+   * \brief Adds a received message
+   *
+   * \param msg The received message. Messages which are not chunks are returned unchanged
+   *
+   * \return The complete message once the last chunk of a transfer has been received, otherwise nullptr.
+   *         A transfer with a missing chunk is dropped.
+   */
+  autoware_lanelet2_msgs::msg::MapBin::SharedPtr addMessage(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr& msg);
+
+private:
+  autoware_lanelet2_msgs::msg::MapBin::SharedPtr assembled_;  // Message being assembled or nullptr if none
+  uint32_t transfer_id_ = 0;
+  uint32_t next_chunk_index_ = 0;
+  uint32_t num_chunks_ = 0;
+};
+
+}  // namespace carma_wm
@@ -0,0 +1,49 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <vector>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_extension/regulatory_elements/CarmaTrafficSignal.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief Creates a new map in which the regulatory elements of the given lanelets can be edited without modifying the
+ *        original map.
+ *
+ * The given lanelets are copied along with every regulatory element which refers to a copied lanelet or area and every
+ * lanelet or area which uses a copied regulatory element, so that references between copied and shared primitives
+ * never cross the two maps. All other primitives, including the points and line strings of the copied lanelets, are
+ * shared with the original map. Copied primitives keep their ids.
+ *
+ * \param map The map to copy
+ * \param lanelet_ids The ids of the lanelets which will be edited. Ids which are not in the map are ignored
+ *
+ * \return A new map with the same contents as map
+ */
+lanelet::LaneletMapPtr copyMapForEdit(const lanelet::LaneletMapPtr& map, const std::vector<lanelet::Id>& lanelet_ids);
+
+/*!
+ * \brief Copies the SPaT timing and cycle information of one traffic signal to another
+ *
+ * \param from The signal to copy from
+ * \param to The signal to copy to
+ */
+void copyTrafficSignalTiming(const lanelet::CarmaTrafficSignal& from, lanelet::CarmaTrafficSignal& to);
+
+}  // namespace carma_wm
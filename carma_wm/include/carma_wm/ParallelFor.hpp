@@ -0,0 +1,94 @@
+#pragma once
+
+/*
+ * Copyright (C) 2023 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <vector>
+
+namespace carma_wm
+{
+/*! \brief Calls func for every index in [0, count), splitting the indices into contiguous chunks across at most
+ *         max_threads threads. The calling thread processes the last chunk.
+ *
+ * \param count Number of indices to process
+ * \param max_threads Largest number of threads to use, including the calling thread
+ * \param min_per_thread Smallest number of indices worth handing to a thread of their own
+ * \param func Function called once for each index. Calls for different indices may run concurrently
+ *
+ * \throw Any exception thrown by func, once every chunk has finished
+ */
+inline void parallelFor(size_t count, size_t max_threads, size_t min_per_thread,
+                        const std::function<void(size_t)>& func)
+{
+  size_t thread_count = std::max<size_t>(std::min(count / std::max<size_t>(min_per_thread, 1), max_threads), 1);
+
+  if (thread_count == 1)
+  {
+    for (size_t i = 0; i < count; i++)
+      func(i);
+
+    return;
+  }
+
+  size_t chunk_size = (count + thread_count - 1) / thread_count;
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(thread_count - 1);
+
+  size_t chunk_start = 0;
+  for (; chunk_start + chunk_size < count; chunk_start += chunk_size)
+  {
+    futures.push_back(std::async(std::launch::async, [chunk_start, chunk_size, &func] {
+      for (size_t i = chunk_start; i < chunk_start + chunk_size; i++)
+        func(i);
+    }));
+  }
+
+  std::exception_ptr error;
+  try
+  {
+    for (size_t i = chunk_start; i < count; i++)
+      func(i);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  // Wait on every chunk before rethrowing so no thread outlives the references captured in func
+  for (auto& future : futures)
+  {
+    try
+    {
+      future.get();
+    }
+    catch (...)
+    {
+      if (!error)
+        error = std::current_exception();
+    }
+  }
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+}  // namespace carma_wm
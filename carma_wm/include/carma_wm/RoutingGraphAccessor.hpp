@@ -19,6 +19,9 @@
 
 #include <lanelet2_routing/RoutingGraph.h>
 #include <lanelet2_routing/internal/Graph.h>
+#include <lanelet2_routing/internal/RouteBuilder.h>
+#include <lanelet2_routing/Route.h>
+#include <autoware_lanelet2_msgs/msg/routing_graph.hpp>
 
 
 /**
@@ -33,6 +36,60 @@ class RoutingGraphAccessor : public lanelet::routing::RoutingGraph {
 
   public:
 
+  /**
+   * \brief Returns the underlying boost graph of this RoutingGraph. This is done by accessing protected data members directly
+   *
+   * \return The graph containing one vertex per passable lanelet or area and one edge per routing relation
+   */
+  const lanelet::routing::internal::GraphType& getInternalGraph() const {
+    return this->graph_->get();
+  }
+
+  /**
+   * \return The number of routing costs this graph was built with
+   */
+  size_t getNumRoutingCosts() const {
+    return this->graph_->numRoutingCosts();
+  }
+
+  /**
+   * \brief Returns true if a route may step directly from one lanelet to the other in this graph
+   *
+   * \param from The lanelet being left
+   * \param to The lanelet being entered
+   *
+   * \return True if the lanelets are connected by a successor or lane change relation
+   */
+  bool canTraverse(const lanelet::ConstLanelet& from, const lanelet::ConstLanelet& to) const {
+    auto relation = this->routingRelation(from, to);
+
+    return relation && (*relation == lanelet::routing::RelationType::Successor || *relation == lanelet::routing::RelationType::Left
+                        || *relation == lanelet::routing::RelationType::Right);
+  }
+
+  /**
+   * \brief Builds the route which follows the provided shortest path without searching this graph.
+   *        This is the second half of getRouteVia, so the result matches getRouteVia for a path this graph would produce.
+   *
+   * \param path The lanelets of the shortest path in order
+   *
+   * \return The route. Empty if the path is empty or if consecutive lanelets are not connected by a successor or lane change relation in this graph
+   */
+  lanelet::Optional<lanelet::routing::Route> getRouteFromShortestPath(const lanelet::ConstLanelets& path) const {
+
+    if (path.empty() || !this->passableSubmap()->laneletLayer.exists(path.front().id())) {
+      return {};
+    }
+
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+      if (!canTraverse(path[i], path[i + 1])) {
+        return {};
+      }
+    }
+
+    return lanelet::routing::internal::RouteBuilder(*this->graph_).getRouteFromShortestPath(lanelet::routing::LaneletPath(path));
+  }
+
   /**
    * \brief Returns a ROS message version of this RoutingGraph. This is done by accessing protected data members directly
    * 
@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+namespace carma_wm
+{
+/*!
+ * \brief A single vertex of a lanelet2 routing graph. Lanelets which are passable in both directions have a second
+ *        vertex for their inverted form which shares the id of the lanelet
+ */
+struct RoutingGraphVertex
+{
+  lanelet::Id id = lanelet::InvalId;
+  bool inverted = false;
+};
+
+/*!
+ * \brief A single directed edge of a lanelet2 routing graph identified by the ids and directions of its end points
+ */
+struct RoutingGraphEdge
+{
+  lanelet::Id from = lanelet::InvalId;
+  lanelet::Id to = lanelet::InvalId;
+  bool from_inverted = false;
+  bool to_inverted = false;
+  double routing_cost = 0.0;
+  uint16_t routing_cost_id = 0;
+  uint8_t relation = 0; // lanelet::routing::RelationType stored as its underlying value
+};
+
+/*!
+ * \brief Describes how a routing graph changes when the lanelets in affected_lanelet_ids change.
+ *
+ * Applying the delta removes every vertex in affected_lanelet_ids, in either direction, along with every edge that
+ * touches them, then re-adds the vertices in passable_vertices and the edges in edges. All other vertices and edges are kept as is.
+ * A delta is only valid for the graph it was computed against. base_graph_hash identifies that graph so a receiver
+ * can detect that its graph has diverged and rebuild it instead.
+ */
+struct RoutingGraphDelta
+{
+  std::string participant;  // Participant the graph was built for. Must match the graph the delta is applied to
+  uint64_t base_graph_hash = 0;  // routingGraphHash of the graph the delta was computed against. 0 if unknown
+  std::vector<lanelet::Id> affected_lanelet_ids;  // Lanelets whose vertices and edges are replaced
+  std::vector<RoutingGraphVertex> passable_vertices;  // Vertices of affected lanelets after the change
+  std::vector<RoutingGraphEdge> edges;            // Every edge after the change with an affected lanelet as an end point
+};
+
+/*!
+ * \brief Computes a hash of the vertices and edges of a routing graph. The hash does not depend on the order in which
+ *        vertices and edges were added, so graphs with the same structure have the same hash however they were built.
+ *
+ * \param graph The graph to hash
+ *
+ * \return The hash of the graph. Never 0
+ */
+uint64_t routingGraphHash(const lanelet::routing::RoutingGraph& graph);
+
+/*!
+ * \brief Computes the routing graph delta caused by a change to the given lanelets of the map.
+ *
+ * Rather than building a routing graph for the whole map, this builds one only for the affected lanelets and the
+ * lanelets and areas whose bounding boxes are within search_margin of them. Every routing relation lanelet2 creates
+ * (succession, lane changes, adjacency, conflicts and areas) requires the two primitives to touch or overlap, so the
+ * edges of the affected lanelets in this small graph are the same as in a graph built from the full map.
+ *
+ * \param map The map after the change has been applied to it
+ * \param traffic_rules The traffic rules used to build the graph the delta will be applied to
+ * \param affected_lanelet_ids Ids of the lanelets whose regulations or geometry changed. Ids not in the map are ignored
+ * \param participant The participant used to build the graph the delta will be applied to
+ * \param search_margin Distance in meters by which the bounding boxes of the affected lanelets are grown when searching for neighbors
+ *
+ * \return The delta to apply to a graph of the map from before the change
+ */
+RoutingGraphDelta computeRoutingGraphDelta(const lanelet::LaneletMap& map,
+                                           const lanelet::traffic_rules::TrafficRules& traffic_rules,
+                                           const std::vector<lanelet::Id>& affected_lanelet_ids,
+                                           const std::string& participant, double search_margin = 1.0);
+
+/*!
+ * \brief Creates a new routing graph by applying the delta to an existing graph. Only the adjacency structure of the
+ *        existing graph is copied, so no geometry is evaluated for lanelets the delta does not affect.
+ *
+ * Every vertex of the new graph is looked up in the provided map by id. Applying an empty delta therefore rebinds a
+ * graph to a copy of the map it was built from without rebuilding it.
+ *
+ * \param graph The graph to apply the delta to. This graph is not modified
+ * \param delta The delta to apply
+ * \param map The map the new graph will refer to. Must contain every lanelet and area referenced by the graph and delta
+ *
+ * \return The updated routing graph or nullptr if the delta references lanelets or areas which are not in the map or graph
+ */
+std::shared_ptr<lanelet::routing::RoutingGraph> applyRoutingGraphDelta(const lanelet::routing::RoutingGraph& graph,
+                                                                      const RoutingGraphDelta& delta,
+                                                                      const lanelet::LaneletMapPtr& map);
+
+}  // namespace carma_wm
@@ -32,6 +32,8 @@
 #include <lanelet2_extension/regulatory_elements/PassingControlLine.h>
 #include <lanelet2_extension/regulatory_elements/DigitalMinimumGap.h>
 #include <carma_wm/SignalizedIntersectionManager.hpp>
+#include <carma_wm/RoutingGraphDelta.hpp>
+#include <carma_wm/MapBinTransport.hpp>
 #include <lanelet2_core/primitives/LaneletOrArea.h>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -71,6 +73,10 @@ public:
   // signalized intersection manager
   carma_wm::SignalizedIntersectionManager sim_;
 
+  // changes to the routing graph caused by this update. Only meaningful if has_routing_graph_delta_ is true
+  bool has_routing_graph_delta_ = false;
+  carma_wm::RoutingGraphDelta routing_graph_delta_;
+
 };
 
 /**
@@ -78,10 +84,12 @@ public:
  * lanelet2_extension::utility::message_conversion::toBinMsg]
  * @param gf_ptr [Ptr to Geofence data]
  * @param msg [converted ROS message. Only "data" field is filled]
+ * @param compression [compression applied to the serialized data. Receivers detect it automatically]
  * NOTE: When converting the geofence object, the converter fills its relevant map update
  * fields (update_list, remove_list) to be read once received at the user
  */
-void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::msg::MapBin* msg);
+void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::msg::MapBin* msg,
+              carma_wm::MapBinCompression compression = carma_wm::MapBinCompression::NONE);
 
 /**
  * [Converts Geofence binary ROS message to carma_wm::TrafficControl object. Similar implementation to 
@@ -97,6 +105,15 @@ void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet
  */
 void fromBinMsg(const autoware_lanelet2_msgs::msg::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr, lanelet::LaneletMapPtr lanelet_map = nullptr);
 
+/**
+ * [Replaces the primitives referenced by the regulatory elements of a received geofence object with the primitives
+ * of lanelet_map which have the same ids. This is the memory matching step of fromBinMsg for callers which must
+ * deserialize the update before choosing the map it is applied to]
+ * @param gf_ptr      [Ptr to the geofence object to resolve]
+ * @param lanelet_map [Ptr to lanelet map whose primitives the regulatory elements should refer to]
+ */
+void resolveMapReferences(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, lanelet::LaneletMapPtr lanelet_map);
+
 }  // namespace carma_wm
 
 
@@ -133,6 +150,10 @@ inline void save(Archive& ar, const carma_wm::TrafficControl& gf, unsigned int /
 
   // convert signalized intersection manager
   ar << gf.sim_;
+
+  // convert routing graph delta
+  ar << gf.has_routing_graph_delta_;
+  if (gf.has_routing_graph_delta_) ar << gf.routing_graph_delta_;
 }
 
 template <class Archive>
@@ -187,6 +208,10 @@ inline void load(Archive& ar, carma_wm::TrafficControl& gf, unsigned int /*versi
 
   // save signalized intersection manager
   ar >> gf.sim_;
+
+  // save routing graph delta
+  ar >> gf.has_routing_graph_delta_;
+  if (gf.has_routing_graph_delta_) ar >> gf.routing_graph_delta_;
 }
 
 
@@ -295,6 +320,68 @@ inline void load(Archive& ar, carma_wm::SignalizedIntersectionManager& sim, unsi
 
 }
 
+template <class Archive>
+// NOLINTNEXTLINE
+inline void save(Archive& ar, const carma_wm::RoutingGraphDelta& delta, unsigned int /*version*/) 
+{
+  ar << delta.participant;
+  ar << delta.base_graph_hash;
+
+  size_t affected_lanelet_ids_size = delta.affected_lanelet_ids.size();
+  ar << affected_lanelet_ids_size;
+  for (auto id : delta.affected_lanelet_ids) ar << id;
+
+  size_t passable_vertices_size = delta.passable_vertices.size();
+  ar << passable_vertices_size;
+  for (const auto& vertex : delta.passable_vertices) ar << vertex;
+
+  size_t edges_size = delta.edges.size();
+  ar << edges_size;
+  for (const auto& edge : delta.edges) ar << edge;
+}
+
+template <class Archive>
+// NOLINTNEXTLINE
+inline void load(Archive& ar, carma_wm::RoutingGraphDelta& delta, unsigned int /*version*/) 
+{
+  ar >> delta.participant;
+  ar >> delta.base_graph_hash;
+
+  size_t affected_lanelet_ids_size;
+  ar >> affected_lanelet_ids_size;
+  delta.affected_lanelet_ids.resize(affected_lanelet_ids_size);
+  for (auto& id : delta.affected_lanelet_ids) ar >> id;
+
+  size_t passable_vertices_size;
+  ar >> passable_vertices_size;
+  delta.passable_vertices.resize(passable_vertices_size);
+  for (auto& vertex : delta.passable_vertices) ar >> vertex;
+
+  size_t edges_size;
+  ar >> edges_size;
+  delta.edges.resize(edges_size);
+  for (auto& edge : delta.edges) ar >> edge;
+}
+
+template <typename Archive>
+void serialize(Archive& ar, carma_wm::RoutingGraphVertex& vertex, unsigned int /*version*/) 
+{
+  ar& vertex.id;
+  ar& vertex.inverted;
+}
+
+template <typename Archive>
+void serialize(Archive& ar, carma_wm::RoutingGraphEdge& edge, unsigned int /*version*/) 
+{
+  ar& edge.from;
+  ar& edge.to;
+  ar& edge.from_inverted;
+  ar& edge.to_inverted;
+  ar& edge.routing_cost;
+  ar& edge.routing_cost_id;
+  ar& edge.relation;
+}
+
 template <typename Archive>
 void serialize(Archive& ar, std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>& p, unsigned int /*version*/) 
 {
@@ -328,3 +415,4 @@ void serialize(Archive& ar, std::pair<uint32_t, lanelet::Id>& p, unsigned int /*
 
 BOOST_SERIALIZATION_SPLIT_FREE(carma_wm::TrafficControl)
 BOOST_SERIALIZATION_SPLIT_FREE(carma_wm::SignalizedIntersectionManager)
+BOOST_SERIALIZATION_SPLIT_FREE(carma_wm::RoutingGraphDelta)
@@ -42,6 +42,12 @@ class WMListenerWorker;  // Forward declaration of worker class
  * in the constructor. When used in a multi-threading case users can ensure threadsafe operation though usage of the
  * getLock function
  *
+ * If the use_world_model_snapshots parameter is true, every update is published as an immutable snapshot of the world
+ * model. getWorldModel() then returns the latest snapshot without locking and readers may hold it for a whole planning
+ * cycle while updates continue in the background. Updates are serialized with mw_mutex_ in this mode.
+ * Traffic signal timing received over SPaT is held per snapshot and is read through getSignalsAlongRoute() or
+ * CARMAWorldModel::getTrafficSignal().
+ *
  */
 class WMListener
 {
@@ -67,6 +73,7 @@ public:
 
   /*!
    * \brief Returns a pointer to an intialized world model instance
+   *        In snapshot mode this does not lock and the returned world model never changes
    *
    * \return Const pointer to a world model object
    */
@@ -129,6 +136,10 @@ public:
 private:
   // Callback function that uses lock to edit the map
   void mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::SharedPtr geofence_msg);
+
+  // Applies an update to the world model. In snapshot mode the update is serialized with mw_mutex_ and then published
+  // if it returns true
+  void applyUpdate(const std::function<bool()>& update);
   carma_ros2_utils::SubPtr<carma_perception_msgs::msg::RoadwayObstacleList> roadway_objects_sub_;
   carma_ros2_utils::SubPtr<autoware_lanelet2_msgs::msg::MapBin> map_update_sub_;
 
@@ -145,6 +156,7 @@ private:
   carma_ros2_utils::SubPtr<rosgraph_msgs::msg::Clock> sim_clock_sub_;
   carma_ros2_utils::SubPtr<rosgraph_msgs::msg::Clock> ros1_clock_sub_;
   const bool multi_threaded_;
+  bool use_snapshots_ = false;
   std::mutex mw_mutex_;
 
 
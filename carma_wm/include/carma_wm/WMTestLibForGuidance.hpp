@@ -555,6 +555,9 @@ std::vector<std::pair<boost::posix_time::ptime, lanelet::CarmaTrafficSignalState
     cmw->getMutableMap()->update(llt, traffic_light);
   }
 
+  // Ensure world model lookup tables are updated
+  cmw->setMap(cmw->getMutableMap(), cmw->getMapVersion(), false);
+
 }
 
 /**
@@ -63,6 +63,18 @@ enum LaneSection
   LANE_FULL
 };
 
+/*! \brief Search hint used by the incremental routeTrackPos method.
+ *         Records the route reference line vertex which was matched by the previous call so the next call can walk
+ *         from it instead of performing a spatial search. A default constructed cursor is always valid to pass in and
+ *         will result in a full search. The contents should be treated as opaque by users.
+ */
+struct RouteTrackPosCursor
+{
+  size_t route_version = 0;     // Version of the route the indexes refer to. 0 means the cursor is unset
+  size_t linestring_index = 0;  // Index of the matched route reference line segment
+  size_t point_index = 0;       // Index of the matched point within the reference line segment
+};
+
 /*! \brief An interface which provides read access to the semantic map and route.
  *         This class is not thread safe. All units of distance are in meters
  *
@@ -122,6 +134,34 @@ class WorldModel
     */
     virtual TrackPos routeTrackPos(const lanelet::BasicPoint2d& point) const = 0;
 
+    /*! \brief Incremental version of routeTrackPos(point) intended for sequences of nearby points such as trajectories.
+    *         The search starts from the route reference line vertex stored in the cursor and walks along the reference
+    *         line to the nearest vertex. A full spatial search is used if the cursor is unset, was produced for a different
+    *         route, the walk reaches the end of a reference line segment, or the point is too far from the walked segment.
+    *
+    * NOTE: The route definition used in this class contains discontinuities in the reference line at lane changes. It is
+    * important to consider that when using route related functions.
+    *
+    * \param point The lanelet2 point which will have its distance computed
+    * \param cursor The search hint from the previous call. Updated with the vertex matched by this call
+    *
+    * \throws std::invalid_argument If the route is not yet loaded
+    *
+    * \return The TrackPos of the point
+    */
+    virtual TrackPos routeTrackPos(const lanelet::BasicPoint2d& point, RouteTrackPosCursor& cursor) const = 0;
+
+    /*! \brief Batch version of routeTrackPos(point). Points are processed in order using a shared RouteTrackPosCursor
+    *         so monotone sequences of points such as trajectories only pay for a spatial search on the first point.
+    *
+    * \param points The lanelet2 points which will have their distances computed
+    *
+    * \throws std::invalid_argument If the route is not yet loaded
+    *
+    * \return The TrackPos of each point in the same order as the input
+    */
+    virtual std::vector<TrackPos> routeTrackPos(const std::vector<lanelet::BasicPoint2d>& points) const = 0;
+
     /*! \brief Returns a list of lanelets which are part of the route and whose downtrack bounds exist within the provided
     * start and end distances. 
     *
@@ -251,6 +291,21 @@ class WorldModel
     virtual lanelet::Optional<carma_perception_msgs::msg::RoadwayObstacle>
     toRoadwayObstacle(const carma_perception_msgs::msg::ExternalObject& object) const = 0;
 
+    /**
+     * \brief Converts a list of ExternalObjects into RoadwayObstacles. Gives the same result as calling toRoadwayObstacle
+     * on every object but splits the objects across threads, and seeds the lanelet search of each prediction with the
+     * lanelet of the previous one rather than querying the whole map.
+     *
+     * \param objects the external objects to convert
+     * \param max_threads the maximum number of threads, including the calling thread, used for the conversion
+     *
+     * \throw std::invalid_argument if the map is not set or contains no lanelets
+     *
+     * \return A RoadwayObstacleList containing the objects which are on the roadway in the order they were provided
+    */
+    virtual carma_perception_msgs::msg::RoadwayObstacleList
+    toRoadwayObstacles(const carma_perception_msgs::msg::ExternalObjectList& objects, size_t max_threads = 1) const = 0;
+
     /**
      * \brief Gets the a lanelet the object is currently on determined by its position on the semantic map. If it's
      * across multiple lanelets, get the closest one
@@ -363,6 +418,15 @@ class WorldModel
      */ 
     virtual size_t getMapVersion() const = 0;
 
+    /**
+     * \brief Returns a number which increases every time the map is set, including updates such as geofences which modify
+     *        the lanelets of the current map in place without changing the map version.
+     *        Data derived from the map can be reused for as long as this value and the map pointer are unchanged.
+     *
+     * \return map update count
+     */
+    virtual size_t getMapUpdateCount() const = 0;
+
     /**
      * \brief Gets the underlying lanelet, given the cartesian point on the map
      *
@@ -41,6 +41,13 @@ namespace carma_wm {
 
         typedef boost::geometry::model::point<double, 2, boost::geometry::cs::cartesian> point_t;
         typedef boost::geometry::model::polygon<point_t> polygon_t;
+        typedef boost::geometry::model::box<point_t> box_t;
+
+        // Maximum difference in seconds between an obstacle prediction and a trajectory point for them to be compared
+        constexpr double COLLISION_TIME_WINDOW = 5.0;
+
+        // Side length in meters of the uniform grid cells used by the WorldCollisionDetection broadphase
+        constexpr double BROADPHASE_CELL_SIZE = 5.0;
 
         //TODO: verify correctness of descriptions for each of these elements
         struct MovingObject {
@@ -56,12 +63,32 @@ namespace carma_wm {
 
         /*! \brief Main collision detection function to be called when needed to check for collision detection of the vehicle with 
         * the current trajectory plan and the current world objects
+        *
+        * The host footprint at each trajectory point is bucketed by time slice and uniform grid cell. Each obstacle prediction
+        * only visits the buckets its bounding box overlaps in neighboring time slices and is rejected by bounding box before
+        * the exact polygon intersection test. A prediction and trajectory point are compared if their times are within COLLISION_TIME_WINDOW.
+        *
+        * NOTE: An obstacle collides when its footprint at a prediction intersects the host footprint, oriented along the trajectory,
+        * at a trajectory point whose time is within COLLISION_TIME_WINDOW of the prediction in either direction. Earlier versions
+        * compared the center distance against the difference of the two sizes and matched every prediction earlier than COLLISION_TIME_WINDOW
+        * after a trajectory point.
+        *
+        * \param rwol The list of Roadway Obstacle
+        * \param tp The TrajectoryPlan of the host vehicle
         * \param size The size of the host vehicle defined in meters
+        * \return A list of obstacles the provided trajectory plan collides with. Each obstacle is reported at most once
+        */
+        std::vector<carma_perception_msgs::msg::RoadwayObstacle> WorldCollisionDetection(const carma_perception_msgs::msg::RoadwayObstacleList& rwol, 
+                                                                    const carma_planning_msgs::msg::TrajectoryPlan& tp, const geometry_msgs::msg::Vector3& size);
+
+        /*! \brief Overload of WorldCollisionDetection kept for existing callers. The host velocity is not used since the trajectory
+        * point times already describe the host motion
+        *
         * \param rwol The list of Roadway Obstacle
         * \param tp The TrajectoryPlan of the host vehicle
         * \param size The size of the host vehicle defined in meters
-        * \param velocity of the host vehicle m/s
-        * \return A list of obstacles the provided trajectory plan collides with
+        * \param velocity of the host vehicle m/s. Unused
+        * \return A list of obstacles the provided trajectory plan collides with. Each obstacle is reported at most once
         */
         std::vector<carma_perception_msgs::msg::RoadwayObstacle> WorldCollisionDetection(const carma_perception_msgs::msg::RoadwayObstacleList& rwol, 
                                                                     const carma_planning_msgs::msg::TrajectoryPlan& tp, const geometry_msgs::msg::Vector3& size, 
@@ -26,16 +26,69 @@
 #include <Eigen/Core>
 #include <Eigen/LU>
 #include <cmath>
+#include <limits>
 #include <lanelet2_core/geometry/Polygon.h>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/polygon.hpp>
 #include "carma_wm/Geometry.hpp"
-#include <queue>
+#include "carma_wm/ParallelFor.hpp"
+#include "carma_wm/MapCopy.hpp"
 #include <boost/math/special_functions/sign.hpp>
 #include <boost/date_time/posix_time/conversion.hpp>
+#include <unordered_set>
 
 namespace carma_wm
 {
+namespace
+{
+  // Smallest number of objects worth handing to a thread of their own when converting roadway obstacles
+  constexpr size_t MIN_OBJECTS_PER_THREAD = 4;
+
+  /*! \brief Returns the elements of a route regulatory element index whose downtrack is at or beyond the given
+   *         downtrack, in shortest path order
+   */
+  template <class Entry>
+  std::vector<decltype(Entry::element)> elementsAtOrBeyond(const std::vector<Entry>& entries, double downtrack)
+  {
+    // Every entry before the first whose running maximum reaches the downtrack is behind it
+    auto it = std::lower_bound(entries.begin(), entries.end(), downtrack,
+                               [](const Entry& entry, double value) { return entry.max_downtrack < value; });
+
+    std::vector<decltype(Entry::element)> elements;
+    for (; it != entries.end(); it++)
+    {
+      if (it->downtrack >= downtrack)
+        elements.push_back(it->element);
+    }
+
+    return elements;
+  }
+
+  /*! \brief Appends an entry to a route regulatory element index keeping the running maximum downtrack
+   */
+  template <class Entry>
+  void addRouteRegulatoryElement(std::vector<Entry>& entries, const decltype(Entry::element)& element, double downtrack)
+  {
+    Entry entry;
+    entry.element = element;
+    entry.downtrack = downtrack;
+    entry.max_downtrack = entries.empty() ? downtrack : std::max(entries.back().max_downtrack, downtrack);
+    entries.push_back(entry);
+  }
+
+  /*! \brief Returns the smallest distance from a centerline point of the lanelet to either of its bounds
+   */
+  double minHalfWidth(const lanelet::ConstLanelet& lanelet)
+  {
+    double half_width = std::numeric_limits<double>::infinity();
+    for (const auto& point : lanelet.centerline2d())
+    {
+      half_width = std::min(half_width, lanelet::geometry::distance2d(lanelet.leftBound2d(), point.basicPoint2d()));
+      half_width = std::min(half_width, lanelet::geometry::distance2d(lanelet.rightBound2d(), point.basicPoint2d()));
+    }
+    return half_width;
+  }
+}  // namespace
 
   std::pair<TrackPos, TrackPos> CARMAWorldModel::routeTrackPos(const lanelet::ConstArea& area) const
   {
@@ -55,12 +108,13 @@ namespace carma_wm
     TrackPos minPos(0, 0);
     TrackPos maxPos(0, 0);
     bool first = true;
+    RouteTrackPosCursor cursor; // Bound vertices are consecutive so each search can start from the last match
     for (lanelet::ConstLineString3d sub_bound3d : outer_bound)
     {
       auto sub_bound = lanelet::utils::to2D(sub_bound3d);
       for (lanelet::ConstPoint2d point : sub_bound)
       {
-        TrackPos tp = routeTrackPos(point);
+        TrackPos tp = routeTrackPos(point.basicPoint(), cursor);
         if (first)
         {
           minPos = maxPos = tp;
@@ -130,58 +184,99 @@ namespace carma_wm
       RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Route has not yet been loaded");
       return {};
     }
-    std::vector<lanelet::BusStopRulePtr> bus_stop_list;
-    auto curr_downtrack = routeTrackPos(loc).downtrack;
-    // shortpath is already sorted by distance
+    // Bus stops along the route are indexed by downtrack when the route is set
+    return elementsAtOrBeyond(route_regulatory_element_index_->bus_stops, routeTrackPos(loc).downtrack);
+  }
 
-    for (const auto &ll : route_->shortestPath())
+  TrackPos CARMAWorldModel::routeTrackPos(const lanelet::BasicPoint2d& point) const
+  {
+    // Check if the route was loaded yet
+    if (!route_)
     {
-      auto bus_stops = semantic_map_->laneletLayer.get(ll.id()).regulatoryElementsAs<lanelet::BusStopRule>();
-      if (bus_stops.empty())
+      throw std::invalid_argument("Route has not yet been loaded");
+    }
+
+    // Find the nearest continuos shortest path centerline segment using fast map nearest search
+    lanelet::Points3d near_points =
+        shortest_path_filtered_centerline_view_->pointLayer.nearest(point, 1);  // Find the nearest points
+
+    auto indexes = route_reference_line_->distance_map.getIndexFromId(near_points[0].id());
+
+    return routeTrackPosFromNearestPoint(point, indexes.first, indexes.second);
+  }
+
+  TrackPos CARMAWorldModel::routeTrackPos(const lanelet::BasicPoint2d& point, RouteTrackPosCursor& cursor) const
+  {
+    // Check if the route was loaded yet
+    if (!route_)
+    {
+      throw std::invalid_argument("Route has not yet been loaded");
+    }
+
+    if (cursor.route_version == route_version_ && cursor.linestring_index < route_reference_line_->centerlines.size())
+    {
+      const auto& linestring = route_reference_line_->centerlines[cursor.linestring_index];
+      size_t p_i = std::min(cursor.point_index, linestring.size() - 1);
+
+      // Walk along the reference line segment towards the vertex nearest to the point
+      auto sq_dist = [&linestring, &point](size_t i) {
+        return (linestring[i].basicPoint2d() - point).squaredNorm();
+      };
+      double cur_dist = sq_dist(p_i);
+      while (p_i + 1 < linestring.size() && sq_dist(p_i + 1) < cur_dist)
       {
-        continue;
+        p_i++;
+        cur_dist = sq_dist(p_i);
+      }
+      while (p_i > 0 && sq_dist(p_i - 1) < cur_dist)
+      {
+        p_i--;
+        cur_dist = sq_dist(p_i);
       }
 
-      for (auto bus_stop : bus_stops)
+      // The end points of a segment require checking the neighboring segments so those are left to the full search
+      if (p_i > 0 && p_i < linestring.size() - 1)
       {
-        auto stop_line = bus_stop->stopAndWaitLine();
-        if (stop_line.empty())
+        // A point further from the centerline than half the lane width may be in a neighboring lane whose centerline is
+        // nearer, so only points within the lanes of this segment are trusted
+        TrackPos tp = routeTrackPosFromNearestPoint(point, cursor.linestring_index, p_i);
+        if (std::fabs(tp.crosstrack) <= route_reference_line_->half_widths[cursor.linestring_index])
         {
-          RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "No stop line");
-          continue;
-        }
-        else
-        {
-          double bus_stop_downtrack = routeTrackPos(stop_line.front().front().basicPoint2d()).downtrack;
-          double distance_remaining_to_bus_stop = bus_stop_downtrack - curr_downtrack;
-
-          if (distance_remaining_to_bus_stop < 0)
-          {
-            continue;
-          }
-          bus_stop_list.push_back(bus_stop);
+          cursor.point_index = p_i;
+          return tp;
         }
       }
     }
-    return bus_stop_list;
+
+    // Fall back to the full search
+    lanelet::Points3d near_points = shortest_path_filtered_centerline_view_->pointLayer.nearest(point, 1);
+    auto indexes = route_reference_line_->distance_map.getIndexFromId(near_points[0].id());
+
+    cursor.route_version = route_version_;
+    cursor.linestring_index = indexes.first;
+    cursor.point_index = indexes.second;
+
+    return routeTrackPosFromNearestPoint(point, indexes.first, indexes.second);
   }
 
-  TrackPos CARMAWorldModel::routeTrackPos(const lanelet::BasicPoint2d& point) const
+  std::vector<TrackPos> CARMAWorldModel::routeTrackPos(const std::vector<lanelet::BasicPoint2d>& points) const
   {
-    // Check if the route was loaded yet
-    if (!route_)
+    std::vector<TrackPos> output;
+    output.reserve(points.size());
+
+    RouteTrackPosCursor cursor;
+    for (const auto& point : points)
     {
-      throw std::invalid_argument("Route has not yet been loaded");
+      output.push_back(routeTrackPos(point, cursor));
     }
 
-    // Find the nearest continuos shortest path centerline segment using fast map nearest search
-    lanelet::Points3d near_points =
-        shortest_path_filtered_centerline_view_->pointLayer.nearest(point, 1);  // Find the nearest points
+    return output;
+  }
 
-    // Match point with linestring using fast map lookup
-    auto lineString_1 =
-        lanelet::utils::to2D(shortest_path_filtered_centerline_view_->lineStringLayer.findUsages(near_points[0])
-                                 .front());  // Only need the first index due to nature of route centerline
+  TrackPos CARMAWorldModel::routeTrackPosFromNearestPoint(const lanelet::BasicPoint2d& point, size_t ls_i, size_t p_i) const
+  {
+    // Match point with linestring using fast index lookup
+    auto lineString_1 = lanelet::utils::to2D(route_reference_line_->centerlines[ls_i]);
 
     if (lineString_1.size() == 0)
     {
@@ -205,11 +300,7 @@ namespace carma_wm
     TrackPos tp(0, 0);
     // Check for end cases
 
-    auto indexes = shortest_path_distance_map_.getIndexFromId(near_points[0].id());
-    size_t ls_i = indexes.first;
-    size_t p_i = indexes.second;
-
-    if (near_points[0].id() == lineString_1.front().id())
+    if (p_i == 0)
     {  // Nearest point is at the start of a line string
       // Get start point of cur segment and add 1
       auto next_point = lineString_1[1];
@@ -226,14 +317,14 @@ namespace carma_wm
         // If downtrack is negative then iterate over route segments to find preceeding segment
         const size_t prev_ls_i = ls_i - 1;
 
-        auto prev_centerline = lanelet::utils::to2D(shortest_path_centerlines_[prev_ls_i]);  // Get prev centerline
+        auto prev_centerline = lanelet::utils::to2D(route_reference_line_->centerlines[prev_ls_i]);  // Get prev centerline
         tp = geometry::trackPos(point, prev_centerline[prev_centerline.size() - 2].basicPoint(),
                                 prev_centerline[prev_centerline.size() - 1].basicPoint());
-        tp.downtrack += shortest_path_distance_map_.distanceToPointAlongElement(prev_ls_i, prev_centerline.size() - 2);
+        tp.downtrack += route_reference_line_->distance_map.distanceToPointAlongElement(prev_ls_i, prev_centerline.size() - 2);
         bestRouteSegId = prev_centerline.id();
       }
     }
-    else if (near_points[0].id() == lineString_1.back().id())
+    else if (p_i == lineString_1.size() - 1)
     {  // Nearest point is the end of a line string
 
       // Get end point of cur segment and subtract 1
@@ -243,19 +334,19 @@ namespace carma_wm
       TrackPos tp_prev = geometry::trackPos(point, prev_prev_point.basicPoint(), prev_point.basicPoint());
 
       double last_seg_length =
-          shortest_path_distance_map_.distanceBetween(ls_i, lineString_1.size() - 2, lineString_1.size() - 1);
+          route_reference_line_->distance_map.distanceBetween(ls_i, lineString_1.size() - 2, lineString_1.size() - 1);
 
-      if (tp_prev.downtrack < last_seg_length || ls_i == shortest_path_centerlines_.size() - 1)
+      if (tp_prev.downtrack < last_seg_length || ls_i == route_reference_line_->centerlines.size() - 1)
       {
         // If downtrack is less then seg length then we are on the correct segment
         bestRouteSegId = lineString_1.id();
         tp = tp_prev;
-        tp.downtrack += shortest_path_distance_map_.distanceToPointAlongElement(ls_i, lineString_1.size() - 2);
+        tp.downtrack += route_reference_line_->distance_map.distanceToPointAlongElement(ls_i, lineString_1.size() - 2);
       }
       else
       {
         // If downtrack is greater then seg length then we need to find the succeeding segment
-        auto next_centerline = lanelet::utils::to2D(shortest_path_centerlines_[ls_i + 1]);  // Get prev centerline
+        auto next_centerline = lanelet::utils::to2D(route_reference_line_->centerlines[ls_i + 1]);  // Get prev centerline
         tp = geometry::trackPos(point, next_centerline[0].basicPoint(), next_centerline[1].basicPoint());
         bestRouteSegId = next_centerline.id();
       }
@@ -263,7 +354,7 @@ namespace carma_wm
     else
     {  // The nearest point is in the middle of a line string
       // Graph the two bounding points on the line string and call matchSegment using a 3 element segment
-      // There is a guarantee from the earlier if statements that near_points[0] will always be located at an index within
+      // There is a guarantee from the earlier if statements that the nearest point will always be located at an index within
       // the exclusive range (0,lineString_1.size() - 1) so no need for range checks
 
       lanelet::BasicLineString2d subSegment = lanelet::BasicLineString2d(
@@ -271,37 +362,18 @@ namespace carma_wm
 
       tp = std::get<0>(geometry::matchSegment(point, subSegment));  // Get track pos along centerline
 
-      tp.downtrack += shortest_path_distance_map_.distanceToPointAlongElement(ls_i, p_i - 1);
+      tp.downtrack += route_reference_line_->distance_map.distanceToPointAlongElement(ls_i, p_i - 1);
 
       bestRouteSegId = lineString_1.id();
     }
 
     // Accumulate distance
-    auto bestRouteSegIndex = shortest_path_distance_map_.getIndexFromId(bestRouteSegId);
-    tp.downtrack += shortest_path_distance_map_.distanceToElement(bestRouteSegIndex.first);
+    auto bestRouteSegIndex = route_reference_line_->distance_map.getIndexFromId(bestRouteSegId);
+    tp.downtrack += route_reference_line_->distance_map.distanceToElement(bestRouteSegIndex.first);
 
     return tp;
   }
 
-  class LaneletDowntrackPair
-  {
-  public:
-    lanelet::ConstLanelet lanelet_;
-    double downtrack_ = 0;
-
-    LaneletDowntrackPair(lanelet::ConstLanelet lanelet, double downtrack) : lanelet_(lanelet), downtrack_(downtrack)
-    {
-    }
-    bool operator<(const LaneletDowntrackPair& pair) const
-    {
-      return this->downtrack_ < pair.downtrack_;
-    }
-    bool operator>(const LaneletDowntrackPair& pair) const
-    {
-      return this->downtrack_ > pair.downtrack_;
-    }
-  };
-
   std::vector<lanelet::ConstLanelet> CARMAWorldModel::getLaneletsBetween(double start, double end, bool shortest_path_only,
                                                                          bool bounds_inclusive) const
   {
@@ -315,28 +387,36 @@ namespace carma_wm
       throw std::invalid_argument("Start distance is greater than end distance");
     }
 
-    std::vector<lanelet::ConstLanelet> output;
-    std::priority_queue<LaneletDowntrackPair, std::vector<LaneletDowntrackPair>, std::greater<LaneletDowntrackPair>>
-        prioritized_lanelets;
+    // Any interval which intersects [start, end] must begin no earlier than start - the longest interval length
+    // and no later than end. The small padding keeps the window a superset of the exact checks below.
+    constexpr double window_padding = 0.001;
+    double window_start = start - route_lanelet_index_->max_interval_length - window_padding;
+    double window_end = end + window_padding;
 
-    auto lanelet_map = route_->laneletMap();
-    for (lanelet::ConstLanelet lanelet : lanelet_map->laneletLayer)
+    auto first = std::lower_bound(route_lanelet_index_->intervals.begin(), route_lanelet_index_->intervals.end(), window_start,
+                                  [](const LaneletDowntrackInterval& interval, double downtrack) {
+                                    return interval.start_downtrack < downtrack;
+                                  });
+    auto last = std::upper_bound(first, route_lanelet_index_->intervals.end(), window_end,
+                                 [](double downtrack, const LaneletDowntrackInterval& interval) {
+                                   return downtrack < interval.start_downtrack;
+                                 });
+
+    std::vector<const LaneletDowntrackInterval*> matches;
+    for (auto it = first; it != last; ++it)
     {
-      if (shortest_path_only && !shortest_path_view_->laneletLayer.exists(lanelet.id()))
+      if (shortest_path_only && it->shortest_path_index < 0)
       {
         continue;  // Continue if we are only evaluating the shortest path and this lanelet is not part of it
       }
-      lanelet::ConstLineString2d centerline = lanelet::utils::to2D(lanelet.centerline());
 
-      auto front = centerline.front();
-      auto back = centerline.back();
-      TrackPos min = routeTrackPos(front);
-      TrackPos max = routeTrackPos(back);
+      double min = it->start_downtrack;
+      double max = it->end_downtrack;
 
       if (!bounds_inclusive) // reduce bounds slightly to avoid including exact bounds
       {
-        if (std::max(min.downtrack, start + 0.00001) > std::min(max.downtrack, end - 0.00001)
-          || (start == end && (min.downtrack >= start || max.downtrack <= end)))
+        if (std::max(min, start + 0.00001) > std::min(max, end - 0.00001)
+          || (start == end && (min >= start || max <= end)))
         {  // Check for 1d intersection
           // No intersection so continue
           continue;
@@ -344,46 +424,34 @@ namespace carma_wm
       }
       else
       {
-        if (std::max(min.downtrack, start) > std::min(max.downtrack, end)
-          || (start == end && (min.downtrack > start || max.downtrack < end)))
+        if (std::max(min, start) > std::min(max, end)
+          || (start == end && (min > start || max < end)))
         {  // Check for 1d intersection
           // No intersection so continue
           continue;
         }
       }
       // Intersection has occurred so add lanelet to list
-      LaneletDowntrackPair pair(lanelet, min.downtrack);
-      prioritized_lanelets.push(pair);
+      matches.push_back(&(*it));
     }
 
-    output.reserve(prioritized_lanelets.size());
-    while (!prioritized_lanelets.empty())
+    //Sort lanelets according to shortest path if using shortest path. Otherwise they are already sorted by downtrack
+    if (shortest_path_only)
     {
-      auto pair = prioritized_lanelets.top();
-      prioritized_lanelets.pop();
-      output.push_back(pair.lanelet_);
+      std::sort(matches.begin(), matches.end(),
+                [](const LaneletDowntrackInterval* a, const LaneletDowntrackInterval* b) {
+                  return a->shortest_path_index < b->shortest_path_index;
+                });
     }
 
-    if (!shortest_path_only)
-    {
-      return output;
-    }
-
-    //Sort lanelets according to shortest path if using shortest path
-    std::vector<lanelet::ConstLanelet> sorted_output;
-    for (auto llt : route_->shortestPath())
+    std::vector<lanelet::ConstLanelet> output;
+    output.reserve(matches.size());
+    for (const auto* interval : matches)
     {
-      for (size_t i = 0; i < output.size(); i++)
-      {
-        if (llt.id() == output[i].id())
-        {
-          sorted_output.push_back(llt);
-          break;
-        }
-      }
+      output.push_back(interval->lanelet);
     }
 
-    return sorted_output;
+    return output;
   }
 
   std::vector<lanelet::BasicPoint2d> CARMAWorldModel::sampleRoutePoints(double start_downtrack, double end_downtrack,
@@ -447,18 +515,18 @@ namespace carma_wm
     }
 
     // Use fast lookup to identify the points before and after the provided downtrack on the route
-    auto indices = shortest_path_distance_map_.getElementIndexByDistance(downtrack, true); // Get the linestring matching the provided downtrack
+    auto indices = route_reference_line_->distance_map.getElementIndexByDistance(downtrack, true); // Get the linestring matching the provided downtrack
     size_t ls_i = std::get<0>(indices);
     size_t pt_i = std::get<1>(indices);
 
-    auto linestring = shortest_path_centerlines_[ls_i];
+    auto linestring = route_reference_line_->centerlines[ls_i];
 
     if (pt_i >= linestring.size())
     {
       throw std::invalid_argument("Impossible index: pt: " + std::to_string(pt_i) + " linestring: " + std::to_string(ls_i));
     }
 
-    double ls_downtrack = shortest_path_distance_map_.distanceToElement(ls_i);
+    double ls_downtrack = route_reference_line_->distance_map.distanceToElement(ls_i);
 
     double relative_downtrack = downtrack - ls_downtrack;
 
@@ -506,8 +574,8 @@ namespace carma_wm
       return lanelet::BasicPoint2d(x + delta_x, y + delta_y);
     }
 
-    double prior_downtrack = shortest_path_distance_map_.distanceToPointAlongElement(ls_i, prior_idx);
-    double next_downtrack = shortest_path_distance_map_.distanceToPointAlongElement(ls_i, next_idx);
+    double prior_downtrack = route_reference_line_->distance_map.distanceToPointAlongElement(ls_i, prior_idx);
+    double next_downtrack = route_reference_line_->distance_map.distanceToPointAlongElement(ls_i, next_idx);
 
     double prior_to_next_dist = next_downtrack - prior_downtrack;
     double prior_to_target_dist = relative_downtrack - prior_downtrack;
@@ -571,8 +639,17 @@ namespace carma_wm
       recompute_routing_graph = true;
     }
 
+    bool map_replaced = semantic_map_ != map;
+
     semantic_map_ = map;
     map_version_ = map_version;
+    map_update_count_++;
+
+    // Signals may have been replaced by the new map so their SPaT timing is moved onto the new signals
+    if (!traffic_signal_copies_->empty())
+    {
+      rebaseTrafficSignalCopies();
+    }
 
     // If the routing graph should be updated then recompute it
     if (recompute_routing_graph)
@@ -594,6 +671,14 @@ namespace carma_wm
 
       RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm"), "Done building routing graph");
     }
+
+    roadway_objects_ = computeRoadwayObjectIndex(roadway_objects_->objects); // Adjacent lanelets of the roadway objects may have changed
+
+    // Only map updates which change the regulatory elements of the route require the route index to be recomputed
+    if (route_ && (map_replaced || routeRegulatoryElementsChanged()))
+    {
+      computeRouteRegulatoryElementIndex();
+    }
   }
 
   void CARMAWorldModel::setRoutingGraph(LaneletRoutingGraphPtr graph) {
@@ -601,6 +686,8 @@ namespace carma_wm
     RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm"), "Setting the routing graph with user or listener provided graph");
 
     map_routing_graph_ = graph;
+
+    roadway_objects_ = computeRoadwayObjectIndex(roadway_objects_->objects); // Adjacent lanelets of the roadway objects may have changed
   }
 
   size_t CARMAWorldModel::getMapVersion() const
@@ -608,6 +695,11 @@ namespace carma_wm
     return map_version_;
   }
 
+  size_t CARMAWorldModel::getMapUpdateCount() const
+  {
+    return map_update_count_;
+  }
+
   lanelet::LaneletMapPtr CARMAWorldModel::getMutableMap() const
   {
     return semantic_map_;
@@ -626,9 +718,12 @@ namespace carma_wm
   void CARMAWorldModel::setRoute(LaneletRoutePtr route)
   {
     route_ = route;
+    route_version_++; // Invalidate any outstanding RouteTrackPosCursor objects
     lanelet::ConstLanelets path_lanelets(route_->shortestPath().begin(), route_->shortestPath().end());
     shortest_path_view_ = lanelet::utils::createConstSubmap(path_lanelets, {});
     computeDowntrackReferenceLine();
+    computeLaneletDowntrackIndex();
+    computeRouteRegulatoryElementIndex();
     // NOTE: Setting the route_length_ field here will likely result in the final lanelets final point being used. Call setRouteEndPoint to use the destination point value
     route_length_ = routeTrackPos(route_->getEndPoint().basicPoint2d()).downtrack;  // Cache the route length with
                                                                                    // consideration for endpoint
@@ -685,6 +780,7 @@ namespace carma_wm
 
     std::vector<lanelet::LineString3d> lineStrings;  // List of continuos line strings representing segments of the route
                                                     // reference line
+    std::vector<double> halfWidths;  // Smallest lanelet half width of each line string
 
     bool first = true;
     size_t next_index = 0;
@@ -695,6 +791,7 @@ namespace carma_wm
       if (first)
       {  // For the first lanelet store its centerline and length
         lineStrings.push_back(copyConstructLineString(ll.centerline()));
+        halfWidths.push_back(minHalfWidth(ll));
         first = false;
       }
       if (next_index < shortest_path.size())
@@ -716,6 +813,7 @@ namespace carma_wm
             throw std::invalid_argument("Cannot process route with lanelet containing very short centerline");
           }
           lineStrings.back().insert(lineStrings.back().end(), nextCenterline.begin() + offset, nextCenterline.end());
+          halfWidths.back() = std::min(halfWidths.back(), minHalfWidth(nextLanelet));
         }
         else if (connectionCount == 0)
         {
@@ -728,6 +826,7 @@ namespace carma_wm
           empty_linestring.setId(lanelet::utils::getId());
           distance_map.pushBack(lanelet::utils::to2D(lineStrings.back()));
           lineStrings.push_back(empty_linestring);
+          halfWidths.push_back(std::numeric_limits<double>::infinity());
         }
         else
         {
@@ -737,20 +836,177 @@ namespace carma_wm
     }
     // Copy values to member variables
     while (lineStrings.back().size() == 0)
+    {
       lineStrings.pop_back();  // clear empty linestrings that was never used in the end
-    shortest_path_centerlines_ = lineStrings;
-    shortest_path_distance_map_ = distance_map;
+      halfWidths.pop_back();
+    }
+    auto reference_line = std::make_shared<RouteReferenceLine>();
+    reference_line->centerlines = lineStrings;
+    reference_line->half_widths = halfWidths;
+    reference_line->distance_map = distance_map;
 
     // Add length of final sections
-    if (shortest_path_centerlines_.size() > shortest_path_distance_map_.size())
+    if (reference_line->centerlines.size() > reference_line->distance_map.size())
     {
-      shortest_path_distance_map_.pushBack(lanelet::utils::to2D(lineStrings.back()));  // Record length of last continuous
-                                                                                      // segment
+      reference_line->distance_map.pushBack(lanelet::utils::to2D(lineStrings.back()));  // Record length of last continuous
+                                                                                       // segment
     }
 
+    route_reference_line_ = reference_line;
+
     // Since our copy constructed linestrings do not contain references to lanelets they can be added to a full map
     // instead of a submap
-    shortest_path_filtered_centerline_view_ = lanelet::utils::createMap(shortest_path_centerlines_);
+    shortest_path_filtered_centerline_view_ = lanelet::utils::createMap(route_reference_line_->centerlines);
+  }
+
+  void CARMAWorldModel::computeLaneletDowntrackIndex()
+  {
+    std::unordered_map<lanelet::Id, int> shortest_path_indices;
+    int path_index = 0;
+    for (const auto& ll : route_->shortestPath())
+    {
+      shortest_path_indices.emplace(ll.id(), path_index);
+      path_index++;
+    }
+
+    std::vector<LaneletDowntrackInterval> intervals;
+    intervals.reserve(route_->laneletMap()->laneletLayer.size());
+    double max_length = 0;
+
+    for (lanelet::ConstLanelet lanelet : route_->laneletMap()->laneletLayer)
+    {
+      lanelet::ConstLineString2d centerline = lanelet::utils::to2D(lanelet.centerline());
+
+      LaneletDowntrackInterval interval;
+      interval.lanelet = lanelet;
+      interval.start_downtrack = routeTrackPos(centerline.front()).downtrack;
+      interval.end_downtrack = routeTrackPos(centerline.back()).downtrack;
+
+      auto path_it = shortest_path_indices.find(lanelet.id());
+      if (path_it != shortest_path_indices.end())
+      {
+        interval.shortest_path_index = path_it->second;
+      }
+
+      max_length = std::max(max_length, interval.end_downtrack - interval.start_downtrack);
+      intervals.push_back(interval);
+    }
+
+    std::stable_sort(intervals.begin(), intervals.end(),
+                     [](const LaneletDowntrackInterval& a, const LaneletDowntrackInterval& b) {
+                       return a.start_downtrack < b.start_downtrack;
+                     });
+
+    auto index = std::make_shared<RouteLaneletIndex>();
+    index->intervals = std::move(intervals);
+    index->max_interval_length = max_length;
+    route_lanelet_index_ = index;
+  }
+
+  void CARMAWorldModel::computeRouteRegulatoryElementIndex()
+  {
+    auto index = std::make_shared<RouteRegulatoryElementIndex>();
+
+    if (!route_ || !semantic_map_)
+    {
+      route_regulatory_element_index_ = index;
+      return;
+    }
+
+    // shortpath is already sorted by distance
+    for (const auto& ll : route_->shortestPath())
+    {
+      index->shortest_path_indices.emplace(ll.id(), index->lanelet_regulatory_elements.size());
+
+      auto map_llt_it = semantic_map_->laneletLayer.find(ll.id());
+
+      if (map_llt_it == semantic_map_->laneletLayer.end())
+      {
+        index->lanelet_regulatory_elements.emplace_back();
+        continue;
+      }
+
+      lanelet::Lanelet map_llt = *map_llt_it;
+      index->lanelet_regulatory_elements.push_back(map_llt.regulatoryElements());
+
+      for (const auto& light : map_llt.regulatoryElementsAs<lanelet::CarmaTrafficSignal>())
+      {
+        auto stop_line = light->getStopLine(ll);
+        if (!stop_line)
+        {
+          RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "No stop line");
+          continue;
+        }
+
+        addRouteRegulatoryElement(index->signals, light, routeTrackPos(stop_line.get().front().basicPoint2d()).downtrack);
+      }
+
+      for (const auto& bus_stop : map_llt.regulatoryElementsAs<lanelet::BusStopRule>())
+      {
+        auto stop_line = bus_stop->stopAndWaitLine();
+        if (stop_line.empty())
+        {
+          RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "No stop line");
+          continue;
+        }
+
+        addRouteRegulatoryElement(index->bus_stops, bus_stop, routeTrackPos(stop_line.front().front().basicPoint2d()).downtrack);
+      }
+
+      for (const auto& intersection : map_llt.regulatoryElementsAs<lanelet::AllWayStop>())
+      {
+        addRouteRegulatoryElement(index->all_way_stops, intersection,
+                                  routeTrackPos(intersection->stopLines().front().front().basicPoint2d()).downtrack);
+      }
+
+      auto signalized_intersections = map_llt.regulatoryElementsAs<lanelet::SignalizedIntersection>();
+      if (!signalized_intersections.empty())
+      {
+        double intersection_downtrack = routeTrackPos(ll.centerline().back().basicPoint2d()).downtrack;
+
+        for (const auto& intersection : signalized_intersections)
+        {
+          addRouteRegulatoryElement(index->signalized_intersections, intersection, intersection_downtrack);
+        }
+      }
+    }
+
+    route_regulatory_element_index_ = index;
+  }
+
+  bool CARMAWorldModel::routeRegulatoryElementsChanged() const
+  {
+    if (!route_ || !semantic_map_)
+    {
+      return false;
+    }
+
+    const auto& route_lanelet_regulatory_elements = route_regulatory_element_index_->lanelet_regulatory_elements;
+
+    size_t path_index = 0;
+    for (const auto& ll : route_->shortestPath())
+    {
+      if (path_index >= route_lanelet_regulatory_elements.size())
+      {
+        return true;
+      }
+
+      auto map_llt_it = semantic_map_->laneletLayer.find(ll.id());
+
+      if (map_llt_it == semantic_map_->laneletLayer.end())
+      {
+        if (!route_lanelet_regulatory_elements[path_index].empty())
+          return true;
+      }
+      else if (lanelet::Lanelet(*map_llt_it).regulatoryElements() != route_lanelet_regulatory_elements[path_index])
+      {
+        return true;
+      }
+
+      path_index++;
+    }
+
+    return path_index != route_lanelet_regulatory_elements.size();
   }
 
   LaneletRoutingGraphConstPtr CARMAWorldModel::getMapRoutingGraph() const
@@ -798,14 +1054,125 @@ namespace carma_wm
       throw std::invalid_argument("Map is not set or does not contain lanelets");
     }
 
-    lanelet::BasicPoint2d object_center(object.pose.pose.position.x, object.pose.pose.position.y);
+    ObjectLaneletMatch match = matchObjectLanelets(object);
 
-    auto nearestLaneletBoost = getIntersectingLanelet(object);
-
-    if (!nearestLaneletBoost)
+    if (!match.object_lanelet)
       return boost::none;
 
-    lanelet::Lanelet nearestLanelet = nearestLaneletBoost.get();
+    return toRoadwayObstacle(object, match);
+  }
+
+  carma_perception_msgs::msg::RoadwayObstacleList
+  CARMAWorldModel::toRoadwayObstacles(const carma_perception_msgs::msg::ExternalObjectList& objects,
+                                      size_t max_threads) const
+  {
+    if (!semantic_map_ || semantic_map_->laneletLayer.size() == 0)
+    {
+      throw std::invalid_argument("Map is not set or does not contain lanelets");
+    }
+
+    // Only lanelet polygons are evaluated while matching so objects can be matched concurrently
+    std::vector<ObjectLaneletMatch> matches(objects.objects.size());
+
+    parallelFor(objects.objects.size(), max_threads, MIN_OBJECTS_PER_THREAD, [&](size_t i) {
+      matches[i] = matchObjectLanelets(objects.objects[i]);
+    });
+
+    // Lanelets compute and cache their centerline on first access, which is not thread safe. Compute the centerlines of
+    // every matched lanelet once before the track positions are computed concurrently
+    std::unordered_set<lanelet::Id> warmed_lanelets;
+    for (const auto& match : matches)
+    {
+      if (!match.object_lanelet)
+        continue;
+
+      if (warmed_lanelets.insert(match.object_lanelet->id()).second)
+        match.object_lanelet->centerline();
+
+      for (const auto& llt : match.prediction_lanelets)
+      {
+        if (warmed_lanelets.insert(llt.id()).second)
+          llt.centerline();
+      }
+    }
+
+    std::vector<lanelet::Optional<carma_perception_msgs::msg::RoadwayObstacle>> obstacles(objects.objects.size());
+
+    parallelFor(objects.objects.size(), max_threads, MIN_OBJECTS_PER_THREAD, [&](size_t i) {
+      if (matches[i].object_lanelet)
+        obstacles[i] = toRoadwayObstacle(objects.objects[i], matches[i]);
+    });
+
+    carma_perception_msgs::msg::RoadwayObstacleList obstacle_list;
+    obstacle_list.roadway_obstacles.reserve(objects.objects.size());
+
+    for (auto& obstacle : obstacles)
+    {
+      if (obstacle)
+        obstacle_list.roadway_obstacles.emplace_back(std::move(obstacle.get()));
+    }
+
+    return obstacle_list;
+  }
+
+  CARMAWorldModel::ObjectLaneletMatch
+  CARMAWorldModel::matchObjectLanelets(const carma_perception_msgs::msg::ExternalObject& object) const
+  {
+    ObjectLaneletMatch match;
+
+    auto intersecting_lanelet = getIntersectingLanelet(object);
+
+    if (!intersecting_lanelet)
+      return match;
+
+    match.object_lanelet = lanelet::ConstLanelet(intersecting_lanelet.get());
+    match.prediction_lanelets.reserve(object.predictions.size());
+
+    lanelet::ConstLanelet seed = match.object_lanelet.get();
+
+    for (const auto& prediction : object.predictions)
+    {
+      lanelet::BasicPoint2d prediction_center(prediction.predicted_position.position.x,
+                                              prediction.predicted_position.position.y);
+
+      // Predictions usually stay in the lanelet of the previous prediction or move on to one of its successors
+      lanelet::Optional<lanelet::ConstLanelet> pred_lanelet;
+
+      if (boost::geometry::within(prediction_center, seed.polygon2d().basicPolygon()))
+      {
+        pred_lanelet = seed;
+      }
+      else if (map_routing_graph_)
+      {
+        for (const auto& successor : map_routing_graph_->following(seed, false))
+        {
+          if (boost::geometry::within(prediction_center, successor.polygon2d().basicPolygon()))
+          {
+            pred_lanelet = successor;
+            break;
+          }
+        }
+      }
+
+      if (!pred_lanelet)
+      {
+        pred_lanelet = lanelet::ConstLanelet(semantic_map_->laneletLayer.nearest(prediction_center, 1)[0]);
+      }
+
+      match.prediction_lanelets.push_back(pred_lanelet.get());
+      seed = pred_lanelet.get();
+    }
+
+    return match;
+  }
+
+  carma_perception_msgs::msg::RoadwayObstacle
+  CARMAWorldModel::toRoadwayObstacle(const carma_perception_msgs::msg::ExternalObject& object,
+                                     const ObjectLaneletMatch& match) const
+  {
+    lanelet::BasicPoint2d object_center(object.pose.pose.position.x, object.pose.pose.position.y);
+
+    const lanelet::ConstLanelet& nearestLanelet = match.object_lanelet.get();
 
     carma_perception_msgs::msg::RoadwayObstacle obs;
     obs.object = object;
@@ -817,24 +1184,22 @@ namespace carma_wm
     obs.down_track = obj_track_pos.downtrack;
     obs.cross_track = obj_track_pos.crosstrack;
 
-    for (auto prediction : object.predictions)
+    for (size_t i = 0; i < object.predictions.size(); i++)
     {
-      // Compute prediction polygon
-      lanelet::BasicPolygon2d prediction_polygon =
-          geometry::objectToMapPolygon(prediction.predicted_position, object.size);
+      const auto& prediction = object.predictions[i];
+      const auto& predNearestLanelet = match.prediction_lanelets[i];
+
       lanelet::BasicPoint2d prediction_center(prediction.predicted_position.position.x,
                                               prediction.predicted_position.position.y);
 
-      auto predNearestLanelet = semantic_map_->laneletLayer.nearest(prediction_center, 1)[0];
-
       carma_wm::TrackPos pred_track_pos = geometry::trackPos(predNearestLanelet, prediction_center);
 
       obs.predicted_lanelet_ids.emplace_back(predNearestLanelet.id());
       obs.predicted_cross_tracks.emplace_back(pred_track_pos.crosstrack);
       obs.predicted_down_tracks.emplace_back(pred_track_pos.downtrack);
 
-      // Since the predictions are having their lanelet ids matched based on the nearest nounding box search rather than
-      // checking for intersection The id confidence will be set to 90% of the position confidence
+      // Since the predictions are having their lanelet ids matched based on containment of their center or the nearest
+      // bounding box search rather than checking for intersection The id confidence will be set to 90% of the position confidence
       obs.predicted_lanelet_id_confidences.emplace_back(0.9 * prediction.predicted_position_confidence);
       obs.predicted_cross_track_confidences.emplace_back(0.9 * prediction.predicted_position_confidence);
       obs.predicted_down_track_confidences.emplace_back(0.9 * prediction.predicted_position_confidence);
@@ -845,84 +1210,134 @@ namespace carma_wm
 
   void CARMAWorldModel::setRoadwayObjects(const std::vector<carma_perception_msgs::msg::RoadwayObstacle>& rw_objs)
   {
-    roadway_objects_ = rw_objs;
+    roadway_objects_ = computeRoadwayObjectIndex(rw_objs);
   }
 
-  std::vector<carma_perception_msgs::msg::RoadwayObstacle> CARMAWorldModel::getRoadwayObjects() const
+  std::shared_ptr<const CARMAWorldModel::RoadwayObjects>
+  CARMAWorldModel::computeRoadwayObjectIndex(std::vector<carma_perception_msgs::msg::RoadwayObstacle> objects) const
   {
-    return roadway_objects_;
-  }
+    auto roadway_objects = std::make_shared<RoadwayObjects>();
+    roadway_objects->objects = std::move(objects);
 
-  std::vector<carma_perception_msgs::msg::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const lanelet::ConstLanelet& lanelet,
-                                                                           const LaneSection& section) const
-  {
-    // Get all lanelets on current lane section
-    std::vector<lanelet::ConstLanelet> lane = getLane(lanelet, section);
+    auto& lanelet_object_index = roadway_objects->lanelet_index;
 
-    // Check if any roadway object is registered
-    if (roadway_objects_.size() == 0)
+    for (size_t i = 0; i < roadway_objects->objects.size(); i++)
     {
-      return std::vector<carma_perception_msgs::msg::RoadwayObstacle>{};
-    }
+      const auto& obj = roadway_objects->objects[i];
 
-    // Initialize useful variables
-    std::vector<carma_perception_msgs::msg::RoadwayObstacle> lane_objects, roadway_objects_copy = roadway_objects_;
+      lanelet_object_index[obj.lanelet_id].push_back({ i, false });
 
-    /*
-   * Get all in lane objects
-   * For each lane, we check if each object is on it by matching lanelet_id
-   * Complexity N*K, where N: num of lanelets, K: num of objects
-   */
-    int curr_idx;
-    std::queue<int> obj_idxs_queue;
+      if (!semantic_map_ || !map_routing_graph_)
+      {
+        continue;
+      }
 
-    // Create an index queue for roadway objects to quickly pop the idx if associated
-    // lanelet is found. This is to reduce number of objects to check as we check new lanelets
-    for (size_t i = 0; i < roadway_objects_copy.size(); i++)
-    {
-      obj_idxs_queue.push((int)i);
-    }
+      auto obj_llt_it = semantic_map_->laneletLayer.find(obj.lanelet_id);
 
-    // check each lanelets
-    for (auto llt : lane)
-    {
-      int checked_queue_items = 0, to_check = obj_idxs_queue.size();
-      // check each objects
-      while (checked_queue_items < to_check)
+      if (obj_llt_it == semantic_map_->laneletLayer.end())
       {
-        curr_idx = obj_idxs_queue.front();
-        obj_idxs_queue.pop();
-        checked_queue_items++;
+        continue;
+      }
 
-        // Check if the object is in the lanelet
-        auto curr_obj = roadway_objects_copy[curr_idx];
-        if (curr_obj.lanelet_id == llt.id())
+      lanelet::ConstLanelet obj_llt = *obj_llt_it;
+
+      // An object on a lanelet is also in lane for a neighboring lanelet if the object's lanelet is the left or right
+      // lanelet of that neighbor and the object intersects it, since the object may be lane changing.
+      // Every such neighbor is adjacent to the object's lanelet so only those need to be checked
+      lanelet::Optional<lanelet::BasicPolygon2d> object_polygon;
+
+      for (const auto& neighbor : { map_routing_graph_->left(obj_llt), map_routing_graph_->adjacentLeft(obj_llt),
+                                    map_routing_graph_->right(obj_llt), map_routing_graph_->adjacentRight(obj_llt) })
+      {
+        if (!neighbor)
         {
-          // found intersecting lanelet for this object
-          lane_objects.push_back(curr_obj);
+          continue;
         }
-        // handle a case where an object might be lane-changing, so check adjacent ids
-        // a bit faster than checking intersection solely as && is left-to-right evaluation
-        else if (((map_routing_graph_->left(llt) && curr_obj.lanelet_id == map_routing_graph_->left(llt).get().id()) ||
-                  (map_routing_graph_->right(llt) && curr_obj.lanelet_id == map_routing_graph_->right(llt).get().id())) &&
-                 boost::geometry::intersects(
-                     llt.polygon2d().basicPolygon(),
-                     geometry::objectToMapPolygon(curr_obj.object.pose.pose, curr_obj.object.size)))
+
+        auto neighbor_left = map_routing_graph_->left(neighbor.get());
+        auto neighbor_right = map_routing_graph_->right(neighbor.get());
+
+        if (!((neighbor_left && neighbor_left.get().id() == obj.lanelet_id) ||
+              (neighbor_right && neighbor_right.get().id() == obj.lanelet_id)))
         {
-          // found intersecting lanelet for this object
-          lane_objects.push_back(curr_obj);
+          continue;
         }
-        else
+
+        if (!object_polygon)
+        {
+          object_polygon = geometry::objectToMapPolygon(obj.object.pose.pose, obj.object.size);
+        }
+
+        if (boost::geometry::intersects(neighbor.get().polygon2d().basicPolygon(), object_polygon.get()))
+        {
+          lanelet_object_index[neighbor.get().id()].push_back({ i, true });
+        }
+      }
+    }
+
+    return roadway_objects;
+  }
+
+  std::vector<CARMAWorldModel::InLaneObject>
+  CARMAWorldModel::getInLaneObjectIndices(const std::vector<lanelet::ConstLanelet>& lane) const
+  {
+    std::vector<InLaneObject> lane_objects;
+    std::vector<bool> found(roadway_objects_->objects.size(), false);
+
+    for (size_t lane_index = 0; lane_index < lane.size(); lane_index++)
+    {
+      auto index_it = roadway_objects_->lanelet_index.find(lane[lane_index].id());
+
+      if (index_it == roadway_objects_->lanelet_index.end())
+      {
+        continue;
+      }
+
+      for (const auto& entry : index_it->second)
+      {
+        // An object is only reported for the first lanelet of the lane it belongs to
+        if (found[entry.object_index])
         {
-          // did not find suitable lanelet, so it will be processed again for next lanelet
-          obj_idxs_queue.push(curr_idx);
+          continue;
         }
+
+        found[entry.object_index] = true;
+        lane_objects.push_back({ entry.object_index, lane_index, entry.adjacent });
       }
     }
 
     return lane_objects;
   }
 
+  std::vector<carma_perception_msgs::msg::RoadwayObstacle> CARMAWorldModel::getRoadwayObjects() const
+  {
+    return roadway_objects_->objects;
+  }
+
+  std::vector<carma_perception_msgs::msg::RoadwayObstacle> CARMAWorldModel::getInLaneObjects(const lanelet::ConstLanelet& lanelet,
+                                                                           const LaneSection& section) const
+  {
+    // Get all lanelets on current lane section
+    std::vector<lanelet::ConstLanelet> lane = getLane(lanelet, section);
+
+    // Check if any roadway object is registered
+    if (roadway_objects_->objects.size() == 0)
+    {
+      return std::vector<carma_perception_msgs::msg::RoadwayObstacle>{};
+    }
+
+    // Objects are looked up per lanelet in the index built by setRoadwayObjects
+    // Complexity N + K, where N: num of lanelets, K: num of objects in the lane
+    std::vector<carma_perception_msgs::msg::RoadwayObstacle> lane_objects;
+
+    for (const auto& in_lane_object : getInLaneObjectIndices(lane))
+    {
+      lane_objects.push_back(roadway_objects_->objects[in_lane_object.object_index]);
+    }
+
+    return lane_objects;
+  }
+
   lanelet::Optional<lanelet::Lanelet>
   CARMAWorldModel::getIntersectingLanelet(const carma_perception_msgs::msg::ExternalObject& object) const
   {
@@ -956,7 +1371,7 @@ namespace carma_wm
     }
 
     // return empty if there is no object nearby
-    if (roadway_objects_.size() == 0)
+    if (roadway_objects_->objects.size() == 0)
       return boost::none;
 
     // Get the lanelet of this point
@@ -966,15 +1381,13 @@ namespace carma_wm
     if (!boost::geometry::within(object_center, curr_lanelet.polygon2d().basicPolygon()))
       throw std::invalid_argument("Given point is not within any lanelet");
 
-    std::vector<carma_perception_msgs::msg::RoadwayObstacle> lane_objects = getInLaneObjects(curr_lanelet);
-
     // return empty if there is no object in the lane
-    if (lane_objects.size() == 0)
+    if (getInLaneObjectIndices(getLane(curr_lanelet)).empty())
       return boost::none;
 
     // Record the closest distance out of all polygons, 4 points each
     double min_dist = INFINITY;
-    for (auto obj : roadway_objects_)
+    for (const auto& obj : roadway_objects_->objects)
     {
       lanelet::BasicPolygon2d object_polygon = geometry::objectToMapPolygon(obj.object.pose.pose, obj.object.size);
 
@@ -998,7 +1411,7 @@ namespace carma_wm
     }
 
     // return empty if there is no object nearby
-    if (roadway_objects_.size() == 0)
+    if (roadway_objects_->objects.size() == 0)
       return boost::none;
 
     // Get the lanelet of this point
@@ -1008,69 +1421,26 @@ namespace carma_wm
     if (!boost::geometry::within(object_center, curr_lanelet.polygon2d().basicPolygon()))
       throw std::invalid_argument("Given point is not within any lanelet");
 
-    // Get objects that are in the lane
-    std::vector<carma_perception_msgs::msg::RoadwayObstacle> lane_objects = getInLaneObjects(curr_lanelet, section);
+    // Get the lane that is including this lanelet
+    std::vector<lanelet::ConstLanelet> lane_section = getLane(curr_lanelet, section);
+
+    // Get objects that are in the lane along with the lanelet of the lane each belongs to
+    std::vector<InLaneObject> lane_objects = getInLaneObjectIndices(lane_section);
 
     // return empty if there is no object in the lane
     if (lane_objects.size() == 0)
       return boost::none;
 
-    // Get the lane that is including this lanelet
-    std::vector<lanelet::ConstLanelet> lane_section = getLane(curr_lanelet, section);
-
-    std::vector<double> object_downtracks, object_crosstracks;
-    std::vector<int> object_idxs;
-    std::queue<int> obj_idxs_queue;
+    // Downtrack of the start of each lanelet along the lane
+    std::vector<double> base_downtracks;
+    base_downtracks.reserve(lane_section.size());
     double base_downtrack = 0;
     double input_obj_downtrack = 0;
-    int curr_idx = 0;
 
-    // Create an index queue for in lane objects to quickly pop the idx if associated
-    // lanelet is found. This is to reduce number of objects to check as we check new lanelets
-    for (size_t i = 0; i < lane_objects.size(); i++)
+    for (const auto& llt : lane_section)
     {
-      obj_idxs_queue.push((int)i);
-    }
-
-    // For each lanelet, check if each object is inside it. if so, calculate downtrack
-    for (auto llt : lane_section)
-    {
-      int checked_queue_items = 0, to_check = obj_idxs_queue.size();
-
-      // check each remaining objects
-      while (checked_queue_items < to_check)
-      {
-        curr_idx = obj_idxs_queue.front();
-        obj_idxs_queue.pop();
-        checked_queue_items++;
+      base_downtracks.push_back(base_downtrack);
 
-        // if the object is on it, store its total downtrack distance
-        if (lane_objects[curr_idx].lanelet_id == llt.id())
-        {
-          object_downtracks.push_back(base_downtrack + lane_objects[curr_idx].down_track);
-          object_crosstracks.push_back(lane_objects[curr_idx].cross_track);
-          object_idxs.push_back(curr_idx);
-        }
-        // if it's not on it, try adjacent lanelets because the object could be lane changing
-        else if ((map_routing_graph_->left(llt) &&
-                  lane_objects[curr_idx].lanelet_id == map_routing_graph_->left(llt).get().id()) ||
-                 (map_routing_graph_->right(llt) &&
-                  lane_objects[curr_idx].lanelet_id == map_routing_graph_->right(llt).get().id()))
-        {
-          // no need to check intersection as the objects are guaranteed to be intersecting this lane
-          lanelet::BasicPoint2d obj_center(lane_objects[curr_idx].object.pose.pose.position.x,
-                                           lane_objects[curr_idx].object.pose.pose.position.y);
-          TrackPos new_tp = geometry::trackPos(llt, obj_center);
-          object_downtracks.push_back(base_downtrack + new_tp.downtrack);
-          object_crosstracks.push_back(lane_objects[curr_idx].cross_track);
-          object_idxs.push_back(curr_idx);
-        }
-        else
-        {
-          // the object is not in the lanelet if above conditions do not meet
-          obj_idxs_queue.push(curr_idx);
-        }
-      }
       // try to update object_center's downtrack
       if (curr_lanelet.id() == llt.id())
         input_obj_downtrack = base_downtrack + geometry::trackPos(llt, object_center).downtrack;
@@ -1082,24 +1452,44 @@ namespace carma_wm
               .downtrack;
     }
 
-    // compare with input's downtrack and return the min_dist
+    // compare each object's downtrack with input's downtrack and keep the min_dist
     size_t min_idx = 0;
     double min_dist = INFINITY;
-    for (size_t idx = 0; idx < object_downtracks.size(); idx++)
+    double min_obj_downtrack = 0;
+    for (size_t idx = 0; idx < lane_objects.size(); idx++)
     {
-      if (min_dist > std::fabs(object_downtracks[idx] - input_obj_downtrack))
+      const auto& obj = roadway_objects_->objects[lane_objects[idx].object_index];
+      const auto& llt = lane_section[lane_objects[idx].lane_index];
+
+      double obj_downtrack = base_downtracks[lane_objects[idx].lane_index];
+
+      if (lane_objects[idx].adjacent)
       {
-        min_dist = std::fabs(object_downtracks[idx] - input_obj_downtrack);
+        // the object is on an adjacent lanelet because it is lane changing, so its downtrack is measured along this one
+        lanelet::BasicPoint2d obj_center(obj.object.pose.pose.position.x, obj.object.pose.pose.position.y);
+        obj_downtrack += geometry::trackPos(llt, obj_center).downtrack;
+      }
+      else
+      {
+        obj_downtrack += obj.down_track;
+      }
+
+      if (min_dist > std::fabs(obj_downtrack - input_obj_downtrack))
+      {
+        min_dist = std::fabs(obj_downtrack - input_obj_downtrack);
         min_idx = idx;
+        min_obj_downtrack = obj_downtrack;
       }
     }
 
+    const auto& nearest_obj = roadway_objects_->objects[lane_objects[min_idx].object_index];
+
     // if before the parallel line with the start of the llt that crosses given object_center, neg downtrack.
     // if left to the parallel line with the centerline of the llt that crosses given object_center, pos crosstrack
     return std::tuple<TrackPos, carma_perception_msgs::msg::RoadwayObstacle>(
-        TrackPos(object_downtracks[min_idx] - input_obj_downtrack,
-                 object_crosstracks[min_idx] - geometry::trackPos(curr_lanelet, object_center).crosstrack),
-        lane_objects[object_idxs[min_idx]]);
+        TrackPos(min_obj_downtrack - input_obj_downtrack,
+                 nearest_obj.cross_track - geometry::trackPos(curr_lanelet, object_center).crosstrack),
+        nearest_obj);
   }
 
   lanelet::Optional<std::tuple<TrackPos, carma_perception_msgs::msg::RoadwayObstacle>>
@@ -1229,40 +1619,15 @@ namespace carma_wm
       RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Route has not yet been loaded");
       return {};
     }
-    std::vector<lanelet::CarmaTrafficSignalPtr> light_list;
-    auto curr_downtrack = routeTrackPos(loc).downtrack;
-    // shortpath is already sorted by distance
+    // Signals along the route are indexed by downtrack when the route is set
+    auto signals = elementsAtOrBeyond(route_regulatory_element_index_->signals, routeTrackPos(loc).downtrack);
 
-    for (const auto &ll : route_->shortestPath())
+    for (auto& signal : signals)
     {
-      auto lights = semantic_map_->laneletLayer.get(ll.id()).regulatoryElementsAs<lanelet::CarmaTrafficSignal>();
-      if (lights.empty())
-      {
-        continue;
-      }
-
-      for (auto light : lights)
-      {
-        auto stop_line = light->getStopLine(ll);
-        if (!stop_line)
-        {
-          RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "No stop line");
-          continue;
-        }
-        else
-        {
-          double light_downtrack = routeTrackPos(stop_line.get().front().basicPoint2d()).downtrack;
-          double distance_remaining_to_traffic_light = light_downtrack - curr_downtrack;
-
-          if (distance_remaining_to_traffic_light < 0)
-          {
-            continue;
-          }
-          light_list.push_back(light);
-        }
-      }
+      signal = signalWithTiming(signal);
     }
-    return light_list;
+
+    return signals;
   }
 
   boost::optional<std::pair<lanelet::ConstLanelet, lanelet::ConstLanelet>> CARMAWorldModel::getEntryExitOfSignalAlongRoute(const lanelet::CarmaTrafficSignalPtr& traffic_signal) const
@@ -1279,38 +1644,35 @@ namespace carma_wm
     auto exit_lanelets = traffic_signal->getControlEndLanelets();
 
     // get entry and exit lane along route for the nearest given signal
-    for (const auto& ll: route_->shortestPath())
+    // The first lanelet of each list along the shortest path is found by its index in the path
+    size_t entry_index = 0;
+    size_t exit_index = 0;
+
+    for (const auto& entry: entry_lanelets)
     {
-      if (!found_entry)
+      auto index_it = route_regulatory_element_index_->shortest_path_indices.find(entry.id());
+      if (index_it != route_regulatory_element_index_->shortest_path_indices.end() && (!found_entry || index_it->second < entry_index))
       {
-        for (const auto& entry: entry_lanelets)
-        {
-          if (ll.id() == entry.id())
-          {
-            entry_exit.first = entry;
-            found_entry = true;
-            break;
-          }
-        }
+        entry_exit.first = entry;
+        entry_index = index_it->second;
+        found_entry = true;
       }
+    }
 
-      if (!found_exit)
+    for (const auto& exit: exit_lanelets)
+    {
+      auto index_it = route_regulatory_element_index_->shortest_path_indices.find(exit.id());
+      if (index_it != route_regulatory_element_index_->shortest_path_indices.end() && (!found_exit || index_it->second < exit_index))
       {
-        for (const auto& exit: exit_lanelets)
-        {
-          if (ll.id() == exit.id())
-          {
-            entry_exit.second = exit;
-            found_exit = true;
-            break;
-          }
-        }
+        entry_exit.second = exit;
+        exit_index = index_it->second;
+        found_exit = true;
       }
-
-      if (found_entry && found_exit)
-        return entry_exit;
     }
 
+    if (found_entry && found_exit)
+      return entry_exit;
+
     // was not able to find entry and exit for this signal along route
     return boost::none;
   }
@@ -1329,27 +1691,8 @@ namespace carma_wm
       RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Route has not yet been loaded");
       return {};
     }
-    std::vector<std::shared_ptr<lanelet::AllWayStop>> intersection_list;
-    auto curr_downtrack = routeTrackPos(loc).downtrack;
-    // shortpath is already sorted by distance
-    for(const auto& ll : route_->shortestPath())
-    {
-      auto intersections = semantic_map_->laneletLayer.get(ll.id()).regulatoryElementsAs<lanelet::AllWayStop>();
-      if (intersections.empty())
-      {
-        continue;
-      }
-      for (auto intersection : intersections)
-      {
-        double intersection_downtrack = routeTrackPos(intersection->stopLines().front().front().basicPoint2d()).downtrack;
-        if (intersection_downtrack < curr_downtrack)
-        {
-          continue;
-        }
-        intersection_list.push_back(intersection);
-      }
-    }
-    return intersection_list;
+    // Intersections along the route are indexed by downtrack when the route is set
+    return elementsAtOrBeyond(route_regulatory_element_index_->all_way_stops, routeTrackPos(loc).downtrack);
   }
 
   std::vector<lanelet::SignalizedIntersectionPtr> CARMAWorldModel::getSignalizedIntersectionsAlongRoute(const lanelet::BasicPoint2d &loc) const
@@ -1366,30 +1709,16 @@ namespace carma_wm
       RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Route has not yet been loaded");
       return {};
     }
-    std::vector<lanelet::SignalizedIntersectionPtr> intersection_list;
-    auto curr_downtrack = routeTrackPos(loc).downtrack;
-    // shortpath is already sorted by distance
-    for (const auto &ll : route_->shortestPath())
-    {
-      auto intersections = semantic_map_->laneletLayer.get(ll.id()).regulatoryElementsAs<lanelet::SignalizedIntersection>();
-      if (intersections.empty())
-      {
-        continue;
-      }
-      for (auto intersection : intersections)
-      {
-        double intersection_downtrack = routeTrackPos(ll.centerline().back().basicPoint2d()).downtrack;
-        if (intersection_downtrack < curr_downtrack)
-        {
-          continue;
-        }
-        intersection_list.push_back(intersection);
-      }
-    }
-    return intersection_list;
+    // Intersections along the route are indexed by downtrack when the route is set
+    return elementsAtOrBeyond(route_regulatory_element_index_->signalized_intersections, routeTrackPos(loc).downtrack);
   }
 
   lanelet::CarmaTrafficSignalPtr CARMAWorldModel::getTrafficSignal(const lanelet::Id& id) const
+  {
+    return signalWithTiming(findMapTrafficSignal(id));
+  }
+
+  lanelet::CarmaTrafficSignalPtr CARMAWorldModel::findMapTrafficSignal(const lanelet::Id& id) const
   {
     auto general_regem = semantic_map_->regulatoryElementLayer.get(id);
 
@@ -1473,20 +1802,124 @@ namespace carma_wm
     }
   }
 
-  void CARMAWorldModel::processSpatFromMsg(const carma_v2x_msgs::msg::SPAT &spat_msg, bool use_sim_time)
+  void CARMAWorldModel::setTrafficSignalCopyOnWrite(bool enabled)
+  {
+    traffic_signal_copy_on_write_ = enabled;
+
+    if (enabled)
+    {
+      return;
+    }
+
+    // Later updates are written into the map signals so they must start from the latest timing
+    for (const auto& [id, copy] : *traffic_signal_copies_)
+    {
+      auto map_signal = findMapTrafficSignal(id);
+      if (map_signal && map_signal->constData() == copy->constData())
+      {
+        copyTrafficSignalTiming(*copy, *map_signal);
+      }
+    }
+    traffic_signal_copies_ = std::make_shared<TrafficSignalCopies>();
+  }
+
+  lanelet::CarmaTrafficSignalPtr CARMAWorldModel::signalWithTiming(const lanelet::CarmaTrafficSignalPtr& map_signal) const
+  {
+    if (!map_signal || traffic_signal_copies_->empty())
+    {
+      return map_signal;
+    }
+
+    auto copy = traffic_signal_copies_->find(map_signal->id());
+    if (copy != traffic_signal_copies_->end() && copy->second->constData() == map_signal->constData())
+    {
+      return copy->second;
+    }
+
+    return map_signal;
+  }
+
+  lanelet::CarmaTrafficSignalPtr CARMAWorldModel::writableTrafficSignal(const lanelet::CarmaTrafficSignalPtr& map_signal)
+  {
+    if (!traffic_signal_copy_on_write_)
+    {
+      return map_signal;
+    }
+
+    TrafficSignalCopies& copies = writableTrafficSignalCopies();
+
+    // References to a copy are only created from this object or from copies of it, so a copy referenced only here is not
+    // visible anywhere else and can be modified in place
+    auto copy = copies.find(map_signal->id());
+    if (copy != copies.end() && copy->second->constData() == map_signal->constData() && copy->second.use_count() == 1)
+    {
+      return copy->second;
+    }
+
+    lanelet::CarmaTrafficSignalPtr writable_signal(new lanelet::CarmaTrafficSignal(std::const_pointer_cast<lanelet::RegulatoryElementData>(map_signal->constData())));
+    copyTrafficSignalTiming(*signalWithTiming(map_signal), *writable_signal);
+    copies[map_signal->id()] = writable_signal;
+
+    return writable_signal;
+  }
+
+  CARMAWorldModel::TrafficSignalCopies& CARMAWorldModel::writableTrafficSignalCopies()
+  {
+    // The table is shared with the copies of this object until one of them modifies it
+    if (traffic_signal_copies_.use_count() > 1)
+    {
+      traffic_signal_copies_ = std::make_shared<TrafficSignalCopies>(*traffic_signal_copies_);
+    }
+
+    return *traffic_signal_copies_;
+  }
+
+  void CARMAWorldModel::rebaseTrafficSignalCopies()
+  {
+    TrafficSignalCopies& copies = writableTrafficSignalCopies();
+
+    for (auto it = copies.begin(); it != copies.end();)
+    {
+      lanelet::CarmaTrafficSignalPtr map_signal;
+      auto regem = semantic_map_->regulatoryElementLayer.find(it->first);
+      if (regem != semantic_map_->regulatoryElementLayer.end())
+      {
+        map_signal = std::dynamic_pointer_cast<lanelet::CarmaTrafficSignal>(*regem);
+      }
+
+      if (!map_signal)
+      {
+        it = copies.erase(it);
+        continue;
+      }
+
+      if (map_signal->constData() != it->second->constData())
+      {
+        lanelet::CarmaTrafficSignalPtr rebased_signal(new lanelet::CarmaTrafficSignal(std::const_pointer_cast<lanelet::RegulatoryElementData>(map_signal->constData())));
+        copyTrafficSignalTiming(*it->second, *rebased_signal);
+        it->second = rebased_signal;
+      }
+
+      ++it;
+    }
+  }
+
+  bool CARMAWorldModel::processSpatFromMsg(const carma_v2x_msgs::msg::SPAT &spat_msg, bool use_sim_time)
   {
     if (!semantic_map_)
     {
       RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm"), "Map is not set yet.");
-      return;
+      return false;
     }
 
     if (spat_msg.intersection_state_list.empty())
     {
       RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm"), "No intersection_state_list in the newly received SPAT msg. Returning...");
-      return;
+      return false;
     }
 
+    bool signals_changed = false;
+
     for (const auto& curr_intersection : spat_msg.intersection_state_list)
     {
 
@@ -1499,13 +1932,15 @@ namespace carma_wm
           continue;
         }
 
-        lanelet::CarmaTrafficSignalPtr curr_light = getTrafficSignal(curr_light_id);
+        lanelet::CarmaTrafficSignalPtr map_light = findMapTrafficSignal(curr_light_id);
 
-        if (curr_light == nullptr)
+        if (map_light == nullptr)
         {
           continue;
         }
 
+        lanelet::CarmaTrafficSignalPtr curr_light = signalWithTiming(map_light);
+
         // reset states if the intersection's geometry changed
         if (curr_light->revision_ != curr_intersection.revision)
         {
@@ -1525,8 +1960,6 @@ namespace carma_wm
           RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm"), "Movement_event_list size: " << current_movement_state.movement_event_list.size() << " . intersection_id: " << (int)curr_intersection.id.id << ", and signal_group_id: " << (int)current_movement_state.signal_group);
         }
 
-        curr_light->revision_ = curr_intersection.revision; // valid SPAT msg
-
         sim_.traffic_signal_states_[curr_intersection.id.id][current_movement_state.signal_group]={};
         sim_.traffic_signal_start_times_[curr_intersection.id.id][current_movement_state.signal_group]={};
 
@@ -1550,10 +1983,26 @@ namespace carma_wm
             << ", end_time: " << std::to_string(lanelet::time::toSec(min_end_time_dynamic))
             << ", state: " << received_state_dynamic);
         }
-        curr_light->recorded_time_stamps = sim_.traffic_signal_states_[curr_intersection.id.id][current_movement_state.signal_group];
-        curr_light->recorded_start_time_stamps  = sim_.traffic_signal_start_times_[curr_intersection.id.id][current_movement_state.signal_group];
+
+        const auto& time_stamps = sim_.traffic_signal_states_[curr_intersection.id.id][current_movement_state.signal_group];
+        const auto& start_time_stamps = sim_.traffic_signal_start_times_[curr_intersection.id.id][current_movement_state.signal_group];
+
+        // Repeated messages are common so the signal is only written, and possibly copied, when its timing changes
+        if (curr_light->revision_ == curr_intersection.revision && curr_light->recorded_time_stamps == time_stamps
+            && curr_light->recorded_start_time_stamps == start_time_stamps)
+        {
+          continue;
+        }
+
+        curr_light = writableTrafficSignal(map_light);
+        curr_light->revision_ = curr_intersection.revision; // valid SPAT msg
+        curr_light->recorded_time_stamps = time_stamps;
+        curr_light->recorded_start_time_stamps = start_time_stamps;
+        signals_changed = true;
       }
     }
+
+    return signals_changed;
   }
 
 } // namespace carma_wm
\ No newline at end of file
@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/GeoreferenceProjector.hpp>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <sstream>
+
+namespace carma_wm
+{
+namespace projection
+{
+namespace
+{
+constexpr double WGS84_A = 6378137.0;
+constexpr double WGS84_F = 1.0 / 298.257223563;
+constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);
+constexpr double DEG_TO_RAD = M_PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / M_PI;
+
+// Number of georeference strings kept by getGeoreferenceProjector
+constexpr size_t PROJECTOR_CACHE_SIZE = 8;
+
+/*!
+ * \brief Parameters of a proj string which can be converted in closed form
+ */
+struct ClosedFormParams
+{
+  bool tmerc = false;
+  double lat_0 = 0.0;
+  double lon_0 = 0.0;
+  double k_0 = 1.0;
+  double x_0 = 0.0;
+  double y_0 = 0.0;
+};
+
+/*!
+ * \brief Parses a proj string of the form "+proj=tmerc +lat_0=... +datum=WGS84 ...".
+ *        Returns false if the string contains anything which the closed form conversions do not reproduce exactly
+ *        such as another ellipsoid, a datum shift, a geoid grid or axis swapping.
+ */
+bool parseClosedFormParams(const std::string& georeference, ClosedFormParams* params)
+{
+  std::istringstream stream(georeference);
+  std::string token;
+  bool projection_found = false;
+  bool wgs84 = false;
+
+  while (stream >> token)
+  {
+    if (token.empty() || token[0] != '+')
+    {
+      return false;
+    }
+
+    auto equals = token.find('=');
+    std::string key = token.substr(1, equals == std::string::npos ? std::string::npos : equals - 1);
+    std::string value = equals == std::string::npos ? "" : token.substr(equals + 1);
+
+    try
+    {
+      if (key == "proj")
+      {
+        if (value != "tmerc" && value != "geocent")
+        {
+          return false;
+        }
+        params->tmerc = value == "tmerc";
+        projection_found = true;
+      }
+      else if (key == "lat_0")
+      {
+        params->lat_0 = std::stod(value);
+      }
+      else if (key == "lon_0")
+      {
+        params->lon_0 = std::stod(value);
+      }
+      else if (key == "k" || key == "k_0")
+      {
+        params->k_0 = std::stod(value);
+      }
+      else if (key == "x_0")
+      {
+        params->x_0 = std::stod(value);
+      }
+      else if (key == "y_0")
+      {
+        params->y_0 = std::stod(value);
+      }
+      else if (key == "datum" || key == "ellps")
+      {
+        if (value != "WGS84")
+        {
+          return false;
+        }
+        wgs84 = true;
+      }
+      else if ((key == "units" || key == "vunits") && value != "m")
+      {
+        return false;
+      }
+      else if (key != "units" && key != "vunits" && key != "no_defs" && key != "type")
+      {
+        return false;
+      }
+    }
+    catch (const std::logic_error&)  // Unparsable number
+    {
+      return false;
+    }
+  }
+
+  return projection_found && wgs84;
+}
+}  // namespace
+
+TransverseMercator::TransverseMercator(double lat_0, double lon_0, double k_0, double x_0, double y_0)
+  : k_0_(k_0), lon_0_(lon_0 * DEG_TO_RAD), x_0_(x_0), y_0_(y_0)
+{
+  e2_ = WGS84_E2;
+  e_ = std::sqrt(e2_);
+
+  double n = WGS84_F / (2.0 - WGS84_F);
+  double n2 = n * n;
+  double n3 = n2 * n;
+  double n4 = n3 * n;
+  double n5 = n4 * n;
+  double n6 = n5 * n;
+
+  scaled_radius_ = k_0_ * WGS84_A / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+
+  alpha_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+  alpha_[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+  alpha_[2] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+  alpha_[3] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0;
+  alpha_[4] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+  alpha_[5] = 212378941.0 * n6 / 319334400.0;
+
+  beta_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0 - 81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0;
+  beta_[1] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 + 46.0 * n5 / 105.0 - 1118711.0 * n6 / 3870720.0;
+  beta_[2] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0 + 5569.0 * n6 / 90720.0;
+  beta_[3] = 4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 - 830251.0 * n6 / 7257600.0;
+  beta_[4] = 4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0;
+  beta_[5] = 20648693.0 * n6 / 638668800.0;
+
+  double xi_0, eta_0;
+  gaussKruger(lat_0 * DEG_TO_RAD, 0.0, &xi_0, &eta_0);
+  origin_northing_ = scaled_radius_ * xi_0;
+}
+
+double TransverseMercator::conformalTan(double tan_lat) const
+{
+  double sec = std::hypot(1.0, tan_lat);
+  double sig = std::sinh(e_ * std::atanh(e_ * tan_lat / sec));
+  return std::hypot(1.0, sig) * tan_lat - sig * sec;
+}
+
+void TransverseMercator::gaussKruger(double lat, double delta_lon, double* xi, double* eta) const
+{
+  double conformal_tan = conformalTan(std::tan(lat));
+  double cos_lon = std::cos(delta_lon);
+  double xi_prime = std::atan2(conformal_tan, cos_lon);
+  double eta_prime = std::asinh(std::sin(delta_lon) / std::hypot(conformal_tan, cos_lon));
+
+  *xi = xi_prime;
+  *eta = eta_prime;
+  for (int j = 1; j <= 6; j++)
+  {
+    *xi += alpha_[j - 1] * std::sin(2 * j * xi_prime) * std::cosh(2 * j * eta_prime);
+    *eta += alpha_[j - 1] * std::cos(2 * j * xi_prime) * std::sinh(2 * j * eta_prime);
+  }
+}
+
+void TransverseMercator::forward(double lat, double lon, double* x, double* y) const
+{
+  double delta_lon = std::remainder(lon * DEG_TO_RAD - lon_0_, 2.0 * M_PI);
+
+  double xi, eta;
+  gaussKruger(lat * DEG_TO_RAD, delta_lon, &xi, &eta);
+
+  *x = scaled_radius_ * eta + x_0_;
+  *y = scaled_radius_ * xi - origin_northing_ + y_0_;
+}
+
+void TransverseMercator::reverse(double x, double y, double* lat, double* lon) const
+{
+  double xi = (y - y_0_ + origin_northing_) / scaled_radius_;
+  double eta = (x - x_0_) / scaled_radius_;
+
+  double xi_prime = xi;
+  double eta_prime = eta;
+  for (int j = 1; j <= 6; j++)
+  {
+    xi_prime -= beta_[j - 1] * std::sin(2 * j * xi) * std::cosh(2 * j * eta);
+    eta_prime -= beta_[j - 1] * std::cos(2 * j * xi) * std::sinh(2 * j * eta);
+  }
+
+  double sinh_eta = std::sinh(eta_prime);
+  double cos_xi = std::cos(xi_prime);
+  double conformal_tan = std::sin(xi_prime) / std::hypot(sinh_eta, cos_xi);
+
+  // Newton's method for the latitude whose conformal latitude was found. Converges in two or three iterations
+  double tan_lat = conformal_tan;
+  for (int i = 0; i < 5; i++)
+  {
+    double estimate = conformalTan(tan_lat);
+    double step = (conformal_tan - estimate) / std::hypot(1.0, estimate) * (1.0 + (1.0 - e2_) * tan_lat * tan_lat) /
+                  ((1.0 - e2_) * std::hypot(1.0, tan_lat));
+    tan_lat += step;
+
+    if (std::abs(step) < 1e-14 * std::max(1.0, std::abs(tan_lat)))
+    {
+      break;
+    }
+  }
+
+  *lat = std::atan(tan_lat) * RAD_TO_DEG;
+  *lon = std::remainder(std::atan2(sinh_eta, cos_xi) + lon_0_, 2.0 * M_PI) * RAD_TO_DEG;
+}
+
+lanelet::BasicPoint3d geodeticToECEF(const lanelet::GPSPoint& gps_point)
+{
+  double lat = gps_point.lat * DEG_TO_RAD;
+  double lon = gps_point.lon * DEG_TO_RAD;
+  double sin_lat = std::sin(lat);
+  double cos_lat = std::cos(lat);
+  double prime_vertical_radius = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+
+  return { (prime_vertical_radius + gps_point.ele) * cos_lat * std::cos(lon),
+           (prime_vertical_radius + gps_point.ele) * cos_lat * std::sin(lon),
+           (prime_vertical_radius * (1.0 - WGS84_E2) + gps_point.ele) * sin_lat };
+}
+
+lanelet::GPSPoint ecefToGeodetic(const lanelet::BasicPoint3d& ecef_point)
+{
+  constexpr double e4 = WGS84_E2 * WGS84_E2;
+
+  double x = ecef_point.x();
+  double y = ecef_point.y();
+  double z = ecef_point.z();
+  double horizontal_dist = std::hypot(x, y);
+
+  double p = (horizontal_dist * horizontal_dist) / (WGS84_A * WGS84_A);
+  double q = (1.0 - WGS84_E2) / (WGS84_A * WGS84_A) * z * z;
+  double r = (p + q - e4) / 6.0;
+  double s = e4 * p * q / (4.0 * r * r * r);
+  double t = std::cbrt(1.0 + s + std::sqrt(s * (2.0 + s)));
+  double u = r * (1.0 + t + 1.0 / t);
+  double v = std::sqrt(u * u + e4 * q);
+  double w = WGS84_E2 * (u + v - q) / (2.0 * v);
+  double k = std::sqrt(u + v + w * w) - w;
+  double d = k * horizontal_dist / (k + WGS84_E2);
+  double dz = std::hypot(d, z);
+
+  lanelet::GPSPoint gps_point;
+  gps_point.lat = 2.0 * std::atan2(z, d + dz) * RAD_TO_DEG;
+  gps_point.lon = std::atan2(y, x) * RAD_TO_DEG;
+  gps_point.ele = (k + WGS84_E2 - 1.0) / k * dz;
+  return gps_point;
+}
+
+GeoreferenceProjector::GeoreferenceProjector(const std::string& georeference) : georeference_(georeference)
+{
+  ClosedFormParams params;
+  if (parseClosedFormParams(georeference, &params))
+  {
+    if (params.tmerc)
+    {
+      frame_ = Frame::TRANSVERSE_MERCATOR;
+      tmerc_ = std::make_unique<TransverseMercator>(params.lat_0, params.lon_0, params.k_0, params.x_0, params.y_0);
+    }
+    else
+    {
+      frame_ = Frame::GEOCENTRIC;
+    }
+    return;
+  }
+
+  projector_ = std::make_unique<lanelet::projection::LocalFrameProjector>(georeference.c_str());
+}
+
+const std::string& GeoreferenceProjector::getGeoreference() const
+{
+  return georeference_;
+}
+
+bool GeoreferenceProjector::hasClosedForm() const
+{
+  return frame_ != Frame::PROJ;
+}
+
+lanelet::BasicPoint3d GeoreferenceProjector::forward(const lanelet::GPSPoint& gps_point) const
+{
+  switch (frame_)
+  {
+    case Frame::TRANSVERSE_MERCATOR:
+    {
+      lanelet::BasicPoint3d map_point;
+      tmerc_->forward(gps_point.lat, gps_point.lon, &map_point.x(), &map_point.y());
+      map_point.z() = gps_point.ele;
+      return map_point;
+    }
+    case Frame::GEOCENTRIC:
+      return geodeticToECEF(gps_point);
+    default:
+    {
+      std::lock_guard<std::mutex> lock(projector_mutex_);
+      return projector_->forward(gps_point);
+    }
+  }
+}
+
+lanelet::GPSPoint GeoreferenceProjector::reverse(const lanelet::BasicPoint3d& map_point) const
+{
+  switch (frame_)
+  {
+    case Frame::TRANSVERSE_MERCATOR:
+    {
+      lanelet::GPSPoint gps_point;
+      tmerc_->reverse(map_point.x(), map_point.y(), &gps_point.lat, &gps_point.lon);
+      gps_point.ele = map_point.z();
+      return gps_point;
+    }
+    case Frame::GEOCENTRIC:
+      return ecefToGeodetic(map_point);
+    default:
+    {
+      std::lock_guard<std::mutex> lock(projector_mutex_);
+      return projector_->reverse(map_point);
+    }
+  }
+}
+
+lanelet::BasicPoint3d GeoreferenceProjector::projectECEF(const lanelet::BasicPoint3d& point, int proj_dir) const
+{
+  switch (frame_)
+  {
+    case Frame::TRANSVERSE_MERCATOR:
+      return proj_dir == 1 ? geodeticToECEF(reverse(point)) : forward(ecefToGeodetic(point));
+    case Frame::GEOCENTRIC:
+      return point;
+    default:
+    {
+      std::lock_guard<std::mutex> lock(projector_mutex_);
+      return projector_->projectECEF(point, proj_dir);
+    }
+  }
+}
+
+std::vector<lanelet::BasicPoint3d> GeoreferenceProjector::forward(const std::vector<lanelet::GPSPoint>& gps_points) const
+{
+  std::vector<lanelet::BasicPoint3d> map_points;
+  map_points.reserve(gps_points.size());
+
+  if (frame_ == Frame::PROJ)
+  {
+    // Take the lock once for the whole batch
+    std::lock_guard<std::mutex> lock(projector_mutex_);
+    for (const auto& gps_point : gps_points)
+    {
+      map_points.emplace_back(projector_->forward(gps_point));
+    }
+    return map_points;
+  }
+
+  for (const auto& gps_point : gps_points)
+  {
+    map_points.emplace_back(forward(gps_point));
+  }
+  return map_points;
+}
+
+std::vector<lanelet::GPSPoint> GeoreferenceProjector::reverse(const std::vector<lanelet::BasicPoint3d>& map_points) const
+{
+  std::vector<lanelet::GPSPoint> gps_points;
+  gps_points.reserve(map_points.size());
+
+  if (frame_ == Frame::PROJ)
+  {
+    std::lock_guard<std::mutex> lock(projector_mutex_);
+    for (const auto& map_point : map_points)
+    {
+      gps_points.emplace_back(projector_->reverse(map_point));
+    }
+    return gps_points;
+  }
+
+  for (const auto& map_point : map_points)
+  {
+    gps_points.emplace_back(reverse(map_point));
+  }
+  return gps_points;
+}
+
+std::vector<lanelet::BasicPoint3d> GeoreferenceProjector::projectECEF(const std::vector<lanelet::BasicPoint3d>& points,
+                                                                      int proj_dir) const
+{
+  std::vector<lanelet::BasicPoint3d> projected;
+  projected.reserve(points.size());
+
+  if (frame_ == Frame::PROJ)
+  {
+    std::lock_guard<std::mutex> lock(projector_mutex_);
+    for (const auto& point : points)
+    {
+      projected.emplace_back(projector_->projectECEF(point, proj_dir));
+    }
+    return projected;
+  }
+
+  for (const auto& point : points)
+  {
+    projected.emplace_back(projectECEF(point, proj_dir));
+  }
+  return projected;
+}
+
+std::shared_ptr<const GeoreferenceProjector> getGeoreferenceProjector(const std::string& georeference)
+{
+  static std::mutex cache_mutex;
+  static std::deque<std::shared_ptr<const GeoreferenceProjector>> cache;  // Most recently used first
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+
+  auto it = std::find_if(cache.begin(), cache.end(),
+                         [&georeference](const auto& projector) { return projector->getGeoreference() == georeference; });
+
+  if (it != cache.end())
+  {
+    auto projector = *it;
+    cache.erase(it);
+    cache.push_front(projector);
+    return projector;
+  }
+
+  auto projector = std::make_shared<const GeoreferenceProjector>(georeference);
+  cache.push_front(projector);
+
+  if (cache.size() > PROJECTOR_CACHE_SIZE)
+  {
+    cache.pop_back();
+  }
+
+  return projector;
+}
+
+}  // namespace projection
+}  // namespace carma_wm
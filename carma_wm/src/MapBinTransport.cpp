@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/MapBinTransport.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <lanelet2_io/io_handlers/Serialize.h>
+#include <rclcpp/rclcpp.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace carma_wm
+{
+namespace
+{
+using MapBinData = decltype(autoware_lanelet2_msgs::msg::MapBin::data);
+using MapBinByte = MapBinData::value_type;
+
+// Compressed data starts with this magic followed by one byte holding the MapBinCompression value.
+// A plain boost archive starts with the length of its signature string so it can never match
+constexpr char COMPRESSED_MAGIC[] = { 'C', 'W', 'M', 'Z' };
+constexpr size_t COMPRESSED_HEADER_SIZE = sizeof(COMPRESSED_MAGIC) + 1;
+
+// Chunk data starts with this magic followed by a ChunkHeader
+constexpr char CHUNK_MAGIC[] = { 'C', 'W', 'M', 'K' };
+
+struct ChunkHeader
+{
+  uint32_t transfer_id;
+  uint32_t chunk_index;
+  uint32_t num_chunks;
+  uint64_t total_size;  // Size of the data of the original message
+};
+
+constexpr size_t CHUNK_HEADER_SIZE = sizeof(CHUNK_MAGIC) + sizeof(ChunkHeader);
+
+/*!
+ * \brief boost::iostreams sink which appends to the data of a MapBin message
+ */
+class MapBinDataSink
+{
+public:
+  using char_type = char;
+  using category = boost::iostreams::sink_tag;
+
+  explicit MapBinDataSink(MapBinData* data) : data_(data)
+  {
+  }
+
+  std::streamsize write(const char* s, std::streamsize n)
+  {
+    const auto* bytes = reinterpret_cast<const MapBinByte*>(s);
+    data_->insert(data_->end(), bytes, bytes + n);
+    return n;
+  }
+
+private:
+  MapBinData* data_;
+};
+
+bool startsWith(const MapBinData& data, const char* magic, size_t magic_size)
+{
+  return data.size() >= magic_size && std::memcmp(data.data(), magic, magic_size) == 0;
+}
+
+bool readChunkHeader(const MapBinData& data, ChunkHeader* header)
+{
+  if (!startsWith(data, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) || data.size() < CHUNK_HEADER_SIZE)
+  {
+    return false;
+  }
+
+  std::memcpy(header, data.data() + sizeof(CHUNK_MAGIC), sizeof(ChunkHeader));
+  return true;
+}
+}  // namespace
+
+void writeBinArchive(const std::function<void(boost::archive::binary_oarchive&)>& write, MapBinCompression compression,
+                     autoware_lanelet2_msgs::msg::MapBin* msg)
+{
+  if (msg == nullptr)
+  {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), __FUNCTION__ << ": msg is null pointer!");
+    return;
+  }
+
+  msg->data.clear();
+
+  boost::iostreams::filtering_ostream out;
+
+  if (compression == MapBinCompression::ZLIB)
+  {
+    const auto* magic = reinterpret_cast<const MapBinByte*>(COMPRESSED_MAGIC);
+    msg->data.insert(msg->data.end(), magic, magic + sizeof(COMPRESSED_MAGIC));
+    msg->data.push_back(static_cast<MapBinByte>(compression));
+
+    out.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_speed));
+  }
+
+  out.push(MapBinDataSink(&msg->data));
+
+  {
+    boost::archive::binary_oarchive oa(out);
+    write(oa);
+  }
+
+  out.reset();  // Flush the compressor and close the chain
+}
+
+void readBinArchive(const autoware_lanelet2_msgs::msg::MapBin& msg,
+                    const std::function<void(boost::archive::binary_iarchive&)>& read)
+{
+  if (isMapBinChunk(msg))
+  {
+    throw std::invalid_argument("MapBin message is a chunk of a larger message and must be reassembled before reading");
+  }
+
+  MapBinCompression compression = getMapBinCompression(msg);
+  size_t offset = compression == MapBinCompression::NONE ? 0 : COMPRESSED_HEADER_SIZE;
+
+  boost::iostreams::filtering_istream in;
+
+  if (compression == MapBinCompression::ZLIB)
+  {
+    in.push(boost::iostreams::zlib_decompressor());
+  }
+
+  in.push(boost::iostreams::array_source(reinterpret_cast<const char*>(msg.data.data()) + offset,
+                                         msg.data.size() - offset));
+
+  boost::archive::binary_iarchive ia(in);
+  read(ia);
+}
+
+MapBinCompression getMapBinCompression(const autoware_lanelet2_msgs::msg::MapBin& msg)
+{
+  if (msg.data.size() < COMPRESSED_HEADER_SIZE || !startsWith(msg.data, COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC)))
+  {
+    return MapBinCompression::NONE;
+  }
+
+  auto compression = static_cast<MapBinCompression>(msg.data[sizeof(COMPRESSED_MAGIC)]);
+
+  if (compression != MapBinCompression::ZLIB)
+  {
+    throw std::invalid_argument("MapBin message uses an unsupported compression: " +
+                                std::to_string(static_cast<int>(compression)));
+  }
+
+  return compression;
+}
+
+void mapToBinMsg(const lanelet::LaneletMapPtr& map, autoware_lanelet2_msgs::msg::MapBin* msg,
+                 MapBinCompression compression)
+{
+  if (!map)
+  {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), __FUNCTION__ << ": map is null pointer!");
+    return;
+  }
+
+  writeBinArchive(
+      [&map](boost::archive::binary_oarchive& oa) {
+        oa << *map;
+        auto id_counter = lanelet::utils::getId();  // Receivers continue the id sequence from this value
+        oa << id_counter;
+      },
+      compression, msg);
+}
+
+void mapFromBinMsg(const autoware_lanelet2_msgs::msg::MapBin& msg, lanelet::LaneletMapPtr map)
+{
+  if (!map)
+  {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), __FUNCTION__ << ": map is null pointer!");
+    return;
+  }
+
+  readBinArchive(msg, [&map](boost::archive::binary_iarchive& ia) {
+    ia >> *map;
+    lanelet::Id id_counter;
+    ia >> id_counter;
+    lanelet::utils::registerId(id_counter);
+  });
+}
+
+std::vector<autoware_lanelet2_msgs::msg::MapBin> splitMapBinMsg(autoware_lanelet2_msgs::msg::MapBin msg,
+                                                               size_t max_chunk_size)
+{
+  std::vector<autoware_lanelet2_msgs::msg::MapBin> chunks;
+
+  if (max_chunk_size == 0 || msg.data.size() <= max_chunk_size)
+  {
+    chunks.emplace_back(std::move(msg));
+    return chunks;
+  }
+
+  static std::atomic<uint32_t> next_transfer_id(1);
+
+  ChunkHeader header{};  // Value initialized so padding bytes are zero
+  header.transfer_id = next_transfer_id++;
+  header.num_chunks = static_cast<uint32_t>((msg.data.size() + max_chunk_size - 1) / max_chunk_size);
+  header.total_size = msg.data.size();
+
+  // The data and routing graph are moved out of the message so every chunk only copies the small metadata fields
+  MapBinData data = std::move(msg.data);
+  msg.data.clear();
+
+  autoware_lanelet2_msgs::msg::RoutingGraph routing_graph = std::move(msg.routing_graph);
+  bool has_routing_graph = msg.has_routing_graph;
+  msg.routing_graph = autoware_lanelet2_msgs::msg::RoutingGraph();
+  msg.has_routing_graph = false;
+
+  chunks.reserve(header.num_chunks);
+
+  for (header.chunk_index = 0; header.chunk_index < header.num_chunks; header.chunk_index++)
+  {
+    chunks.push_back(msg);
+    auto& chunk = chunks.back();
+
+    size_t start = header.chunk_index * max_chunk_size;
+    size_t end = std::min(start + max_chunk_size, data.size());
+
+    chunk.data.reserve(CHUNK_HEADER_SIZE + end - start);
+
+    const auto* magic = reinterpret_cast<const MapBinByte*>(CHUNK_MAGIC);
+    chunk.data.insert(chunk.data.end(), magic, magic + sizeof(CHUNK_MAGIC));
+
+    const auto* header_bytes = reinterpret_cast<const MapBinByte*>(&header);
+    chunk.data.insert(chunk.data.end(), header_bytes, header_bytes + sizeof(ChunkHeader));
+
+    chunk.data.insert(chunk.data.end(), data.begin() + start, data.begin() + end);
+  }
+
+  chunks.back().routing_graph = std::move(routing_graph);
+  chunks.back().has_routing_graph = has_routing_graph;
+
+  return chunks;
+}
+
+bool isMapBinChunk(const autoware_lanelet2_msgs::msg::MapBin& msg)
+{
+  return startsWith(msg.data, CHUNK_MAGIC, sizeof(CHUNK_MAGIC));
+}
+
+autoware_lanelet2_msgs::msg::MapBin::SharedPtr
+MapBinChunkAssembler::addMessage(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr& msg)
+{
+  ChunkHeader header;
+
+  if (!readChunkHeader(msg->data, &header))
+  {
+    return msg;
+  }
+
+  if (header.chunk_index == 0)
+  {
+    if (assembled_)
+    {
+      RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), "Dropping incomplete map transfer " << transfer_id_
+                         << " as a new transfer " << header.transfer_id << " started");
+    }
+
+    assembled_ = std::make_shared<autoware_lanelet2_msgs::msg::MapBin>();
+    assembled_->data.reserve(header.total_size);
+    transfer_id_ = header.transfer_id;
+    next_chunk_index_ = 0;
+    num_chunks_ = header.num_chunks;
+  }
+
+  if (!assembled_ || header.transfer_id != transfer_id_ || header.chunk_index != next_chunk_index_ ||
+      header.num_chunks != num_chunks_)
+  {
+    RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), "Dropping map chunk " << header.chunk_index << " of transfer "
+                       << header.transfer_id << " as it does not continue the current transfer");
+    assembled_.reset();
+    return nullptr;
+  }
+
+  assembled_->data.insert(assembled_->data.end(), msg->data.begin() + CHUNK_HEADER_SIZE, msg->data.end());
+  next_chunk_index_++;
+
+  if (next_chunk_index_ < num_chunks_)
+  {
+    return nullptr;
+  }
+
+  auto assembled = std::move(assembled_);
+  assembled_.reset();
+
+  if (assembled->data.size() != header.total_size)
+  {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::MapBinTransport"), "Dropping map transfer " << header.transfer_id << " with size "
+                        << assembled->data.size() << " which does not match the expected size " << header.total_size);
+    return nullptr;
+  }
+
+  // The last chunk carries the metadata and routing graph of the original message
+  auto complete = std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(*msg);
+  complete->data.swap(assembled->data);
+
+  return complete;
+}
+
+}  // namespace carma_wm
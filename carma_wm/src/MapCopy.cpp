@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/MapCopy.hpp>
+#include <lanelet2_core/primitives/RegulatoryElement.h>
+#include <boost/variant/get.hpp>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace carma_wm
+{
+namespace
+{
+// Calls the given functions for every lanelet and area referenced by the parameters of a regulatory element
+template <class LaneletFunc, class AreaFunc>
+void forEachReferencedLaneletOrArea(const lanelet::RegulatoryElement& regem, LaneletFunc lanelet_func, AreaFunc area_func)
+{
+  for (const auto& role : regem.constData()->parameters)
+  {
+    for (const auto& param : role.second)
+    {
+      if (const auto* weak_llt = boost::get<lanelet::WeakLanelet>(&param))
+      {
+        if (!weak_llt->expired())
+          lanelet_func(weak_llt->lock().id());
+      }
+      else if (const auto* weak_area = boost::get<lanelet::WeakArea>(&param))
+      {
+        if (!weak_area->expired())
+          area_func(weak_area->lock().id());
+      }
+    }
+  }
+}
+}  // namespace
+
+lanelet::LaneletMapPtr copyMapForEdit(const lanelet::LaneletMapPtr& map, const std::vector<lanelet::Id>& lanelet_ids)
+{
+  // Regulatory elements indexed by the lanelets and areas they refer to
+  std::unordered_map<lanelet::Id, std::vector<lanelet::RegulatoryElementPtr>> regems_by_lanelet;
+  std::unordered_map<lanelet::Id, std::vector<lanelet::RegulatoryElementPtr>> regems_by_area;
+  for (const auto& regem : map->regulatoryElementLayer)
+  {
+    forEachReferencedLaneletOrArea(*regem,
+                                   [&](lanelet::Id id) { regems_by_lanelet[id].push_back(regem); },
+                                   [&](lanelet::Id id) { regems_by_area[id].push_back(regem); });
+  }
+
+  // Find every primitive which must be copied so that no shared primitive refers to a copied one or the other way around
+  std::unordered_set<lanelet::Id> copied_lanelet_ids;
+  std::unordered_set<lanelet::Id> copied_area_ids;
+  std::unordered_set<lanelet::Id> copied_regem_ids;
+  std::queue<lanelet::Id> lanelet_queue;
+  std::queue<lanelet::Id> area_queue;
+  std::queue<lanelet::RegulatoryElementPtr> regem_queue;
+
+  for (auto id : lanelet_ids)
+  {
+    if (map->laneletLayer.exists(id) && copied_lanelet_ids.insert(id).second)
+      lanelet_queue.push(id);
+  }
+
+  auto visit_regems = [&](const std::vector<lanelet::RegulatoryElementPtr>& regems) {
+    for (const auto& regem : regems)
+    {
+      if (copied_regem_ids.insert(regem->id()).second)
+        regem_queue.push(regem);
+    }
+  };
+
+  while (!lanelet_queue.empty() || !area_queue.empty() || !regem_queue.empty())
+  {
+    if (!lanelet_queue.empty())
+    {
+      auto id = lanelet_queue.front();
+      lanelet_queue.pop();
+      visit_regems(map->laneletLayer.get(id).regulatoryElements());
+      visit_regems(regems_by_lanelet[id]);
+    }
+    else if (!area_queue.empty())
+    {
+      auto id = area_queue.front();
+      area_queue.pop();
+      visit_regems(map->areaLayer.get(id).regulatoryElements());
+      visit_regems(regems_by_area[id]);
+    }
+    else
+    {
+      auto regem = regem_queue.front();
+      regem_queue.pop();
+      for (const auto& llt : map->laneletLayer.findUsages(regem))
+      {
+        if (copied_lanelet_ids.insert(llt.id()).second)
+          lanelet_queue.push(llt.id());
+      }
+      for (const auto& area : map->areaLayer.findUsages(regem))
+      {
+        if (copied_area_ids.insert(area.id()).second)
+          area_queue.push(area.id());
+      }
+      forEachReferencedLaneletOrArea(*regem,
+                                     [&](lanelet::Id id) {
+                                       if (map->laneletLayer.exists(id) && copied_lanelet_ids.insert(id).second)
+                                         lanelet_queue.push(id);
+                                     },
+                                     [&](lanelet::Id id) {
+                                       if (map->areaLayer.exists(id) && copied_area_ids.insert(id).second)
+                                         area_queue.push(id);
+                                     });
+    }
+  }
+
+  // Copy lanelets and areas first as the copied regulatory elements refer to them
+  std::unordered_map<lanelet::Id, lanelet::Lanelet> copied_lanelets;
+  for (auto id : copied_lanelet_ids)
+  {
+    auto llt = map->laneletLayer.get(id);
+    lanelet::Lanelet copy(id, llt.leftBound3d(), llt.rightBound3d(), llt.attributes());
+    if (llt.hasCustomCenterline())
+    {
+      auto centerline = llt.centerline3d();
+      copy.setCenterline(lanelet::LineString3d(std::const_pointer_cast<lanelet::LineStringData>(centerline.constData()), centerline.inverted()));
+    }
+    copied_lanelets.emplace(id, copy);
+  }
+
+  std::unordered_map<lanelet::Id, lanelet::Area> copied_areas;
+  for (auto id : copied_area_ids)
+  {
+    auto area = map->areaLayer.get(id);
+    copied_areas.emplace(id, lanelet::Area(id, area.outerBound(), area.innerBounds(), area.attributes()));
+  }
+
+  std::unordered_map<lanelet::Id, lanelet::RegulatoryElementPtr> copied_regems;
+  for (auto id : copied_regem_ids)
+  {
+    auto regem = map->regulatoryElementLayer.get(id);
+
+    lanelet::RuleParameterMap parameters = regem->constData()->parameters;
+    for (auto& role : parameters)
+    {
+      for (auto& param : role.second)
+      {
+        if (auto* weak_llt = boost::get<lanelet::WeakLanelet>(&param))
+        {
+          if (weak_llt->expired())
+            continue;
+          auto llt = weak_llt->lock();
+          auto copy = copied_lanelets.find(llt.id());
+          if (copy != copied_lanelets.end())
+            param = lanelet::WeakLanelet(llt.inverted() ? copy->second.invert() : copy->second);
+        }
+        else if (auto* weak_area = boost::get<lanelet::WeakArea>(&param))
+        {
+          if (weak_area->expired())
+            continue;
+          auto copy = copied_areas.find(weak_area->lock().id());
+          if (copy != copied_areas.end())
+            param = lanelet::WeakArea(copy->second);
+        }
+      }
+    }
+
+    auto data = std::make_shared<lanelet::RegulatoryElementData>(id, parameters, regem->attributes());
+    auto copy = lanelet::RegulatoryElementFactory::create(regem->attribute(lanelet::AttributeName::Subtype).value(), data);
+
+    // SPaT timing is held by the signal object rather than its data
+    auto signal = std::dynamic_pointer_cast<lanelet::CarmaTrafficSignal>(regem);
+    auto signal_copy = std::dynamic_pointer_cast<lanelet::CarmaTrafficSignal>(copy);
+    if (signal && signal_copy)
+      copyTrafficSignalTiming(*signal, *signal_copy);
+
+    copied_regems.emplace(id, copy);
+  }
+
+  auto resolve_regem = [&copied_regems](const lanelet::RegulatoryElementPtr& regem) {
+    auto copy = copied_regems.find(regem->id());
+    return copy != copied_regems.end() ? copy->second : regem;
+  };
+
+  for (auto& [id, copy] : copied_lanelets)
+  {
+    for (const auto& regem : map->laneletLayer.get(id).regulatoryElements())
+      copy.addRegulatoryElement(resolve_regem(regem));
+  }
+
+  for (auto& [id, copy] : copied_areas)
+  {
+    for (const auto& regem : map->areaLayer.get(id).regulatoryElements())
+      copy.addRegulatoryElement(resolve_regem(regem));
+  }
+
+  // Assemble the new map from the copied primitives and the shared remainder of the original map
+  lanelet::LaneletLayer::Map lanelets;
+  for (auto llt : map->laneletLayer)
+  {
+    auto copy = copied_lanelets.find(llt.id());
+    lanelets.emplace(llt.id(), copy != copied_lanelets.end() ? copy->second : llt);
+  }
+
+  lanelet::AreaLayer::Map areas;
+  for (auto area : map->areaLayer)
+  {
+    auto copy = copied_areas.find(area.id());
+    areas.emplace(area.id(), copy != copied_areas.end() ? copy->second : area);
+  }
+
+  lanelet::RegulatoryElementLayer::Map regems;
+  for (const auto& regem : map->regulatoryElementLayer)
+  {
+    regems.emplace(regem->id(), resolve_regem(regem));
+  }
+
+  lanelet::PolygonLayer::Map polygons;
+  for (auto polygon : map->polygonLayer)
+  {
+    polygons.emplace(polygon.id(), polygon);
+  }
+  lanelet::LineStringLayer::Map line_strings;
+  for (auto line_string : map->lineStringLayer)
+  {
+    line_strings.emplace(line_string.id(), line_string);
+  }
+  lanelet::PointLayer::Map points;
+  for (auto point : map->pointLayer)
+  {
+    points.emplace(point.id(), point);
+  }
+
+  return std::make_shared<lanelet::LaneletMap>(lanelets, areas, regems, polygons, line_strings, points);
+}
+
+void copyTrafficSignalTiming(const lanelet::CarmaTrafficSignal& from, lanelet::CarmaTrafficSignal& to)
+{
+  to.recorded_time_stamps = from.recorded_time_stamps;
+  to.recorded_start_time_stamps = from.recorded_start_time_stamps;
+  to.fixed_cycle_duration = from.fixed_cycle_duration;
+  to.signal_durations = from.signal_durations;
+  to.revision_ = from.revision_;
+}
+
+}  // namespace carma_wm
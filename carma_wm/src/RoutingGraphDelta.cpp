@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <carma_wm/RoutingGraphDelta.hpp>
+#include <carma_wm/RoutingGraphAccessor.hpp>
+#include <lanelet2_core/geometry/Lanelet.h>
+#include <rclcpp/rclcpp.hpp>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace carma_wm
+{
+namespace
+{
+bool isInverted(const lanelet::ConstLaneletOrArea& lanelet_or_area)
+{
+  return lanelet_or_area.isLanelet() && lanelet_or_area.lanelet()->inverted();
+}
+
+// splitmix64 finalizer. Spreads the bits of each field so that summing element hashes does not cancel them out
+uint64_t mix(uint64_t value)
+{
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+uint64_t combine(uint64_t seed, uint64_t value)
+{
+  return mix(seed ^ mix(value));
+}
+}  // namespace
+
+uint64_t routingGraphHash(const lanelet::routing::RoutingGraph& graph)
+{
+  const auto* readable_graph = static_cast<const RoutingGraphAccessor*>(&graph);
+  const auto& underlying_graph = readable_graph->getInternalGraph();
+
+  // Element hashes are summed so the result does not depend on insertion order
+  uint64_t hash = mix(readable_graph->getNumRoutingCosts());
+
+  boost::graph_traits<lanelet::routing::internal::GraphType>::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = boost::vertices(underlying_graph); vi != vi_end; ++vi)
+  {
+    const auto& lanelet_or_area = underlying_graph[*vi].laneletOrArea;
+
+    uint64_t vertex_hash = combine(static_cast<uint64_t>(lanelet_or_area.id()), isInverted(lanelet_or_area));
+    hash += combine(vertex_hash, lanelet_or_area.isLanelet());
+  }
+
+  boost::graph_traits<lanelet::routing::internal::GraphType>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(underlying_graph); ei != ei_end; ++ei)
+  {
+    const auto& from = underlying_graph[boost::source(*ei, underlying_graph)].laneletOrArea;
+    const auto& to = underlying_graph[boost::target(*ei, underlying_graph)].laneletOrArea;
+    const auto& edge_info = underlying_graph[*ei];
+
+    uint64_t cost_bits;
+    std::memcpy(&cost_bits, &edge_info.routingCost, sizeof(cost_bits));
+
+    uint64_t edge_hash = combine(static_cast<uint64_t>(from.id()), isInverted(from));
+    edge_hash = combine(edge_hash, static_cast<uint64_t>(to.id()));
+    edge_hash = combine(edge_hash, isInverted(to));
+    edge_hash = combine(edge_hash, static_cast<uint64_t>(edge_info.relation));
+    edge_hash = combine(edge_hash, edge_info.costId);
+    hash += combine(edge_hash, cost_bits);
+  }
+
+  // 0 marks a delta without a base graph
+  return hash == 0 ? 1 : hash;
+}
+
+RoutingGraphDelta computeRoutingGraphDelta(const lanelet::LaneletMap& map,
+                                           const lanelet::traffic_rules::TrafficRules& traffic_rules,
+                                           const std::vector<lanelet::Id>& affected_lanelet_ids,
+                                           const std::string& participant, double search_margin)
+{
+  RoutingGraphDelta delta;
+  delta.participant = participant;
+
+  std::unordered_set<lanelet::Id> affected_ids;
+  std::unordered_set<lanelet::Id> local_ids;
+  lanelet::ConstLanelets local_lanelets;
+  lanelet::ConstAreas local_areas;
+
+  const lanelet::BasicPoint2d margin(search_margin, search_margin);
+
+  for (auto id : affected_lanelet_ids)
+  {
+    auto llt_it = map.laneletLayer.find(id);
+
+    if (llt_it == map.laneletLayer.end() || !affected_ids.insert(id).second)
+    {
+      continue;
+    }
+
+    delta.affected_lanelet_ids.push_back(id);
+
+    // Collect every primitive which could share a routing relation with this lanelet
+    lanelet::BoundingBox2d search_box = lanelet::geometry::boundingBox2d(*llt_it);
+    search_box.min() -= margin;
+    search_box.max() += margin;
+
+    for (const auto& llt : map.laneletLayer.search(search_box))
+    {
+      if (local_ids.insert(llt.id()).second)
+      {
+        local_lanelets.push_back(llt);
+      }
+    }
+
+    for (const auto& area : map.areaLayer.search(search_box))
+    {
+      if (local_ids.insert(area.id()).second)
+      {
+        local_areas.push_back(area);
+      }
+    }
+  }
+
+  if (delta.affected_lanelet_ids.empty())
+  {
+    return delta;
+  }
+
+  auto local_map = lanelet::utils::createConstSubmap(local_lanelets, local_areas);
+  auto local_graph = lanelet::routing::RoutingGraph::build(*local_map, traffic_rules);
+
+  const auto* readable_graph = static_cast<const RoutingGraphAccessor*>(local_graph.get());
+  const auto& underlying_graph = readable_graph->getInternalGraph();
+
+  boost::graph_traits<lanelet::routing::internal::GraphType>::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = boost::vertices(underlying_graph); vi != vi_end; ++vi)
+  {
+    const auto& lanelet_or_area = underlying_graph[*vi].laneletOrArea;
+
+    if (lanelet_or_area.isLanelet() && affected_ids.find(lanelet_or_area.id()) != affected_ids.end())
+    {
+      RoutingGraphVertex vertex;
+      vertex.id = lanelet_or_area.id();
+      vertex.inverted = isInverted(lanelet_or_area);
+
+      delta.passable_vertices.push_back(vertex);
+    }
+  }
+
+  boost::graph_traits<lanelet::routing::internal::GraphType>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(underlying_graph); ei != ei_end; ++ei)
+  {
+    const auto& from = underlying_graph[boost::source(*ei, underlying_graph)].laneletOrArea;
+    const auto& to = underlying_graph[boost::target(*ei, underlying_graph)].laneletOrArea;
+
+    if (affected_ids.find(from.id()) == affected_ids.end() && affected_ids.find(to.id()) == affected_ids.end())
+    {
+      continue;
+    }
+
+    const auto& edge_info = underlying_graph[*ei];
+
+    RoutingGraphEdge edge;
+    edge.from = from.id();
+    edge.to = to.id();
+    edge.from_inverted = isInverted(from);
+    edge.to_inverted = isInverted(to);
+    edge.routing_cost = edge_info.routingCost;
+    edge.routing_cost_id = edge_info.costId;
+    edge.relation = static_cast<uint8_t>(edge_info.relation);
+
+    delta.edges.push_back(edge);
+  }
+
+  return delta;
+}
+
+std::shared_ptr<lanelet::routing::RoutingGraph> applyRoutingGraphDelta(const lanelet::routing::RoutingGraph& graph,
+                                                                      const RoutingGraphDelta& delta,
+                                                                      const lanelet::LaneletMapPtr& map)
+{
+  const auto* readable_graph = static_cast<const RoutingGraphAccessor*>(&graph);
+  const auto& underlying_graph = readable_graph->getInternalGraph();
+
+  std::unordered_set<lanelet::Id> affected_ids(delta.affected_lanelet_ids.begin(), delta.affected_lanelet_ids.end());
+
+  auto new_graph = std::make_unique<lanelet::routing::internal::RoutingGraphGraph>(readable_graph->getNumRoutingCosts());
+
+  // Passable primitives by id. Used to resolve edge end points and to build the passable submap
+  // Lanelets which are passable in both directions have a second vertex for their inverted form which is tracked separately
+  std::unordered_map<lanelet::Id, lanelet::ConstLaneletOrArea> vertices;
+  std::unordered_map<lanelet::Id, lanelet::ConstLaneletOrArea> inverted_vertices;
+
+  auto add_vertex = [&](const lanelet::ConstLaneletOrArea& lanelet_or_area) {
+    new_graph->addVertex(lanelet::routing::internal::VertexInfo{ lanelet_or_area });
+
+    auto& vertex_map = isInverted(lanelet_or_area) ? inverted_vertices : vertices;
+    vertex_map.emplace(lanelet_or_area.id(), lanelet_or_area);
+  };
+
+  // Finds the vertex of the new graph with the given id and direction. Returns nullptr if there is none
+  auto find_vertex = [&](lanelet::Id id, bool inverted) -> const lanelet::ConstLaneletOrArea* {
+    const auto& vertex_map = inverted ? inverted_vertices : vertices;
+    auto vertex_it = vertex_map.find(id);
+    return vertex_it == vertex_map.end() ? nullptr : &vertex_it->second;
+  };
+
+  // Keep every vertex the delta does not replace. Vertices are resolved against the map by id so the new graph refers
+  // to the primitives of the provided map even if it is a copy of the map the existing graph was built from
+  boost::graph_traits<lanelet::routing::internal::GraphType>::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = boost::vertices(underlying_graph); vi != vi_end; ++vi)
+  {
+    const auto& lanelet_or_area = underlying_graph[*vi].laneletOrArea;
+    lanelet::Id id = lanelet_or_area.id();
+
+    if (affected_ids.find(id) != affected_ids.end())
+    {
+      continue;
+    }
+
+    if (lanelet_or_area.isLanelet())
+    {
+      auto llt_it = map->laneletLayer.find(id);
+
+      if (llt_it == map->laneletLayer.end())
+      {
+        RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Routing graph references lanelet " << id << " which is not in the map");
+        return nullptr;
+      }
+
+      lanelet::ConstLanelet llt(*llt_it);
+      add_vertex(isInverted(lanelet_or_area) ? llt.invert() : llt);
+    }
+    else
+    {
+      auto area_it = map->areaLayer.find(id);
+
+      if (area_it == map->areaLayer.end())
+      {
+        RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Routing graph references area " << id << " which is not in the map");
+        return nullptr;
+      }
+
+      add_vertex(lanelet::ConstArea(*area_it));
+    }
+  }
+
+  for (const auto& vertex : delta.passable_vertices)
+  {
+    auto llt_it = map->laneletLayer.find(vertex.id);
+
+    if (llt_it == map->laneletLayer.end())
+    {
+      RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Routing graph delta references lanelet " << vertex.id << " which is not in the map");
+      return nullptr;
+    }
+
+    lanelet::ConstLanelet llt(*llt_it);
+    add_vertex(vertex.inverted ? llt.invert() : llt);
+  }
+
+  // Keep every edge which does not touch a replaced vertex
+  boost::graph_traits<lanelet::routing::internal::GraphType>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(underlying_graph); ei != ei_end; ++ei)
+  {
+    const auto& from = underlying_graph[boost::source(*ei, underlying_graph)].laneletOrArea;
+    const auto& to = underlying_graph[boost::target(*ei, underlying_graph)].laneletOrArea;
+
+    if (affected_ids.find(from.id()) != affected_ids.end() || affected_ids.find(to.id()) != affected_ids.end())
+    {
+      continue;
+    }
+
+    new_graph->addEdge(*find_vertex(from.id(), isInverted(from)), *find_vertex(to.id(), isInverted(to)), underlying_graph[*ei]);
+  }
+
+  for (const auto& edge : delta.edges)
+  {
+    const auto* from_vertex = find_vertex(edge.from, edge.from_inverted);
+    const auto* to_vertex = find_vertex(edge.to, edge.to_inverted);
+
+    if (!from_vertex || !to_vertex)
+    {
+      RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm"), "Routing graph delta references edge " << edge.from << " -> " << edge.to
+                                                          << " whose end points are not passable in the current graph");
+      return nullptr;
+    }
+
+    new_graph->addEdge(*from_vertex, *to_vertex,
+                       lanelet::routing::internal::EdgeInfo{ edge.routing_cost, edge.routing_cost_id,
+                                                             static_cast<lanelet::routing::RelationType>(edge.relation) });
+  }
+
+  // Every primitive with a vertex in either direction is passable. Lanelets are added in their normal form once
+  lanelet::ConstLanelets passable_lanelets;
+  lanelet::ConstAreas passable_areas;
+
+  for (const auto& vertex : vertices)
+  {
+    if (vertex.second.isLanelet())
+    {
+      passable_lanelets.push_back(*vertex.second.lanelet());
+    }
+    else
+    {
+      passable_areas.push_back(*vertex.second.area());
+    }
+  }
+
+  for (const auto& vertex : inverted_vertices)
+  {
+    if (vertices.find(vertex.first) == vertices.end())
+    {
+      passable_lanelets.push_back(vertex.second.lanelet()->invert());
+    }
+  }
+
+  auto passable_map = lanelet::utils::createConstSubmap(passable_lanelets, passable_areas);
+
+  return std::make_shared<lanelet::routing::RoutingGraph>(std::move(new_graph), std::move(passable_map));
+}
+
+}  // namespace carma_wm
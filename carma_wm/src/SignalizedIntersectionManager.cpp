@@ -17,6 +17,7 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <carma_wm/SignalizedIntersectionManager.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <algorithm>
 #include <j2735_v2x_msgs/msg/lane_type_attributes.hpp>
 
@@ -66,14 +67,14 @@ namespace carma_wm
       throw std::invalid_argument("Map is not initialized yet as the georeference was not found...");
     }
 
-    lanelet::projection::LocalFrameProjector local_projector(target_frame_.c_str());
+    auto local_projector = carma_wm::projection::getGeoreferenceProjector(target_frame_);
 
     lanelet::GPSPoint gps_point;
     gps_point.lat = intersection.ref_point.latitude;
     gps_point.lon = intersection.ref_point.longitude;
     gps_point.ele = intersection.ref_point.elevation;
 
-    auto ref_node  = local_projector.forward(gps_point);
+    auto ref_node  = local_projector->forward(gps_point);
 
     RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::SignalizedIntersectionManager"), "Reference node in map frame x: " << ref_node.x() << ", y: " << ref_node.y());
     
@@ -17,24 +17,21 @@
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <carma_wm/TrafficControl.hpp>
+#include <unordered_set>
 
 namespace carma_wm
 {
 
-void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::msg::MapBin* msg)
+void toBinMsg(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, autoware_lanelet2_msgs::msg::MapBin* msg,
+              carma_wm::MapBinCompression compression)
 {
   if (msg == nullptr)
   {
     RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::TrafficControl"), __FUNCTION__ << ": msg is null pointer!");
     return;
   }
-  std::stringstream ss;
-  boost::archive::binary_oarchive oa(ss);
-  oa << *gf_ptr;
-  std::string data_str(ss.str());
 
-  msg->data.clear();
-  msg->data.assign(data_str.begin(), data_str.end());
+  carma_wm::writeBinArchive([&gf_ptr](boost::archive::binary_oarchive& oa) { oa << *gf_ptr; }, compression, msg);
 }
 
 void fromBinMsg(const autoware_lanelet2_msgs::msg::MapBin& msg, std::shared_ptr<carma_wm::TrafficControl> gf_ptr, lanelet::LaneletMapPtr lanelet_map)
@@ -45,26 +42,37 @@ void fromBinMsg(const autoware_lanelet2_msgs::msg::MapBin& msg, std::shared_ptr<
     return;
   }
 
-  std::string data_str;
-  data_str.assign(msg.data.begin(), msg.data.end());
-  
-  std::stringstream ss;
-  ss << data_str;
-  boost::archive::binary_iarchive oa(ss);
-
-  oa >> *gf_ptr;
+  carma_wm::readBinArchive(msg, [&gf_ptr](boost::archive::binary_iarchive& ia) { ia >> *gf_ptr; });
 
   if (!lanelet_map)
     return;
-  
+
+  resolveMapReferences(gf_ptr, lanelet_map);
+}
+
+void resolveMapReferences(std::shared_ptr<carma_wm::TrafficControl> gf_ptr, lanelet::LaneletMapPtr lanelet_map)
+{
+  if (!gf_ptr || !lanelet_map)
+  {
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::TrafficControl"), __FUNCTION__ << ": gf_ptr or lanelet_map is null pointer!");
+    return;
+  }
+
   RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::TrafficControl"), "Lanelet Map is provided to match memory addresses of received binary map update");
  
   lanelet::utils::OverwriteParameterVisitor memory_visitor(lanelet_map);
-  // It is sufficient to check single regem as carma_wm_ctrl sends only one type of regem in each list
-  if (!gf_ptr->update_list_.empty())
-    gf_ptr->update_list_.front().second->applyVisitor(memory_visitor);
-  if (!gf_ptr->remove_list_.empty())
-    gf_ptr->remove_list_.front().second->applyVisitor(memory_visitor);
+  // An update combining several geofences holds one regem per geofence, each usually repeated for every lanelet it applies to
+  std::unordered_set<const lanelet::RegulatoryElement*> visited_regems;
+  for (const auto& pair : gf_ptr->update_list_)
+  {
+    if (visited_regems.insert(pair.second.get()).second)
+      pair.second->applyVisitor(memory_visitor);
+  }
+  for (const auto& pair : gf_ptr->remove_list_)
+  {
+    if (visited_regems.insert(pair.second.get()).second)
+      pair.second->applyVisitor(memory_visitor);
+  }
   
   RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::TrafficControl"), "Done resolving memory addresses of received regulatory elements!");
 }
@@ -53,21 +53,32 @@ WMListener::WMListener(
     use_sim_time_param_value = node_params_->declare_parameter("use_sim_time", rclcpp::ParameterValue (false));
   }
 
+  rclcpp::Parameter use_snapshots_param("use_world_model_snapshots");
+  if(!node_params_->get_parameter("use_world_model_snapshots", use_snapshots_param)){
+    rclcpp::ParameterValue use_snapshots_param_value;
+    use_snapshots_param_value = node_params_->declare_parameter("use_world_model_snapshots", rclcpp::ParameterValue (false));
+  }
+
   // Get params
   config_speed_limit_param = node_params_->get_parameter("config_speed_limit");
   participant_param = node_params_->get_parameter("vehicle_participant_type");
   use_sim_time_param = node_params_->get_parameter("use_sim_time");
+  use_snapshots_param = node_params_->get_parameter("use_world_model_snapshots");
 
 
   RCLCPP_INFO_STREAM(node_logging->get_logger(), "Loaded config speed limit: " << config_speed_limit_param.as_double());
   RCLCPP_INFO_STREAM(node_logging->get_logger(), "Loaded vehicle participant type: " << participant_param.as_string());
   RCLCPP_INFO_STREAM(node_logging->get_logger(), "Is using simulation time? : " << use_sim_time_param.as_bool());
+  RCLCPP_INFO_STREAM(node_logging->get_logger(), "Is using world model snapshots? : " << use_snapshots_param.as_bool());
 
 
   setConfigSpeedLimit(config_speed_limit_param.as_double());
   worker_->setVehicleParticipationType(participant_param.as_string());
   worker_->isUsingSimTime(use_sim_time_param.as_bool());
 
+  use_snapshots_ = use_snapshots_param.as_bool();
+  worker_->setSnapshotMode(use_snapshots_);
+
   rclcpp::SubscriptionOptions map_update_options;
   rclcpp::SubscriptionOptions map_options;
   rclcpp::SubscriptionOptions route_options;
@@ -99,35 +110,36 @@ WMListener::WMListener(
   route_sub_ = rclcpp::create_subscription<carma_planning_msgs::msg::Route>(node_topics_, "route", 1,
                                   [this](const carma_planning_msgs::msg::Route::SharedPtr msg)
                                   {
-                                    this->worker_->routeCallback(msg);
+                                    this->applyUpdate([this, msg]() { this->worker_->routeCallback(msg); return true; });
                                   }
                                   , route_options);
 
   ros1_clock_sub_ = rclcpp::create_subscription<rosgraph_msgs::msg::Clock>(node_topics_, "/clock", 1,
                                   [this](const rosgraph_msgs::msg::Clock::SharedPtr msg)
                                   {
-                                    this->worker_->ros1ClockCallback(msg);
+                                    // The clocks only affect how later SPaT messages are interpreted so no snapshot is published
+                                    this->applyUpdate([this, msg]() { this->worker_->ros1ClockCallback(msg); return false; });
                                   }
                                   , ros1_clock_options);
 
   sim_clock_sub_ = rclcpp::create_subscription<rosgraph_msgs::msg::Clock>(node_topics_, "/sim_clock", 1,
                                   [this](const rosgraph_msgs::msg::Clock::SharedPtr msg)
                                   {
-                                    this->worker_->simClockCallback(msg);
+                                    this->applyUpdate([this, msg]() { this->worker_->simClockCallback(msg); return false; });
                                   }
                                   , sim_clock_options);
 
   roadway_objects_sub_ = rclcpp::create_subscription<carma_perception_msgs::msg::RoadwayObstacleList>(node_topics_, "roadway_objects", 1,
                                   [this](const carma_perception_msgs::msg::RoadwayObstacleList::SharedPtr msg)
                                   {
-                                    this->worker_->roadwayObjectListCallback(msg);
+                                    this->applyUpdate([this, msg]() { this->worker_->roadwayObjectListCallback(msg); return true; });
                                   }
                                   , roadway_objects_options);
 
   traffic_spat_sub_ = rclcpp::create_subscription<carma_v2x_msgs::msg::SPAT>(node_topics_, "incoming_spat", 1,
                                   [this](const carma_v2x_msgs::msg::SPAT::SharedPtr msg)
                                   {
-                                    this->worker_->incomingSpatCallback(msg);
+                                    this->applyUpdate([this, msg]() { return this->worker_->incomingSpatCallback(msg); });
                                   }
                                   , traffic_spat_options);
 
@@ -146,7 +158,7 @@ WMListener::WMListener(
                   , map_update_options);
 
   map_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable; // Disable intra-process comms for the semantic map subscriber
-  auto map_sub_qos = rclcpp::QoS(rclcpp::KeepLast(2)); // Set the queue size for the semantic map subscriber
+  auto map_sub_qos = rclcpp::QoS(rclcpp::KeepAll()); // Keep every sample as large maps may arrive as a burst of chunks
   map_sub_qos.transient_local();  // If it is possible that this node is a late-joiner to its topic, it must be set to transient_local to receive earlier messages that were missed.
                                   // NOTE: The publisher's QoS must be set to transisent_local() as well for earlier messages to be resent to this later-joiner.
 
@@ -154,7 +166,7 @@ WMListener::WMListener(
   map_sub_ = rclcpp::create_subscription<autoware_lanelet2_msgs::msg::MapBin>(node_topics_, "semantic_map", map_sub_qos,
                   [this](const autoware_lanelet2_msgs::msg::MapBin::SharedPtr msg)
                   {
-                    this->worker_->mapCallback(msg);
+                    this->applyUpdate([this, msg]() { this->worker_->mapCallback(msg); return true; });
                   }
                   , map_options);
 }
@@ -175,6 +187,11 @@ bool WMListener::checkIfReRoutingNeededWL()
 
 WorldModelConstPtr WMListener::getWorldModel()
 {
+  if (use_snapshots_)
+  {
+    return worker_->getSnapshot();
+  }
+
   const std::lock_guard<std::mutex> lock(mw_mutex_);
   return worker_->getWorldModel();
 }
@@ -186,6 +203,22 @@ void WMListener::mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::SharedPt
   RCLCPP_INFO_STREAM(node_logging_->get_logger(), "New Map Update Received. SeqNum: " << geofence_msg->seq_id);
 
   worker_->mapUpdateCallback(geofence_msg);
+  worker_->publishSnapshot();
+}
+
+void WMListener::applyUpdate(const std::function<bool()>& update)
+{
+  if (!use_snapshots_)
+  {
+    update();
+    return;
+  }
+
+  const std::lock_guard<std::mutex> lock(mw_mutex_);
+  if (update())
+  {
+    worker_->publishSnapshot();
+  }
 }
 
 void WMListener::setMapCallback(std::function<void()> callback)
@@ -20,6 +20,10 @@
 #include <lanelet2_extension/regulatory_elements/CarmaTrafficSignal.h>
 #include <lanelet2_extension/regulatory_elements/SignalizedIntersection.h>
 #include <lanelet2_routing/internal/Graph.h>
+#include <carma_wm/RoutingGraphAccessor.hpp>
+#include <carma_wm/RoutingGraphDelta.hpp>
+#include <carma_wm/MapBinTransport.hpp>
+#include <carma_wm/MapCopy.hpp>
 #include "WMListenerWorker.hpp"
 
 namespace carma_wm
@@ -53,15 +57,25 @@ WorldModelConstPtr WMListenerWorker::getWorldModel() const
 }
 
 
-void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr map_msg)
+void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr chunk_msg)
 {
+  // Large maps may be published in chunks so wait until the whole map has been received
+  auto map_msg = map_assembler_.addMessage(chunk_msg);
+
+  if (!map_msg) {
+    RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Received map chunk. Waiting for the remaining chunks.");
+    return;
+  }
+
   current_map_version_ = map_msg->map_version;
 
   lanelet::LaneletMapPtr new_map(new lanelet::LaneletMap);
 
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
+  carma_wm::mapFromBinMsg(*map_msg, new_map);
 
   world_model_->setMap(new_map, current_map_version_);
+  map_shared_with_snapshot_ = false;
+  applied_route_msg_ = boost::none; // The applied route refers to lanelets of the previous map
 
   // After setting map evaluate the current update queue to apply any updates that arrived before the map
   bool more_updates_to_apply = true;
@@ -86,7 +100,7 @@ void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::msg::MapBin::Sh
   // Call user defined map callback
   if (map_callback_)
   {
-    map_callback_();
+    callUserCallback(map_callback_);
   }
 
   if (delayed_route_msg_) {
@@ -101,9 +115,9 @@ void WMListenerWorker::mapCallback(const autoware_lanelet2_msgs::msg::MapBin::Sh
   }
 }
 
-void WMListenerWorker::incomingSpatCallback(const carma_v2x_msgs::msg::SPAT::SharedPtr spat_msg)
+bool WMListenerWorker::incomingSpatCallback(const carma_v2x_msgs::msg::SPAT::SharedPtr spat_msg)
 {
-  world_model_->processSpatFromMsg(*spat_msg, use_sim_time_);
+  return world_model_->processSpatFromMsg(*spat_msg, use_sim_time_);
 }
 
 bool WMListenerWorker::checkIfReRoutingNeeded() const
@@ -190,7 +204,20 @@ void WMListenerWorker::mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::Sh
   auto gf_ptr = std::shared_ptr<carma_wm::TrafficControl>(new carma_wm::TrafficControl);
 
   // convert ros msg to geofence object
-  carma_wm::fromBinMsg(*geofence_msg, gf_ptr, world_model_->getMutableMap());
+  carma_wm::fromBinMsg(*geofence_msg, gf_ptr);
+
+  // Published snapshots must never observe a partially applied update so edit a private copy of the updated lanelets if needed
+  std::vector<lanelet::Id> updated_lanelet_ids;
+  updated_lanelet_ids.reserve(gf_ptr->update_list_.size() + gf_ptr->remove_list_.size());
+  for (const auto& pair : gf_ptr->update_list_)
+    updated_lanelet_ids.push_back(pair.first);
+  for (const auto& pair : gf_ptr->remove_list_)
+    updated_lanelet_ids.push_back(pair.first);
+
+  bool map_detached = detachMapFromSnapshots(updated_lanelet_ids);
+
+  // Match the memory addresses of the received regulatory elements with those of the map being edited
+  carma_wm::resolveMapReferences(gf_ptr, world_model_->getMutableMap());
 
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Processing Map Update with Geofence Id:" << gf_ptr->id_);
 
@@ -279,8 +306,11 @@ void WMListenerWorker::mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::Sh
     }
   }
 
-  // set the Map to trigger a new route graph construction if rerouting was required by the updates and a new graph was not provided
-  world_model_->setMap(world_model_->getMutableMap(), current_map_version_, recompute_route_flag_ && !geofence_msg->has_routing_graph );
+  // A routing graph delta is only needed if the full graph was not provided
+  bool apply_graph_delta = gf_ptr->has_routing_graph_delta_ && !geofence_msg->has_routing_graph;
+
+  // set the Map to trigger a new route graph construction if rerouting was required by the updates and a new graph or graph delta was not provided
+  world_model_->setMap(world_model_->getMutableMap(), current_map_version_, recompute_route_flag_ && !geofence_msg->has_routing_graph && !apply_graph_delta);
 
   // If a new graph was provided then set that graph
   // recompute_route_flag_ not checked here to support the case of the first map or map version changing
@@ -294,12 +324,31 @@ void WMListenerWorker::mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::Sh
 
     world_model_->setRoutingGraph(graph);
 
+  }
+  else if (apply_graph_delta) {
+
+    LaneletRoutingGraphPtr graph = routingGraphFromDelta(gf_ptr->routing_graph_delta_, world_model_->getMutableMap());
+
+    if (graph) {
+      world_model_->setRoutingGraph(graph);
+    } else {
+      // The delta could not be applied so fall back to rebuilding the whole graph from the updated map
+      RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Map update provided routing graph delta which could not be applied to the current graph. Rebuilding routing graph.");
+      world_model_->setMap(world_model_->getMutableMap(), current_map_version_, true);
+    }
+
   }
 
   // no need to reroute again unless received invalidated msg again
   if (recompute_route_flag_)
     recompute_route_flag_ = false;
 
+  // The route refers to the lanelets of the map it was computed on so it must be recomputed on the copied map
+  if (map_detached && applied_route_msg_ && !setRouteFromMsg(applied_route_msg_.get()))
+  {
+    RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Route could not be recomputed on the updated map. Keeping the previous route until a new route is received.");
+  }
+
 
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Finished Applying the Map Update with Geofence Id:" << gf_ptr->id_);
 
@@ -307,7 +356,7 @@ void WMListenerWorker::mapUpdateCallback(autoware_lanelet2_msgs::msg::MapBin::Sh
   if (map_callback_)
   {
     RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Calling user defined map update callback");
-    map_callback_();
+    callUserCallback(map_callback_);
   }
 }
 
@@ -565,6 +614,43 @@ LaneletRoutingGraphPtr WMListenerWorker::routingGraphFromMsg(const autoware_lane
 
 }
 
+LaneletRoutingGraphPtr WMListenerWorker::routingGraphFromDelta(const carma_wm::RoutingGraphDelta& delta, lanelet::LaneletMapPtr map) const {
+
+  if (delta.participant.compare(getVehicleParticipationType()) != 0) {
+
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"),"Received routing graph delta does not have matching vehicle type for world model. WM Type: "
+      << getVehicleParticipationType()
+      << " delta type: " << delta.participant
+    );
+
+    return nullptr;
+  }
+
+  auto current_graph = world_model_->getMapRoutingGraph();
+
+  if (!current_graph) {
+
+    RCLCPP_ERROR_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"),"Received routing graph delta before a routing graph was available to apply it to");
+
+    return nullptr;
+  }
+
+  // A delta only describes the change to the graph it was computed against. If this graph has diverged, for example
+  // because an update was missed or the graph was received in a form which does not carry inverted lanelets, then
+  // the caller rebuilds the full graph instead
+  if (delta.base_graph_hash != 0 && delta.base_graph_hash != carma_wm::routingGraphHash(*current_graph)) {
+
+    RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"),"Received routing graph delta was computed against a different routing graph than the current one");
+
+    return nullptr;
+  }
+
+  RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Applying routing graph delta affecting " << delta.affected_lanelet_ids.size()
+    << " lanelets with " << delta.edges.size() << " edges");
+
+  return carma_wm::applyRoutingGraphDelta(*current_graph, delta, map);
+}
+
 std::string WMListenerWorker::getVehicleParticipationType() const
 {
   return world_model_->getVehicleParticipationType();
@@ -656,34 +742,127 @@ void WMListenerWorker::routeCallback(const carma_planning_msgs::msg::Route::Shar
   else {
     rerouting_flag_ = false; // Reset flag since no applied queued map updates invalidated the route for the route node
 
-    auto path = lanelet::ConstLanelets();
-    for(auto id : route_msg->shortest_path_lanelet_ids)
-    {
-      auto ll = world_model_->getMap()->laneletLayer.get(id);
-      path.push_back(ll);
-    }
-
-    auto route_opt = path.size() == 1 ? world_model_->getMapRoutingGraph()->getRoute(path.front(), path.back())
-                                : world_model_->getMapRoutingGraph()->getRouteVia(path.front(), lanelet::ConstLanelets(path.begin() + 1, path.end() - 1), path.back());
-    if(route_opt.is_initialized()) {
-      RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Setting route in world model");
-      auto ptr = std::make_shared<lanelet::routing::Route>(std::move(route_opt.get()));
-      world_model_->setRoute(ptr);
-    }
-
-    world_model_->setRouteEndPoint({route_msg->end_point.x,route_msg->end_point.y,route_msg->end_point.z});
-    world_model_->setRouteName(route_msg->route_name);
+    setRouteFromMsg(*route_msg);
 
     // Call route_callback_
     if (route_callback_)
     {
-      route_callback_();
+      callUserCallback(route_callback_);
     }
 
     return;
   }
 }
 
+bool WMListenerWorker::setRouteFromMsg(const carma_planning_msgs::msg::Route& route_msg)
+{
+  auto path = lanelet::ConstLanelets();
+  for(auto id : route_msg.shortest_path_lanelet_ids)
+  {
+    auto ll = world_model_->getMap()->laneletLayer.get(id);
+    path.push_back(ll);
+  }
+
+  bool route_set = false;
+
+  // The message carries the full shortest path so the route can be built without searching the graph
+  auto route_opt = std::static_pointer_cast<const RoutingGraphAccessor>(world_model_->getMapRoutingGraph())->getRouteFromShortestPath(path);
+
+  if (!route_opt && !path.empty()) {
+    RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Route shortest path is not connected in the current routing graph. Searching the graph for the route");
+    route_opt = path.size() == 1 ? world_model_->getMapRoutingGraph()->getRoute(path.front(), path.back())
+                                 : world_model_->getMapRoutingGraph()->getRouteVia(path.front(), lanelet::ConstLanelets(path.begin() + 1, path.end() - 1), path.back());
+  }
+  if(route_opt.is_initialized()) {
+    RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Setting route in world model");
+    auto ptr = std::make_shared<lanelet::routing::Route>(std::move(route_opt.get()));
+    world_model_->setRoute(ptr);
+    route_set = true;
+  }
+
+  // Setting the end point modifies the route in place so a route which may be shared with snapshots is left untouched
+  if (route_set || !snapshot_mode_) {
+    world_model_->setRouteEndPoint({route_msg.end_point.x,route_msg.end_point.y,route_msg.end_point.z});
+    world_model_->setRouteName(route_msg.route_name);
+  }
+
+  applied_route_msg_ = route_msg;
+
+  return route_set;
+}
+
+bool WMListenerWorker::detachMapFromSnapshots(const std::vector<lanelet::Id>& lanelet_ids)
+{
+  if (!snapshot_mode_ || !map_shared_with_snapshot_ || !world_model_->getMap())
+  {
+    return false;
+  }
+
+  RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::WMListenerWorker"), "Copying map so the update does not modify published snapshots");
+
+  // Only the edited lanelets and the primitives connected to them are copied. Everything else stays shared
+  lanelet::LaneletMapPtr map_copy = carma_wm::copyMapForEdit(world_model_->getMutableMap(), lanelet_ids);
+
+  // Rebinding the existing graph to the copy is much cheaper than building a new one
+  LaneletRoutingGraphPtr rebound_graph;
+  auto current_graph = world_model_->getMapRoutingGraph();
+  if (current_graph)
+  {
+    rebound_graph = carma_wm::applyRoutingGraphDelta(*current_graph, carma_wm::RoutingGraphDelta(), map_copy);
+  }
+
+  world_model_->setMap(map_copy, current_map_version_, !rebound_graph);
+
+  if (rebound_graph)
+  {
+    world_model_->setRoutingGraph(rebound_graph);
+  }
+
+  map_shared_with_snapshot_ = false;
+
+  return true;
+}
+
+void WMListenerWorker::callUserCallback(const std::function<void()>& callback)
+{
+  // Users query the world model from their callbacks so the update must already be visible in the snapshot
+  publishSnapshot();
+  callback();
+}
+
+void WMListenerWorker::setSnapshotMode(bool enabled)
+{
+  snapshot_mode_ = enabled;
+  // SPaT updates must not modify the signals of a map shared with published snapshots
+  world_model_->setTrafficSignalCopyOnWrite(enabled);
+  publishSnapshot();
+}
+
+bool WMListenerWorker::isSnapshotModeEnabled() const
+{
+  return snapshot_mode_;
+}
+
+void WMListenerWorker::publishSnapshot()
+{
+  if (!snapshot_mode_)
+  {
+    return;
+  }
+
+  // The copy shares the map, routing graph, route indexes, roadway objects and SPaT timing with the worker. Each of
+  // those is replaced rather than modified while a snapshot holds it, so later updates copy only what they change
+  WorldModelConstPtr snapshot = std::make_shared<const CARMAWorldModel>(*world_model_);
+  std::atomic_store(&snapshot_, snapshot);
+
+  map_shared_with_snapshot_ = true;
+}
+
+WorldModelConstPtr WMListenerWorker::getSnapshot() const
+{
+  return std::atomic_load(&snapshot_);
+}
+
 void WMListenerWorker::setMapCallback(std::function<void()> callback)
 {
   map_callback_ = callback;
@@ -699,6 +878,7 @@ void WMListenerWorker::setConfigSpeedLimit(double config_lim)
   config_speed_limit_ = config_lim;
   //Function to load config_limit into CarmaWorldModel
    world_model_->setConfigSpeedLimit(config_speed_limit_);
+   publishSnapshot();
 }
 
 void WMListenerWorker::isUsingSimTime(bool use_sim_time)
@@ -715,6 +895,7 @@ void WMListenerWorker::setVehicleParticipationType(std::string participant)
 {
   //Function to load participation type into CarmaWorldModel
   world_model_->setVehicleParticipationType(participant);
+  publishSnapshot();
 }
 
 
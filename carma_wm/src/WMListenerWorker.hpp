@@ -20,6 +20,7 @@
 #include <carma_v2x_msgs/msg/spat.hpp>
 #include <carma_wm/CARMAWorldModel.hpp>
 #include <carma_wm/TrafficControl.hpp>
+#include <carma_wm/MapBinTransport.hpp>
 #include <queue>
 #include <carma_wm/SignalizedIntersectionManager.hpp>
 #include <utility>
@@ -47,9 +48,9 @@ public:
   /*!
    * \brief Callback for new map messages. Updates the underlying map
    *
-   * \param map_msg The new map messages to generate the map from
+   * \param chunk_msg The new map message to generate the map from or one chunk of it if the map was published in chunks
    */
-  void mapCallback(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr map_msg);
+  void mapCallback(const autoware_lanelet2_msgs::msg::MapBin::SharedPtr chunk_msg);
 
   /*!
    * \brief Callback for new map update messages (geofence). Updates the underlying map
@@ -141,16 +142,59 @@ public:
    */
   LaneletRoutingGraphPtr routingGraphFromMsg(const autoware_lanelet2_msgs::msg::RoutingGraph& msg, lanelet::LaneletMapPtr map) const;
 
+  /**
+   * \brief Helper function to apply a routing graph delta to the current routing graph of the world model
+   *
+   * \param delta The delta received with a map update
+   * \param map The map this graph applies to with the map update already applied
+   *
+   * \return nullptr if the delta is for a different participant, was computed against a different graph than the current one
+   *         or references lanelets which are not in the map or graph. The full graph must then be rebuilt
+   */
+  LaneletRoutingGraphPtr routingGraphFromDelta(const carma_wm::RoutingGraphDelta& delta, lanelet::LaneletMapPtr map) const;
+
   /**
    *  \brief incoming spat message
+   *
+   *  \return True if the timing of any traffic signal changed
    */
-  void incomingSpatCallback(const carma_v2x_msgs::msg::SPAT::SharedPtr spat_msg);
+  bool incomingSpatCallback(const carma_v2x_msgs::msg::SPAT::SharedPtr spat_msg);
 
   /**
    *  \brief set true if simulation_mode is on
    */
   void isUsingSimTime(bool use_sim_time);
 
+  /**
+   * \brief Enables or disables snapshot mode. In snapshot mode each call to publishSnapshot() publishes an immutable copy
+   *        of the world model which readers can hold without locking. Map updates are then applied to a private copy
+   *        of the map whenever the current map is shared with a published snapshot and SPaT updates are applied to
+   *        private copies of the traffic signals.
+   *        Enabling snapshot mode immediately publishes a snapshot of the current world model.
+   *
+   * \param enabled True if snapshot mode should be used
+   */
+  void setSnapshotMode(bool enabled);
+
+  /**
+   * \brief Returns true if snapshot mode is enabled
+   */
+  bool isSnapshotModeEnabled() const;
+
+  /**
+   * \brief Publishes a copy of the current world model as the latest snapshot. Does nothing if snapshot mode is disabled.
+   *        NOTE: Calls to this function must be serialized with the other update functions of this class
+   */
+  void publishSnapshot();
+
+  /**
+   * \brief Returns the most recently published snapshot. This function does not lock and may be called from any thread
+   *        while updates are being applied.
+   *
+   * \return The latest snapshot or nullptr if snapshot mode has never been enabled
+   */
+  WorldModelConstPtr getSnapshot() const;
+
 private:
   std::shared_ptr<CARMAWorldModel> world_model_;
   bool use_sim_time_;
@@ -159,6 +203,37 @@ private:
   void newRegemUpdateHelper(lanelet::Lanelet parent_llt, lanelet::RegulatoryElement* regem) const;
   double config_speed_limit_;
 
+  /**
+   * \brief Helper function which sets the world model route from a route message. The route is only updated if the
+   *        routing graph contains a path through the lanelets of the message.
+   *
+   * \return True if the route was set
+   */
+  bool setRouteFromMsg(const carma_planning_msgs::msg::Route& route_msg);
+
+  /**
+   * \brief Helper function which replaces the world model map with a private copy if the map is shared with a
+   *        published snapshot. Only the given lanelets and the primitives connected to them are copied, see
+   *        carma_wm::copyMapForEdit. The routing graph is rebound to the copy. The route must be reset afterwards.
+   *
+   * \param lanelet_ids The ids of the lanelets which will be edited
+   *
+   * \return True if the map was copied
+   */
+  bool detachMapFromSnapshots(const std::vector<lanelet::Id>& lanelet_ids);
+
+  /**
+   * \brief Helper function which publishes a snapshot if needed and then calls the provided user callback
+   */
+  void callUserCallback(const std::function<void()>& callback);
+
+  carma_wm::MapBinChunkAssembler map_assembler_; // Reassembles maps which are published in chunks
+
+  bool snapshot_mode_ = false; // If true updates are published as immutable snapshots of the world model
+  bool map_shared_with_snapshot_ = false; // True if the current map is referenced by a published snapshot
+  WorldModelConstPtr snapshot_; // Latest snapshot. Only accessed through std::atomic_load and std::atomic_store
+  boost::optional<carma_planning_msgs::msg::Route> applied_route_msg_; // Last route message applied to the world model
+
   size_t current_map_version_ = 0; // Current map version based on recived map messages
   std::queue<autoware_lanelet2_msgs::msg::MapBin::SharedPtr> map_update_queue_; // Update queue used to cache map updates when they cannot be immeadiatly applied due to waiting for rerouting
   boost::optional<carma_planning_msgs::msg::Route> delayed_route_msg_;
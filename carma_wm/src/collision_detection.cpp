@@ -17,78 +17,195 @@
 ------------------------------------------------------------------------------*/
 
 #include "carma_wm/collision_detection.hpp"
+#include <limits>
+#include <unordered_map>
 
 namespace carma_wm {
 
     namespace collision_detection {
 
-        //TODO: consider rewriting this method to improve efficiency; it has object_count*prediction_count*trajectory_point sqrt calls!
-        std::vector<carma_perception_msgs::msg::RoadwayObstacle> WorldCollisionDetection(const carma_perception_msgs::msg::RoadwayObstacleList& rwol, const carma_planning_msgs::msg::TrajectoryPlan& tp, 
-                                                                        const geometry_msgs::msg::Vector3& size, const geometry_msgs::msg::Twist& velocity) {
+        namespace
+        {
+            /*! \brief Footprint of an object at a point in time along with its bounding box
+            */
+            struct TimedFootprint
+            {
+                polygon_t polygon;
+                box_t box;
+                double time = 0; // seconds
+            };
+
+            /*! \brief Key of a broadphase bucket. A bucket is one uniform grid cell within one time slice
+            */
+            struct BucketKey
+            {
+                int64_t time_slice;
+                int64_t cell_x;
+                int64_t cell_y;
+
+                bool operator==(const BucketKey& other) const
+                {
+                    return time_slice == other.time_slice && cell_x == other.cell_x && cell_y == other.cell_y;
+                }
+            };
+
+            struct BucketKeyHash
+            {
+                size_t operator()(const BucketKey& key) const
+                {
+                    return (static_cast<size_t>(key.time_slice) * 73856093u) ^ (static_cast<size_t>(key.cell_x) * 19349663u) ^
+                           (static_cast<size_t>(key.cell_y) * 83492791u);
+                }
+            };
+
+            TimedFootprint MakeFootprint(const geometry_msgs::msg::Pose& pose, const geometry_msgs::msg::Vector3& size, double time)
+            {
+                TimedFootprint footprint;
+                footprint.polygon = ObjectToBoostPolygon<polygon_t>(pose, size);
+                boost::geometry::correct(footprint.polygon); // Close the ring so it can be used with boost predicates
+                boost::geometry::envelope(footprint.polygon, footprint.box);
+                footprint.time = time;
+                return footprint;
+            }
 
+            int64_t ToCell(double value)
+            {
+                return static_cast<int64_t>(std::floor(value / BROADPHASE_CELL_SIZE));
+            }
 
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "WorldCollisionDetection");
+            double ToSeconds(const builtin_interfaces::msg::Time& stamp)
+            {
+                return static_cast<double>(stamp.sec) + static_cast<double>(stamp.nanosec) * 1e-9;
+            }
+        }
+
+        std::vector<carma_perception_msgs::msg::RoadwayObstacle> WorldCollisionDetection(const carma_perception_msgs::msg::RoadwayObstacleList& rwol, const carma_planning_msgs::msg::TrajectoryPlan& tp, 
+                                                                        const geometry_msgs::msg::Vector3& size) {
 
             std::vector<carma_perception_msgs::msg::RoadwayObstacle> rwo_collison;
 
+            if (tp.trajectory_points.empty()) {
+                return rwo_collison;
+            }
 
-            for (auto i : rwol.roadway_obstacles) {
+            // Build host vehicle footprints oriented along the trajectory
+            std::vector<TimedFootprint> host_footprints;
+            host_footprints.reserve(tp.trajectory_points.size());
 
-                for (auto j : i.object.predictions) {
+            double yaw = 0;
+            for (size_t k = 0; k < tp.trajectory_points.size(); k++) {
 
-                    for(size_t k=0; k < tp.trajectory_points.size(); k++) {
+                const auto& point = tp.trajectory_points[k];
 
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "in for loop");
+                if (k + 1 < tp.trajectory_points.size()) {
+                    const auto& next = tp.trajectory_points[k + 1];
+                    if (next.x != point.x || next.y != point.y) {
+                        yaw = std::atan2(next.y - point.y, next.x - point.x);
+                    }
+                } // The final point keeps the heading of the previous segment
 
-                        double distancex = (tp.trajectory_points[k].x - j.predicted_position.position.x)*(tp.trajectory_points[k].x - j.predicted_position.position.x);
-                        double distancey = (tp.trajectory_points[k].y - j.predicted_position.position.y)*(tp.trajectory_points[k].y - j.predicted_position.position.y);
+                tf2::Quaternion orientation;
+                orientation.setRPY(0, 0, yaw);
 
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "tp.trajectory_points[k].x");
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), tp.trajectory_points[k].x);
+                geometry_msgs::msg::Pose pose;
+                pose.position.x = point.x;
+                pose.position.y = point.y;
+                pose.orientation = tf2::toMsg(orientation);
 
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "j.predicted_position.position.x");
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), j.predicted_position.position.x);
+                host_footprints.push_back(MakeFootprint(pose, size, ToSeconds(point.target_time)));
+            }
 
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "tp.trajectory_points[k].y");
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), tp.trajectory_points[k].y);
+            // Broadphase: bucket each host footprint into every grid cell its bounding box overlaps within its time slice
+            std::unordered_map<BucketKey, std::vector<size_t>, BucketKeyHash> buckets;
+            for (size_t k = 0; k < host_footprints.size(); k++) {
 
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "j.predicted_position.position.y");
-                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), j.predicted_position.position.y);
+                const auto& footprint = host_footprints[k];
+                int64_t time_slice = static_cast<int64_t>(std::floor(footprint.time / COLLISION_TIME_WINDOW));
+
+                for (int64_t cx = ToCell(footprint.box.min_corner().get<0>()); cx <= ToCell(footprint.box.max_corner().get<0>()); cx++) {
+                    for (int64_t cy = ToCell(footprint.box.min_corner().get<1>()); cy <= ToCell(footprint.box.max_corner().get<1>()); cy++) {
+                        buckets[{time_slice, cx, cy}].push_back(k);
+                    }
+                }
+            }
 
+            size_t exact_checks = 0;
 
-                        double calcdistance = sqrt(abs(distancex + distancey));
+            // A host footprint can be in several of the buckets a prediction visits. Each footprint records the last prediction
+            // it was checked against so it is only checked once per prediction
+            std::vector<size_t> last_checked_prediction(host_footprints.size(), std::numeric_limits<size_t>::max());
+            size_t prediction_count = 0;
 
-                        rclcpp::Duration diff= rclcpp::Time(j.header.stamp) - rclcpp::Time(tp.trajectory_points[k].target_time);
+            for (const auto& obstacle : rwol.roadway_obstacles) {
 
-                        double timediff = diff.seconds();
+                bool collision = false;
 
-                        double x = (i.object.size.x - size.x)*(i.object.size.x - size.x);
-                        double y = (i.object.size.y - size.y)*(i.object.size.y - size.y);
-                        
-                        double car_t_x = tp.trajectory_points[k].x - tp.trajectory_points[0].x / velocity.linear.x;
-                        // double car_t_y = tp.trajectory_points[k].y - tp.trajectory_points[0].y/velocity.linear.y;
+                for (const auto& prediction : obstacle.object.predictions) {
 
-                        double object_t_x = j.predicted_position.position.x - i.object.predictions[0].predicted_position.position.x / i.object.velocity.twist.linear.x;
-                        // double object_t_y = j.predicted_position.position.y - i.object.predictions[0].predicted_position.position.y / j.predicted_velocity.linear.y;
+                    size_t prediction_id = prediction_count++;
+                    TimedFootprint object_footprint = MakeFootprint(prediction.predicted_position, obstacle.object.size, ToSeconds(prediction.header.stamp));
+                    int64_t time_slice = static_cast<int64_t>(std::floor(object_footprint.time / COLLISION_TIME_WINDOW));
 
+                    // Any host footprint within the time window must be in the same or an adjacent time slice
+                    for (int64_t ts = time_slice - 1; ts <= time_slice + 1 && !collision; ts++) {
+                        for (int64_t cx = ToCell(object_footprint.box.min_corner().get<0>()); cx <= ToCell(object_footprint.box.max_corner().get<0>()) && !collision; cx++) {
+                            for (int64_t cy = ToCell(object_footprint.box.min_corner().get<1>()); cy <= ToCell(object_footprint.box.max_corner().get<1>()) && !collision; cy++) {
 
-                        if(timediff <= 5) {
-                            if(calcdistance <= sqrt(x - y) ) {
-                                rwo_collison.push_back(i);
-                                break;
+                                auto bucket = buckets.find({ts, cx, cy});
+                                if (bucket == buckets.end()) {
+                                    continue;
+                                }
+
+                                for (size_t k : bucket->second) {
+
+                                    if (last_checked_prediction[k] == prediction_id) {
+                                        continue;
+                                    }
+                                    last_checked_prediction[k] = prediction_id;
+
+                                    const auto& host_footprint = host_footprints[k];
+
+                                    if (std::fabs(object_footprint.time - host_footprint.time) > COLLISION_TIME_WINDOW) {
+                                        continue;
+                                    }
+
+                                    // Bounding box rejection
+                                    if (boost::geometry::disjoint(object_footprint.box, host_footprint.box)) {
+                                        continue;
+                                    }
+
+                                    // Exact polygon test
+                                    exact_checks++;
+                                    if (boost::geometry::intersects(object_footprint.polygon, host_footprint.polygon)) {
+                                        collision = true;
+                                        break;
+                                    }
+                                }
                             }
                         }
                     }
-                }
 
+                    if (collision) {
+                        break;
+                    }
+                }
 
+                if (collision) {
+                    rwo_collison.push_back(obstacle);
+                }
             }
 
-
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "WorldCollisionDetection checked " << rwol.roadway_obstacles.size()
+                << " obstacles against " << host_footprints.size() << " trajectory points using " << exact_checks << " exact polygon checks. Collisions: " << rwo_collison.size());
 
             return rwo_collison;
         }
 
+        std::vector<carma_perception_msgs::msg::RoadwayObstacle> WorldCollisionDetection(const carma_perception_msgs::msg::RoadwayObstacleList& rwol, const carma_planning_msgs::msg::TrajectoryPlan& tp, 
+                                                                        const geometry_msgs::msg::Vector3& size, const geometry_msgs::msg::Twist&) {
+            return WorldCollisionDetection(rwol, tp, size);
+        }
+
         collision_detection::MovingObject ConvertRoadwayObstacleToMovingObject(const carma_perception_msgs::msg::RoadwayObstacle& rwo){
 
             collision_detection::MovingObject mo;
@@ -175,6 +292,15 @@ namespace carma_wm {
 
         bool CheckPolygonIntersection(collision_detection::MovingObject const &ob_1, collision_detection::MovingObject const &ob_2) {    
 
+                // Reject using bounding boxes before computing the polygon intersection
+                box_t box_1, box_2;
+                boost::geometry::envelope(ob_1.object_polygon, box_1);
+                boost::geometry::envelope(ob_2.object_polygon, box_2);
+
+                if (boost::geometry::disjoint(box_1, box_2)) {
+                    return false;
+                }
+
                 std::deque<polygon_t> output;
 
                 boost::geometry::intersection(ob_1.object_polygon, ob_2.object_polygon, output); 
@@ -25,6 +25,8 @@
 #include <lanelet2_extension/regulatory_elements/PassingControlLine.h>
 #include <carma_wm/WMTestLibForGuidance.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <queue>
+#include <set>
 
 
 namespace carma_wm
@@ -411,6 +413,83 @@ TEST(CARMAWorldModelTest, getInLaneObjects)
 
 }
 
+TEST(CARMAWorldModelTest, getInLaneObjectsIndexFollowsMap)
+{
+  carma_wm::CARMAWorldModel cmw;
+  std::vector<lanelet::Lanelet> llts;
+  lanelet::LaneletMapPtr map;
+  std::vector<carma_perception_msgs::msg::ExternalObject> obstacles;
+
+  createTestingWorld(llts, map, obstacles);
+
+  // Convert to RoadwayObstacle format with a temporary world model as the map is needed for the conversion
+  carma_wm::CARMAWorldModel converter;
+  converter.setMap(map);
+
+  std::vector<carma_perception_msgs::msg::RoadwayObstacle> roadway_objects;
+  for (auto obj : obstacles)
+  {
+    roadway_objects.push_back(converter.toRoadwayObstacle(obj).get());
+  }
+
+  // Objects set before the map can only be indexed under their own lanelet
+  cmw.setRoadwayObjects(roadway_objects);
+  cmw.setMap(map);
+
+  // Once the map is set the lane changing object is also found in the neighboring lane
+  for (int i = 0; i < 3; i++)
+  {
+    ASSERT_EQ(cmw.getInLaneObjects(llts[i], LANE_FULL).size(), 2u);
+  }
+  for (int i = 3; i < 6; i++)
+  {
+    ASSERT_EQ(cmw.getInLaneObjects(llts[i], LANE_FULL).size(), 4u);
+  }
+
+  // Each object is reported once even if it is indexed under several lanelets of the lane
+  auto in_lane_objects = cmw.getInLaneObjects(llts[3], LANE_FULL);
+  std::set<uint32_t> object_ids;
+  for (const auto& obj : in_lane_objects)
+  {
+    object_ids.insert(obj.object.id);
+  }
+  ASSERT_EQ(in_lane_objects.size(), object_ids.size());
+
+  // Clearing the objects clears the index
+  cmw.setRoadwayObjects({});
+  ASSERT_EQ(cmw.getInLaneObjects(llts[3], LANE_FULL).size(), 0u);
+}
+
+TEST(CARMAWorldModelTest, copySharesRoadwayObjects)
+{
+  carma_wm::CARMAWorldModel cmw;
+  std::vector<lanelet::Lanelet> llts;
+  lanelet::LaneletMapPtr map;
+  std::vector<carma_perception_msgs::msg::ExternalObject> obstacles;
+
+  createTestingWorld(llts, map, obstacles);
+  cmw.setMap(map);
+
+  std::vector<carma_perception_msgs::msg::RoadwayObstacle> roadway_objects;
+  for (auto obj : obstacles)
+  {
+    roadway_objects.push_back(cmw.toRoadwayObstacle(obj).get());
+  }
+  cmw.setRoadwayObjects(roadway_objects);
+
+  // The copy shares the objects and their index until the original receives new ones
+  carma_wm::CARMAWorldModel copy(cmw);
+  cmw.setRoadwayObjects({ roadway_objects[0] });
+
+  ASSERT_EQ(copy.getRoadwayObjects().size(), roadway_objects.size());
+  ASSERT_EQ(copy.getInLaneObjects(llts[3], LANE_FULL).size(), 4u);
+  ASSERT_EQ(cmw.getRoadwayObjects().size(), 1u);
+
+  // A map update reindexes the original without affecting the copy
+  cmw.setMap(map, 1, false);
+  ASSERT_EQ(copy.getInLaneObjects(llts[3], LANE_FULL).size(), 4u);
+}
+
 TEST(CARMAWorldModelTest, distToNearestObjInLane)
 {
    /*
@@ -571,6 +650,14 @@ TEST(CARMAWorldModelTest, getSetMap)
   ASSERT_TRUE((bool)cmw.getMap());
   ASSERT_FALSE((bool)cmw.getRoute());
   ASSERT_TRUE((bool)cmw.getMapRoutingGraph());
+
+  // Updating the current map in place keeps the map version but changes the update count
+  size_t map_version = cmw.getMapVersion();
+  size_t update_count = cmw.getMapUpdateCount();
+  ASSERT_EQ(1u, update_count);
+  cmw.setMap(cmw.getMutableMap(), map_version, false);
+  ASSERT_EQ(map_version, cmw.getMapVersion());
+  ASSERT_EQ(update_count + 1, cmw.getMapUpdateCount());
 }
 
 TEST(CARMAWorldModelTest, getSetRoute)
@@ -727,6 +814,61 @@ TEST(CARMAWorldModelTest, routeTrackPos_point)
   ASSERT_NEAR(1.0, result.crosstrack, 0.000001);
 }
 
+TEST(CARMAWorldModelTest, routeTrackPos_batch)
+{
+  CARMAWorldModel cmw;
+
+  ///// Test route exception
+  ASSERT_THROW(cmw.routeTrackPos(std::vector<lanelet::BasicPoint2d>({ lanelet::BasicPoint2d(0, 0) })), std::invalid_argument);
+
+  ///// Test disjoint route where lane changes break the reference line
+  addDisjointRoute(cmw);
+
+  std::vector<lanelet::BasicPoint2d> points;
+  for (double y = -0.5; y <= 2.5; y += 0.05)
+  {
+    points.emplace_back(0.5, y);
+  }
+  for (double x = 0.5; x <= 1.5; x += 0.05)
+  {
+    points.emplace_back(x, 1.5);
+  }
+
+  auto batch = cmw.routeTrackPos(points);
+  ASSERT_EQ(points.size(), batch.size());
+  for (size_t i = 0; i < points.size(); i++)
+  {
+    TrackPos expected = cmw.routeTrackPos(points[i]);
+    ASSERT_NEAR(expected.downtrack, batch[i].downtrack, 0.000001) << "index: " << i;
+    ASSERT_NEAR(expected.crosstrack, batch[i].crosstrack, 0.000001) << "index: " << i;
+  }
+
+  ///// Test long route with the cursor used across calls
+  addLongTwoLaneRoute(cmw, 500, 10.0);
+
+  points.clear();
+  for (double y = 0.0; y <= 5000.0; y += 0.5)
+  {
+    points.emplace_back(1.85 + 0.5 * std::sin(y / 20.0), y);
+  }
+
+  RouteTrackPosCursor cursor;
+  for (const auto& p : points)
+  {
+    TrackPos expected = cmw.routeTrackPos(p);
+    TrackPos result = cmw.routeTrackPos(p, cursor);
+
+    ASSERT_NEAR(expected.downtrack, result.downtrack, 0.000001);
+    ASSERT_NEAR(expected.crosstrack, result.crosstrack, 0.000001);
+  }
+
+  ///// Test cursor from a previous route is not reused
+  addStraightRoute(cmw);
+  TrackPos result = cmw.routeTrackPos(lanelet::BasicPoint2d(0.5, 1.5), cursor);
+  ASSERT_NEAR(1.5, result.downtrack, 0.000001);
+  ASSERT_NEAR(0.0, result.crosstrack, 0.000001);
+}
+
 TEST(CARMAWorldModelTest, routeTrackPos_lanelet)
 {
   CARMAWorldModel cmw;
@@ -873,6 +1015,69 @@ TEST(CARMAWorldModelTest, getLaneletsBetween) // HERE
   ASSERT_NEAR(result[0].id(), (cmw.getRoute()->shortestPath().begin() + 1)->id(), 0.000001);
 }
 
+TEST(CARMAWorldModelTest, getLaneletsBetweenLargeRoute)
+{
+  CARMAWorldModel cmw;
+
+  // 2 lanes of 1000 lanelets each giving a 10km route
+  addLongTwoLaneRoute(cmw, 1000, 10.0);
+
+  ASSERT_EQ(2000u, cmw.getRoute()->laneletMap()->laneletLayer.size());
+
+  // Reference implementation which projects every route lanelet on each call
+  auto brute_force_between = [&cmw](double start, double end, bool shortest_path_only) {
+    std::vector<std::pair<double, lanelet::Id>> matches;
+    for (lanelet::ConstLanelet ll : cmw.getRoute()->laneletMap()->laneletLayer)
+    {
+      bool on_path = std::any_of(cmw.getRoute()->shortestPath().begin(), cmw.getRoute()->shortestPath().end(),
+                                 [&ll](const lanelet::ConstLanelet& path_ll) { return path_ll.id() == ll.id(); });
+      if (shortest_path_only && !on_path)
+      {
+        continue;
+      }
+      auto centerline = lanelet::utils::to2D(ll.centerline());
+      double min = cmw.routeTrackPos(centerline.front()).downtrack;
+      double max = cmw.routeTrackPos(centerline.back()).downtrack;
+      if (std::max(min, start) > std::min(max, end) || (start == end && (min > start || max < end)))
+      {
+        continue;
+      }
+      matches.emplace_back(min, ll.id());
+    }
+    return matches;
+  };
+
+  std::vector<std::pair<double, double>> windows = { { 0, 0 },       { 0, 50 },      { 995, 1005 },
+                                                     { 4000, 4000 }, { 5000, 5120 }, { 9990, 10000 },
+                                                     { -10, 5 },     { 10000, 10010 } };
+
+  for (const auto& window : windows)
+  {
+    for (bool shortest_path_only : { false, true })
+    {
+      auto expected = brute_force_between(window.first, window.second, shortest_path_only);
+      auto result = cmw.getLaneletsBetween(window.first, window.second, shortest_path_only);
+
+      ASSERT_EQ(expected.size(), result.size()) << "window: " << window.first << ", " << window.second;
+
+      std::vector<lanelet::Id> expected_ids, result_ids;
+      for (const auto& match : expected)
+        expected_ids.push_back(match.second);
+      for (const auto& ll : result)
+        result_ids.push_back(ll.id());
+      std::sort(expected_ids.begin(), expected_ids.end());
+      std::sort(result_ids.begin(), result_ids.end());
+      ASSERT_EQ(expected_ids, result_ids);
+
+      // Output must remain ordered by downtrack
+      for (size_t i = 1; i < result.size(); i++)
+      {
+        ASSERT_LE(cmw.routeTrackPos(result[i - 1]).downtrack, cmw.routeTrackPos(result[i]).downtrack + 0.000001);
+      }
+    }
+  }
+}
+
 TEST(CARMAWorldModelTest, getTrafficRules)
 {
   CARMAWorldModel cmw;
@@ -1031,6 +1236,62 @@ TEST(CARMAWorldModelTest, toRoadwayObstacle)
   ASSERT_FALSE(!!result);
 }
 
+TEST(CARMAWorldModelTest, toRoadwayObstacles)
+{
+  carma_wm::CARMAWorldModel cmw;
+  std::vector<lanelet::Lanelet> llts;
+  lanelet::LaneletMapPtr map;
+  std::vector<carma_perception_msgs::msg::ExternalObject> obstacles;
+
+  createTestingWorld(llts, map, obstacles);
+
+  carma_perception_msgs::msg::ExternalObjectList object_list;
+  object_list.objects = obstacles;
+
+  // Test no map set
+  ASSERT_THROW(cmw.toRoadwayObstacles(object_list), std::invalid_argument);
+
+  cmw.setMap(map);
+
+  // Predictions of the first object move along its lane into the successors of its lanelet
+  auto& moving_obj = object_list.objects[0];
+  moving_obj.predictions.resize(3, moving_obj.predictions[0]);
+  moving_obj.predictions[1].predicted_position.position.y = 12;
+  moving_obj.predictions[2].predicted_position.position.y = 19;
+
+  // An object which is off the road is dropped
+  carma_perception_msgs::msg::ExternalObject off_road_obj = obstacles[0];
+  off_road_obj.pose.pose.position.x = 100;
+  off_road_obj.pose.pose.position.y = 100;
+  object_list.objects.push_back(off_road_obj);
+
+  // Repeat the objects so the conversion is split across threads
+  auto base_objects = object_list.objects;
+  for (int i = 0; i < 20; i++)
+  {
+    object_list.objects.insert(object_list.objects.end(), base_objects.begin(), base_objects.end());
+  }
+
+  auto result = cmw.toRoadwayObstacles(object_list, 4);
+
+  std::vector<carma_perception_msgs::msg::RoadwayObstacle> expected;
+  for (const auto& obj : object_list.objects)
+  {
+    auto obs = cmw.toRoadwayObstacle(obj);
+    if (obs)
+      expected.push_back(obs.get());
+  }
+
+  ASSERT_EQ(21u * obstacles.size(), result.roadway_obstacles.size());
+  ASSERT_EQ(expected, result.roadway_obstacles);
+
+  const auto& moving_obs = result.roadway_obstacles[0];
+  ASSERT_EQ(3u, moving_obs.predicted_lanelet_ids.size());
+  ASSERT_EQ(llts[1].id(), moving_obs.predicted_lanelet_ids[1]);
+  ASSERT_EQ(llts[2].id(), moving_obs.predicted_lanelet_ids[2]);
+  ASSERT_NEAR(3.0, moving_obs.predicted_down_tracks[1], 0.00001);
+}
+
 TEST(CARMAWorldModelTest, getLaneletsFromPoint)
 {
   carma_wm::CARMAWorldModel cmw;
@@ -1423,6 +1684,39 @@ TEST(CARMAWorldModelTest, getSignalsAlongRoute)
 
 }
 
+TEST(CARMAWorldModelTest, getSignalsAlongRouteFollowsMapUpdates)
+{
+  test::MapOptions mp;
+  auto cmw_ptr = test::getGuidanceTestMap(mp);
+
+  // The default route is set before any signal exists
+  ASSERT_TRUE(cmw_ptr->getSignalsAlongRoute({1.85, 1.0}).empty());
+
+  lanelet::Id traffic_light_id = lanelet::utils::getId();
+  carma_wm::test::addTrafficLight(cmw_ptr, traffic_light_id, {1200}, {1203});
+
+  auto lights = cmw_ptr->getSignalsAlongRoute({1.85, 1.0});
+  ASSERT_EQ(lights.size(), 1u);
+  ASSERT_EQ(lights[0]->id(), traffic_light_id);
+
+  auto entry_exit = cmw_ptr->getEntryExitOfSignalAlongRoute(lights[0]);
+  ASSERT_TRUE(!!entry_exit);
+  ASSERT_EQ(entry_exit.get().first.id(), 1200);
+  ASSERT_EQ(entry_exit.get().second.id(), 1203);
+
+  // The stop line is at the end of lanelet 1200 so the signal is behind a vehicle on 1201
+  ASSERT_TRUE(cmw_ptr->getSignalsAlongRoute({1.85, 30.0}).empty());
+
+  // Map updates which do not touch the route keep the index
+  cmw_ptr->setMap(cmw_ptr->getMutableMap(), cmw_ptr->getMapVersion(), false);
+  ASSERT_EQ(cmw_ptr->getSignalsAlongRoute({1.85, 1.0}).size(), 1u);
+
+  // Removing the signal from the route lanelet is picked up by the next setMap
+  cmw_ptr->getMutableMap()->remove(cmw_ptr->getMutableMap()->laneletLayer.get(1200), lights[0]);
+  cmw_ptr->setMap(cmw_ptr->getMutableMap(), cmw_ptr->getMapVersion(), false);
+  ASSERT_TRUE(cmw_ptr->getSignalsAlongRoute({1.85, 1.0}).empty());
+}
+
 TEST(CARMAWorldModelTest, getIntersectionAlongRoute)
 {
   lanelet::Id id{1200};
@@ -26,6 +26,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 
 #include "TestHelpers.hpp"
+#include <chrono>
 
 
 namespace carma_wm
@@ -267,13 +268,6 @@ namespace carma_wm
     carma_planning_msgs::msg::TrajectoryPlan tp;
 
     
-    geometry_msgs::msg::Twist velocity;
-
-    geometry_msgs::msg::Vector3 linear_velocity;
-    linear_velocity.x = 0;
-    linear_velocity.y = 0;
-
-    velocity.linear = linear_velocity;
 
     
     geometry_msgs::msg::Vector3 size;
@@ -375,7 +369,13 @@ namespace carma_wm
 
     rwol.roadway_obstacles = {rwo_1};
 
-    std::vector<carma_perception_msgs::msg::RoadwayObstacle> result = collision_detection::WorldCollisionDetection(rwol, tp, size, velocity);
+    std::vector<carma_perception_msgs::msg::RoadwayObstacle> result = collision_detection::WorldCollisionDetection(rwol, tp, size);
+
+    ASSERT_EQ(result.size(),1);
+
+    // The overload taking the host velocity gives the same result
+    geometry_msgs::msg::Twist velocity;
+    result = collision_detection::WorldCollisionDetection(rwol, tp, size, velocity);
 
     ASSERT_EQ(result.size(),1);
 
@@ -387,13 +387,6 @@ namespace carma_wm
     carma_perception_msgs::msg::RoadwayObstacleList rwol;
     carma_planning_msgs::msg::TrajectoryPlan tp;
 
-    geometry_msgs::msg::Twist velocity;
-
-    geometry_msgs::msg::Vector3 linear_velocity;
-    linear_velocity.x = 0;
-    linear_velocity.y = 1;
-
-    velocity.linear = linear_velocity;
 
     geometry_msgs::msg::Vector3 size;
     size.x = 1;
@@ -489,10 +482,77 @@ namespace carma_wm
 
     rwol.roadway_obstacles = {rwo_1};
 
-    std::vector<carma_perception_msgs::msg::RoadwayObstacle> result = collision_detection::WorldCollisionDetection(rwol, tp, size, velocity);
+    std::vector<carma_perception_msgs::msg::RoadwayObstacle> result = collision_detection::WorldCollisionDetection(rwol, tp, size);
 
     ASSERT_EQ(result.size(),0);
 
   }
 
+  TEST(CollisionDetectionTest, WorldCollisionDetectionManyObstacles)
+  {
+    carma_perception_msgs::msg::RoadwayObstacleList rwol;
+    carma_planning_msgs::msg::TrajectoryPlan tp;
+
+    geometry_msgs::msg::Vector3 size;
+    size.x = 5;
+    size.y = 2;
+    size.z = 1;
+
+    // Host drives along the x axis at 10 m/s for 10 seconds
+    for (int i = 0; i <= 100; i++)
+    {
+      carma_planning_msgs::msg::TrajectoryPlanPoint point;
+      point.x = i;
+      point.y = 0;
+      point.target_time = rclcpp::Time(0, 0) + rclcpp::Duration::from_seconds(i * 0.1);
+      tp.trajectory_points.push_back(point);
+    }
+
+    // 60 obstacles with 30 predictions each. Every 10th obstacle crosses the host path, the rest drive in parallel lanes
+    for (int i = 0; i < 60; i++)
+    {
+      carma_perception_msgs::msg::RoadwayObstacle rwo;
+      rwo.object.size.x = 4;
+      rwo.object.size.y = 2;
+      rwo.object.size.z = 1;
+      rwo.object.id = i;
+
+      bool crossing = i % 10 == 0;
+      double lane_y = crossing ? -15.0 : 3.7 * (1 + i % 5);
+
+      for (int j = 0; j < 30; j++)
+      {
+        carma_perception_msgs::msg::PredictedState ps;
+        ps.header.stamp = rclcpp::Time(0, 0) + rclcpp::Duration::from_seconds(j * 0.1);
+        if (crossing)
+        {
+          ps.predicted_position.position.x = i;
+          ps.predicted_position.position.y = lane_y + j; // Moves across the host path
+        }
+        else
+        {
+          ps.predicted_position.position.x = i * 2 + j;
+          ps.predicted_position.position.y = lane_y;
+        }
+        ps.predicted_position.orientation.w = 1;
+        rwo.object.predictions.push_back(ps);
+      }
+
+      rwol.roadway_obstacles.push_back(rwo);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<carma_perception_msgs::msg::RoadwayObstacle> result = collision_detection::WorldCollisionDetection(rwol, tp, size);
+    auto end = std::chrono::steady_clock::now();
+
+    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm::collision_detection"), "WorldCollisionDetection with 60 obstacles took "
+      << std::chrono::duration<double, std::milli>(end - start).count() << " ms");
+
+    ASSERT_EQ(result.size(), 6u);
+    for (const auto& obstacle : result)
+    {
+      ASSERT_EQ(obstacle.object.id % 10, 0u);
+    }
+  }
+
 }  // namespace carma_wm
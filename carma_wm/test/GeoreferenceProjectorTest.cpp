@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
+
+namespace carma_wm
+{
+namespace projection
+{
+namespace
+{
+const std::string TMERC_GEOREFERENCE =
+    "+proj=tmerc +lat_0=39.46636844371259 +lon_0=-76.16919523566943 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=m +vunits=m +no_defs";
+
+const std::vector<lanelet::GPSPoint> TEST_POINTS = {
+  { 39.46636844371259, -76.16919523566943, 0.0 },
+  { 39.4670, -76.1700, 12.5 },
+  { 39.4500, -76.1500, -3.0 },
+  { 39.6000, -76.4000, 150.0 },
+};
+}  // namespace
+
+TEST(GeoreferenceProjector, transverseMercatorMatchesProj)
+{
+  GeoreferenceProjector projector(TMERC_GEOREFERENCE);
+  lanelet::projection::LocalFrameProjector proj_projector(TMERC_GEOREFERENCE.c_str());
+
+  ASSERT_TRUE(projector.hasClosedForm());
+
+  for (const auto& gps_point : TEST_POINTS)
+  {
+    auto map_point = projector.forward(gps_point);
+    auto expected = proj_projector.forward(gps_point);
+
+    ASSERT_NEAR(expected.x(), map_point.x(), 0.000001);
+    ASSERT_NEAR(expected.y(), map_point.y(), 0.000001);
+    ASSERT_NEAR(expected.z(), map_point.z(), 0.000001);
+
+    auto gps_result = projector.reverse(map_point);
+    ASSERT_NEAR(gps_point.lat, gps_result.lat, 0.000000001);
+    ASSERT_NEAR(gps_point.lon, gps_result.lon, 0.000000001);
+    ASSERT_NEAR(gps_point.ele, gps_result.ele, 0.000001);
+
+    auto ecef_point = projector.projectECEF(map_point, 1);
+    auto expected_ecef = proj_projector.projectECEF(map_point, 1);
+    ASSERT_NEAR(expected_ecef.x(), ecef_point.x(), 0.000001);
+    ASSERT_NEAR(expected_ecef.y(), ecef_point.y(), 0.000001);
+    ASSERT_NEAR(expected_ecef.z(), ecef_point.z(), 0.000001);
+
+    auto map_result = projector.projectECEF(ecef_point, -1);
+    ASSERT_NEAR(map_point.x(), map_result.x(), 0.000001);
+    ASSERT_NEAR(map_point.y(), map_result.y(), 0.000001);
+    ASSERT_NEAR(map_point.z(), map_result.z(), 0.000001);
+  }
+
+  // Batch conversions match single conversions
+  auto map_points = projector.forward(TEST_POINTS);
+  ASSERT_EQ(TEST_POINTS.size(), map_points.size());
+  ASSERT_NEAR(projector.forward(TEST_POINTS[3]).x(), map_points[3].x(), 0.000000001);
+
+  auto gps_points = projector.reverse(map_points);
+  ASSERT_EQ(TEST_POINTS.size(), gps_points.size());
+  ASSERT_NEAR(TEST_POINTS[2].lat, gps_points[2].lat, 0.000000001);
+
+  auto ecef_points = projector.projectECEF(map_points, 1);
+  ASSERT_EQ(TEST_POINTS.size(), ecef_points.size());
+  ASSERT_NEAR(projector.projectECEF(map_points[1], 1).z(), ecef_points[1].z(), 0.000000001);
+}
+
+TEST(GeoreferenceProjector, universalTransverseMercatorReference)
+{
+  // UTM zone 31N at 45N 3E lies on the central meridian
+  TransverseMercator utm(0.0, 3.0, 0.9996, 500000.0, 0.0);
+
+  double x, y;
+  utm.forward(45.0, 3.0, &x, &y);
+
+  ASSERT_NEAR(500000.0, x, 0.000001);
+  ASSERT_NEAR(4982950.400, y, 0.001);
+}
+
+TEST(GeoreferenceProjector, geocentricMatchesProj)
+{
+  std::string georeference = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
+  GeoreferenceProjector projector(georeference);
+  lanelet::projection::LocalFrameProjector proj_projector(georeference.c_str());
+
+  ASSERT_TRUE(projector.hasClosedForm());
+
+  for (const auto& gps_point : TEST_POINTS)
+  {
+    auto ecef_point = projector.forward(gps_point);
+    auto expected = proj_projector.forward(gps_point);
+
+    ASSERT_NEAR(expected.x(), ecef_point.x(), 0.000001);
+    ASSERT_NEAR(expected.y(), ecef_point.y(), 0.000001);
+    ASSERT_NEAR(expected.z(), ecef_point.z(), 0.000001);
+
+    auto gps_result = projector.reverse(ecef_point);
+    ASSERT_NEAR(gps_point.lat, gps_result.lat, 0.000000001);
+    ASSERT_NEAR(gps_point.lon, gps_result.lon, 0.000000001);
+    ASSERT_NEAR(gps_point.ele, gps_result.ele, 0.000001);
+  }
+}
+
+TEST(GeoreferenceProjector, otherFramesUseProj)
+{
+  std::string georeference = "+proj=utm +zone=18 +datum=WGS84 +units=m +no_defs";
+  GeoreferenceProjector projector(georeference);
+  lanelet::projection::LocalFrameProjector proj_projector(georeference.c_str());
+
+  ASSERT_FALSE(projector.hasClosedForm());
+
+  auto map_point = projector.forward(TEST_POINTS[1]);
+  auto expected = proj_projector.forward(TEST_POINTS[1]);
+
+  ASSERT_NEAR(expected.x(), map_point.x(), 0.000001);
+  ASSERT_NEAR(expected.y(), map_point.y(), 0.000001);
+
+  // Parameters the closed form does not reproduce also fall back to PROJ
+  ASSERT_FALSE(GeoreferenceProjector("+proj=tmerc +lat_0=39.4 +lon_0=-76.1 +ellps=GRS80 +units=m +no_defs").hasClosedForm());
+  ASSERT_FALSE(GeoreferenceProjector("+proj=tmerc +lat_0=39.4 +lon_0=-76.1 +k=1 +x_0=0 +y_0=0 +datum=WGS84 +units=us-ft +no_defs").hasClosedForm());
+}
+
+TEST(GeoreferenceProjector, sharedProjectors)
+{
+  auto projector = getGeoreferenceProjector(TMERC_GEOREFERENCE);
+
+  ASSERT_EQ(projector, getGeoreferenceProjector(TMERC_GEOREFERENCE));
+  ASSERT_EQ(TMERC_GEOREFERENCE, projector->getGeoreference());
+
+  auto other = getGeoreferenceProjector(lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR);
+  ASSERT_NE(projector, other);
+  ASSERT_EQ(projector, getGeoreferenceProjector(TMERC_GEOREFERENCE));
+}
+
+}  // namespace projection
+}  // namespace carma_wm
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_wm/MapBinTransport.hpp>
+#include <carma_wm/TrafficControl.hpp>
+#include <carma_wm/WMTestLibForGuidance.hpp>
+#include <autoware_lanelet2_ros2_interface/utility/message_conversion.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <../src/WMListenerWorker.hpp>
+
+namespace carma_wm
+{
+TEST(MapBinTransport, plainRoundTripMatchesLaneletConversion)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  mapToBinMsg(map, &msg);
+
+  ASSERT_EQ(MapBinCompression::NONE, getMapBinCompression(msg));
+
+  // Uncompressed messages remain readable by subscribers which do not use carma_wm
+  lanelet::LaneletMapPtr converted_map(new lanelet::LaneletMap);
+  lanelet::utils::conversion::fromBinMsg(msg, converted_map);
+  ASSERT_EQ(map->laneletLayer.size(), converted_map->laneletLayer.size());
+
+  // And messages created by lanelet conversion are readable here
+  autoware_lanelet2_msgs::msg::MapBin converted_msg;
+  lanelet::utils::conversion::toBinMsg(map, &converted_msg);
+
+  lanelet::LaneletMapPtr received_map(new lanelet::LaneletMap);
+  mapFromBinMsg(converted_msg, received_map);
+  ASSERT_EQ(map->laneletLayer.size(), received_map->laneletLayer.size());
+  ASSERT_TRUE(received_map->laneletLayer.exists(1211));
+}
+
+TEST(MapBinTransport, compressedRoundTrip)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  autoware_lanelet2_msgs::msg::MapBin plain_msg;
+  mapToBinMsg(map, &plain_msg);
+
+  autoware_lanelet2_msgs::msg::MapBin compressed_msg;
+  mapToBinMsg(map, &compressed_msg, MapBinCompression::ZLIB);
+
+  ASSERT_EQ(MapBinCompression::ZLIB, getMapBinCompression(compressed_msg));
+  ASSERT_LT(compressed_msg.data.size(), plain_msg.data.size());
+
+  lanelet::LaneletMapPtr received_map(new lanelet::LaneletMap);
+  mapFromBinMsg(compressed_msg, received_map);
+
+  ASSERT_EQ(map->laneletLayer.size(), received_map->laneletLayer.size());
+  ASSERT_EQ(map->pointLayer.size(), received_map->pointLayer.size());
+  ASSERT_NEAR(map->laneletLayer.get(1211).centerline2d().front().x(),
+              received_map->laneletLayer.get(1211).centerline2d().front().x(), 0.000001);
+}
+
+TEST(MapBinTransport, compressedTrafficControl)
+{
+  auto send_data = std::make_shared<carma_wm::TrafficControl>();
+  send_data->id_ = boost::uuids::random_generator()();
+  send_data->has_routing_graph_delta_ = true;
+  send_data->routing_graph_delta_.participant = lanelet::Participants::VehicleCar;
+  send_data->routing_graph_delta_.affected_lanelet_ids = { 1211, 1212 };
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  carma_wm::toBinMsg(send_data, &msg, MapBinCompression::ZLIB);
+
+  ASSERT_EQ(MapBinCompression::ZLIB, getMapBinCompression(msg));
+
+  auto data_received = std::make_shared<carma_wm::TrafficControl>();
+  carma_wm::fromBinMsg(msg, data_received);
+
+  ASSERT_EQ(send_data->id_, data_received->id_);
+  ASSERT_TRUE(data_received->has_routing_graph_delta_);
+  ASSERT_EQ(send_data->routing_graph_delta_.affected_lanelet_ids,
+            data_received->routing_graph_delta_.affected_lanelet_ids);
+}
+
+TEST(MapBinTransport, splitAndAssemble)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  mapToBinMsg(map, &msg, MapBinCompression::ZLIB);
+  msg.map_version = 3;
+  msg.has_routing_graph = true;
+
+  auto original_data = msg.data;
+
+  // Data which fits in a single chunk is not split
+  auto single = splitMapBinMsg(msg, msg.data.size());
+  ASSERT_EQ(1u, single.size());
+  ASSERT_FALSE(isMapBinChunk(single[0]));
+
+  size_t chunk_size = original_data.size() / 4 + 1;
+  auto chunks = splitMapBinMsg(msg, chunk_size);
+
+  ASSERT_EQ(4u, chunks.size());
+
+  for (size_t i = 0; i < chunks.size(); i++)
+  {
+    ASSERT_TRUE(isMapBinChunk(chunks[i]));
+    ASSERT_EQ(3u, chunks[i].map_version);
+    ASSERT_EQ(i + 1 == chunks.size(), chunks[i].has_routing_graph) << "Only the last chunk carries the routing graph";
+  }
+
+  ASSERT_THROW(readBinArchive(chunks[0], [](boost::archive::binary_iarchive&) {}), std::invalid_argument);
+
+  MapBinChunkAssembler assembler;
+  autoware_lanelet2_msgs::msg::MapBin::SharedPtr complete;
+
+  for (size_t i = 0; i < chunks.size(); i++)
+  {
+    complete = assembler.addMessage(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(chunks[i]));
+    ASSERT_EQ(i + 1 == chunks.size(), !!complete);
+  }
+
+  ASSERT_EQ(original_data, complete->data);
+  ASSERT_EQ(3u, complete->map_version);
+  ASSERT_TRUE(complete->has_routing_graph);
+
+  lanelet::LaneletMapPtr received_map(new lanelet::LaneletMap);
+  mapFromBinMsg(*complete, received_map);
+  ASSERT_EQ(map->laneletLayer.size(), received_map->laneletLayer.size());
+
+  // A transfer with a missing chunk is dropped and the next transfer is still received
+  ASSERT_FALSE(!!assembler.addMessage(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(chunks[0])));
+  ASSERT_FALSE(!!assembler.addMessage(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(chunks[2])));
+  ASSERT_FALSE(!!assembler.addMessage(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(chunks[3])));
+
+  for (const auto& chunk : chunks)
+  {
+    complete = assembler.addMessage(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(chunk));
+  }
+
+  ASSERT_TRUE(!!complete);
+  ASSERT_EQ(original_data, complete->data);
+
+  // Messages which are not chunks pass through unchanged
+  auto plain = std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(msg);
+  ASSERT_EQ(plain, assembler.addMessage(plain));
+}
+
+TEST(MapBinTransport, listenerReceivesChunkedMap)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  mapToBinMsg(map, &msg, MapBinCompression::ZLIB);
+  msg.map_version = 1;
+
+  auto chunks = splitMapBinMsg(msg, msg.data.size() / 3 + 1);
+  ASSERT_EQ(3u, chunks.size());
+
+  WMListenerWorker wmlw;
+
+  bool flag = false;
+  wmlw.setMapCallback([&flag]() { flag = true; });
+
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(chunks[0]));
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(chunks[1]));
+
+  ASSERT_FALSE(flag);
+  ASSERT_FALSE((bool)(wmlw.getWorldModel()->getMap()));
+
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(chunks[2]));
+
+  ASSERT_TRUE(flag);
+  ASSERT_TRUE((bool)(wmlw.getWorldModel()->getMap()));
+  ASSERT_EQ(map->laneletLayer.size(), wmlw.getWorldModel()->getMap()->laneletLayer.size());
+}
+
+}  // namespace carma_wm
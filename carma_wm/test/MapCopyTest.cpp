@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_wm/MapCopy.hpp>
+#include <lanelet2_extension/regulatory_elements/DigitalSpeedLimit.h>
+#include "TestHelpers.hpp"
+
+namespace carma_wm
+{
+TEST(MapCopyTest, copiesOnlyConnectedPrimitives)
+{
+  using namespace lanelet::units::literals;
+
+  auto pl1 = getPoint(0, 0, 0);
+  auto pl2 = getPoint(0, 1, 0);
+  auto pl3 = getPoint(0, 2, 0);
+  auto pl4 = getPoint(0, 3, 0);
+  auto pr1 = getPoint(1, 0, 0);
+  auto pr2 = getPoint(1, 1, 0);
+  auto pr3 = getPoint(1, 2, 0);
+  auto pr4 = getPoint(1, 3, 0);
+  auto ll_1 = getLanelet({ pl1, pl2 }, { pr1, pr2 });
+  auto ll_2 = getLanelet({ pl2, pl3 }, { pr2, pr3 });
+  auto ll_3 = getLanelet({ pl3, pl4 }, { pr3, pr4 });
+
+  // The signal is used by ll_1 and refers to ll_2 so editing ll_1 requires ll_2 to be copied too
+  lanelet::LineString3d stop_line(lanelet::utils::getId(), { pl2, pr2 });
+  std::shared_ptr<lanelet::CarmaTrafficSignal> signal(new lanelet::CarmaTrafficSignal(
+      lanelet::CarmaTrafficSignal::buildData(lanelet::utils::getId(), { stop_line }, { ll_1 }, { ll_2 })));
+  signal->revision_ = 3;
+  signal->recorded_start_time_stamps = { lanelet::time::timeFromSec(1.0) };
+  signal->recorded_time_stamps = { std::make_pair(lanelet::time::timeFromSec(2.0), lanelet::CarmaTrafficSignalState::PROTECTED_MOVEMENT_ALLOWED) };
+  ll_1.addRegulatoryElement(signal);
+
+  lanelet::DigitalSpeedLimitPtr speed_limit = std::make_shared<lanelet::DigitalSpeedLimit>(
+      lanelet::DigitalSpeedLimit::buildData(lanelet::utils::getId(), 5_mph, { ll_3 }, {}, { lanelet::Participants::VehicleCar }));
+  ll_3.addRegulatoryElement(speed_limit);
+
+  auto map = lanelet::utils::createMap({ ll_1, ll_2, ll_3 }, {});
+  map->add(signal);
+  map->add(speed_limit);
+
+  auto copy = copyMapForEdit(map, { ll_1.id() });
+
+  ASSERT_NE(map, copy);
+  ASSERT_EQ(map->laneletLayer.size(), copy->laneletLayer.size());
+  ASSERT_EQ(map->regulatoryElementLayer.size(), copy->regulatoryElementLayer.size());
+  ASSERT_EQ(map->lineStringLayer.size(), copy->lineStringLayer.size());
+  ASSERT_EQ(map->pointLayer.size(), copy->pointLayer.size());
+
+  auto copy_ll_1 = copy->laneletLayer.get(ll_1.id());
+  auto copy_ll_2 = copy->laneletLayer.get(ll_2.id());
+  auto copy_ll_3 = copy->laneletLayer.get(ll_3.id());
+
+  EXPECT_NE(ll_1.constData(), copy_ll_1.constData());
+  EXPECT_NE(ll_2.constData(), copy_ll_2.constData());
+  EXPECT_EQ(ll_3.constData(), copy_ll_3.constData());
+
+  // Geometry is shared
+  EXPECT_EQ(ll_1.leftBound3d().constData(), copy_ll_1.leftBound3d().constData());
+  EXPECT_EQ(pl1.constData(), copy->pointLayer.get(pl1.id()).constData());
+
+  // The copied signal keeps its timing and refers to the copied lanelets
+  auto copy_signals = copy_ll_1.regulatoryElementsAs<lanelet::CarmaTrafficSignal>();
+  ASSERT_EQ(1u, copy_signals.size());
+  auto copy_signal = copy_signals.front();
+  EXPECT_NE(signal, copy_signal);
+  EXPECT_EQ(signal->id(), copy_signal->id());
+  EXPECT_EQ(copy_signal, copy->regulatoryElementLayer.get(signal->id()));
+  EXPECT_EQ(3, copy_signal->revision_);
+  EXPECT_EQ(signal->recorded_time_stamps, copy_signal->recorded_time_stamps);
+  EXPECT_EQ(signal->recorded_start_time_stamps, copy_signal->recorded_start_time_stamps);
+  ASSERT_EQ(1u, copy_signal->getControlStartLanelets().size());
+  ASSERT_EQ(1u, copy_signal->getControlEndLanelets().size());
+  EXPECT_EQ(copy_ll_1.constData(), copy_signal->getControlStartLanelets().front().constData());
+  EXPECT_EQ(copy_ll_2.constData(), copy_signal->getControlEndLanelets().front().constData());
+
+  // Unrelated regulatory elements are shared
+  EXPECT_EQ(speed_limit, copy->regulatoryElementLayer.get(speed_limit->id()));
+
+  // Editing the copy leaves the original map untouched
+  copy->remove(copy_ll_1, copy_signal);
+  EXPECT_TRUE(copy_ll_1.regulatoryElementsAs<lanelet::CarmaTrafficSignal>().empty());
+  EXPECT_EQ(1u, map->laneletLayer.get(ll_1.id()).regulatoryElementsAs<lanelet::CarmaTrafficSignal>().size());
+  EXPECT_EQ(1u, map->laneletLayer.findUsages(signal).size());
+  EXPECT_TRUE(copy->laneletLayer.findUsages(copy_signal).empty());
+}
+
+TEST(MapCopyTest, ignoresUnknownLanelets)
+{
+  CARMAWorldModel cmw;
+  addStraightRoute(cmw);
+  auto map = cmw.getMutableMap();
+
+  auto copy = copyMapForEdit(map, { lanelet::utils::getId() });
+
+  ASSERT_NE(map, copy);
+  ASSERT_EQ(map->laneletLayer.size(), copy->laneletLayer.size());
+  for (const auto& llt : map->laneletLayer)
+  {
+    EXPECT_EQ(llt.constData(), copy->laneletLayer.get(llt.id()).constData());
+  }
+}
+
+}  // namespace carma_wm
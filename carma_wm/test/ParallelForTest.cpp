@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_wm/ParallelFor.hpp>
+#include <atomic>
+#include <stdexcept>
+
+namespace carma_wm
+{
+TEST(ParallelFor, visitsEveryIndexOnce)
+{
+  for (size_t count : { 0, 1, 7, 64, 1001 })
+  {
+    for (size_t max_threads : { 0, 1, 3, 8 })
+    {
+      std::vector<std::atomic<int>> visits(count);
+      parallelFor(count, max_threads, 4, [&visits](size_t i) { visits[i]++; });
+
+      for (size_t i = 0; i < count; i++)
+        ASSERT_EQ(1, visits[i].load()) << "count: " << count << " max_threads: " << max_threads << " index: " << i;
+    }
+  }
+}
+
+TEST(ParallelFor, rethrowsAfterEveryChunkFinishes)
+{
+  std::atomic<size_t> calls(0);
+
+  ASSERT_THROW(parallelFor(100, 4, 1,
+                           [&calls](size_t i) {
+                             calls++;
+                             if (i == 10)
+                               throw std::runtime_error("failure");
+                           }),
+               std::runtime_error);
+
+  // Only the chunk which threw stops early
+  ASSERT_GE(calls.load(), 100u - 25u + 1u);
+}
+
+}  // namespace carma_wm
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <gtest/gtest.h>
+#include <carma_wm/RoutingGraphDelta.hpp>
+#include <carma_wm/RoutingGraphAccessor.hpp>
+#include <carma_wm/TrafficControl.hpp>
+#include <carma_wm/WMTestLibForGuidance.hpp>
+#include <carma_wm/MapConformer.hpp>
+#include <lanelet2_extension/regulatory_elements/RegionAccessRule.h>
+#include <lanelet2_extension/traffic_rules/CarmaUSTrafficRules.h>
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+#include <set>
+#include <tuple>
+#include "TestHelpers.hpp"
+
+namespace carma_wm
+{
+namespace
+{
+using VertexPair = std::pair<lanelet::Id, bool>;
+using EdgeTuple = std::tuple<lanelet::Id, bool, lanelet::Id, bool, uint8_t, uint16_t, double>;
+
+bool isInverted(const lanelet::ConstLaneletOrArea& lanelet_or_area)
+{
+  return lanelet_or_area.isLanelet() && lanelet_or_area.lanelet()->inverted();
+}
+
+// Collect the vertices and edges of a routing graph in a form which does not depend on insertion order
+std::pair<std::set<VertexPair>, std::set<EdgeTuple>> graphContents(const lanelet::routing::RoutingGraph& graph)
+{
+  const auto& underlying_graph = static_cast<const RoutingGraphAccessor*>(&graph)->getInternalGraph();
+
+  std::set<VertexPair> vertices;
+  boost::graph_traits<lanelet::routing::internal::GraphType>::vertex_iterator vi, vi_end;
+  for (boost::tie(vi, vi_end) = boost::vertices(underlying_graph); vi != vi_end; ++vi)
+  {
+    const auto& lanelet_or_area = underlying_graph[*vi].laneletOrArea;
+    vertices.emplace(lanelet_or_area.id(), isInverted(lanelet_or_area));
+  }
+
+  std::set<EdgeTuple> edges;
+  boost::graph_traits<lanelet::routing::internal::GraphType>::edge_iterator ei, ei_end;
+  for (boost::tie(ei, ei_end) = boost::edges(underlying_graph); ei != ei_end; ++ei)
+  {
+    const auto& info = underlying_graph[*ei];
+    const auto& from = underlying_graph[boost::source(*ei, underlying_graph)].laneletOrArea;
+    const auto& to = underlying_graph[boost::target(*ei, underlying_graph)].laneletOrArea;
+    edges.emplace(from.id(), isInverted(from), to.id(), isInverted(to),
+                  static_cast<uint8_t>(info.relation), info.costId, info.routingCost);
+  }
+
+  return std::make_pair(vertices, edges);
+}
+
+// Collect the ids of the primitives in the passable submap of a routing graph
+std::set<lanelet::Id> passableIds(const lanelet::routing::RoutingGraph& graph)
+{
+  std::set<lanelet::Id> ids;
+  for (const auto& llt : graph.passableSubmap()->laneletLayer)
+  {
+    ids.insert(llt.id());
+  }
+  for (const auto& area : graph.passableSubmap()->areaLayer)
+  {
+    ids.insert(area.id());
+  }
+  return ids;
+}
+
+// Replace the access rule of the lanelet so that only the given participants may use it
+void setAccess(lanelet::LaneletMapPtr map, lanelet::Id lanelet_id, const std::vector<std::string>& participants)
+{
+  auto llt = map->laneletLayer.get(lanelet_id);
+
+  for (const auto& rule : llt.regulatoryElementsAs<lanelet::RegionAccessRule>())
+  {
+    llt.removeRegulatoryElement(rule);
+  }
+
+  std::shared_ptr<lanelet::RegionAccessRule> rule(new lanelet::RegionAccessRule(
+      lanelet::RegionAccessRule::buildData(lanelet::utils::getId(), { llt }, {}, participants)));
+  map->update(llt, rule);
+}
+}  // namespace
+
+TEST(RoutingGraphDelta, applyMatchesFullRebuild)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+
+  std::shared_ptr<lanelet::routing::RoutingGraph> original_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  auto original_contents = graphContents(*original_graph);
+
+  ASSERT_EQ(1u, original_contents.first.count({ 1211, false }));
+
+  // Close the middle lane as a work zone would
+  setAccess(map, 1211, { lanelet::Participants::Pedestrian });
+
+  auto delta = computeRoutingGraphDelta(*map, *traffic_rules, { 1211, 99999 }, lanelet::Participants::VehicleCar);
+
+  ASSERT_EQ(lanelet::Participants::VehicleCar, delta.participant);
+  ASSERT_EQ(1u, delta.affected_lanelet_ids.size()) << "Ids which are not in the map should be ignored";
+  ASSERT_TRUE(delta.passable_vertices.empty()) << "Closed lanelet should no longer be a vertex";
+  ASSERT_TRUE(delta.edges.empty()) << "Closed lanelet should have no edges";
+
+  auto patched_graph = applyRoutingGraphDelta(*original_graph, delta, map);
+  ASSERT_TRUE(!!patched_graph);
+
+  auto rebuilt_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  auto patched_contents = graphContents(*patched_graph);
+
+  ASSERT_EQ(graphContents(*rebuilt_graph), patched_contents);
+  ASSERT_EQ(0u, patched_contents.first.count({ 1211, false }));
+  ASSERT_TRUE(patched_graph->passableSubmap()->laneletLayer.exists(1210));
+  ASSERT_FALSE(patched_graph->passableSubmap()->laneletLayer.exists(1211));
+
+  // Reopen the lane and check the original graph is restored
+  setAccess(map, 1211, { lanelet::Participants::Vehicle });
+
+  auto reopen_delta = computeRoutingGraphDelta(*map, *traffic_rules, { 1211 }, lanelet::Participants::VehicleCar);
+
+  ASSERT_EQ(1u, reopen_delta.passable_vertices.size());
+  ASSERT_FALSE(reopen_delta.edges.empty());
+
+  auto reopened_graph = applyRoutingGraphDelta(*patched_graph, reopen_delta, map);
+  ASSERT_TRUE(!!reopened_graph);
+
+  ASSERT_EQ(original_contents, graphContents(*reopened_graph));
+}
+
+TEST(RoutingGraphDelta, applyRejectsUnknownLanelets)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+
+  auto graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+
+  RoutingGraphDelta delta;
+  delta.participant = lanelet::Participants::VehicleCar;
+  delta.affected_lanelet_ids = { 1211 };
+  delta.passable_vertices = { RoutingGraphVertex{ 1211, false } };
+
+  RoutingGraphEdge edge;
+  edge.from = 1211;
+  edge.to = 99999;
+  delta.edges.push_back(edge);
+
+  ASSERT_FALSE(!!applyRoutingGraphDelta(*graph, delta, map));
+
+  delta.edges.clear();
+  delta.passable_vertices = { RoutingGraphVertex{ 99999, false } };
+
+  ASSERT_FALSE(!!applyRoutingGraphDelta(*graph, delta, map));
+
+  // 1212 is one way so it has no inverted vertex for an edge to end at
+  delta.passable_vertices = { RoutingGraphVertex{ 1211, false } };
+  edge.to = 1212;
+  edge.to_inverted = true;
+  delta.edges.push_back(edge);
+
+  ASSERT_FALSE(!!applyRoutingGraphDelta(*graph, delta, map));
+}
+
+TEST(RoutingGraphDelta, applyMatchesFullRebuildWithBidirectionalLanelets)
+{
+  // Lanelet 10003 is passable in both directions so the graph has a vertex for each of its directions
+  auto map = carma_wm::getDisjointRouteMap();
+  lanelet::MapConformer::ensureCompliance(map);
+
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+
+  std::shared_ptr<lanelet::routing::RoutingGraph> original_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  auto original_contents = graphContents(*original_graph);
+
+  ASSERT_EQ(1u, original_contents.first.count({ 10003, false }));
+  ASSERT_EQ(1u, original_contents.first.count({ 10003, true }));
+
+  // Close the two way lanelet and its predecessor
+  setAccess(map, 10002, { lanelet::Participants::Pedestrian });
+  setAccess(map, 10003, { lanelet::Participants::Pedestrian });
+
+  auto delta = computeRoutingGraphDelta(*map, *traffic_rules, { 10002, 10003 }, lanelet::Participants::VehicleCar);
+  delta.base_graph_hash = routingGraphHash(*original_graph);
+
+  ASSERT_TRUE(delta.passable_vertices.empty());
+
+  auto patched_graph = applyRoutingGraphDelta(*original_graph, delta, map);
+  ASSERT_TRUE(!!patched_graph);
+
+  auto closed_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  auto patched_contents = graphContents(*patched_graph);
+  ASSERT_EQ(graphContents(*closed_graph), patched_contents);
+  ASSERT_EQ(passableIds(*closed_graph), passableIds(*patched_graph));
+  ASSERT_EQ(0u, patched_contents.first.count({ 10003, true }));
+
+  // No edge of the remaining graph may end at either direction of the closed lanelets
+  for (const auto& edge : patched_contents.second)
+  {
+    ASSERT_NE(10003, std::get<0>(edge));
+    ASSERT_NE(10003, std::get<2>(edge));
+  }
+
+  // Reopen both lanelets. Both directions of the two way lanelet are re-added
+  setAccess(map, 10002, { lanelet::Participants::Vehicle });
+  setAccess(map, 10003, { lanelet::Participants::Vehicle });
+
+  auto reopen_delta = computeRoutingGraphDelta(*map, *traffic_rules, { 10002, 10003 }, lanelet::Participants::VehicleCar);
+  reopen_delta.base_graph_hash = routingGraphHash(*patched_graph);
+
+  bool has_inverted_vertex = false;
+  for (const auto& vertex : reopen_delta.passable_vertices)
+  {
+    has_inverted_vertex = has_inverted_vertex || (vertex.id == 10003 && vertex.inverted);
+  }
+  ASSERT_TRUE(has_inverted_vertex);
+
+  auto reopened_graph = applyRoutingGraphDelta(*patched_graph, reopen_delta, map);
+  ASSERT_TRUE(!!reopened_graph);
+
+  auto rebuilt_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  auto reopened_contents = graphContents(*reopened_graph);
+  ASSERT_EQ(graphContents(*rebuilt_graph), reopened_contents);
+  ASSERT_EQ(original_contents, reopened_contents);
+  ASSERT_EQ(routingGraphHash(*rebuilt_graph), routingGraphHash(*reopened_graph));
+  ASSERT_EQ(passableIds(*rebuilt_graph), passableIds(*reopened_graph));
+
+  // The reopened graph can route through the two way lanelet in its inverted direction
+  auto inverted_llt = reopened_graph->passableSubmap()->laneletLayer.get(10003).invert();
+  ASSERT_EQ(rebuilt_graph->following(inverted_llt).size(), reopened_graph->following(inverted_llt).size());
+}
+
+TEST(RoutingGraphDelta, graphHash)
+{
+  auto map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::traffic_rules::CarmaUSTrafficRules::Location, lanelet::Participants::VehicleCar);
+
+  auto graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+  uint64_t hash = routingGraphHash(*graph);
+
+  ASSERT_NE(0u, hash);
+
+  // The same structure built in a different order has the same hash
+  auto rebound_graph = applyRoutingGraphDelta(*graph, RoutingGraphDelta(), map);
+  ASSERT_TRUE(!!rebound_graph);
+  ASSERT_EQ(hash, routingGraphHash(*rebound_graph));
+
+  setAccess(map, 1211, { lanelet::Participants::Pedestrian });
+  auto changed_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+
+  ASSERT_NE(hash, routingGraphHash(*changed_graph));
+}
+
+TEST(RoutingGraphDelta, serializeWithTrafficControl)
+{
+  auto send_data = std::make_shared<carma_wm::TrafficControl>();
+  send_data->id_ = boost::uuids::random_generator()();
+  send_data->has_routing_graph_delta_ = true;
+  send_data->routing_graph_delta_.participant = lanelet::Participants::VehicleCar;
+  send_data->routing_graph_delta_.base_graph_hash = 0x1234567890abcdefULL;
+  send_data->routing_graph_delta_.affected_lanelet_ids = { 1211, 1212 };
+  send_data->routing_graph_delta_.passable_vertices = { RoutingGraphVertex{ 1212, false }, RoutingGraphVertex{ 1212, true } };
+
+  RoutingGraphEdge edge;
+  edge.from = 1212;
+  edge.to = 1213;
+  edge.from_inverted = true;
+  edge.routing_cost = 25.0;
+  edge.routing_cost_id = 1;
+  edge.relation = static_cast<uint8_t>(lanelet::routing::RelationType::Successor);
+  send_data->routing_graph_delta_.edges.push_back(edge);
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  carma_wm::toBinMsg(send_data, &msg);
+
+  auto data_received = std::make_shared<carma_wm::TrafficControl>();
+  carma_wm::fromBinMsg(msg, data_received);
+
+  ASSERT_TRUE(data_received->has_routing_graph_delta_);
+
+  const auto& received_delta = data_received->routing_graph_delta_;
+  ASSERT_EQ(lanelet::Participants::VehicleCar, received_delta.participant);
+  ASSERT_EQ(send_data->routing_graph_delta_.affected_lanelet_ids, received_delta.affected_lanelet_ids);
+  ASSERT_EQ(send_data->routing_graph_delta_.base_graph_hash, received_delta.base_graph_hash);
+  ASSERT_EQ(2u, received_delta.passable_vertices.size());
+  ASSERT_EQ(1212, received_delta.passable_vertices[1].id);
+  ASSERT_FALSE(received_delta.passable_vertices[0].inverted);
+  ASSERT_TRUE(received_delta.passable_vertices[1].inverted);
+  ASSERT_EQ(1u, received_delta.edges.size());
+  ASSERT_EQ(1212, received_delta.edges[0].from);
+  ASSERT_EQ(1213, received_delta.edges[0].to);
+  ASSERT_TRUE(received_delta.edges[0].from_inverted);
+  ASSERT_FALSE(received_delta.edges[0].to_inverted);
+  ASSERT_NEAR(25.0, received_delta.edges[0].routing_cost, 0.000001);
+  ASSERT_EQ(1u, received_delta.edges[0].routing_cost_id);
+  ASSERT_EQ(edge.relation, received_delta.edges[0].relation);
+
+  // Updates without a delta do not carry one
+  auto plain_data = std::make_shared<carma_wm::TrafficControl>();
+  plain_data->id_ = boost::uuids::random_generator()();
+
+  autoware_lanelet2_msgs::msg::MapBin plain_msg;
+  carma_wm::toBinMsg(plain_data, &plain_msg);
+
+  auto plain_received = std::make_shared<carma_wm::TrafficControl>();
+  carma_wm::fromBinMsg(plain_msg, plain_received);
+
+  ASSERT_FALSE(plain_received->has_routing_graph_delta_);
+}
+
+}  // namespace carma_wm
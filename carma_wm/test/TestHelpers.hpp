@@ -198,6 +198,62 @@ inline void addDisjointRoute(CARMAWorldModel& cmw)
   cmw.setRoute(route_ptr);
 }
 
+/**
+ * \brief Builds a long straight two lane road and sets a route along its right lane.
+ *        The left lane is reachable by lane change so it is part of the route lanelet map but not the shortest path.
+ *        Intended for timing tests which need many route lanelets.
+ *
+ * \param cmw The world model to set the map and route on
+ * \param segment_count Number of lanelets in each lane
+ * \param segment_length Length in meters of each lanelet. Each lanelet bound contains 3 points
+ */
+inline void addLongTwoLaneRoute(CARMAWorldModel& cmw, size_t segment_count, double segment_length = 10.0)
+{
+  // 1. Construct lane boundaries
+  std::vector<lanelet::Point3d> left_pts, mid_pts, right_pts;
+  for (size_t i = 0; i < 2 * segment_count + 1; i++)
+  {
+    double y = i * segment_length / 2.0;
+    left_pts.push_back(getPoint(-3.7, y, 0));
+    mid_pts.push_back(getPoint(0, y, 0));
+    right_pts.push_back(getPoint(3.7, y, 0));
+  }
+
+  std::vector<lanelet::Lanelet> right_lane, left_lane;
+  for (size_t i = 0; i < segment_count; i++)
+  {
+    auto begin = 2 * i;
+    lanelet::LineString3d left_ls(lanelet::utils::getId(), { left_pts[begin], left_pts[begin + 1], left_pts[begin + 2] });
+    lanelet::LineString3d mid_ls(lanelet::utils::getId(), { mid_pts[begin], mid_pts[begin + 1], mid_pts[begin + 2] });
+    lanelet::LineString3d right_ls(lanelet::utils::getId(), { right_pts[begin], right_pts[begin + 1], right_pts[begin + 2] });
+
+    left_lane.push_back(
+        getLanelet(left_ls, mid_ls, lanelet::AttributeValueString::Solid, lanelet::AttributeValueString::Dashed));
+    right_lane.push_back(
+        getLanelet(mid_ls, right_ls, lanelet::AttributeValueString::Dashed, lanelet::AttributeValueString::Solid));
+  }
+
+  std::vector<lanelet::Lanelet> all_lanelets(right_lane.begin(), right_lane.end());
+  all_lanelets.insert(all_lanelets.end(), left_lane.begin(), left_lane.end());
+
+  // 2. Build map
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap(all_lanelets, {});
+
+  // 3. Build routing graph
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::Locations::Germany, lanelet::Participants::VehicleCar);
+  lanelet::routing::RoutingGraphUPtr map_graph = lanelet::routing::RoutingGraph::build(*map, *traffic_rules);
+
+  // 4. Generate route along the right lane
+  auto optional_route = map_graph->getRoute(right_lane.front(), right_lane.back());
+  lanelet::routing::Route route = std::move(*optional_route);
+  LaneletRoutePtr route_ptr = std::make_shared<lanelet::routing::Route>(std::move(route));
+
+  // 5. Set route and map
+  cmw.setMap(map);
+  cmw.setRoute(route_ptr);
+}
+
 inline lanelet::LaneletMapPtr getDisjointRouteMap()
 {
   // 1. Construct map
@@ -25,6 +25,9 @@
 #include <boost/archive/binary_oarchive.hpp>
 #include <sstream>
 #include <string>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include "TestHelpers.hpp"
 #include <carma_wm/MapConformer.hpp>
 #include <lanelet2_io/Io.h>
@@ -309,4 +312,355 @@ TEST(WMListenerWorkerTest, checkIfReRoutingNeeded2)
   ASSERT_EQ(true, wmlw.checkIfReRoutingNeeded());
 }
 
+TEST(WMListenerWorkerTest, snapshotIsolatedFromMapUpdates)
+{
+  using namespace lanelet::units::literals;
+
+  auto p1 = getPoint(0, 0, 0);
+  auto p2 = getPoint(0, 1, 0);
+  auto p3 = getPoint(1, 1, 0);
+  auto p4 = getPoint(1, 0, 0);
+  lanelet::LineString3d left_ls_1(lanelet::utils::getId(), { p1, p2 });
+  lanelet::LineString3d right_ls_1(lanelet::utils::getId(), { p4, p3 });
+
+  auto ll_1 = getLanelet(left_ls_1, right_ls_1, lanelet::AttributeValueString::SolidSolid,
+                         lanelet::AttributeValueString::Dashed);
+  auto ll_2 = getLanelet(left_ls_1, right_ls_1, lanelet::AttributeValueString::SolidSolid,
+                         lanelet::AttributeValueString::Dashed);
+
+  lanelet::DigitalSpeedLimitPtr speed_limit_old = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9000, 5_mph, {ll_1}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  lanelet::DigitalSpeedLimitPtr speed_limit_new = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(9001, 5_mph, {ll_1}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+
+  auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  gf_ptr->id_ = boost::uuids::random_generator()();
+  gf_ptr->remove_list_.push_back(std::make_pair(ll_1.id(), speed_limit_old));
+  gf_ptr->update_list_.push_back(std::make_pair(ll_1.id(), speed_limit_new));
+
+  autoware_lanelet2_msgs::msg::MapBin gf_obj_msg;
+  auto received_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_, {ll_2}));
+  carma_wm::toBinMsg(received_data, &gf_obj_msg);
+
+  ll_1.addRegulatoryElement(speed_limit_old);
+  lanelet::LaneletMapPtr map = lanelet::utils::createMap({ ll_1 }, { });
+  autoware_lanelet2_msgs::msg::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map, &map_msg);
+
+  WMListenerWorker wmlw;
+  wmlw.setSnapshotMode(true);
+  ASSERT_TRUE(wmlw.isSnapshotModeEnabled());
+  ASSERT_TRUE((bool)wmlw.getSnapshot());
+
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(map_msg));
+  wmlw.publishSnapshot();
+
+  auto old_snapshot = wmlw.getSnapshot();
+  ASSERT_TRUE((bool)old_snapshot->getMap());
+
+  wmlw.mapUpdateCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(gf_obj_msg));
+
+  // The update is applied to a copy of the map so the held snapshot does not change
+  auto regems = old_snapshot->getMap()->laneletLayer.get(ll_1.id()).regulatoryElements();
+  ASSERT_EQ(1u, regems.size());
+  ASSERT_EQ(speed_limit_old->id(), regems[0]->id());
+  ASSERT_EQ(1u, old_snapshot->getMap()->laneletLayer.size());
+
+  // Until the next snapshot is published readers still see the old one
+  ASSERT_EQ(old_snapshot, wmlw.getSnapshot());
+
+  wmlw.publishSnapshot();
+  auto new_snapshot = wmlw.getSnapshot();
+
+  ASSERT_NE(old_snapshot->getMap(), new_snapshot->getMap());
+  regems = new_snapshot->getMap()->laneletLayer.get(ll_1.id()).regulatoryElements();
+  ASSERT_EQ(1u, regems.size());
+  ASSERT_EQ(speed_limit_new->id(), regems[0]->id());
+  ASSERT_EQ(2u, new_snapshot->getMap()->laneletLayer.size());
+  ASSERT_TRUE(new_snapshot->getMapRoutingGraph()->passableSubmap()->laneletLayer.exists(ll_1.id()));
+
+  // The writer side world model matches the latest snapshot
+  ASSERT_EQ(new_snapshot->getMap(), wmlw.getWorldModel()->getMap());
+}
+
+TEST(WMListenerWorkerTest, snapshotRouteRecomputedOnMapCopy)
+{
+  CARMAWorldModel cwm;
+  addStraightRoute(cwm);
+
+  auto map_ptr = lanelet::utils::removeConst(cwm.getMap());
+  autoware_lanelet2_msgs::msg::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map_ptr, &map_msg);
+
+  carma_planning_msgs::msg::Route route_msg;
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[0].id());
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[1].id());
+  route_msg.end_point.x = 0.5;
+  route_msg.end_point.y = 2.0;
+  route_msg.route_name = "snapshot_route";
+
+  WMListenerWorker wmlw;
+  wmlw.setSnapshotMode(true);
+
+  bool route_flag = false;
+  wmlw.setRouteCallback([&]() {
+    // The route must already be visible to users through the snapshot
+    route_flag = (bool)wmlw.getSnapshot()->getRoute();
+  });
+
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(map_msg));
+  wmlw.routeCallback(std::make_unique<carma_planning_msgs::msg::Route>(route_msg));
+  ASSERT_TRUE(route_flag);
+
+  auto old_snapshot = wmlw.getSnapshot();
+
+  // An update which carries no changes still moves the writer to a copy of the map
+  auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+  gf_ptr->id_ = boost::uuids::random_generator()();
+  autoware_lanelet2_msgs::msg::MapBin gf_msg;
+  carma_wm::toBinMsg(gf_ptr, &gf_msg);
+
+  wmlw.mapUpdateCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(gf_msg));
+  wmlw.publishSnapshot();
+
+  auto new_snapshot = wmlw.getSnapshot();
+
+  ASSERT_NE(old_snapshot->getMap(), new_snapshot->getMap());
+  ASSERT_TRUE((bool)new_snapshot->getRoute());
+  ASSERT_EQ("snapshot_route", new_snapshot->getRouteName());
+
+  // Each snapshot's route refers to the lanelets of its own map
+  for (const auto& snapshot : { old_snapshot, new_snapshot })
+  {
+    auto route_llt = snapshot->getRoute()->shortestPath()[0];
+    ASSERT_EQ(snapshot->getMap()->laneletLayer.get(route_llt.id()).constData(), route_llt.constData());
+
+    auto graph_llt = snapshot->getMapRoutingGraph()->passableSubmap()->laneletLayer.get(route_llt.id());
+    ASSERT_EQ(route_llt.constData(), graph_llt.constData());
+  }
+
+  ASSERT_NEAR(old_snapshot->getRouteEndTrackPos().downtrack, new_snapshot->getRouteEndTrackPos().downtrack, 0.0001);
+  ASSERT_NEAR(old_snapshot->routeTrackPos(lanelet::BasicPoint2d(0.5, 1.0)).downtrack,
+              new_snapshot->routeTrackPos(lanelet::BasicPoint2d(0.5, 1.0)).downtrack, 0.0001);
+}
+
+TEST(WMListenerWorkerTest, snapshotConcurrentReadersAndWriters)
+{
+  using namespace lanelet::units::literals;
+
+  CARMAWorldModel cwm;
+  addStraightRoute(cwm);
+
+  auto map_ptr = lanelet::utils::removeConst(cwm.getMap());
+  lanelet::Id llt_id = cwm.getRoute()->shortestPath()[0].id();
+  auto llt = map_ptr->laneletLayer.get(llt_id);
+
+  // A traffic signal at the end of the first route lanelet receives SPaT updates
+  lanelet::Id signal_id = lanelet::utils::getId();
+  lanelet::LineString3d stop_line(lanelet::utils::getId(), { llt.leftBound3d().back(), llt.rightBound3d().back() });
+  std::shared_ptr<lanelet::CarmaTrafficSignal> traffic_light(new lanelet::CarmaTrafficSignal(lanelet::CarmaTrafficSignal::buildData(signal_id, { stop_line }, { llt }, { llt })));
+  llt.addRegulatoryElement(traffic_light);
+  map_ptr->add(traffic_light);
+
+  autoware_lanelet2_msgs::msg::MapBin map_msg;
+  lanelet::utils::conversion::toBinMsg(map_ptr, &map_msg);
+
+  carma_planning_msgs::msg::Route route_msg;
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[0].id());
+  route_msg.shortest_path_lanelet_ids.push_back(cwm.getRoute()->shortestPath()[1].id());
+  route_msg.end_point.x = 0.5;
+  route_msg.end_point.y = 2.0;
+
+  WMListenerWorker wmlw;
+  wmlw.setSnapshotMode(true);
+  wmlw.mapCallback(std::make_unique<autoware_lanelet2_msgs::msg::MapBin>(map_msg));
+  wmlw.routeCallback(std::make_unique<carma_planning_msgs::msg::Route>(route_msg));
+  wmlw.publishSnapshot();
+
+  // Each map update adds one more speed limit to the first route lanelet
+  constexpr size_t num_map_updates = 50;
+  std::vector<autoware_lanelet2_msgs::msg::MapBin> update_msgs(num_map_updates);
+  for (size_t i = 0; i < num_map_updates; ++i)
+  {
+    lanelet::DigitalSpeedLimitPtr speed_limit = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(
+        lanelet::utils::getId(), 5_mph, {llt}, {}, { lanelet::Participants::VehicleCar }));
+
+    auto gf_ptr = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl());
+    gf_ptr->id_ = boost::uuids::random_generator()();
+    gf_ptr->update_list_.push_back(std::make_pair(llt_id, speed_limit));
+
+    if (i == 0)
+    {
+      gf_ptr->sim_.intersection_id_to_regem_id_[1] = 1001;
+      gf_ptr->sim_.signal_group_to_traffic_light_id_[1] = signal_id;
+    }
+
+    carma_wm::toBinMsg(gf_ptr, &update_msgs[i]);
+    update_msgs[i].seq_id = i;
+  }
+
+  // Writers are serialized by this mutex as they are by WMListener
+  std::mutex writer_mutex;
+  std::atomic<bool> writers_done(false);
+  std::atomic<size_t> failures(0);
+  std::atomic<size_t> reads(0);
+
+  std::thread object_writer([&]() {
+    for (size_t i = 0; i < 2000; ++i)
+    {
+      // Every object in a list carries the size of the list as its id so torn reads can be detected
+      auto msg = std::make_shared<carma_perception_msgs::msg::RoadwayObstacleList>();
+      size_t list_size = 1 + (i % 7);
+      msg->roadway_obstacles.resize(list_size);
+      for (auto& obstacle : msg->roadway_obstacles)
+      {
+        obstacle.object.id = list_size;
+      }
+
+      const std::lock_guard<std::mutex> lock(writer_mutex);
+      wmlw.roadwayObjectListCallback(msg);
+      wmlw.publishSnapshot();
+    }
+  });
+
+  // Every event of a SPaT message carries the index of the message as its timing so torn reads can be detected
+  auto make_spat = [](size_t i) {
+    carma_v2x_msgs::msg::MovementEvent event;
+    event.event_state.movement_phase_state = 5;
+    event.timing.min_end_time = i;
+    event.timing.start_time = i;
+
+    carma_v2x_msgs::msg::MovementState movement;
+    movement.signal_group = 1;
+    movement.movement_event_list.resize(1 + (i % 4), event);
+
+    carma_v2x_msgs::msg::IntersectionState state;
+    state.id.id = 1;
+    state.revision = 0;
+    state.movement_list.push_back(movement);
+
+    auto spat = std::make_shared<carma_v2x_msgs::msg::SPAT>();
+    spat->intersection_state_list.push_back(state);
+    return spat;
+  };
+
+  std::thread spat_writer([&]() {
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      const std::lock_guard<std::mutex> lock(writer_mutex);
+      if (wmlw.incomingSpatCallback(make_spat(i)))
+      {
+        wmlw.publishSnapshot();
+      }
+    }
+  });
+
+  std::thread map_writer([&]() {
+    for (const auto& update_msg : update_msgs)
+    {
+      const std::lock_guard<std::mutex> lock(writer_mutex);
+      wmlw.mapUpdateCallback(std::make_shared<autoware_lanelet2_msgs::msg::MapBin>(update_msg));
+      wmlw.publishSnapshot();
+    }
+  });
+
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < 4; ++r)
+  {
+    readers.emplace_back([&]() {
+      size_t last_num_limits = 0;
+
+      // Always perform at least one read so a fast writer cannot make the test trivially pass
+      do
+      {
+        auto snapshot = wmlw.getSnapshot();
+
+        auto objects = snapshot->getRoadwayObjects();
+        for (const auto& obstacle : objects)
+        {
+          if (obstacle.object.id != objects.size())
+          {
+            failures++;
+          }
+        }
+
+        size_t num_limits = snapshot->getMap()->laneletLayer.get(llt_id).regulatoryElementsAs<lanelet::DigitalSpeedLimit>().size();
+        if (num_limits < last_num_limits)
+        {
+          failures++;  // Snapshots must be published in order
+        }
+        last_num_limits = num_limits;
+
+        if (!snapshot->getRoute() || snapshot->getRoute()->shortestPath()[0].id() != llt_id)
+        {
+          failures++;
+        }
+
+        auto signals = snapshot->getSignalsAlongRoute(lanelet::BasicPoint2d(0.5, 0.5));
+        if (signals.size() != 1 || signals.front()->id() != signal_id)
+        {
+          failures++;
+          continue;
+        }
+
+        auto time_stamps = signals.front()->recorded_time_stamps;
+        auto start_time_stamps = signals.front()->recorded_start_time_stamps;
+        if (time_stamps.size() != start_time_stamps.size())
+        {
+          failures++;
+        }
+        for (size_t i = 0; i < time_stamps.size(); ++i)
+        {
+          if (time_stamps[i].first != time_stamps.front().first || start_time_stamps[i] != time_stamps.front().first)
+          {
+            failures++;
+          }
+        }
+
+        // A held snapshot must not change while writers continue
+        std::this_thread::yield();
+        if (snapshot->getRoadwayObjects().size() != objects.size() ||
+            snapshot->getMap()->laneletLayer.get(llt_id).regulatoryElementsAs<lanelet::DigitalSpeedLimit>().size() != num_limits ||
+            signals.front()->recorded_time_stamps != time_stamps ||
+            snapshot->getSignalsAlongRoute(lanelet::BasicPoint2d(0.5, 0.5)).front()->recorded_time_stamps != time_stamps)
+        {
+          failures++;
+        }
+
+        reads++;
+      } while (!writers_done);
+    });
+  }
+
+  object_writer.join();
+  spat_writer.join();
+  map_writer.join();
+  writers_done = true;
+
+  for (auto& reader : readers)
+  {
+    reader.join();
+  }
+
+  ASSERT_EQ(0u, failures.load());
+  ASSERT_GE(reads.load(), 4u);
+
+  auto final_snapshot = wmlw.getSnapshot();
+  ASSERT_EQ(num_map_updates, final_snapshot->getMap()->laneletLayer.get(llt_id).regulatoryElementsAs<lanelet::DigitalSpeedLimit>().size());
+  ASSERT_EQ(5u, final_snapshot->getRoadwayObjects().size()); // Last list written has 1 + (1999 % 7) objects
+
+  // The signal mapping arrives with the first map update so the final SPaT message is only sent once it is applied
+  ASSERT_TRUE(wmlw.incomingSpatCallback(make_spat(1000)));
+  ASSERT_FALSE(wmlw.incomingSpatCallback(make_spat(1000))); // Repeated messages do not change the signal
+  wmlw.publishSnapshot();
+
+  auto final_signals = wmlw.getSnapshot()->getSignalsAlongRoute(lanelet::BasicPoint2d(0.5, 0.5));
+  ASSERT_EQ(1u, final_signals.size());
+  ASSERT_EQ(1u, final_signals.front()->recorded_time_stamps.size()); // 1 + (1000 % 4) events
+  ASSERT_EQ(lanelet::time::timeFromSec(1000), final_signals.front()->recorded_time_stamps.front().first);
+
+  // Earlier snapshots keep the timing they were published with
+  ASSERT_NE(final_signals.front(), final_snapshot->getSignalsAlongRoute(lanelet::BasicPoint2d(0.5, 0.5)).front());
+}
+
 }  // namespace carma_wm
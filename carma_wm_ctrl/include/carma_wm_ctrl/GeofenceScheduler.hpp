@@ -14,10 +14,12 @@
  * License for the specific language governing permissions and limitations under
  * the License.
  */
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <memory>
-#include <unordered_map>
+#include <queue>
+#include <vector>
 #include <carma_wm_ctrl/Geofence.hpp>
 #include <carma_ros2_utils/timers/Timer.hpp>
 #include <carma_ros2_utils/timers/TimerFactory.hpp>
@@ -30,6 +32,10 @@ namespace carma_wm_ctrl
 /**
  * @brief A GeofenceScheduler is responsable for notifying the user when a geofence is active or inactive according to
  * its schedule
+ *
+ * All schedule transitions are kept in a single min-heap ordered by trigger time which is drained by one repeating
+ * tick timer. Transitions which come due in the same tick are reported together, deactivations first, through one
+ * callback invocation of each kind.
  */
 class GeofenceScheduler
 {
@@ -38,23 +44,58 @@ class GeofenceScheduler
   using ROSTimerFactory = carma_ros2_utils::timers::ROSTimerFactory;
   using TimerPtr = std::unique_ptr<Timer>;
 
+public:
+  using GeofenceCallback = std::function<void(std::shared_ptr<Geofence>)>;
+  using GeofenceBatchCallback = std::function<void(const std::vector<std::shared_ptr<Geofence>>&)>;
+
+private:
+  /**
+   * @brief A pending activation or deactivation of one schedule of a geofence
+   */
+  struct ScheduledEvent
+  {
+    rcl_time_point_value_t time;  // Trigger time in nanoseconds of the scheduler clock
+    bool activation;              // True if the geofence becomes active at this time
+    uint64_t sequence;            // Insertion order used to break ties deterministically
+    std::shared_ptr<Geofence> gf_ptr;
+    size_t schedule_idx;
+  };
+
+  /**
+   * @brief Ordering which places the earliest event at the top of the heap. Deactivations are ordered before
+   * activations with the same trigger time
+   */
+  struct LaterEvent
+  {
+    bool operator()(const ScheduledEvent& a, const ScheduledEvent& b) const
+    {
+      if (a.time != b.time)
+        return a.time > b.time;
+      if (a.activation != b.activation)
+        return a.activation;
+      return a.sequence > b.sequence;
+    }
+  };
+
   std::mutex mutex_;
   std::shared_ptr<TimerFactory> timerFactory_;
-  std::unordered_map<uint32_t, std::pair<TimerPtr, bool>> timers_;  // Pairing of timers with their Id and valid status
-  std::unique_ptr<Timer> deletion_timer_;
-  std::function<void(std::shared_ptr<Geofence>)> active_callback_;
-  std::function<void(std::shared_ptr<Geofence>)> inactive_callback_;
-  uint32_t next_id_ = 0;  // Timer id counter
+  std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, LaterEvent> events_;
+  TimerPtr tick_timer_;
+  GeofenceBatchCallback active_callback_;
+  GeofenceBatchCallback inactive_callback_;
+  uint64_t next_sequence_ = 0;  // Event sequence counter
   rcl_clock_type_t clock_type_ = RCL_SYSTEM_TIME;
 
 public:
   /**
-   * @brief Constructor which takes in a TimerFactory. Timers from this factory will be used to generate the triggers
-   * for goefence activity.
+   * @brief Constructor which takes in a TimerFactory. A single repeating timer from this factory will be used to
+   * trigger geofence activity.
    *
-   * @param timerFactory A pointer to a TimerFactory which can be used to generate timers for geofence triggers.
+   * @param timerFactory A pointer to a TimerFactory which can be used to generate the tick timer.
+   * @param tick_period The period of the tick timer. Transitions are reported at most this long after they come due.
    */
-  GeofenceScheduler(std::shared_ptr<TimerFactory> timerFactory);
+  GeofenceScheduler(std::shared_ptr<TimerFactory> timerFactory,
+                    rclcpp::Duration tick_period = rclcpp::Duration(std::chrono::milliseconds(100)));
 
   /**
    * @brief Add a geofence to the scheduler. This will cause it to trigger an event when it becomes active or goes
@@ -66,21 +107,33 @@ public:
 
   /**
    * @brief Method which allows the user to set a callback which will be triggered when a geofence becomes active
+   *        The callback is invoked once per geofence. Overrides any callback set with onGeofencesActive
    *
    * @param active_callback The callback which will be triggered
    */
-  void onGeofenceActive(std::function<void(std::shared_ptr<Geofence>)> active_callback);
+  void onGeofenceActive(GeofenceCallback active_callback);
   /**
    * @brief Method which allows the user to set a callback which will be triggered when a geofence becomes in-active
+   *        The callback is invoked once per geofence. Overrides any callback set with onGeofencesInactive
    *
    * @param inactive_callback The callback which will be triggered
    */
-  void onGeofenceInactive(std::function<void(std::shared_ptr<Geofence>)> inactive_callback);
+  void onGeofenceInactive(GeofenceCallback inactive_callback);
 
   /**
-   * @brief Clears the expired timers from the memory of this scheduler
+   * @brief Method which allows the user to set a callback which will be triggered with all geofences which become
+   *        active in the same tick
+   *
+   * @param active_callback The callback which will be triggered
+   */
+  void onGeofencesActive(GeofenceBatchCallback active_callback);
+  /**
+   * @brief Method which allows the user to set a callback which will be triggered with all geofences which become
+   *        in-active in the same tick
+   *
+   * @param inactive_callback The callback which will be triggered
    */
-  void clearTimers();
+  void onGeofencesInactive(GeofenceBatchCallback inactive_callback);
 
   /**
    * @brief Get the clock type of the clock being created by the timer factory
@@ -91,35 +144,41 @@ public:
    * @brief Get current time used by scheduler
    */
   rclcpp::Time now();
+
+  /**
+   * @brief Get the number of activations and deactivations waiting to come due
+   */
+  size_t pendingEventCount();
   
 private:
   /**
-   * @brief Generates the next id to be used for a timer
-   *
-   * @return The next available timer id
+   * @brief Callback of the tick timer. Pops every event which has come due and reports all deactivated geofences
+   *        followed by all activated geofences
    */
-  uint32_t nextId();
+  void tickCallback();
 
   /**
-   * @brief The callback which is triggered when a geofence becomes active
-   *        This will call the user set active_callback set from the onGeofenceActive function
+   * @brief Queues an event. Must be called with mutex_ held
    *
-   * @param event The record of the timer event causing this to trigger
-   * @param gf The geofence which is being activated
-   * @param schedule_id index number of the schedule being used corresponding to this geofence
-   * @param timer_id The id of the timer which caused this callback to occur
+   * @param time The time at which the event comes due
+   * @param activation True if the geofence becomes active at this time
+   * @param gf_ptr The geofence which is changing state
+   * @param schedule_idx index number of the schedule being used corresponding to this geofence
    */
-  void startGeofenceCallback(std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id);
+  void pushEvent(const rclcpp::Time& time, bool activation, std::shared_ptr<Geofence> gf_ptr, size_t schedule_idx);
+
   /**
-   * @brief The callback which is triggered when a geofence becomes in-active
-   *        This will call the user set inactive_callback set from the onGeofenceInactive function
+   * @brief Queues the next activation of a schedule based on its next interval after the provided time.
+   *        Must be called with mutex_ held
+   *
+   * @param gf_ptr The geofence owning the schedule
+   * @param schedule_idx index number of the schedule being used corresponding to this geofence
+   * @param now The current time
    *
-   * @param event The record of the timer event causing this to trigger
-   * @param gf The geofence which is being un-activated
-   * @param schedule_id index number of the schedule being used corresponding to this geofence
-   * @param timer_id The id of the timer which caused this callback to occur
+   * @return False if the schedule has no active or upcoming control period
    */
-  void endGeofenceCallback(std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id);
+  bool scheduleNextActivation(std::shared_ptr<Geofence> gf_ptr, size_t schedule_idx, const rclcpp::Time& now);
 
+  FRIEND_TEST(GeofenceScheduler, tenThousandSchedulesBenchmark);
 };
 }  // namespace carma_wm_ctrl
\ No newline at end of file
@@ -22,7 +22,9 @@
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/date_defs.hpp>
 #include <boost/icl/interval_set.hpp>
+#include <boost/optional.hpp>
 #include <unordered_set>
+#include <set>
 #include <rclcpp/rclcpp.hpp>
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_core/primitives/Lanelet.h>
@@ -40,11 +42,13 @@
 #include <geometry_msgs/msg/pose_stamped.h>
 
 #include <carma_wm/MapConformer.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 
 #include <lanelet2_extension/traffic_rules/CarmaUSTrafficRules.h>
 #include <lanelet2_core/utility/Units.h>
 #include <carma_perception_msgs/msg/check_active_geofence.hpp>
 #include <carma_wm/TrafficControl.hpp>
+#include <carma_wm/MapBinTransport.hpp>
 #include <std_msgs/msg/string.hpp>
 #include <unordered_set>
 #include <visualization_msgs/msg/marker_array.hpp>
@@ -124,6 +128,18 @@ public:
    * \brief Removes a geofence from the current map and publishes the ROS msg
    */
   void removeGeofence(std::shared_ptr<Geofence> gf_ptr);
+
+  /*!
+   * \brief Adds the geofences which became active in the same scheduler tick to the current map while holding the map lock once
+   *        One ROS msg combining every geofence is published, with at most one routing graph update
+   */
+  void addGeofences(const std::vector<std::shared_ptr<Geofence>>& gf_ptrs);
+
+  /*!
+   * \brief Removes the geofences which became inactive in the same scheduler tick from the current map while holding the map lock once
+   *        One ROS msg combining every geofence is published, with at most one routing graph update
+   */
+  void removeGeofences(const std::vector<std::shared_ptr<Geofence>>& gf_ptrs);
   
   /*!
   * \brief Calls controlRequestFromRoute() and publishes the TrafficControlRequest Message returned after the completed operations
@@ -141,7 +157,7 @@ public:
   * \brief composeTCRStatus() compose TCM Request visualization on UI
   * \param input The message containing tcr information
   */
-  carma_v2x_msgs::msg::TrafficControlRequestPolygon composeTCRStatus(const lanelet::BasicPoint3d& localPoint, const carma_v2x_msgs::msg::TrafficControlBounds& cB, const lanelet::projection::LocalFrameProjector& local_projector);
+  carma_v2x_msgs::msg::TrafficControlRequestPolygon composeTCRStatus(const lanelet::BasicPoint3d& localPoint, const carma_v2x_msgs::msg::TrafficControlBounds& cB, const carma_wm::projection::GeoreferenceProjector& local_projector);
 
  /*!
   * \brief Pulls vehicle information from CARMA Cloud at startup by providing its selected route in a TrafficControlRequest message that is published after a route is selected.
@@ -391,6 +407,24 @@ public:
    */
   void setConfigACKPubTimes(int ack_pub_times);
 
+  /*!
+   * \brief Sets whether route invalidating geofences publish routing graph deltas instead of full routing graphs.
+   @param enabled If true only the edges around the lanelets affected by a geofence are recomputed and published
+   */
+  void setRoutingGraphDeltaUpdates(bool enabled);
+
+  /*!
+   * \brief Sets whether the map and map update messages are compressed.
+   @param enabled If true the serialized map and geofences are zlib compressed before publication
+   */
+  void setMapCompression(bool enabled);
+
+  /*!
+   * \brief Sets the maximum size of the map data in a single published map message.
+   @param max_chunk_size Maps larger than this many bytes are published as a sequence of chunks. 0 disables chunking
+   */
+  void setMapChunkSize(size_t max_chunk_size);
+
   /*!
   * \brief Construct TCM acknowledgement object and populate it with params. Publish the object for a configured number of times.
   */
@@ -408,13 +442,38 @@ public:
 private:
   double error_distance_ = 5; //meters
   lanelet::ConstLanelets route_path_;
+
+  /*!
+   * \brief A route lanelet with the geometry needed to locate the vehicle on the route without the map lock
+   */
+  struct RouteLaneletEntry
+  {
+    lanelet::ConstLanelet lanelet;
+    lanelet::BasicPolygon2d polygon;
+  };
+
+  // Active geofence state read on every pose update. Guarded by active_geofence_mutex_ rather than map_mutex_
+  // so pose updates do not wait on geofence application
+  std::mutex active_geofence_mutex_;
   std::unordered_set<lanelet::Id> active_geofence_llt_ids_; 
+  std::vector<RouteLaneletEntry> route_lanelet_entries_; // Route lanelets in route (downtrack) order
+  std::unordered_map<lanelet::Id, size_t> route_lanelet_indices_; // Index into route_lanelet_entries_ by lanelet id
+  std::set<size_t> active_route_lanelet_indices_; // Indices of route lanelets with an active geofence in downtrack order
+  size_t route_lanelet_hint_ = 0; // Route index the vehicle was last located on
   std::unordered_map<uint8_t, std::shared_ptr<Geofence>> work_zone_geofence_cache_;
   std::unordered_map<uint32_t, lanelet::Id> traffic_light_id_lookup_;
   void addRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr) const;
   void addBackRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr) const;
   void removeGeofenceHelper(std::shared_ptr<Geofence> gf_ptr) const;
   void addGeofenceHelper(std::shared_ptr<Geofence> gf_ptr);
+  std::vector<std::shared_ptr<Geofence>> activateGeofence(std::shared_ptr<Geofence> gf_ptr);
+  bool deactivateGeofence(std::shared_ptr<Geofence> gf_ptr);
+  void publishMapUpdate(const std::vector<std::shared_ptr<Geofence>>& updates, bool activation, bool include_sim);
+  void setActiveGeofenceRoute(const lanelet::ConstLanelets& path);
+  void updateActiveGeofenceLanelets(const std::vector<std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>>& llt_list, bool active);
+  bool isActiveGeofenceLanelet(lanelet::Id id);
+  boost::optional<size_t> locateOnRoute(const lanelet::BasicPoint2d& curr_pos);
+  void updateRoutingGraph(const std::vector<lanelet::Id>& affected_llt_ids, autoware_lanelet2_msgs::msg::MapBin& gf_msg, carma_wm::TrafficControl& traffic_control);
   bool shouldChangeControlLine(const lanelet::ConstLaneletOrArea& el,const lanelet::RegulatoryElementConstPtr& regem, std::shared_ptr<Geofence> gf_ptr) const;
   bool shouldChangeTrafficSignal(const lanelet::ConstLaneletOrArea& el,const lanelet::RegulatoryElementConstPtr& regem, std::shared_ptr<carma_wm::SignalizedIntersectionManager> sim) const;
   void addPassingControlLineFromMsg(std::shared_ptr<Geofence> gf_ptr, const carma_v2x_msgs::msg::TrafficControlMessageV01& msg_v01, const std::vector<lanelet::Lanelet>& affected_llts) const; 
@@ -425,9 +484,11 @@ private:
                                                       const lanelet::Point3d& left_back_pt, const lanelet::Point3d& right_back_pt, double increment_distance = 0.25);
   std::unordered_set<lanelet::Lanelet> filterSuccessorLanelets(const std::unordered_set<lanelet::Lanelet>& possible_lanelets, const std::unordered_set<lanelet::Lanelet>& root_lanelets);
   
-  lanelet::LaneletMapPtr base_map_;
   lanelet::LaneletMapPtr current_map_;
   lanelet::routing::RoutingGraphPtr current_routing_graph_; // Current map routing graph
+  bool routing_graph_delta_updates_ = true; // If true route invalidating geofences publish routing graph deltas
+  carma_wm::MapBinCompression map_compression_ = carma_wm::MapBinCompression::NONE; // Compression of published map and map update messages
+  size_t map_chunk_size_ = 0; // Maximum size in bytes of the map data in a published map message. 0 disables chunking
   lanelet::Velocity config_limit;
   std::string participant_ = lanelet::Participants::VehicleCar;//Default participant type
   std::unordered_set<std::string>  checked_geofence_ids_;
@@ -35,6 +35,9 @@ namespace carma_wm_ctrl
     double config_limit = 6.67; //config speed limit in m/s
     std::string vehicle_id = "CARMA"; 
     std::string participant = "vehicle:car";
+    bool routing_graph_delta_updates = true; // If true route invalidating geofences publish routing graph deltas instead of full routing graphs
+    bool compress_map_messages = false; // If true map and map update messages are zlib compressed. Requires carma_wm based subscribers
+    int map_chunk_size = 0; // Maximum size in bytes of a published map message. Larger maps are split into chunks. 0 disables chunking
     
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const Config &c)
@@ -48,6 +51,9 @@ namespace carma_wm_ctrl
            << "vehicle_id: " << c.vehicle_id << std::endl
            << "participant: " << c.participant << std::endl
            << "config_limit: " << c.config_limit << std::endl
+           << "routing_graph_delta_updates: " << c.routing_graph_delta_updates << std::endl
+           << "compress_map_messages: " << c.compress_map_messages << std::endl
+           << "map_chunk_size: " << c.map_chunk_size << std::endl
            << "}" << std::endl;
       return output;
     }
@@ -15,18 +15,16 @@
  */
 
 #include <carma_wm_ctrl/GeofenceScheduler.hpp>
+#include <set>
 
 namespace carma_wm_ctrl
 {
-using std::placeholders::_1;
-
-GeofenceScheduler::GeofenceScheduler(std::shared_ptr<TimerFactory> timerFactory)
+GeofenceScheduler::GeofenceScheduler(std::shared_ptr<TimerFactory> timerFactory, rclcpp::Duration tick_period)
   : timerFactory_(timerFactory)
 {
-  // Create repeating loop to clear geofence timers which are no longer needed
-  deletion_timer_ =
-      timerFactory_->buildTimer(nextId(), rclcpp::Duration(1), std::bind(&GeofenceScheduler::clearTimers, this));
   clock_type_ = timerFactory_->now().get_clock_type();
+  // A single repeating timer drives every geofence schedule
+  tick_timer_ = timerFactory_->buildTimer(0, tick_period, std::bind(&GeofenceScheduler::tickCallback, this));
 }
 
 rclcpp::Time GeofenceScheduler::now()
@@ -34,37 +32,42 @@ rclcpp::Time GeofenceScheduler::now()
   return timerFactory_->now();
 }
 
-uint32_t GeofenceScheduler::nextId()
-{
-  next_id_++;
-  return next_id_;
-}
-
 rcl_clock_type_t GeofenceScheduler::getClockType()
 {
   return clock_type_;
 }
 
-void GeofenceScheduler::clearTimers()
+size_t GeofenceScheduler::pendingEventCount()
 {
   std::lock_guard<std::mutex> guard(mutex_);
-  auto it = timers_.begin();
+  return events_.size();
+}
+
+void GeofenceScheduler::pushEvent(const rclcpp::Time& time, bool activation, std::shared_ptr<Geofence> gf_ptr,
+                                  size_t schedule_idx)
+{
+  events_.push({ time.nanoseconds(), activation, next_sequence_++, gf_ptr, schedule_idx });
+}
+
+bool GeofenceScheduler::scheduleNextActivation(std::shared_ptr<Geofence> gf_ptr, size_t schedule_idx,
+                                               const rclcpp::Time& now)
+{
+  auto interval_info = gf_ptr->schedules[schedule_idx].getNextInterval(now);
+  rclcpp::Time startTime = interval_info.second;
 
-  // Erase all expired timers_ using iterators to ensure operation is safe
-  while (it != timers_.end())
+  if (!interval_info.first && startTime == rclcpp::Time(0, 0, clock_type_))
   {
-    // Check if timer is marked for deletion
-    if (it->second.second)
-    {
-      // erase() function returns the iterator of the next
-      // to last deleted element.
-      it = timers_.erase(it);
-    }
-    else
-    {
-      it++;
-    }
+    return false;
   }
+
+  // If this geofence is currently active set the start time to now
+  if (interval_info.first)
+  {
+    startTime = now;
+  }
+
+  pushEvent(startTime, true, gf_ptr, schedule_idx);
+  return true;
 }
 
 void GeofenceScheduler::addGeofence(std::shared_ptr<Geofence> gf_ptr)
@@ -73,106 +76,123 @@ void GeofenceScheduler::addGeofence(std::shared_ptr<Geofence> gf_ptr)
 
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Attempting to add Geofence with Id: " << gf_ptr->id_);
 
-  // Create timer for next start time
+  rclcpp::Time now = timerFactory_->now();
+
+  // Queue the next start time of each schedule
   for (size_t schedule_idx = 0; schedule_idx < gf_ptr->schedules.size(); schedule_idx++)
   {
-    // resolve clock type
-    auto interval_info = gf_ptr->schedules[schedule_idx].getNextInterval(timerFactory_->now());
-    rclcpp::Time startTime = interval_info.second;
-
-    if (!interval_info.first && startTime == rclcpp::Time(0, 0, clock_type_))
+    if (!scheduleNextActivation(gf_ptr, schedule_idx, now))
     {
       RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm_ctrl"), 
           "Failed to add geofence as its schedule did not contain an active or upcoming control period. GF Id: "
           << gf_ptr->id_);
       return;
     }
-    // If this geofence is currently active set the start time to now
-    if (interval_info.first)
-    {
-      startTime = timerFactory_->now();
-    }
-
-    int32_t timer_id = nextId();
-
-    rclcpp::Duration control_duration = rclcpp::Duration(std::max((startTime - timerFactory_->now()).seconds() * 1e9, 0.0)); //guard for negative value
-
-    // Build timer to trigger when this geofence becomes active
-    TimerPtr timer = timerFactory_->buildTimer(
-        timer_id, control_duration,
-        std::bind(&GeofenceScheduler::startGeofenceCallback, this, gf_ptr, schedule_idx, timer_id), true, true);
-
-    timers_[timer_id] = std::make_pair(std::move(timer), false);  // Add start timer to map by Id
   }
-
 }
 
-void GeofenceScheduler::startGeofenceCallback(std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id)
+void GeofenceScheduler::tickCallback()
 {
-  std::lock_guard<std::mutex> guard(mutex_);
-  rclcpp::Time endTime = timerFactory_->now() + gf_ptr->schedules[schedule_id].control_span_;
-
-  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Activating Geofence with Id: " << gf_ptr->id_ << ", which will end at:" << endTime.seconds());
-
-  active_callback_(gf_ptr);
-
-  // Build timer to trigger when this geofence becomes inactive
-  int32_t ending_timer_id = nextId();
+  std::vector<std::shared_ptr<Geofence>> activated;
+  std::vector<std::shared_ptr<Geofence>> deactivated;
+  GeofenceBatchCallback active_callback;
+  GeofenceBatchCallback inactive_callback;
 
-  rclcpp::Duration control_duration = rclcpp::Duration(std::max((endTime - timerFactory_->now()).seconds() * 1e9, 0.0)); //guard for negative value
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
 
-  TimerPtr timer = timerFactory_->buildTimer(
-      ending_timer_id, control_duration,
-      std::bind(&GeofenceScheduler::endGeofenceCallback, this, gf_ptr, schedule_id, ending_timer_id), true, true);
-  timers_[ending_timer_id] = std::make_pair(std::move(timer), false);  // Add end timer to map by Id
+    rclcpp::Time now = timerFactory_->now();
 
-  timers_[timer_id].second = true;  // Mark start timer for deletion
-}
+    // Schedules activated in this tick. Their deactivation is held until the next tick so it is never reported before
+    // the activation
+    std::set<std::pair<Geofence*, size_t>> activated_schedules;
+    std::vector<ScheduledEvent> held_events;
+    // Schedules deactivated in this tick. Their next activation is queued after the drain for the same reason
+    std::vector<std::pair<std::shared_ptr<Geofence>, size_t>> ended_schedules;
 
-void GeofenceScheduler::endGeofenceCallback(std::shared_ptr<Geofence> gf_ptr, const unsigned int schedule_id, const int32_t timer_id)
-{
-  std::lock_guard<std::mutex> guard(mutex_);
+    while (!events_.empty() && events_.top().time <= now.nanoseconds())
+    {
+      ScheduledEvent event = events_.top();
+      events_.pop();
+
+      if (event.activation)
+      {
+        rclcpp::Time endTime = rclcpp::Time(event.time, clock_type_) + event.gf_ptr->schedules[event.schedule_idx].control_span_;
+
+        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Activating Geofence with Id: " << event.gf_ptr->id_ << ", which will end at:" << endTime.seconds());
+
+        activated.push_back(event.gf_ptr);
+        activated_schedules.emplace(event.gf_ptr.get(), event.schedule_idx);
+        pushEvent(endTime, false, event.gf_ptr, event.schedule_idx);
+      }
+      else if (activated_schedules.count(std::make_pair(event.gf_ptr.get(), event.schedule_idx)))
+      {
+        held_events.push_back(event);
+      }
+      else
+      {
+        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Deactivating Geofence with Id: " << event.gf_ptr->id_);
+
+        deactivated.push_back(event.gf_ptr);
+        ended_schedules.emplace_back(event.gf_ptr, event.schedule_idx);
+      }
+    }
 
-  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Deactivating Geofence with Id: " << gf_ptr->id_);
+    for (const auto& event : held_events)
+    {
+      events_.push(event);
+    }
 
-  inactive_callback_(gf_ptr);
-  timers_[timer_id].second = true;  // Mark timer for deletion
+    // Determine if new activations are needed for the geofences which ended
+    for (const auto& ended : ended_schedules)
+    {
+      scheduleNextActivation(ended.first, ended.second, now);
+    }
 
-  // Determine if a new timer is needed for this geofence
-  auto interval_info = gf_ptr->schedules[schedule_id].getNextInterval(timerFactory_->now());
-  rclcpp::Time startTime = interval_info.second;
+    active_callback = active_callback_;
+    inactive_callback = inactive_callback_;
+  }
 
-  // If this geofence should currently be active set the start time to now
-  if (interval_info.first)
+  // Callbacks are invoked without holding the lock so they are free to add geofences.
+  // Deactivations are applied first so a control replaced by another one in the same tick is removed before its successor is added
+  if (!deactivated.empty())
   {
-    startTime = timerFactory_->now();
+    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Deactivating " << deactivated.size() << " geofence(s)");
+    if (inactive_callback)
+      inactive_callback(deactivated);
   }
 
-  if (!interval_info.first && startTime == rclcpp::Time(0, 0, clock_type_))
+  if (!activated.empty())
   {
-    // No more active periods for this geofence so return
-    return;
+    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Activating " << activated.size() << " geofence(s)");
+    if (active_callback)
+      active_callback(activated);
   }
+}
 
-  // Build timer to trigger when this geofence becomes active
-  int32_t start_timer_id = nextId();
-
-  rclcpp::Duration control_duration = rclcpp::Duration(std::max((startTime - timerFactory_->now()).seconds() * 1e9, 0.0)); //guard for negative value
-
-  TimerPtr timer = timerFactory_->buildTimer(
-      start_timer_id, control_duration,
-      std::bind(&GeofenceScheduler::startGeofenceCallback, this, gf_ptr, schedule_id, start_timer_id), true, true);
+void GeofenceScheduler::onGeofenceActive(GeofenceCallback active_callback)
+{
+  onGeofencesActive([active_callback](const std::vector<std::shared_ptr<Geofence>>& gf_ptrs) {
+    for (const auto& gf_ptr : gf_ptrs)
+      active_callback(gf_ptr);
+  });
+}
 
-  timers_[start_timer_id] = std::make_pair(std::move(timer), false);  // Add start timer to map by Id
+void GeofenceScheduler::onGeofenceInactive(GeofenceCallback inactive_callback)
+{
+  onGeofencesInactive([inactive_callback](const std::vector<std::shared_ptr<Geofence>>& gf_ptrs) {
+    for (const auto& gf_ptr : gf_ptrs)
+      inactive_callback(gf_ptr);
+  });
 }
 
-void GeofenceScheduler::onGeofenceActive(std::function<void(std::shared_ptr<Geofence>)> active_callback)
+void GeofenceScheduler::onGeofencesActive(GeofenceBatchCallback active_callback)
 {
   std::lock_guard<std::mutex> guard(mutex_);
   active_callback_ = active_callback;
 }
 
-void GeofenceScheduler::onGeofenceInactive(std::function<void(std::shared_ptr<Geofence>)> inactive_callback)
+void GeofenceScheduler::onGeofencesInactive(GeofenceBatchCallback inactive_callback)
 {
   std::lock_guard<std::mutex> guard(mutex_);
   inactive_callback_ = inactive_callback;
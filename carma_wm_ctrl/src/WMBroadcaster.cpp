@@ -18,6 +18,7 @@
 #include <mutex>
 #include <carma_wm_ctrl/WMBroadcaster.hpp>
 #include <carma_wm/Geometry.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <carma_wm/MapConformer.hpp>
 #include <autoware_lanelet2_ros2_interface/utility/message_conversion.hpp>
 #include <lanelet2_extension/projection/local_frame_projector.h>
@@ -38,7 +39,7 @@
 #include <carma_wm/Geometry.hpp>
 #include <math.h>
 #include <boost/date_time/date_defs.hpp>
-#include "RoutingGraphAccessor.hpp"
+#include <carma_wm/RoutingGraphAccessor.hpp>
 
 namespace carma_wm_ctrl
 {
@@ -48,8 +49,8 @@ WMBroadcaster::WMBroadcaster(const PublishMapCallback& map_pub, const PublishMap
 const PublishActiveGeofCallback& active_pub, std::shared_ptr<carma_ros2_utils::timers::TimerFactory> timer_factory, const PublishMobilityOperationCallback& tcm_ack_pub)
   : map_pub_(map_pub), map_update_pub_(map_update_pub), control_msg_pub_(control_msg_pub), active_pub_(active_pub), scheduler_(timer_factory), tcm_ack_pub_(tcm_ack_pub)
 {
-  scheduler_.onGeofenceActive(std::bind(&WMBroadcaster::addGeofence, this, _1));
-  scheduler_.onGeofenceInactive(std::bind(&WMBroadcaster::removeGeofence, this, _1));
+  scheduler_.onGeofencesActive(std::bind(&WMBroadcaster::addGeofences, this, _1));
+  scheduler_.onGeofencesInactive(std::bind(&WMBroadcaster::removeGeofences, this, _1));
   std::bind(&WMBroadcaster::routeCallbackMessage, this, _1);
 };
 
@@ -69,17 +70,17 @@ void WMBroadcaster::baseMapCallback(autoware_lanelet2_msgs::msg::MapBin::UniqueP
     RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "WMBroadcaster::baseMapCallback called multiple times in the same node");
   }
 
+  // The map is decoded and conformed a single time. Geofences are applied directly to this map and record the
+  // regulations they replace so an unmodified copy of the base map is not needed
   lanelet::LaneletMapPtr new_map(new lanelet::LaneletMap);
-  lanelet::LaneletMapPtr new_map_to_change(new lanelet::LaneletMap);
 
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map);
-  lanelet::utils::conversion::fromBinMsg(*map_msg, new_map_to_change);
+  carma_wm::mapFromBinMsg(*map_msg, new_map);
 
-  base_map_ = new_map;  // Store map
-  current_map_ = new_map_to_change; // broadcaster makes changes to this
+  map_msg.reset(); // Release the encoded map before the routing graph is built to reduce peak memory usage
 
-  lanelet::MapConformer::ensureCompliance(base_map_, config_limit);     // Update map to ensure it complies with expectations
-  lanelet::MapConformer::ensureCompliance(current_map_, config_limit);
+  current_map_ = new_map; // broadcaster makes changes to this
+
+  lanelet::MapConformer::ensureCompliance(current_map_, config_limit); // Update map to ensure it complies with expectations
 
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Building routing graph for base map");
 
@@ -104,9 +105,14 @@ void WMBroadcaster::baseMapCallback(autoware_lanelet2_msgs::msg::MapBin::UniqueP
 
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done creating routing graph message.");
 
-  lanelet::utils::conversion::toBinMsg(current_map_, &compliant_map_msg);
+  carma_wm::mapToBinMsg(current_map_, &compliant_map_msg, map_compression_);
   compliant_map_msg.map_version = current_map_version_;
-  map_pub_(compliant_map_msg);
+
+  // Large maps are published as a burst of chunks so no single sample has to hold the whole map
+  for (const auto& chunk : carma_wm::splitMapBinMsg(std::move(compliant_map_msg), map_chunk_size_))
+  {
+    map_pub_(chunk);
+  }
 };
 
 /*!
@@ -1239,6 +1245,21 @@ void WMBroadcaster::setConfigACKPubTimes(int ack_pub_times){
   ack_pub_times_ = ack_pub_times;
 }
 
+void WMBroadcaster::setRoutingGraphDeltaUpdates(bool enabled)
+{
+  routing_graph_delta_updates_ = enabled;
+}
+
+void WMBroadcaster::setMapCompression(bool enabled)
+{
+  map_compression_ = enabled ? carma_wm::MapBinCompression::ZLIB : carma_wm::MapBinCompression::NONE;
+}
+
+void WMBroadcaster::setMapChunkSize(size_t max_chunk_size)
+{
+  map_chunk_size_ = max_chunk_size;
+}
+
 void WMBroadcaster::setVehicleParticipationType(std::string participant)
 {
   participant_ = participant;
@@ -1487,8 +1508,29 @@ void WMBroadcaster::addBackRegulatoryComponent(std::shared_ptr<Geofence> gf_ptr)
 
 void WMBroadcaster::addGeofence(std::shared_ptr<Geofence> gf_ptr)
 {
-   
+  addGeofences({ gf_ptr });
+}
+
+void WMBroadcaster::addGeofences(const std::vector<std::shared_ptr<Geofence>>& gf_ptrs)
+{
   std::lock_guard<std::mutex> guard(map_mutex_);
+
+  std::vector<std::shared_ptr<Geofence>> applied_updates;
+  bool includes_map_msg = false;
+
+  for (const auto& gf_ptr : gf_ptrs)
+  {
+    auto updates = activateGeofence(gf_ptr);
+    applied_updates.insert(applied_updates.end(), updates.begin(), updates.end());
+
+    includes_map_msg = includes_map_msg || (gf_ptr->msg_.package.label_exists && gf_ptr->msg_.package.label.find("MAP_MSG") != std::string::npos);
+  }
+
+  publishMapUpdate(applied_updates, true, includes_map_msg);
+}
+
+std::vector<std::shared_ptr<Geofence>> WMBroadcaster::activateGeofence(std::shared_ptr<Geofence> gf_ptr)
+{
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Adding active geofence to the map with geofence id: " << gf_ptr->id_);
   
   // if applying workzone geometry geofence, utilize workzone chache to create one 
@@ -1515,6 +1557,8 @@ void WMBroadcaster::addGeofence(std::shared_ptr<Geofence> gf_ptr)
     updates_to_send.push_back(gf_ptr);
   }
 
+  std::vector<std::shared_ptr<Geofence>> applied_updates;
+
   for (auto update : updates_to_send)
   {    
     // add marker to rviz
@@ -1528,100 +1572,172 @@ void WMBroadcaster::addGeofence(std::shared_ptr<Geofence> gf_ptr)
     
     if (!detected_map_msg_signal)
     {
-      for (auto pair : update->update_list_) active_geofence_llt_ids_.insert(pair.first);
+      updateActiveGeofenceLanelets(update->update_list_, true);
     }
 
-    autoware_lanelet2_msgs::msg::MapBin gf_msg;
-    
-    // If the geofence invalidates the route graph then recompute the routing graph now that the map has been updated
-    if (update->invalidate_route_) {
-
-      RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Rebuilding routing graph after is was invalidated by geofence");
+    applied_updates.push_back(update);
+  }
 
-      lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car = lanelet::traffic_rules::TrafficRulesFactory::create(
-      lanelet::traffic_rules::CarmaUSTrafficRules::Location, participant_);
-      current_routing_graph_ = lanelet::routing::RoutingGraph::build(*current_map_, *traffic_rules_car);
+  return applied_updates;
+}
 
-      RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done rebuilding routing graph after is was invalidated by geofence");
+void WMBroadcaster::publishMapUpdate(const std::vector<std::shared_ptr<Geofence>>& updates, bool activation, bool include_sim)
+{
+  if (updates.empty())
+    return;
 
-      // Populate routing graph structure
-      RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Creating routing graph message");
+  // A batch of one keeps the id of its geofence. A combined update gets an id of its own
+  boost::uuids::uuid update_id = updates.size() == 1 ? updates.front()->id_ : boost::uuids::random_generator()();
 
-      auto readable_graph = std::static_pointer_cast<RoutingGraphAccessor>(current_routing_graph_);
+  auto send_data = std::make_shared<carma_wm::TrafficControl>();
+  send_data->id_ = update_id;
 
-      gf_msg.routing_graph = readable_graph->routingGraphToMsg(participant_);
-      gf_msg.has_routing_graph = true;
+  std::vector<lanelet::Id> affected_llt_ids;
+  bool invalidate_route = false;
 
-      RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done creating routing graph message");
+  for (const auto& update : updates)
+  {
+    // Listeners apply every removal before any update, so a regulation added earlier in the batch and removed by a later
+    // geofence is dropped from the update list rather than sent in both lists
+    for (const auto& pair : update->remove_list_)
+    {
+      auto added = std::find_if(send_data->update_list_.begin(), send_data->update_list_.end(), [&pair](const auto& update_pair) {
+        return update_pair.first == pair.first && update_pair.second->id() == pair.second->id();
+      });
+
+      if (added != send_data->update_list_.end())
+        send_data->update_list_.erase(added);
+      else
+        send_data->remove_list_.push_back(pair);
     }
-    
 
-    // Publish
-    auto send_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(update->id_, update->update_list_, update->remove_list_, update->lanelet_additions_));
-    send_data->traffic_light_id_lookup_ = update->traffic_light_id_lookup_;
+    send_data->update_list_.insert(send_data->update_list_.end(), update->update_list_.begin(), update->update_list_.end());
 
-    if (detected_map_msg_signal && updates_to_send.back() == update) // if last update
+    if (activation)
     {
-      send_data->sim_ = *sim_;
+      send_data->lanelet_additions_.insert(send_data->lanelet_additions_.end(), update->lanelet_additions_.begin(), update->lanelet_additions_.end());
+      send_data->traffic_light_id_lookup_.insert(send_data->traffic_light_id_lookup_.end(), update->traffic_light_id_lookup_.begin(), update->traffic_light_id_lookup_.end());
     }
 
-    carma_wm::toBinMsg(send_data, &gf_msg);
-    update_count_++; // Update the sequence count for the geofence messages
-    gf_msg.seq_id = update_count_;
-    gf_msg.invalidates_route=update->invalidate_route_; 
-    gf_msg.map_version = current_map_version_;
-    map_update_pub_(gf_msg);
+    if (update->invalidate_route_)
+    {
+      invalidate_route = true;
+      for (const auto& pair : update->update_list_) affected_llt_ids.push_back(pair.first);
+      for (const auto& pair : update->remove_list_) affected_llt_ids.push_back(pair.first);
+      for (const auto& llt : update->lanelet_additions_) affected_llt_ids.push_back(llt.id());
+    }
   }
-  
+
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Publishing map update " << update_id << " combining " << updates.size() << " geofence updates");
+
+  autoware_lanelet2_msgs::msg::MapBin gf_msg;
+
+  // If any geofence invalidates the route graph then recompute the routing graph once now that the map has been updated
+  if (invalidate_route)
+  {
+    std::sort(affected_llt_ids.begin(), affected_llt_ids.end());
+    affected_llt_ids.erase(std::unique(affected_llt_ids.begin(), affected_llt_ids.end()), affected_llt_ids.end());
+
+    updateRoutingGraph(affected_llt_ids, gf_msg, *send_data);
+  }
+
+  if (include_sim)
+  {
+    send_data->sim_ = *sim_;
+  }
+
+  carma_wm::toBinMsg(send_data, &gf_msg, map_compression_);
+  update_count_++; // Update the sequence count for the geofence messages
+  gf_msg.seq_id = update_count_;
+  gf_msg.map_version = current_map_version_;
+
+  // Removals only update the routing graph, they do not ask listeners to recompute their route
+  if (activation)
+  {
+    gf_msg.invalidates_route = invalidate_route;
+  }
+
+  map_update_pub_(gf_msg);
 }
 
-void WMBroadcaster::removeGeofence(std::shared_ptr<Geofence> gf_ptr)
+void WMBroadcaster::updateRoutingGraph(const std::vector<lanelet::Id>& affected_llt_ids, autoware_lanelet2_msgs::msg::MapBin& gf_msg, carma_wm::TrafficControl& traffic_control)
 {
-  std::lock_guard<std::mutex> guard(map_mutex_);
-  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Removing inactive geofence from the map with geofence id: " << gf_ptr->id_);
-  
-  // Process the geofence object to populate update remove lists
-  if (gf_ptr->affected_parts_.empty())
-    return;
+  lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car = lanelet::traffic_rules::TrafficRulesFactory::create(
+    lanelet::traffic_rules::CarmaUSTrafficRules::Location, participant_);
 
-  removeGeofenceHelper(gf_ptr);
+  if (routing_graph_delta_updates_ && current_routing_graph_)
+  {
+    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Computing routing graph delta for " << affected_llt_ids.size() << " affected lanelets");
 
-  for (auto pair : gf_ptr->remove_list_) active_geofence_llt_ids_.erase(pair.first);
+    carma_wm::RoutingGraphDelta delta = carma_wm::computeRoutingGraphDelta(*current_map_, *traffic_rules_car, affected_llt_ids, participant_);
+    delta.base_graph_hash = carma_wm::routingGraphHash(*current_routing_graph_);
+    auto updated_graph = carma_wm::applyRoutingGraphDelta(*current_routing_graph_, delta, current_map_);
+
+    if (updated_graph)
+    {
+      current_routing_graph_ = updated_graph;
+      traffic_control.routing_graph_delta_ = delta;
+      traffic_control.has_routing_graph_delta_ = true;
 
-  // publish
-  autoware_lanelet2_msgs::msg::MapBin gf_msg_revert;
-  auto send_data = std::make_shared<carma_wm::TrafficControl>(carma_wm::TrafficControl(gf_ptr->id_, gf_ptr->update_list_, gf_ptr->remove_list_, {}));
+      RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done computing routing graph delta with " << delta.edges.size() << " edges");
+      return;
+    }
 
-  if (gf_ptr->invalidate_route_) { // If a geofence initially invalidated the route it stands to reason its removal should as well
+    RCLCPP_WARN_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Routing graph delta could not be applied. Falling back to rebuilding the full routing graph");
+  }
 
-    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Rebuilding routing graph after is was invalidated by geofence removal");
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Rebuilding routing graph after is was invalidated by geofence");
 
-    lanelet::traffic_rules::TrafficRulesUPtr traffic_rules_car = lanelet::traffic_rules::TrafficRulesFactory::create(
-      lanelet::traffic_rules::CarmaUSTrafficRules::Location, participant_
-    );
-    current_routing_graph_ = lanelet::routing::RoutingGraph::build(*current_map_, *traffic_rules_car);
+  current_routing_graph_ = lanelet::routing::RoutingGraph::build(*current_map_, *traffic_rules_car);
 
-    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done rebuilding routing graph after is was invalidated by geofence removal");
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done rebuilding routing graph after is was invalidated by geofence");
 
-    // Populate routing graph structure
-    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Creating routing graph message for geofence removal");
+  // Populate routing graph structure
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Creating routing graph message");
 
-    auto readable_graph = std::static_pointer_cast<RoutingGraphAccessor>(current_routing_graph_);
+  auto readable_graph = std::static_pointer_cast<RoutingGraphAccessor>(current_routing_graph_);
+
+  gf_msg.routing_graph = readable_graph->routingGraphToMsg(participant_);
+  gf_msg.has_routing_graph = true;
+
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done creating routing graph message");
+}
+
+void WMBroadcaster::removeGeofence(std::shared_ptr<Geofence> gf_ptr)
+{
+  removeGeofences({ gf_ptr });
+}
+
+void WMBroadcaster::removeGeofences(const std::vector<std::shared_ptr<Geofence>>& gf_ptrs)
+{
+  std::lock_guard<std::mutex> guard(map_mutex_);
 
-    gf_msg_revert.routing_graph = readable_graph->routingGraphToMsg(participant_);
-    gf_msg_revert.has_routing_graph = true;
+  std::vector<std::shared_ptr<Geofence>> applied_updates;
 
-    RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Done creating routing graph message for geofence removal");
+  for (const auto& gf_ptr : gf_ptrs)
+  {
+    if (deactivateGeofence(gf_ptr))
+    {
+      applied_updates.push_back(gf_ptr);
+    }
   }
+
+  publishMapUpdate(applied_updates, false, false);
+}
+
+bool WMBroadcaster::deactivateGeofence(std::shared_ptr<Geofence> gf_ptr)
+{
+  RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Removing inactive geofence from the map with geofence id: " << gf_ptr->id_);
   
-  carma_wm::toBinMsg(send_data, &gf_msg_revert);
-  update_count_++; // Update the sequence count for geofence messages
-  gf_msg_revert.seq_id = update_count_;
-  gf_msg_revert.map_version = current_map_version_;
+  // Process the geofence object to populate update remove lists
+  if (gf_ptr->affected_parts_.empty())
+    return false;
 
-  map_update_pub_(gf_msg_revert);
+  removeGeofenceHelper(gf_ptr);
 
+  updateActiveGeofenceLanelets(gf_ptr->remove_list_, false);
 
+  return true;
 }
   
 carma_planning_msgs::msg::Route WMBroadcaster::getRoute()
@@ -1658,6 +1774,7 @@ carma_v2x_msgs::msg::TrafficControlRequest WMBroadcaster::controlRequestFromRout
 
   // update local copy
   route_path_ = path;
+  setActiveGeofenceRoute(path);
   
   if(path.size() == 0) throw lanelet::InvalidObjectStateError(std::string("No lanelets available in path."));
 
@@ -1708,13 +1825,13 @@ carma_v2x_msgs::msg::TrafficControlRequest WMBroadcaster::controlRequestFromRout
   }
   
   // Convert the minimum point to latlon
-  lanelet::projection::LocalFrameProjector local_projector(target_frame.c_str());
+  auto local_projector = carma_wm::projection::getGeoreferenceProjector(target_frame); // Shared map projector
   lanelet::BasicPoint3d localPoint;
 
   localPoint.x()= minX;
   localPoint.y()= minY;
 
-  lanelet::GPSPoint gpsRoute = local_projector.reverse(localPoint); //If the appropriate library is included, the reverse() function can be used to convert from local xyz to lat/lon
+  lanelet::GPSPoint gpsRoute = local_projector->reverse(localPoint); //If the appropriate library is included, the reverse() function can be used to convert from local xyz to lat/lon
 
   // Create a local transverse mercator frame at the minimum point to allow us to get east,north oriented bounds 
   std::string local_tmerc_enu_proj = "+proj=tmerc +datum=WGS84 +h_0=0 +lat_0=" + std::to_string(gpsRoute.lat) + " +lon_0=" + std::to_string(gpsRoute.lon);
@@ -1759,7 +1876,7 @@ carma_v2x_msgs::msg::TrafficControlRequest WMBroadcaster::controlRequestFromRout
   cB.offsets[2].deltax = 0.0;
   cB.offsets[2].deltay = pj_max_tmerc.xyz.y - pj_min_tmerc.xyz.y;
 
-  tcr_polygon_ = composeTCRStatus(localPoint, cB, local_projector); // TCR polygon can be visualized in UI
+  tcr_polygon_ = composeTCRStatus(localPoint, cB, *local_projector); // TCR polygon can be visualized in UI
 
   cB.oldest =rclcpp::Time(0.0,0.0, scheduler_.getClockType()); // TODO this needs to be set to 0 or an older value as otherwise this will filter out all controls
   
@@ -1789,7 +1906,7 @@ carma_v2x_msgs::msg::TrafficControlRequest WMBroadcaster::controlRequestFromRout
 
 }
 
-carma_v2x_msgs::msg::TrafficControlRequestPolygon WMBroadcaster::composeTCRStatus(const lanelet::BasicPoint3d& localPoint, const carma_v2x_msgs::msg::TrafficControlBounds& cB, const lanelet::projection::LocalFrameProjector& local_projector)
+carma_v2x_msgs::msg::TrafficControlRequestPolygon WMBroadcaster::composeTCRStatus(const lanelet::BasicPoint3d& localPoint, const carma_v2x_msgs::msg::TrafficControlBounds& cB, const carma_wm::projection::GeoreferenceProjector& local_projector)
 {
   carma_v2x_msgs::msg::TrafficControlRequestPolygon output;
   lanelet::BasicPoint3d local_point_tmp;
@@ -1865,46 +1982,143 @@ visualization_msgs::msg::Marker WMBroadcaster::composeTCMMarkerVisualizer(const
         return marker;
  }
 
-double WMBroadcaster::distToNearestActiveGeofence(const lanelet::BasicPoint2d& curr_pos)
+void WMBroadcaster::setActiveGeofenceRoute(const lanelet::ConstLanelets& path)
 {
-  std::lock_guard<std::mutex> guard(map_mutex_);
+  std::vector<RouteLaneletEntry> entries;
+  entries.reserve(path.size());
+  for (const auto& llt : path)
+  {
+    llt.centerline2d(); // Cache the centerline now so trackPos does not build it concurrently with map updates
+    entries.push_back({ llt, llt.polygon2d().basicPolygon() });
+  }
+
+  std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+
+  route_lanelet_entries_ = std::move(entries);
+  route_lanelet_indices_.clear();
+  active_route_lanelet_indices_.clear();
+  route_lanelet_hint_ = 0;
+
+  for (size_t i = 0; i < route_lanelet_entries_.size(); i++)
+  {
+    lanelet::Id id = route_lanelet_entries_[i].lanelet.id();
+    route_lanelet_indices_.emplace(id, i);
+
+    if (active_geofence_llt_ids_.find(id) != active_geofence_llt_ids_.end())
+      active_route_lanelet_indices_.insert(i);
+  }
+}
+
+void WMBroadcaster::updateActiveGeofenceLanelets(const std::vector<std::pair<lanelet::Id, lanelet::RegulatoryElementPtr>>& llt_list, bool active)
+{
+  std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+
+  for (const auto& pair : llt_list)
+  {
+    if (active)
+      active_geofence_llt_ids_.insert(pair.first);
+    else
+      active_geofence_llt_ids_.erase(pair.first);
+
+    auto route_it = route_lanelet_indices_.find(pair.first);
+    if (route_it == route_lanelet_indices_.end())
+      continue;
+
+    if (active)
+      active_route_lanelet_indices_.insert(route_it->second);
+    else
+      active_route_lanelet_indices_.erase(route_it->second);
+  }
+}
 
+bool WMBroadcaster::isActiveGeofenceLanelet(lanelet::Id id)
+{
+  std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+  return active_geofence_llt_ids_.find(id) != active_geofence_llt_ids_.end();
+}
+
+boost::optional<size_t> WMBroadcaster::locateOnRoute(const lanelet::BasicPoint2d& curr_pos)
+{
+  // The vehicle normally stays on or just ahead of the lanelet it was last located on
+  for (size_t i = route_lanelet_hint_; i < std::min(route_lanelet_hint_ + 2, route_lanelet_entries_.size()); i++)
+  {
+    if (boost::geometry::within(curr_pos, route_lanelet_entries_[i].polygon))
+    {
+      route_lanelet_hint_ = i;
+      return i;
+    }
+  }
+
+  for (size_t i = 0; i < route_lanelet_entries_.size(); i++)
+  {
+    if (boost::geometry::within(curr_pos, route_lanelet_entries_[i].polygon))
+    {
+      route_lanelet_hint_ = i;
+      return i;
+    }
+  }
+
+  return boost::none;
+}
+
+double WMBroadcaster::distToNearestActiveGeofence(const lanelet::BasicPoint2d& curr_pos)
+{
   if (!current_map_ || current_map_->laneletLayer.size() == 0) 
   {
     throw lanelet::InvalidObjectStateError(std::string("Lanelet map (current_map_) is not loaded to the WMBroadcaster"));
   }
 
-  // filter only the lanelets in the route
-  std::vector<lanelet::Id> active_geofence_on_route;
-  for (auto llt : route_path_)
   {
-    if (active_geofence_llt_ids_.find(llt.id()) != active_geofence_llt_ids_.end()) 
-      active_geofence_on_route.push_back(llt.id());
+    std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+
+    auto route_idx = locateOnRoute(curr_pos);
+
+    if (route_idx)
+    {
+      // Active route lanelets are visited in downtrack order, so the first one whose start is still ahead of the vehicle is the nearest
+      // The lanelet that the vehicle is on is not accounted for
+      for (auto it = active_route_lanelet_indices_.upper_bound(route_idx.get()); it != active_route_lanelet_indices_.end(); it++)
+      {
+        carma_wm::TrackPos tp = carma_wm::geometry::trackPos(route_lanelet_entries_[*it].lanelet, curr_pos);
+        // downtrack needs to be negative for lanelet to be in front of the point
+        if (tp.downtrack < 0)
+          return fabs(tp.downtrack) + fabs(tp.crosstrack);
+      }
+      return 0.0;
+    }
+  }
+
+  // The vehicle is off the route, so the map is needed to find the lanelet it is on
+  lanelet::ConstLanelet curr_lanelet;
+  {
+    std::lock_guard<std::mutex> guard(map_mutex_);
+
+    // Get the lanelet of this point
+    curr_lanelet = lanelet::geometry::findNearest(current_map_->laneletLayer, curr_pos, 1)[0].second;
   }
-  // Get the lanelet of this point
-  auto curr_lanelet = lanelet::geometry::findNearest(current_map_->laneletLayer, curr_pos, 1)[0].second;
 
   // Check if this point at least is actually within this lanelets
   if (!boost::geometry::within(curr_pos, curr_lanelet.polygon2d().basicPolygon()))
     throw std::invalid_argument("Given point is not within any lanelet");
 
-  // get route distance (downtrack + cross_track) distances to every lanelets by their ids
-  std::vector<double> route_distances;
+  std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+
+  // get route distance (downtrack + cross_track) distances to every active lanelet on the route
   // and take abs of cross_track to add them to get route distance
-  for (auto id: active_geofence_on_route)
+  double min_dist = std::numeric_limits<double>::max();
+  for (size_t idx : active_route_lanelet_indices_)
   {
-    carma_wm::TrackPos tp = carma_wm::geometry::trackPos(current_map_->laneletLayer.get(id), curr_pos);
+    const auto& llt = route_lanelet_entries_[idx].lanelet;
+    carma_wm::TrackPos tp = carma_wm::geometry::trackPos(llt, curr_pos);
     // downtrack needs to be negative for lanelet to be in front of the point, 
     // also we don't account for the lanelet that the vehicle is on
-    if (tp.downtrack < 0 && id != curr_lanelet.id())
+    if (tp.downtrack < 0 && llt.id() != curr_lanelet.id())
     {
-      double dist = fabs(tp.downtrack) + fabs(tp.crosstrack);
-      route_distances.push_back(dist);
+      min_dist = std::min(min_dist, fabs(tp.downtrack) + fabs(tp.crosstrack));
     }
   }
-  std::sort(route_distances.begin(), route_distances.end());
 
-  if (route_distances.size() != 0 ) return route_distances[0];
+  if (min_dist != std::numeric_limits<double>::max()) return min_dist;
   else return 0.0;
 
 }
@@ -2031,9 +2245,12 @@ carma_perception_msgs::msg::CheckActiveGeofence WMBroadcaster::checkActiveGeofen
   carma_perception_msgs::msg::CheckActiveGeofence outgoing_geof; //message to publish
   double next_distance = 0 ; //Distance to next geofence
 
-  if (active_geofence_llt_ids_.size() <= 0 ) 
   {
-    return outgoing_geof;
+    std::lock_guard<std::mutex> guard(active_geofence_mutex_);
+    if (active_geofence_llt_ids_.empty())
+    {
+      return outgoing_geof;
+    }
   }
   
   RCLCPP_INFO_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence llt ids are loaded to the WMBroadcaster");
@@ -2048,112 +2265,109 @@ carma_perception_msgs::msg::CheckActiveGeofence WMBroadcaster::checkActiveGeofen
     next_distance = distToNearestActiveGeofence(curr_pos);
     outgoing_geof.distance_to_next_geofence = next_distance;
 
-    for(auto id : active_geofence_llt_ids_) 
+    if (isActiveGeofenceLanelet(current_llt.id()))
     {
-      if (id == current_llt.id())
-      {           
-        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Vehicle is on Lanelet " << current_llt.id() << ", which has an active geofence");
-        outgoing_geof.is_on_active_geofence = true;
-        for (auto regem: current_llt.regulatoryElements())
+      RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Vehicle is on Lanelet " << current_llt.id() << ", which has an active geofence");
+      outgoing_geof.is_on_active_geofence = true;
+      for (auto regem: current_llt.regulatoryElements())
+      {
+        // Assign active geofence fields based on the speed limit associated with this lanelet
+        if (regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalSpeedLimit::RuleName) == 0)
         {
-          // Assign active geofence fields based on the speed limit associated with this lanelet
-          if (regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalSpeedLimit::RuleName) == 0)
+          lanelet::DigitalSpeedLimitPtr speed =  std::dynamic_pointer_cast<lanelet::DigitalSpeedLimit>
+          (current_map_->regulatoryElementLayer.get(regem->id()));
+          outgoing_geof.value = speed->speed_limit_.value();
+          outgoing_geof.advisory_speed = speed->speed_limit_.value();
+          outgoing_geof.reason = speed->getReason(); 
+
+          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence has a speed limit of " << speed->speed_limit_.value());
+                  
+          // Cannot overrule outgoing_geof.type if it is already set to LANE_CLOSED
+          if(outgoing_geof.type != carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED)
           {
-            lanelet::DigitalSpeedLimitPtr speed =  std::dynamic_pointer_cast<lanelet::DigitalSpeedLimit>
-            (current_map_->regulatoryElementLayer.get(regem->id()));
-            outgoing_geof.value = speed->speed_limit_.value();
-            outgoing_geof.advisory_speed = speed->speed_limit_.value();
-            outgoing_geof.reason = speed->getReason(); 
-
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence has a speed limit of " << speed->speed_limit_.value());
-                    
-            // Cannot overrule outgoing_geof.type if it is already set to LANE_CLOSED
-            if(outgoing_geof.type != carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED)
-            {
-              outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::SPEED_LIMIT;
-            }
+            outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::SPEED_LIMIT;
           }
+        }
 
-          // Assign active geofence fields based on the minimum gap associated with this lanelet (if it exists)
-          if(regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalMinimumGap::RuleName) == 0)
+        // Assign active geofence fields based on the minimum gap associated with this lanelet (if it exists)
+        if(regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::DigitalMinimumGap::RuleName) == 0)
+        {
+          lanelet::DigitalMinimumGapPtr min_gap =  std::dynamic_pointer_cast<lanelet::DigitalMinimumGap>
+          (current_map_->regulatoryElementLayer.get(regem->id()));
+          outgoing_geof.minimum_gap = min_gap->getMinimumGap();
+          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence has a minimum gap of " << min_gap->getMinimumGap());
+        }
+               
+        // Assign active geofence fields based on whether the current lane is closed or is immediately adjacent to a closed lane
+        if(regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
+        {
+          lanelet::RegionAccessRulePtr accessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
+          (current_map_->regulatoryElementLayer.get(regem->id()));
+
+          // Update the 'type' and 'reason' for this active geofence if the vehicle is in a closed lane
+          if(!accessRuleReg->accessable(lanelet::Participants::VehicleCar) || !accessRuleReg->accessable(lanelet::Participants::VehicleTruck)) 
           {
-            lanelet::DigitalMinimumGapPtr min_gap =  std::dynamic_pointer_cast<lanelet::DigitalMinimumGap>
-            (current_map_->regulatoryElementLayer.get(regem->id()));
-            outgoing_geof.minimum_gap = min_gap->getMinimumGap();
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence has a minimum gap of " << min_gap->getMinimumGap());
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence is a closed lane.");
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Closed lane reason: " << accessRuleReg->getReason());
+            outgoing_geof.reason = accessRuleReg->getReason();
+            outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
           }
-                 
-          // Assign active geofence fields based on whether the current lane is closed or is immediately adjacent to a closed lane
-          if(regem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
+          // Otherwise, update the 'type' and 'reason' for this active geofence if the vehicle is in a lane immediately adjacent to a closed lane with the same travel direction
+          else 
           {
-            lanelet::RegionAccessRulePtr accessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
-            (current_map_->regulatoryElementLayer.get(regem->id()));
+            // Obtain all same-direction lanes sharing the right lane boundary (will include the current lanelet)
+            auto right_boundary_lanelets = current_map_->laneletLayer.findUsages(current_llt.rightBound());
 
-            // Update the 'type' and 'reason' for this active geofence if the vehicle is in a closed lane
-            if(!accessRuleReg->accessable(lanelet::Participants::VehicleCar) || !accessRuleReg->accessable(lanelet::Participants::VehicleTruck)) 
+            // Check if the adjacent right lane is closed
+            if(right_boundary_lanelets.size() > 1)
             {
-              RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Active geofence is a closed lane.");
-              RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Closed lane reason: " << accessRuleReg->getReason());
-              outgoing_geof.reason = accessRuleReg->getReason();
-              outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
-            }
-            // Otherwise, update the 'type' and 'reason' for this active geofence if the vehicle is in a lane immediately adjacent to a closed lane with the same travel direction
-            else 
-            {
-              // Obtain all same-direction lanes sharing the right lane boundary (will include the current lanelet)
-              auto right_boundary_lanelets = current_map_->laneletLayer.findUsages(current_llt.rightBound());
-
-              // Check if the adjacent right lane is closed
-              if(right_boundary_lanelets.size() > 1)
+              for(auto lanelet : right_boundary_lanelets)
               {
-                for(auto lanelet : right_boundary_lanelets)
+                // Only check the adjacent right lanelet; ignore the current lanelet
+                if(lanelet.id() != current_llt.id())
                 {
-                  // Only check the adjacent right lanelet; ignore the current lanelet
-                  if(lanelet.id() != current_llt.id())
+                  for (auto rightRegem: lanelet.regulatoryElements())
                   {
-                    for (auto rightRegem: lanelet.regulatoryElements())
+                    if(rightRegem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
                     {
-                      if(rightRegem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
+                      lanelet::RegionAccessRulePtr rightAccessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
+                      (current_map_->regulatoryElementLayer.get(rightRegem->id()));
+                      if(!rightAccessRuleReg->accessable(lanelet::Participants::VehicleCar) || !rightAccessRuleReg->accessable(lanelet::Participants::VehicleTruck))
                       {
-                        lanelet::RegionAccessRulePtr rightAccessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
-                        (current_map_->regulatoryElementLayer.get(rightRegem->id()));
-                        if(!rightAccessRuleReg->accessable(lanelet::Participants::VehicleCar) || !rightAccessRuleReg->accessable(lanelet::Participants::VehicleTruck))
-                        {
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Right adjacent Lanelet " << lanelet.id() << " is CLOSED");
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning LANE_CLOSED type to active geofence");
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning reason " << rightAccessRuleReg->getReason());
-                          outgoing_geof.reason = rightAccessRuleReg->getReason();
-                          outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
-                        }
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Right adjacent Lanelet " << lanelet.id() << " is CLOSED");
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning LANE_CLOSED type to active geofence");
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning reason " << rightAccessRuleReg->getReason());
+                        outgoing_geof.reason = rightAccessRuleReg->getReason();
+                        outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
                       }
                     }
                   }
                 }
               }
+            }
 
-              // Check if the adjacent left lane is closed
-              auto left_boundary_lanelets = current_map_->laneletLayer.findUsages(current_llt.leftBound());
-              if(left_boundary_lanelets.size() > 1)
+            // Check if the adjacent left lane is closed
+            auto left_boundary_lanelets = current_map_->laneletLayer.findUsages(current_llt.leftBound());
+            if(left_boundary_lanelets.size() > 1)
+            {
+              for(auto lanelet : left_boundary_lanelets)
               {
-                for(auto lanelet : left_boundary_lanelets)
+                // Only check the adjacent left lanelet; ignore the current lanelet
+                if(lanelet.id() != current_llt.id())
                 {
-                  // Only check the adjacent left lanelet; ignore the current lanelet
-                  if(lanelet.id() != current_llt.id())
+                  for (auto leftRegem: lanelet.regulatoryElements())
                   {
-                    for (auto leftRegem: lanelet.regulatoryElements())
+                    if(leftRegem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
                     {
-                      if(leftRegem->attribute(lanelet::AttributeName::Subtype).value().compare(lanelet::RegionAccessRule::RuleName) == 0)
+                      lanelet::RegionAccessRulePtr leftAccessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
+                      (current_map_->regulatoryElementLayer.get(leftRegem->id()));
+                      if(!leftAccessRuleReg->accessable(lanelet::Participants::VehicleCar) || !leftAccessRuleReg->accessable(lanelet::Participants::VehicleTruck))
                       {
-                        lanelet::RegionAccessRulePtr leftAccessRuleReg =  std::dynamic_pointer_cast<lanelet::RegionAccessRule>
-                        (current_map_->regulatoryElementLayer.get(leftRegem->id()));
-                        if(!leftAccessRuleReg->accessable(lanelet::Participants::VehicleCar) || !leftAccessRuleReg->accessable(lanelet::Participants::VehicleTruck))
-                        {
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Left adjacent Lanelet " << lanelet.id() << " is CLOSED");
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning LANE_CLOSED type to active geofence");
-                          RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning reason " << leftAccessRuleReg->getReason());
-                          outgoing_geof.reason = leftAccessRuleReg->getReason();
-                          outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
-                        }
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Left adjacent Lanelet " << lanelet.id() << " is CLOSED");
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning LANE_CLOSED type to active geofence");
+                        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("carma_wm_ctrl"), "Assigning reason " << leftAccessRuleReg->getReason());
+                        outgoing_geof.reason = leftAccessRuleReg->getReason();
+                        outgoing_geof.type = carma_perception_msgs::msg::CheckActiveGeofence::LANE_CLOSED;
                       }
                     }
                   }
@@ -61,6 +61,9 @@ WMBroadcasterNode::WMBroadcasterNode(const rclcpp::NodeOptions &options)
   config_.vehicle_id = declare_parameter<std::string>("vehicle_id", config_.vehicle_id);
   config_.participant = declare_parameter<std::string>("vehicle_participant_type", config_.participant);
   config_.participant = declare_parameter<double>("config_speed_limit", config_.config_limit);
+  config_.routing_graph_delta_updates = declare_parameter<bool>("routing_graph_delta_updates", config_.routing_graph_delta_updates);
+  config_.compress_map_messages = declare_parameter<bool>("compress_map_messages", config_.compress_map_messages);
+  config_.map_chunk_size = declare_parameter<int>("map_chunk_size", config_.map_chunk_size);
   
   declare_parameter("intersection_ids_for_correction");
   declare_parameter("intersection_coord_correction");
@@ -91,12 +94,18 @@ carma_ros2_utils::CallbackReturn WMBroadcasterNode::handle_on_configure(const rc
   get_parameter<std::string>("vehicle_id", config_.vehicle_id);
   get_parameter<std::string>("vehicle_participant_type", config_.participant);
   get_parameter<double>("config_speed_limit", config_.config_limit);
+  get_parameter<bool>("routing_graph_delta_updates", config_.routing_graph_delta_updates);
+  get_parameter<bool>("compress_map_messages", config_.compress_map_messages);
+  get_parameter<int>("map_chunk_size", config_.map_chunk_size);
   
   wmb_->setConfigACKPubTimes(config_.ack_pub_times);
   wmb_->setMaxLaneWidth(config_.max_lane_width);
   wmb_->setConfigSpeedLimit(config_.config_limit);
   wmb_->setConfigVehicleId(config_.vehicle_id);
   wmb_->setVehicleParticipationType(config_.participant);
+  wmb_->setRoutingGraphDeltaUpdates(config_.routing_graph_delta_updates);
+  wmb_->setMapCompression(config_.compress_map_messages);
+  wmb_->setMapChunkSize(config_.map_chunk_size > 0 ? static_cast<size_t>(config_.map_chunk_size) : 0);
 
   rclcpp::Parameter intersection_coord_correction_param = get_parameter("intersection_coord_correction");
   config_.intersection_coord_correction = intersection_coord_correction_param.as_double_array();
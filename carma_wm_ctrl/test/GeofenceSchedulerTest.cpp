@@ -164,4 +164,77 @@ TEST(GeofenceScheduler, addGeofence)
 
 }
 
+TEST(GeofenceScheduler, tenThousandSchedules)
+{
+  // 10k geofences whose control periods start at 100 distinct times spread over one second. Each geofence is
+  // active three times for half a second with a one second period.
+  constexpr size_t num_geofences = 10000;
+  constexpr size_t num_start_times = 100;
+  constexpr size_t intervals_per_geofence = 3;
+
+  auto timer = std::make_shared<carma_ros2_utils::timers::testing::TestTimerFactory>();
+  timer->setNow(rclcpp::Time(0));
+
+  GeofenceScheduler scheduler(timer);
+
+  size_t active_calls = 0;
+  size_t inactive_calls = 0;
+  size_t active_batches = 0;
+  size_t inactive_batches = 0;
+  std::mutex count_mutex;
+
+  scheduler.onGeofencesActive([&](const std::vector<std::shared_ptr<Geofence>>& gf_ptrs) {
+    std::lock_guard<std::mutex> guard(count_mutex);
+    active_calls += gf_ptrs.size();
+    active_batches++;
+  });
+
+  scheduler.onGeofencesInactive([&](const std::vector<std::shared_ptr<Geofence>>& gf_ptrs) {
+    std::lock_guard<std::mutex> guard(count_mutex);
+    inactive_calls += gf_ptrs.size();
+    inactive_batches++;
+  });
+
+  for (size_t i = 0; i < num_geofences; i++)
+  {
+    auto gf_ptr = std::make_shared<Geofence>();
+    gf_ptr->id_ = boost::uuids::random_generator()();
+
+    double control_start = 1.0 + (i % num_start_times) * 0.01;
+    gf_ptr->schedules.push_back(
+        GeofenceSchedule(rclcpp::Time(0),
+                         rclcpp::Time(100e9),
+                         rclcpp::Duration(control_start * 1e9),
+                         rclcpp::Duration(2.5e9),  // Starts at control_start, control_start + 1 and control_start + 2
+                         rclcpp::Duration(0),
+                         rclcpp::Duration(0.5e9),
+                         rclcpp::Duration(1e9)));
+
+    scheduler.addGeofence(gf_ptr);
+  }
+
+  ASSERT_EQ(num_geofences, scheduler.pendingEventCount());
+
+  // Step simulated time in 100ms ticks. The tick is invoked directly so the result does not depend on the
+  // test timer thread
+  size_t ticks = 0;
+
+  for (int64_t now_ns = 100000000; now_ns <= 5000000000; now_ns += 100000000)
+  {
+    timer->setNow(rclcpp::Time(now_ns));
+
+    scheduler.tickCallback();
+    ticks++;
+  }
+
+  std::lock_guard<std::mutex> guard(count_mutex);
+
+  ASSERT_EQ(num_geofences * intervals_per_geofence, active_calls);
+  ASSERT_EQ(num_geofences * intervals_per_geofence, inactive_calls);
+  ASSERT_EQ(0u, scheduler.pendingEventCount());
+
+  // Transitions which come due in the same tick are reported together
+  ASSERT_LE(active_batches + inactive_batches, 2 * ticks);
+}
+
 }  // namespace carma_wm_ctrl
\ No newline at end of file
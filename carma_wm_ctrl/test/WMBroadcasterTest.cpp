@@ -25,6 +25,7 @@
 #include <lanelet2_io/io_handlers/Writer.h>
 #include <carma_wm_ctrl/GeofenceScheduler.hpp>
 #include <carma_wm_ctrl/WMBroadcaster.hpp>
+#include <carma_wm/MapBinTransport.hpp>
 #include <autoware_lanelet2_ros2_interface/utility/message_conversion.hpp>
 #include <lanelet2_extension/io/autoware_osm_parser.h>
 #include <memory>
@@ -90,6 +91,81 @@ TEST(WMBroadcaster, baseMapCallback)
   ASSERT_EQ(1, base_map_call_count);
 }
 
+TEST(WMBroadcaster, baseMapCallbackLargeMap)
+{
+  // Build a large map of parallel multi lane roads
+  constexpr int num_roads = 20;
+  constexpr int num_lanes = 3;
+  constexpr int lanelets_per_lane = 50;
+  constexpr int points_per_bound = 10;
+  constexpr double lane_width = 3.7;
+  constexpr double lanelet_length = 25.0;
+
+  std::vector<lanelet::Lanelet> lanelets;
+  lanelets.reserve(num_roads * num_lanes * lanelets_per_lane);
+
+  for (int road = 0; road < num_roads; road++)
+  {
+    double road_x = road * (num_lanes + 2) * lane_width;
+
+    // Bounds are shared between neighboring lanes and consecutive lanelets so the map is fully connected
+    std::vector<std::vector<lanelet::Point3d>> bound_points(num_lanes + 1);
+    for (int bound = 0; bound <= num_lanes; bound++)
+    {
+      for (int i = 0; i <= lanelets_per_lane * (points_per_bound - 1); i++)
+      {
+        bound_points[bound].push_back(carma_wm::getPoint(road_x + bound * lane_width, i * lanelet_length / (points_per_bound - 1), 0));
+      }
+    }
+
+    for (int lane = 0; lane < num_lanes; lane++)
+    {
+      for (int segment = 0; segment < lanelets_per_lane; segment++)
+      {
+        auto start = segment * (points_per_bound - 1);
+        std::vector<lanelet::Point3d> left(bound_points[lane].begin() + start, bound_points[lane].begin() + start + points_per_bound);
+        std::vector<lanelet::Point3d> right(bound_points[lane + 1].begin() + start, bound_points[lane + 1].begin() + start + points_per_bound);
+
+        lanelets.push_back(carma_wm::getLanelet(lanelet::utils::getId(), left, right, lanelet::AttributeValueString::Dashed,
+                                                lanelet::AttributeValueString::Dashed));
+      }
+    }
+  }
+
+  auto map = lanelet::utils::createMap(lanelets, {});
+  size_t lanelet_count = lanelets.size();
+
+  autoware_lanelet2_msgs::msg::MapBin msg;
+  lanelet::utils::conversion::toBinMsg(map, &msg);
+
+  // The broadcaster decodes its own copy of the map from the message
+  map.reset();
+  lanelets.clear();
+
+  autoware_lanelet2_msgs::msg::MapBin published_msg;
+  size_t base_map_call_count = 0;
+  WMBroadcaster wmb(
+      [&](const autoware_lanelet2_msgs::msg::MapBin& map_bin) {
+        published_msg = map_bin;
+        base_map_call_count++;
+      }, [](const autoware_lanelet2_msgs::msg::MapBin& map_bin) {}, [](const carma_v2x_msgs::msg::TrafficControlRequest& control_msg_pub_){},
+      [](const carma_perception_msgs::msg::CheckActiveGeofence& active_pub_){},
+      std::make_shared<TestTimerFactory>(), [](const carma_v2x_msgs::msg::MobilityOperation& tcm_ack_pub_){});
+
+  autoware_lanelet2_msgs::msg::MapBin::UniquePtr map_msg_ptr(new autoware_lanelet2_msgs::msg::MapBin(msg));
+  wmb.baseMapCallback(std::move(map_msg_ptr));
+
+  // The map is published once, as the first version, with the routing graph built from the conformed map
+  ASSERT_EQ(1u, base_map_call_count);
+  ASSERT_EQ(1u, published_msg.map_version);
+  ASSERT_TRUE(published_msg.has_routing_graph);
+  ASSERT_FALSE(published_msg.routing_graph.lanelet_vertices.empty());
+
+  lanelet::LaneletMapPtr published_map(new lanelet::LaneletMap);
+  carma_wm::mapFromBinMsg(published_msg, published_map);
+  ASSERT_EQ(lanelet_count, published_map->laneletLayer.size());
+}
+
 // here test the proj string transform test
 TEST(WMBroadcaster, getAffectedLaneletOrAreasFromTransform)
 {
@@ -597,6 +673,23 @@ TEST(WMBroadcaster, addAndRemoveGeofence)
   ASSERT_EQ(gf_ptr->prev_regems_[0].first, 10000);
   ASSERT_EQ(gf_ptr->prev_regems_[0].second->id(), old_speed_limit->id());
 
+  // geofences which change state in the same tick are published as one map update
+  wmb.removeGeofence(gf_ptr);
+  ASSERT_EQ(map_update_call_count, 4);
+
+  auto gf_ptr2 = std::make_shared<carma_wm_ctrl::Geofence>(carma_wm_ctrl::Geofence());
+  gf_ptr2->id_ = boost::uuids::random_generator()();
+  gf_ptr2->regulatory_element_ = std::make_shared<lanelet::DigitalSpeedLimit>(lanelet::DigitalSpeedLimit::buildData(map->regulatoryElementLayer.uniqueId(), 15_mph, {}, {},
+                                                     { lanelet::Participants::VehicleCar }));
+  gf_ptr2->gf_pts = gf_ptr->gf_pts;
+  gf_ptr2->affected_parts_ = gf_ptr->affected_parts_;
+  gf_ptr2->msg_ = gf_msg;
+
+  wmb.addGeofences({ gf_ptr, gf_ptr2 });
+  ASSERT_EQ(map_update_call_count, 5);
+
+  wmb.removeGeofences({ gf_ptr2, gf_ptr });
+  ASSERT_EQ(map_update_call_count, 6);
 }
 
 TEST(WMBroadcaster, GeofenceBinMsgTest)
@@ -1265,6 +1358,12 @@ TEST(WMBroadcaster, distToNearestActiveGeofence)
   curr_pos = {1.5,3.5};  // it is currently not on any lanelet
   EXPECT_THROW(wmb.distToNearestActiveGeofence(curr_pos), std::invalid_argument);
 
+  // A route received while the geofence is active picks up the active lanelets
+  wmb.controlRequestFromRoute(route_msg, req_id);
+  curr_pos = {0.5,0.5};
+  nearest_gf_dist = wmb.distToNearestActiveGeofence(curr_pos);
+  ASSERT_NEAR(nearest_gf_dist, 1.5, 0.0001);
+
   activated = false;
   timer->setNow(rclcpp::Time(3.2e9));  // Geofences deactivate now
   ASSERT_TRUE(carma_ros2_utils::testing::waitForEqOrTimeout(10.0, curr_id_hashed, last_inactive_gf));
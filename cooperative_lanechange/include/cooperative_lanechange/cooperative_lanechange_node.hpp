@@ -37,7 +37,7 @@
 #include <carma_planning_msgs/msg/lane_change_status.hpp>
 #include <carma_perception_msgs/msg/roadway_obstacle.hpp>
 #include <basic_autonomy/basic_autonomy.hpp>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <std_msgs/msg/string.hpp>
 
 #include <carma_guidance_plugins/tactical_plugin.hpp>
@@ -86,7 +86,7 @@ namespace cooperative_lanechange
     carma_wm::WorldModelConstPtr wm_;
 
     // Map projection string, which defines the lat/lon -> map conversion
-    std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+    std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
     // Trajectory frequency
     double traj_freq_ = 10;
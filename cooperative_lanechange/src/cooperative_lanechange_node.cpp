@@ -633,7 +633,7 @@ namespace cooperative_lanechange
 
   void CooperativeLaneChangePlugin::georeference_cb(const std_msgs::msg::String::UniquePtr msg) 
   {
-    map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());  // Build projector from proj string
+    map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);  // Build projector from proj string
   }
 
   std::string CooperativeLaneChangePlugin::bsmIDtoString(carma_v2x_msgs::msg::BSMCoreData bsm_core)
@@ -38,7 +38,7 @@
 #include <gps_msgs/msg/gps_fix.hpp>
 #include <wgs84_utils/wgs84_utils.h>
 
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 
 /**
  * \class GNSSToMapConvertor
@@ -101,7 +101,7 @@ public:
   /**
    * \brief Get the projector built from the provided georeference via the callback
    */
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> getMapProjector();
+  std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> getMapProjector();
 
   /**
    * \brief Converts a provided GNSS fix message into a pose message for the map frame describibed by the provided
@@ -126,7 +126,7 @@ public:
    */
   geometry_msgs::msg::PoseWithCovarianceStamped poseFromGnss(const tf2::Transform& baselink_in_sensor,
                                                         const tf2::Quaternion& sensor_in_ned_heading_rotation,
-                                                        const lanelet::projection::LocalFrameProjector& projector,
+                                                        const carma_wm::projection::GeoreferenceProjector& projector,
                                                         const tf2::Quaternion& ned_in_map_rotation,
                                                         gps_msgs::msg::GPSFix fix_msg);
 
@@ -144,9 +144,7 @@ private:
   // Rotation describing orientation of sensor in heading frame
   boost::optional<tf2::Quaternion> sensor_in_ned_heading_rotation_;
   
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;  // Must be shared pointer instead of
-                                                                             // optional since for some reason optional
-                                                                             // does not work with this class
+  std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;  // Shared with every node using the same georeference
 
   boost::optional<tf2::Transform> baselink_in_sensor_;  // A transform describing the relation of the baselink frame
                                                         // with the frame provided by the gnss message
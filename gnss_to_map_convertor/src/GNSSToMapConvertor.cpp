@@ -95,8 +95,7 @@ void GNSSToMapConvertor::gnssFixCb(gps_msgs::msg::GPSFix::UniquePtr fix_msg)
 void GNSSToMapConvertor::geoReferenceCallback(std_msgs::msg::String::UniquePtr geo_ref)
 {
 
-  map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(
-      geo_ref->data.c_str());  // Build projector from proj string
+  map_projector_ = carma_wm::projection::getGeoreferenceProjector(geo_ref->data);  // Get the projector for the proj string
 
   RCLCPP_INFO_STREAM(logger_->get_logger(), "Recieved map georeference: " << geo_ref->data);
 
@@ -116,7 +115,7 @@ boost::optional<tf2::Quaternion> GNSSToMapConvertor::getNedInMapRotation()
   return ned_in_map_rotation_;
 }
 
-std::shared_ptr<lanelet::projection::LocalFrameProjector> GNSSToMapConvertor::getMapProjector()
+std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> GNSSToMapConvertor::getMapProjector()
 {
   return map_projector_;
 }
@@ -125,7 +124,7 @@ std::shared_ptr<lanelet::projection::LocalFrameProjector> GNSSToMapConvertor::ge
 geometry_msgs::msg::PoseWithCovarianceStamped GNSSToMapConvertor::poseFromGnss(
     const tf2::Transform& baselink_in_sensor, 
     const tf2::Quaternion& sensor_in_ned_heading_rotation,
-    const lanelet::projection::LocalFrameProjector& projector, 
+    const carma_wm::projection::GeoreferenceProjector& projector, 
     const tf2::Quaternion& ned_in_map_rotation,
     gps_msgs::msg::GPSFix fix_msg)
 {
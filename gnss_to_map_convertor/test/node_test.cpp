@@ -115,7 +115,7 @@ TEST(GNSSToMapConvertor, poseFromGnss)
     gp.lat = 0.0;
     gp.lon = 0.0;
     gp.ele = 0.0;
-    lanelet::projection::LocalFrameProjector projector(base_proj.c_str());
+    const carma_wm::projection::GeoreferenceProjector& projector = *carma_wm::projection::getGeoreferenceProjector(base_proj);
     lanelet::BasicPoint3d map_point = projector.forward(gp);  // Origin point of projection
     ASSERT_NEAR(map_point.x(), 0.0, 0.000001);
     ASSERT_NEAR(map_point.y(), 0.0, 0.000001);
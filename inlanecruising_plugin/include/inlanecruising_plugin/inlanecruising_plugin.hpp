@@ -84,6 +84,11 @@ public:
    */
   void set_yield_client(carma_ros2_utils::ClientPtr<carma_planning_msgs::srv::PlanTrajectory> client);
 
+  /**
+   * \brief Returns the counters of the geometry cache used by this plugin. The tick counters cover the most recent plan
+   */
+  basic_autonomy::waypoint_generation::GeometryProfileCacheStats get_geometry_profile_cache_stats() const;
+
   carma_planning_msgs::msg::VehicleState ending_state_before_buffer_; //state before applying extra points for curvature calculation that are removed later
 
 private:
@@ -96,6 +101,8 @@ private:
   DebugPublisher debug_publisher_;
   carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds debug_msg_;
   std::shared_ptr<carma_ros2_utils::CarmaLifecycleNode> nh_;
+  std::shared_ptr<basic_autonomy::waypoint_generation::GeometryProfileCache> geometry_profile_cache_ =
+    std::make_shared<basic_autonomy::waypoint_generation::GeometryProfileCache>();
 
   // Access members for unit test
   FRIEND_TEST(InLaneCruisingPluginTest, rostest1);
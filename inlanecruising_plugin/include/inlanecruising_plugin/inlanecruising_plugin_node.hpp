@@ -28,6 +28,7 @@
 #include <carma_planning_msgs/msg/plugin.hpp>
 #include <carma_planning_msgs/srv/plan_trajectory.hpp>
 #include <carma_debug_ros2_msgs/msg/trajectory_curvature_speeds.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 
 namespace inlanecruising_plugin
 {
@@ -61,6 +62,11 @@ public:
 
 private:
 
+  /**
+   * \brief Publishes the geometry cache counters of the most recent plan
+   */
+  void publish_geometry_profile_metrics();
+
   // Node configuration
   InLaneCruisingPluginConfig config_;
 
@@ -69,6 +75,9 @@ private:
 
   carma_ros2_utils::PubPtr<carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds> trajectory_debug_pub_;
 
+  // Geometry cache hit rate and compute time of each plan
+  carma_ros2_utils::PubPtr<diagnostic_msgs::msg::DiagnosticArray> geometry_profile_metrics_pub_;
+
   // Service Clients
   carma_ros2_utils::ClientPtr<carma_planning_msgs::srv::PlanTrajectory> yield_client_;
 
@@ -86,7 +86,8 @@ void InLaneCruisingPlugin::plan_trajectory_callback(
                                                                             config_.buffer_ending_downtrack);
 
   auto points_and_target_speeds = basic_autonomy::waypoint_generation::create_geometry_profile(maneuver_plan, std::max((double)0, current_downtrack - config_.back_distance),
-                                                                         wm_, ending_state_before_buffer_, req->vehicle_state, wpg_general_config, wpg_detail_config);
+                                                                         wm_, ending_state_before_buffer_, req->vehicle_state, wpg_general_config, wpg_detail_config,
+                                                                         geometry_profile_cache_);
 
   RCLCPP_DEBUG_STREAM(nh_->get_logger(), "points_and_target_speeds: " << points_and_target_speeds.size());
 
@@ -99,7 +100,7 @@ void InLaneCruisingPlugin::plan_trajectory_callback(
 
   original_trajectory.trajectory_points = basic_autonomy:: waypoint_generation::compose_lanefollow_trajectory_from_path(points_and_target_speeds,
                                                                                 req->vehicle_state, req->header.stamp, wm_, ending_state_before_buffer_, debug_msg_,
-                                                                                wpg_detail_config); // Compute the trajectory
+                                                                                wpg_detail_config, geometry_profile_cache_); // Compute the trajectory
   original_trajectory.initial_longitudinal_velocity = std::max(req->vehicle_state.longitudinal_vel, config_.minimum_speed);
 
   // Set the planning plugin field name
@@ -137,5 +138,10 @@ void InLaneCruisingPlugin::set_yield_client(carma_ros2_utils::ClientPtr<carma_pl
   yield_client_ = client;
 }
 
+basic_autonomy::waypoint_generation::GeometryProfileCacheStats InLaneCruisingPlugin::get_geometry_profile_cache_stats() const
+{
+  return geometry_profile_cache_->getStats();
+}
+
 
 }  // namespace inlanecruising_plugin
\ No newline at end of file
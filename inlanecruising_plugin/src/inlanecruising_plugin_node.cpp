@@ -47,6 +47,7 @@ namespace inlanecruising_plugin
   carma_ros2_utils::CallbackReturn InLaneCruisingPluginNode::on_configure_plugin()
   {
     trajectory_debug_pub_ = create_publisher<carma_debug_ros2_msgs::msg::TrajectoryCurvatureSpeeds>("debug/trajectory_planning", 1);
+    geometry_profile_metrics_pub_ = create_publisher<diagnostic_msgs::msg::DiagnosticArray>("geometry_profile_metrics", 10);
 
     config_ = InLaneCruisingPluginConfig();
 
@@ -139,6 +140,17 @@ namespace inlanecruising_plugin
     carma_planning_msgs::srv::PlanTrajectory::Response::SharedPtr resp)
   {
     worker_->plan_trajectory_callback(req, resp);
+    publish_geometry_profile_metrics();
+  }
+
+  void InLaneCruisingPluginNode::publish_geometry_profile_metrics()
+  {
+    diagnostic_msgs::msg::DiagnosticArray metrics;
+    metrics.header.stamp = now();
+    metrics.status.push_back(basic_autonomy::waypoint_generation::geometry_profile_metrics(worker_->get_geometry_profile_cache_stats(),
+                                                                                           std::string(get_name()) + "/geometry_profile"));
+
+    geometry_profile_metrics_pub_->publish(metrics);
   }
 
 }  // namespace inlanecruising_plugin
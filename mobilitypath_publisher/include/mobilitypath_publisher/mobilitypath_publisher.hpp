@@ -21,7 +21,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/shared_ptr.hpp>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <bsm_helper/bsm_helper.h>
 #include <std_msgs/msg/string.hpp>
 #include <carma_planning_msgs/msg/trajectory_plan.hpp>
@@ -72,7 +72,7 @@ namespace mobilitypath_publisher
     carma_v2x_msgs::msg::BSMCoreData bsm_core_;
 
     // Map projection string, which defines the lat/lon -> map conversion
-    std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+    std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
     // Recipient's static ID (Empty string indicates a broadcast message)
     std::string recipient_id = "";
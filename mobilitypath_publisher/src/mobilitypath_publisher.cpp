@@ -106,7 +106,7 @@ namespace mobilitypath_publisher
   void MobilityPathPublication::georeference_cb(const std_msgs::msg::String::UniquePtr msg)
   {
     // Build projector from proj string
-    map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());
+    map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);
   }
 
   void MobilityPathPublication::trajectory_cb(const carma_planning_msgs::msg::TrajectoryPlan::UniquePtr msg)
@@ -25,7 +25,7 @@
 #include <visualization_msgs/msg/marker_array.hpp>
 #include <carma_v2x_msgs/msg/mobility_path.hpp>
 #include <unordered_map>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 
 #include "mobilitypath_visualizer/mobilitypath_visualizer_config.hpp"
 
@@ -120,7 +120,7 @@ namespace mobilitypath_visualizer {
         // initialize this node before running
         void initialize();
 
-        std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+        std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
         Config config_;
 
@@ -118,7 +118,7 @@ namespace mobilitypath_visualizer {
 
     void MobilityPathVisualizer::georeferenceCallback(std_msgs::msg::String::UniquePtr msg) 
     {
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());  // Build projector from proj string
+        map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);  // Get the projector for the proj string
     }
     
     void MobilityPathVisualizer::callbackMobilityPath(carma_v2x_msgs::msg::MobilityPath::UniquePtr msg)
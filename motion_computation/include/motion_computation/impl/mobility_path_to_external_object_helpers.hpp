@@ -15,7 +15,7 @@
 #ifndef MOTION_COMPUTATION__IMPL__MOBILITY_PATH_TO_EXTERNAL_OBJECT_HELPERS_HPP_
 #define MOTION_COMPUTATION__IMPL__MOBILITY_PATH_TO_EXTERNAL_OBJECT_HELPERS_HPP_
 
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2/LinearMath/Vector3.h>
 #include <carma_perception_msgs/msg/external_object.hpp>
@@ -68,7 +68,8 @@ double getYawFromQuaternionMsg(const geometry_msgs::msg::Quaternion & quaternion
  * \return point in map
  */
 tf2::Vector3 transform_to_map_frame(
-  const tf2::Vector3 & ecef_point, const lanelet::projection::LocalFrameProjector & map_projector);
+  const tf2::Vector3 & ecef_point,
+  const carma_wm::projection::GeoreferenceProjector & map_projector);
 
 }  // namespace impl
 }  // namespace conversion
@@ -16,7 +16,7 @@
 #define MOTION_COMPUTATION__IMPL__PSM_TO_EXTERNAL_OBJECT_HELPERS_HPP_
 
 #include <lanelet2_core/primitives/GPSPoint.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <tf2/LinearMath/Quaternion.h>
 #include <carma_perception_msgs/msg/external_object.hpp>
 #include <carma_v2x_msgs/msg/psm.hpp>
@@ -44,7 +44,7 @@ std::vector<geometry_msgs::msg::Pose> sample_2d_linear_motion(
   const geometry_msgs::msg::Pose & pose, double velocity, double period, double step_size);
 
 geometry_msgs::msg::PoseWithCovariance pose_from_gnss(
-  const lanelet::projection::LocalFrameProjector & projector,
+  const carma_wm::projection::GeoreferenceProjector & projector,
   const tf2::Quaternion & ned_in_map_rotation, const lanelet::GPSPoint & gps_point,
   const double & heading, const double lat_variance, const double lon_variance,
   const double heading_variance);
@@ -58,6 +58,14 @@ std::vector<carma_perception_msgs::msg::PredictedState> predicted_poses_to_predi
 rclcpp::Time get_psm_timestamp(
   const carma_v2x_msgs::msg::PSM & in_msg, rclcpp::Clock::SharedPtr clock);
 
+/**
+ * \brief Computes the stamp of a PSM. If the minute of the sec_mark cannot be taken from the
+ * path history it is taken from receipt_time instead of the current time of clock.
+ */
+rclcpp::Time get_psm_timestamp(
+  const carma_v2x_msgs::msg::PSM & in_msg, rclcpp::Clock::SharedPtr clock,
+  const rclcpp::Time & receipt_time);
+
 }  // namespace impl
 }  // namespace conversion
 }  // namespace motion_computation
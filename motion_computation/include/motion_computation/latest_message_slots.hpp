@@ -0,0 +1,135 @@
+// Copyright 2023 Leidos
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_COMPUTATION__LATEST_MESSAGE_SLOTS_HPP_
+#define MOTION_COMPUTATION__LATEST_MESSAGE_SLOTS_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace motion_computation
+{
+
+/**
+ * \brief Counters describing how the messages of one V2X source were handled
+ */
+struct V2XIngestionStats
+{
+  uint64_t received = 0;   // Messages stored in a slot
+  uint64_t coalesced = 0;  // Stored messages replaced by a newer message from the same object
+  uint64_t dropped = 0;    // Messages discarded because every slot was in use
+  uint64_t converted = 0;  // Messages converted to ExternalObjects
+};
+
+/**
+ * \brief A received message along with the time it was received
+ */
+template <class MessageT>
+struct ReceivedMessage
+{
+  std::unique_ptr<MessageT> msg;
+  rclcpp::Time receipt_time;
+};
+
+/**
+ * \brief Holds the latest message received from each object until it is consumed.
+ *
+ * A message from an object which already has a slot replaces the message in that slot so that
+ * only the latest message is converted. Slots are kept in the order their objects first arrived.
+ * The number of slots is bounded, messages from new objects are dropped once every slot is in use.
+ */
+template <class MessageT>
+class LatestMessageSlots
+{
+public:
+  /**
+   * \brief Constructor
+   * \param max_slots Maximum number of objects held at once
+   */
+  explicit LatestMessageSlots(size_t max_slots = 1000) : max_slots_(max_slots) {}
+
+  /**
+   * \brief Stores msg as the latest message of object id
+   * \param id object id of the message
+   * \param msg message to store
+   * \param receipt_time time the message was received
+   * \return false if the message was dropped because every slot was in use
+   */
+  bool insert(uint32_t id, std::unique_ptr<MessageT> msg, const rclcpp::Time & receipt_time)
+  {
+    auto slot = slot_index_.find(id);
+
+    if (slot != slot_index_.end()) {
+      slots_[slot->second] = {std::move(msg), receipt_time};
+      stats_.coalesced++;
+      stats_.received++;
+      return true;
+    }
+
+    if (slots_.size() >= max_slots_) {
+      stats_.dropped++;
+      return false;
+    }
+
+    slot_index_[id] = slots_.size();
+    slots_.push_back({std::move(msg), receipt_time});
+    stats_.received++;
+    return true;
+  }
+
+  /**
+   * \brief Moves the latest message of every object out of the slots, leaving them empty
+   * \return messages in the order their objects first arrived
+   */
+  std::vector<ReceivedMessage<MessageT>> take()
+  {
+    std::vector<ReceivedMessage<MessageT>> messages = std::move(slots_);
+    slots_.clear();
+    slot_index_.clear();
+    stats_.converted += messages.size();
+    return messages;
+  }
+
+  /**
+   * \brief Empties the slots without counting their messages as converted
+   */
+  void clear()
+  {
+    slots_.clear();
+    slot_index_.clear();
+  }
+
+  size_t size() const { return slots_.size(); }
+
+  bool empty() const { return slots_.empty(); }
+
+  void setMaxSlots(size_t max_slots) { max_slots_ = max_slots; }
+
+  const V2XIngestionStats & getStats() const { return stats_; }
+
+private:
+  size_t max_slots_;
+  std::vector<ReceivedMessage<MessageT>> slots_;
+  std::unordered_map<uint32_t, size_t> slot_index_;
+  V2XIngestionStats stats_;
+};
+
+}  // namespace motion_computation
+
+#endif  // MOTION_COMPUTATION__LATEST_MESSAGE_SLOTS_HPP_
@@ -15,7 +15,7 @@
 #ifndef MOTION_COMPUTATION__MESSAGE_CONVERSIONS_HPP_
 #define MOTION_COMPUTATION__MESSAGE_CONVERSIONS_HPP_
 
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <tf2/LinearMath/Quaternion.h>
 #include <carma_perception_msgs/msg/external_object.hpp>
 #include <carma_v2x_msgs/msg/bsm.hpp>
@@ -33,20 +33,41 @@ namespace conversion
 void convert(
   const carma_v2x_msgs::msg::PSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
   const std::string & map_frame_id, double pred_period, double pred_step_size,
-  const lanelet::projection::LocalFrameProjector & map_projector,
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
   const tf2::Quaternion & ned_in_map_rotation,
   rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock);
 
+/**
+ * \brief Converts a PSM which was received at receipt_time. The receipt time is used in place of
+ * the current time when the minute of the PSM sec_mark must be taken from the local clock.
+ */
+void convert(
+  const carma_v2x_msgs::msg::PSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
+  const std::string & map_frame_id, double pred_period, double pred_step_size,
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
+  const tf2::Quaternion & ned_in_map_rotation,
+  rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock,
+  const rclcpp::Time & receipt_time);
+
 void convert(
   const carma_v2x_msgs::msg::BSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
   const std::string & map_frame_id, double pred_period, double pred_step_size,
-  const lanelet::projection::LocalFrameProjector & map_projector,
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
   tf2::Quaternion ned_in_map_rotation);
 
 void convert(
   const carma_v2x_msgs::msg::MobilityPath & in_msg,
   carma_perception_msgs::msg::ExternalObject & out_msg,
-  const lanelet::projection::LocalFrameProjector & map_projector);
+  const carma_wm::projection::GeoreferenceProjector & map_projector);
+
+/**
+ * \brief Returns the id of the ExternalObject the message converts to without converting it
+ */
+uint32_t getObjectId(const carma_v2x_msgs::msg::PSM & in_msg);
+
+uint32_t getObjectId(const carma_v2x_msgs::msg::BSM & in_msg);
+
+uint32_t getObjectId(const carma_v2x_msgs::msg::MobilityPath & in_msg);
 }  // namespace conversion
 }  // namespace motion_computation
 
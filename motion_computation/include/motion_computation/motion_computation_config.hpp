@@ -57,6 +57,13 @@ struct Config
   // will occur (objects may be duplicated)
   bool enable_sensor_processing = false;
 
+  // Maximum number of threads used to predict and synchronize objects each cycle
+  int max_prediction_threads = 4;
+
+  // Maximum number of objects from each V2X source queued between sensor frames. Only the latest
+  // message of each object is queued, messages from further objects are dropped
+  int max_v2x_objects = 1000;
+
   // Stream operator for this config
   friend std::ostream & operator<<(std::ostream & output, const Config & c)
   {
@@ -72,6 +79,8 @@ struct Config
            << "enable_psm_processing: " << c.enable_psm_processing << std::endl
            << "enable_mobility_path_processing: " << c.enable_mobility_path_processing << std::endl
            << "enable_sensor_processing: " << c.enable_sensor_processing << std::endl
+           << "max_prediction_threads: " << c.max_prediction_threads << std::endl
+           << "max_v2x_objects: " << c.max_v2x_objects << std::endl
            << "}" << std::endl;
     return output;
   }
@@ -20,10 +20,12 @@
 #include <carma_perception_msgs/msg/external_object_list.hpp>
 #include <carma_ros2_utils/carma_lifecycle_node.hpp>
 #include <carma_v2x_msgs/msg/mobility_path.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <std_msgs/msg/string.hpp>
 
 #include <functional>
+#include <string>
 #include <vector>
 
 #include "motion_computation/motion_computation_config.hpp"
@@ -48,6 +50,7 @@ private:
 
   // Publishers
   carma_ros2_utils::PubPtr<carma_perception_msgs::msg::ExternalObjectList> carma_obj_pub_;
+  carma_ros2_utils::PubPtr<diagnostic_msgs::msg::DiagnosticArray> v2x_ingestion_metrics_pub_;
 
   // MotionComputationWorker class object
   MotionComputationWorker motion_worker_;
@@ -71,7 +74,13 @@ public:
    * \brief Function to publish ExternalObjectList
    * \param obj_pred_msg ExternalObjectList message to be published
    */
-  void publishObject(const carma_perception_msgs::msg::ExternalObjectList & obj_pred_msg) const;
+  void publishObject(carma_perception_msgs::msg::ExternalObjectList && obj_pred_msg) const;
+
+  /**
+   * \brief Publishes the received, coalesced, dropped and converted message counts of each V2X
+   * source
+   */
+  void publishV2XIngestionMetrics() const;
 
   ////
   // Overrides
@@ -16,7 +16,7 @@
 #define MOTION_COMPUTATION__MOTION_COMPUTATION_WORKER_HPP_
 
 #include <gtest/gtest_prod.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <carma_perception_msgs/msg/external_object.hpp>
@@ -29,11 +29,14 @@
 #include <rclcpp/rclcpp.hpp>
 #include <std_msgs/msg/string.hpp>
 
+#include "motion_computation/latest_message_slots.hpp"
+
 #include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 namespace motion_computation
 {
@@ -46,7 +49,7 @@ class MotionComputationWorker
 {
 public:
   using PublishObjectCallback =
-    std::function<void(const carma_perception_msgs::msg::ExternalObjectList &)>;
+    std::function<void(carma_perception_msgs::msg::ExternalObjectList &&)>;
   using LookUpTransform = std::function<void()>;
 
   /*!
@@ -59,6 +62,8 @@ public:
   /**
    * \brief Function to populate duplicated detected objects along with their velocity, yaw,
    * yaw_rate and static/dynamic class to the provided ExternalObjectList message.
+   * Objects are moved from obj_list into the published list and predicted in place across up to
+   * max_prediction_threads threads.
    * \param  obj_list ExternalObjectList message
    */
   void predictionLogic(carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_list);
@@ -70,16 +75,25 @@ public:
   void setYAccelerationNoise(double noise);
   void setProcessNoiseMax(double noise_max);
   void setConfidenceDropRate(double drop_rate);
+  void setMaxPredictionThreads(size_t max_threads);
+  void setMaxV2XObjects(size_t max_objects);
   void setDetectionInputFlags(
     bool enable_sensor_processing, bool enable_bsm_processing, bool enable_psm_processing,
     bool enable_mobility_path_processing);
 
   // callbacks
-  void mobilityPathCallback(const carma_v2x_msgs::msg::MobilityPath::UniquePtr msg);
+  // V2X messages are stored in a slot per object, only the latest message of each object is
+  // converted when the next sensor frame is processed
+  void mobilityPathCallback(carma_v2x_msgs::msg::MobilityPath::UniquePtr msg);
+
+  void bsmCallback(carma_v2x_msgs::msg::BSM::UniquePtr msg);
 
-  void bsmCallback(const carma_v2x_msgs::msg::BSM::UniquePtr msg);
+  void psmCallback(carma_v2x_msgs::msg::PSM::UniquePtr msg);
 
-  void psmCallback(const carma_v2x_msgs::msg::PSM::UniquePtr msg);
+  // Ingestion counters of each V2X source
+  const V2XIngestionStats & getBSMStats() const;
+  const V2XIngestionStats & getPSMStats() const;
+  const V2XIngestionStats & getMobilityPathStats() const;
 
   /**
    * \brief Callback for map projection string to define lat/lon -> map conversion
@@ -133,6 +147,7 @@ private:
   double cv_y_accel_noise_ = 9.0;
   double prediction_process_noise_max_ = 1000.0;
   double prediction_confidence_drop_rate_ = 0.9;
+  size_t max_prediction_threads_ = 4;
 
   // Flags for the different possible detection inputs
   bool enable_sensor_processing_ = true;
@@ -148,21 +163,59 @@ private:
   // Clock interface - gets the ros simulated clock from Node
   rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock_;
 
-  // Queue for v2x msgs to synchronize them with sensor msgs
-  carma_perception_msgs::msg::ExternalObjectList mobility_path_list_;
-  carma_perception_msgs::msg::ExternalObjectList bsm_list_;
-  carma_perception_msgs::msg::ExternalObjectList psm_list_;
-
-  // Maps of external object id to index in synchronization queues
-  std::unordered_map<uint32_t, size_t> mobility_path_obj_id_map_;
-  std::unordered_map<uint32_t, size_t> bsm_obj_id_map_;
-  std::unordered_map<uint32_t, size_t> psm_obj_id_map_;
+  // Latest unconverted v2x msg of each object waiting to be synchronized with sensor msgs
+  LatestMessageSlots<carma_v2x_msgs::msg::MobilityPath> mobility_path_slots_;
+  LatestMessageSlots<carma_v2x_msgs::msg::BSM> bsm_slots_;
+  LatestMessageSlots<carma_v2x_msgs::msg::PSM> psm_slots_;
 
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+  std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
   // Rotation of a North East Down frame located on the map origin described in the map frame
   tf2::Quaternion ned_in_map_rotation_;
 
+  /**
+   * \brief Sets the object type of obj and replaces its predictions using the CTRV model for
+   * vehicles and the CV model for everything else
+   * \param obj object to predict
+   */
+  void predictObject(carma_perception_msgs::msg::ExternalObject & obj) const;
+
+  /**
+   * \brief In place equivalent of synchronizeAndAppend. new_objects are synchronized to the stamp
+   * of base_objects and moved behind its objects.
+   * \param base_objects object detections to append to and synchronize with
+   * \param new_objects new objects to add and be synchronized. Left empty.
+   */
+  void appendSynchronized(
+    carma_perception_msgs::msg::ExternalObjectList & base_objects,
+    std::vector<carma_perception_msgs::msg::ExternalObject> && new_objects) const;
+
+  /**
+   * \brief Converts the messages held in slots to ExternalObjects, synchronizes them to the stamp
+   * of base_objects and appends them. The slots are left empty.
+   * \param base_objects object detections to append to and synchronize with
+   * \param slots latest message of each object
+   * \param convert function converting a message received at the given time
+   */
+  template <class MessageT>
+  void convertAndAppend(
+    carma_perception_msgs::msg::ExternalObjectList & base_objects,
+    LatestMessageSlots<MessageT> & slots,
+    const std::function<void(
+      const MessageT &, const rclcpp::Time &, carma_perception_msgs::msg::ExternalObject &)> &
+      convert) const;
+
+  // Clears all v2x slots without converting their messages
+  void clearV2XSlots();
+
+  /**
+   * \brief In place equivalent of matchAndInterpolateTimeStamp
+   * \param path External object with predictions to modify
+   * \param time_to_match time stamp to have the object start at
+   */
+  void interpolateToTimeStamp(
+    carma_perception_msgs::msg::ExternalObject & path, const rclcpp::Time & time_to_match) const;
+
   // Unit Test Accessors
   FRIEND_TEST(MotionComputationWorker, MobilityPathToExternalObject);
   FRIEND_TEST(MotionComputationWorker, PsmToExternalObject);
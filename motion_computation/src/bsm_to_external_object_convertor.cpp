@@ -26,10 +26,23 @@ namespace motion_computation
 namespace conversion
 {
 
+uint32_t getObjectId(const carma_v2x_msgs::msg::BSM & in_msg)
+{
+  uint32_t id = 0;
+  for (int i = in_msg.core_data.id.size() - 1; i >= 0;
+       i--) {  // using signed iterator to handle empty case
+    // each byte of the bsm id gets placed in one byte of the object id.
+    // This should result in very large numbers which will be unlikely to
+    // conflict with standard detections
+    id |= in_msg.core_data.id[i] << (8 * i);
+  }
+  return id;
+}
+
 void convert(
   const carma_v2x_msgs::msg::BSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
   const std::string & map_frame_id, double pred_period, double pred_step_size,
-  const lanelet::projection::LocalFrameProjector & map_projector,
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
   tf2::Quaternion ned_in_map_rotation)
 {
   out_msg.presence_vector |= carma_perception_msgs::msg::ExternalObject::BSM_ID_PRESENCE_VECTOR;
@@ -40,14 +53,7 @@ void convert(
 
   /////// Object Id /////////
   // Generate a unique object id from the bsm id
-  out_msg.id = 0;
-  for (int i = in_msg.core_data.id.size() - 1; i >= 0;
-       i--) {  // using signed iterator to handle empty case
-    // each byte of the bsm id gets placed in one byte of the object id.
-    // This should result in very large numbers which will be unlikely to
-    // conflict with standard detections
-    out_msg.id |= in_msg.core_data.id[i] << (8 * i);
-  }
+  out_msg.id = getObjectId(in_msg);
   out_msg.presence_vector |= carma_perception_msgs::msg::ExternalObject::ID_PRESENCE_VECTOR;
 
   /////// BSM Id /////////
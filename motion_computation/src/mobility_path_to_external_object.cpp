@@ -26,10 +26,19 @@ namespace motion_computation
 namespace conversion
 {
 
+uint32_t getObjectId(const carma_v2x_msgs::msg::MobilityPath & in_msg)
+{
+  std::hash<std::string> hasher;
+
+  // TODO(carma) hasher returns size_t, message accept uint32_t which we might lose info
+  auto hashed = hasher(in_msg.m_header.sender_id);
+  return static_cast<uint32_t>(hashed);
+}
+
 void convert(
   const carma_v2x_msgs::msg::MobilityPath & in_msg,
   carma_perception_msgs::msg::ExternalObject & out_msg,
-  const lanelet::projection::LocalFrameProjector & map_projector)
+  const carma_wm::projection::GeoreferenceProjector & map_projector)
 {
   constexpr double mobility_path_points_timestep_size =
     0.1;  // Mobility path timestep size per message spec
@@ -56,11 +65,7 @@ void convert(
   // clang-on
 
   out_msg.object_type = carma_perception_msgs::msg::ExternalObject::SMALL_VEHICLE;
-  std::hash<std::string> hasher;
-
-  // TODO(carma) hasher returns size_t, message accept uint32_t which we might lose info
-  auto hashed = hasher(in_msg.m_header.sender_id);
-  out_msg.id = static_cast<uint32_t>(hashed);
+  out_msg.id = getObjectId(in_msg);
 
   // convert hex std::string to uint8_t array
   for (size_t i = 0; i < in_msg.m_header.sender_bsm_id.size(); i += 2) {
@@ -251,7 +256,8 @@ double getYawFromQuaternionMsg(const geometry_msgs::msg::Quaternion & quaternion
 }
 
 tf2::Vector3 transform_to_map_frame(
-  const tf2::Vector3 & ecef_point, const lanelet::projection::LocalFrameProjector & map_projector)
+  const tf2::Vector3 & ecef_point,
+  const carma_wm::projection::GeoreferenceProjector & map_projector)
 {
   lanelet::BasicPoint3d map_point = map_projector.projectECEF(
     {ecef_point.x(), ecef_point.y(), ecef_point.z()},
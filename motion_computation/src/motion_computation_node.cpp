@@ -14,6 +14,9 @@
 
 #include "motion_computation/motion_computation_node.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace motion_computation
@@ -50,6 +53,9 @@ MotionComputationNode::MotionComputationNode(const rclcpp::NodeOptions & options
     "enable_mobility_path_processing", config_.enable_mobility_path_processing);
   config_.enable_sensor_processing =
     declare_parameter<bool>("enable_sensor_processing", config_.enable_sensor_processing);
+  config_.max_prediction_threads =
+    declare_parameter<int>("max_prediction_threads", config_.max_prediction_threads);
+  config_.max_v2x_objects = declare_parameter<int>("max_v2x_objects", config_.max_v2x_objects);
 }
 
 rcl_interfaces::msg::SetParametersResult MotionComputationNode::parameter_update_callback(
@@ -71,9 +77,14 @@ rcl_interfaces::msg::SetParametersResult MotionComputationNode::parameter_update
      {"enable_sensor_processing", config_.enable_sensor_processing}},
     parameters);
 
+  auto error_3 = update_params<int>(
+    {{"max_prediction_threads", config_.max_prediction_threads},
+     {"max_v2x_objects", config_.max_v2x_objects}},
+    parameters);
+
   rcl_interfaces::msg::SetParametersResult result;
 
-  result.successful = !error && !error_2;
+  result.successful = !error && !error_2 && !error_3;
 
   if (result.successful) {
     // Set motion_worker_'s prediction parameters
@@ -83,6 +94,8 @@ rcl_interfaces::msg::SetParametersResult MotionComputationNode::parameter_update
     motion_worker_.setYAccelerationNoise(config_.cv_y_accel_noise);
     motion_worker_.setProcessNoiseMax(config_.prediction_process_noise_max);
     motion_worker_.setConfidenceDropRate(config_.prediction_confidence_drop_rate);
+    motion_worker_.setMaxPredictionThreads(std::max(config_.max_prediction_threads, 1));
+    motion_worker_.setMaxV2XObjects(std::max(config_.max_v2x_objects, 0));
     motion_worker_.setDetectionInputFlags(
       config_.enable_sensor_processing, config_.enable_bsm_processing,
       config_.enable_psm_processing, config_.enable_mobility_path_processing);
@@ -110,6 +123,8 @@ carma_ros2_utils::CallbackReturn MotionComputationNode::handle_on_configure(
   get_parameter<bool>("enable_psm_processing", config_.enable_psm_processing);
   get_parameter<bool>("enable_mobility_path_processing", config_.enable_mobility_path_processing);
   get_parameter<bool>("enable_sensor_processing", config_.enable_sensor_processing);
+  get_parameter<int>("max_prediction_threads", config_.max_prediction_threads);
+  get_parameter<int>("max_v2x_objects", config_.max_v2x_objects);
 
   RCLCPP_INFO_STREAM(get_logger(), "Loaded params: " << config_);
 
@@ -142,6 +157,9 @@ carma_ros2_utils::CallbackReturn MotionComputationNode::handle_on_configure(
   carma_obj_pub_ = create_publisher<carma_perception_msgs::msg::ExternalObjectList>(
     "external_object_predictions", 2);
 
+  v2x_ingestion_metrics_pub_ =
+    create_publisher<diagnostic_msgs::msg::DiagnosticArray>("v2x_ingestion_metrics", 10);
+
   // Set motion_worker_'s prediction parameters
   motion_worker_.setPredictionTimeStep(config_.prediction_time_step);
   motion_worker_.setPredictionPeriod(config_.prediction_period);
@@ -149,6 +167,8 @@ carma_ros2_utils::CallbackReturn MotionComputationNode::handle_on_configure(
   motion_worker_.setYAccelerationNoise(config_.cv_y_accel_noise);
   motion_worker_.setProcessNoiseMax(config_.prediction_process_noise_max);
   motion_worker_.setConfidenceDropRate(config_.prediction_confidence_drop_rate);
+  motion_worker_.setMaxPredictionThreads(std::max(config_.max_prediction_threads, 1));
+  motion_worker_.setMaxV2XObjects(std::max(config_.max_v2x_objects, 0));
   motion_worker_.setDetectionInputFlags(
     config_.enable_sensor_processing, config_.enable_bsm_processing, config_.enable_psm_processing,
     config_.enable_mobility_path_processing);
@@ -158,9 +178,51 @@ carma_ros2_utils::CallbackReturn MotionComputationNode::handle_on_configure(
 }
 
 void MotionComputationNode::publishObject(
-  const carma_perception_msgs::msg::ExternalObjectList & obj_pred_msg) const
+  carma_perception_msgs::msg::ExternalObjectList && obj_pred_msg) const
+{
+  // Hand ownership of the list to the middleware so the objects are not copied on publish
+  carma_obj_pub_->publish(
+    std::make_unique<carma_perception_msgs::msg::ExternalObjectList>(std::move(obj_pred_msg)));
+
+  publishV2XIngestionMetrics();
+}
+
+void MotionComputationNode::publishV2XIngestionMetrics() const
 {
-  carma_obj_pub_->publish(obj_pred_msg);
+  diagnostic_msgs::msg::DiagnosticArray metrics;
+  metrics.header.stamp = get_clock()->now();
+
+  const auto add_status = [this, &metrics](
+                            const std::string & source, const V2XIngestionStats & stats) {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = std::string(get_name()) + "/" + source;
+
+    diagnostic_msgs::msg::KeyValue kv;
+    kv.key = "received";
+    kv.value = std::to_string(stats.received);
+    status.values.push_back(kv);
+
+    kv.key = "coalesced";
+    kv.value = std::to_string(stats.coalesced);
+    status.values.push_back(kv);
+
+    kv.key = "dropped";
+    kv.value = std::to_string(stats.dropped);
+    status.values.push_back(kv);
+
+    kv.key = "converted";
+    kv.value = std::to_string(stats.converted);
+    status.values.push_back(kv);
+
+    metrics.status.push_back(status);
+  };
+
+  add_status("bsm", motion_worker_.getBSMStats());
+  add_status("psm", motion_worker_.getPSMStats());
+  add_status("mobility_path", motion_worker_.getMobilityPathStats());
+
+  v2x_ingestion_metrics_pub_->publish(metrics);
 }
 
 }  // namespace motion_computation
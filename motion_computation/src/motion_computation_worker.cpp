@@ -13,13 +13,23 @@
 // limitations under the License.
 
 #include "motion_computation/motion_computation_worker.hpp"
+#include <carma_wm/ParallelFor.hpp>
 #include <wgs84_utils/proj_tools.h>
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "motion_computation/message_conversions.hpp"
 
 namespace motion_computation
 {
+namespace
+{
+// Smallest number of objects worth handing to a thread of their own
+constexpr size_t MIN_OBJECTS_PER_THREAD = 16;
+}  // namespace
 
 MotionComputationWorker::MotionComputationWorker(
   const PublishObjectCallback & obj_pub,
@@ -32,60 +42,21 @@ MotionComputationWorker::MotionComputationWorker(
 void MotionComputationWorker::predictionLogic(
   carma_perception_msgs::msg::ExternalObjectList::UniquePtr obj_list)
 {
-  carma_perception_msgs::msg::ExternalObjectList sensor_list;
-  sensor_list.header = obj_list->header;
-
-  for (auto obj : obj_list->objects) {
-    // Header contains the frame rest of the fields will use
-    // obj.header = obj_list.objects[i].header;
-
-    // Object id. Matching ids on a topic should refer to the same object within
-    // some time period, expanded
-    // obj.id = obj_list.objects[i].id;
-
-    // Update the object type and generate predictions using CV or CTRV vehicle models.
-    // If the object is a bicycle or motor vehicle use CTRV otherwise use CV.
-
-    bool use_ctrv_model;
-
-    if (obj.object_type == obj.UNKNOWN) {
-      use_ctrv_model = true;
-    } else if (obj.object_type == obj.MOTORCYCLE) {
-      use_ctrv_model = true;
-    } else if (obj.object_type == obj.SMALL_VEHICLE) {
-      use_ctrv_model = true;
-    } else if (obj.object_type == obj.LARGE_VEHICLE) {
-      use_ctrv_model = true;
-    } else if (obj.object_type == obj.PEDESTRIAN) {
-      use_ctrv_model = false;
-    } else {
-      obj.object_type = obj.UNKNOWN;
-      use_ctrv_model = false;
-    }  // end if-else
-
-    if (use_ctrv_model == true) {
-      obj.predictions = motion_predict::ctrv::predictPeriod(
-        obj, prediction_time_step_, prediction_period_, prediction_process_noise_max_,
-        prediction_confidence_drop_rate_);
-    } else {
-      obj.predictions = motion_predict::cv::predictPeriod(
-        obj, prediction_time_step_, prediction_period_, cv_x_accel_noise_, cv_y_accel_noise_,
-        prediction_process_noise_max_, prediction_confidence_drop_rate_);
-    }
-    sensor_list.objects.emplace_back(obj);
-  }  // end for-loop
-
   // Synchronize all data to the current sensor data timestamp
   carma_perception_msgs::msg::ExternalObjectList synchronization_base_objects;
-  synchronization_base_objects.header =
-    sensor_list
-      .header;  // Use the current sensing stamp as the sync point even if sensor data is not used
+  // Use the current sensing stamp as the sync point even if sensor data is not used
+  synchronization_base_objects.header = obj_list->header;
 
   if (enable_sensor_processing_) {
     // If using sensor data add it to the base synchronization list since it
-    // already is at the desired time
+    // already is at the desired time. The objects are owned by this callback so they are
+    // moved rather than copied and their predictions are generated in place
+    synchronization_base_objects.objects = std::move(obj_list->objects);
 
-    synchronization_base_objects.objects = sensor_list.objects;
+    auto & objects = synchronization_base_objects.objects;
+    carma_wm::parallelFor(
+      objects.size(), max_prediction_threads_, MIN_OBJECTS_PER_THREAD,
+      [this, &objects](size_t i) { predictObject(objects[i]); });
 
   } else if (enable_bsm_processing_ || enable_psm_processing_ || enable_mobility_path_processing_) {
     // Since we use the new sensor data as the sync point we will still be
@@ -98,45 +69,137 @@ void MotionComputationWorker::predictionLogic(
       "Not configured to publish any data publishing empty object list. Operating like this is NOT "
       "advised.");
 
-    obj_pub_(synchronization_base_objects);
-    bsm_list_.objects.clear();
-    bsm_obj_id_map_.clear();
-    psm_list_.objects.clear();
-    psm_obj_id_map_.clear();
-    mobility_path_list_.objects.clear();
-    mobility_path_obj_id_map_.clear();
+    obj_pub_(std::move(synchronization_base_objects));
+    clearV2XSlots();
 
     return;
   }
 
-  // Start synchronizing all the enabled data streams
-  if (enable_bsm_processing_) {
-    synchronization_base_objects = synchronizeAndAppend(synchronization_base_objects, bsm_list_);
+  // Start synchronizing all the enabled data streams. Only the latest message of each object is
+  // converted
+  if (enable_bsm_processing_ && map_projector_) {
+    convertAndAppend<carma_v2x_msgs::msg::BSM>(
+      synchronization_base_objects, bsm_slots_,
+      [this](
+        const carma_v2x_msgs::msg::BSM & msg, const rclcpp::Time &,
+        carma_perception_msgs::msg::ExternalObject & obj) {
+        conversion::convert(
+          msg, obj, map_frame_id_, prediction_period_, prediction_time_step_, *map_projector_,
+          ned_in_map_rotation_);
+      });
   }
 
-  if (enable_psm_processing_) {
-    synchronization_base_objects = synchronizeAndAppend(synchronization_base_objects, psm_list_);
+  if (enable_psm_processing_ && map_projector_) {
+    convertAndAppend<carma_v2x_msgs::msg::PSM>(
+      synchronization_base_objects, psm_slots_,
+      [this](
+        const carma_v2x_msgs::msg::PSM & msg, const rclcpp::Time & receipt_time,
+        carma_perception_msgs::msg::ExternalObject & obj) {
+        conversion::convert(
+          msg, obj, map_frame_id_, prediction_period_, prediction_time_step_, *map_projector_,
+          ned_in_map_rotation_, node_clock_, receipt_time);
+      });
   }
 
-  if (enable_mobility_path_processing_) {
-    synchronization_base_objects =
-      synchronizeAndAppend(synchronization_base_objects, mobility_path_list_);
+  if (enable_mobility_path_processing_ && map_projector_) {
+    convertAndAppend<carma_v2x_msgs::msg::MobilityPath>(
+      synchronization_base_objects, mobility_path_slots_,
+      [this](
+        const carma_v2x_msgs::msg::MobilityPath & msg, const rclcpp::Time &,
+        carma_perception_msgs::msg::ExternalObject & obj) {
+        conversion::convert(msg, obj, *map_projector_);
+      });
   }
 
-  obj_pub_(synchronization_base_objects);
+  obj_pub_(std::move(synchronization_base_objects));
   // Clear msg queue since it is published
-  mobility_path_list_.objects.clear();
-  mobility_path_obj_id_map_.clear();
-  bsm_list_.objects.clear();
-  bsm_obj_id_map_.clear();
-  psm_list_.objects.clear();
-  psm_obj_id_map_.clear();
+  clearV2XSlots();
+}
+
+template <class MessageT>
+void MotionComputationWorker::convertAndAppend(
+  carma_perception_msgs::msg::ExternalObjectList & base_objects,
+  LatestMessageSlots<MessageT> & slots,
+  const std::function<void(
+    const MessageT &, const rclcpp::Time &, carma_perception_msgs::msg::ExternalObject &)> &
+    convert) const
+{
+  auto messages = slots.take();
+  const rclcpp::Time time_to_match(base_objects.header.stamp);
+
+  std::vector<carma_perception_msgs::msg::ExternalObject> new_objects(messages.size());
+  carma_wm::parallelFor(
+    messages.size(), max_prediction_threads_, MIN_OBJECTS_PER_THREAD,
+    [this, &messages, &new_objects, &time_to_match, &convert](size_t i) {
+      convert(*messages[i].msg, messages[i].receipt_time, new_objects[i]);
+      interpolateToTimeStamp(new_objects[i], time_to_match);
+    });
+
+  base_objects.objects.reserve(base_objects.objects.size() + new_objects.size());
+  base_objects.objects.insert(
+    base_objects.objects.end(), std::make_move_iterator(new_objects.begin()),
+    std::make_move_iterator(new_objects.end()));
+}
+
+void MotionComputationWorker::clearV2XSlots()
+{
+  mobility_path_slots_.clear();
+  bsm_slots_.clear();
+  psm_slots_.clear();
+}
+
+const V2XIngestionStats & MotionComputationWorker::getBSMStats() const
+{
+  return bsm_slots_.getStats();
+}
+
+const V2XIngestionStats & MotionComputationWorker::getPSMStats() const
+{
+  return psm_slots_.getStats();
+}
+
+const V2XIngestionStats & MotionComputationWorker::getMobilityPathStats() const
+{
+  return mobility_path_slots_.getStats();
+}
+
+void MotionComputationWorker::predictObject(carma_perception_msgs::msg::ExternalObject & obj) const
+{
+  // Update the object type and generate predictions using CV or CTRV vehicle models.
+  // If the object is a bicycle or motor vehicle use CTRV otherwise use CV.
+
+  bool use_ctrv_model;
+
+  if (obj.object_type == obj.UNKNOWN) {
+    use_ctrv_model = true;
+  } else if (obj.object_type == obj.MOTORCYCLE) {
+    use_ctrv_model = true;
+  } else if (obj.object_type == obj.SMALL_VEHICLE) {
+    use_ctrv_model = true;
+  } else if (obj.object_type == obj.LARGE_VEHICLE) {
+    use_ctrv_model = true;
+  } else if (obj.object_type == obj.PEDESTRIAN) {
+    use_ctrv_model = false;
+  } else {
+    obj.object_type = obj.UNKNOWN;
+    use_ctrv_model = false;
+  }  // end if-else
+
+  if (use_ctrv_model == true) {
+    obj.predictions = motion_predict::ctrv::predictPeriod(
+      obj, prediction_time_step_, prediction_period_, prediction_process_noise_max_,
+      prediction_confidence_drop_rate_);
+  } else {
+    obj.predictions = motion_predict::cv::predictPeriod(
+      obj, prediction_time_step_, prediction_period_, cv_x_accel_noise_, cv_y_accel_noise_,
+      prediction_process_noise_max_, prediction_confidence_drop_rate_);
+  }
 }
 
 void MotionComputationWorker::georeferenceCallback(const std_msgs::msg::String::UniquePtr msg)
 {
   // Build projector from proj string
-  map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());
+  map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);
 
   std::string axis =
     wgs84_utils::proj_tools::getAxisFromProjString(msg->data);  // Extract axis for orientation calc
@@ -174,6 +237,18 @@ void MotionComputationWorker::setConfidenceDropRate(double drop_rate)
   prediction_confidence_drop_rate_ = drop_rate;
 }
 
+void MotionComputationWorker::setMaxPredictionThreads(size_t max_threads)
+{
+  max_prediction_threads_ = max_threads;
+}
+
+void MotionComputationWorker::setMaxV2XObjects(size_t max_objects)
+{
+  mobility_path_slots_.setMaxSlots(max_objects);
+  bsm_slots_.setMaxSlots(max_objects);
+  psm_slots_.setMaxSlots(max_objects);
+}
+
 void MotionComputationWorker::setDetectionInputFlags(
   bool enable_sensor_processing, bool enable_bsm_processing, bool enable_psm_processing,
   bool enable_mobility_path_processing)
@@ -185,7 +260,7 @@ void MotionComputationWorker::setDetectionInputFlags(
 }
 
 void MotionComputationWorker::mobilityPathCallback(
-  const carma_v2x_msgs::msg::MobilityPath::UniquePtr msg)
+  carma_v2x_msgs::msg::MobilityPath::UniquePtr msg)
 {
   if (!map_projector_) {
     RCLCPP_ERROR(
@@ -200,22 +275,17 @@ void MotionComputationWorker::mobilityPathCallback(
     return;
   }
 
-  carma_perception_msgs::msg::ExternalObject obj_msg;
-  conversion::convert(*msg, obj_msg, *map_projector_);
-
-  // Check if this mobility path is from an object already being queded.
-  // If so then update the existing object, if not add it to the queue
-  if (mobility_path_obj_id_map_.find(obj_msg.id) != mobility_path_obj_id_map_.end()) {
-    mobility_path_list_.objects[mobility_path_obj_id_map_[obj_msg.id]] = obj_msg;
-
-  } else {
-    // Add the new object to the queue and save its index
-    mobility_path_obj_id_map_[obj_msg.id] = mobility_path_list_.objects.size();
-    mobility_path_list_.objects.push_back(obj_msg);
+  // Conversion is deferred until the next sensor frame. If this mobility path is from an object
+  // already being queued it replaces the queued message
+  const uint32_t id = conversion::getObjectId(*msg);
+  if (!mobility_path_slots_.insert(id, std::move(msg), node_clock_->get_clock()->now())) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      logger_->get_logger(), *node_clock_->get_clock(), 5000,
+      "Too many objects queued, dropping MobilityPath messages from new objects");
   }
 }
 
-void MotionComputationWorker::psmCallback(const carma_v2x_msgs::msg::PSM::UniquePtr msg)
+void MotionComputationWorker::psmCallback(carma_v2x_msgs::msg::PSM::UniquePtr msg)
 {
   if (!map_projector_) {
     RCLCPP_DEBUG_STREAM(
@@ -229,24 +299,17 @@ void MotionComputationWorker::psmCallback(const carma_v2x_msgs::msg::PSM::Unique
     return;
   }
 
-  carma_perception_msgs::msg::ExternalObject obj_msg;
-  conversion::convert(
-    *msg, obj_msg, map_frame_id_, prediction_period_, prediction_time_step_, *map_projector_,
-    ned_in_map_rotation_, node_clock_);
-
-  // Check if this psm is from an object already being queded.
-  // If so then update the existing object, if not add it to the queue
-  if (psm_obj_id_map_.find(obj_msg.id) != psm_obj_id_map_.end()) {
-    psm_list_.objects[psm_obj_id_map_[obj_msg.id]] = obj_msg;
-
-  } else {
-    // Add the new object to the queue and save its index
-    psm_obj_id_map_[obj_msg.id] = psm_list_.objects.size();
-    psm_list_.objects.push_back(obj_msg);
+  // Conversion is deferred until the next sensor frame. If this psm is from an object
+  // already being queued it replaces the queued message
+  const uint32_t id = conversion::getObjectId(*msg);
+  if (!psm_slots_.insert(id, std::move(msg), node_clock_->get_clock()->now())) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      logger_->get_logger(), *node_clock_->get_clock(), 5000,
+      "Too many objects queued, dropping PSM messages from new objects");
   }
 }
 
-void MotionComputationWorker::bsmCallback(const carma_v2x_msgs::msg::BSM::UniquePtr msg)
+void MotionComputationWorker::bsmCallback(carma_v2x_msgs::msg::BSM::UniquePtr msg)
 {
   if (!map_projector_) {
     RCLCPP_DEBUG_STREAM(
@@ -260,20 +323,13 @@ void MotionComputationWorker::bsmCallback(const carma_v2x_msgs::msg::BSM::Unique
     return;
   }
 
-  carma_perception_msgs::msg::ExternalObject obj_msg;
-  conversion::convert(
-    *msg, obj_msg, map_frame_id_, prediction_period_, prediction_time_step_, *map_projector_,
-    ned_in_map_rotation_);
-
-  // Check if this bsm is from an object already being queded.
-  // If so then update the existing object, if not add it to the queue
-  if (bsm_obj_id_map_.find(obj_msg.id) != bsm_obj_id_map_.end()) {
-    bsm_list_.objects[bsm_obj_id_map_[obj_msg.id]] = obj_msg;
-
-  } else {
-    // Add the new object to the queue and save its index
-    bsm_obj_id_map_[obj_msg.id] = bsm_list_.objects.size();
-    bsm_list_.objects.push_back(obj_msg);
+  // Conversion is deferred until the next sensor frame. If this bsm is from an object
+  // already being queued it replaces the queued message
+  const uint32_t id = conversion::getObjectId(*msg);
+  if (!bsm_slots_.insert(id, std::move(msg), node_clock_->get_clock()->now())) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      logger_->get_logger(), *node_clock_->get_clock(), 5000,
+      "Too many objects queued, dropping BSM messages from new objects");
   }
 }
 
@@ -281,104 +337,112 @@ carma_perception_msgs::msg::ExternalObjectList MotionComputationWorker::synchron
   const carma_perception_msgs::msg::ExternalObjectList & base_objects,
   carma_perception_msgs::msg::ExternalObjectList new_objects) const
 {
-  carma_perception_msgs::msg::ExternalObjectList output_list;
-  output_list.header = base_objects.header;
-  output_list.objects.reserve(base_objects.objects.size() + new_objects.objects.size());
-
-  // Compare time_stamps of first elements of each list as they are guaranteed to be the
-  // earliest of the respective lists
-
-  for (auto & obj : new_objects.objects) {
-    // interpolate and match timesteps
-    obj = matchAndInterpolateTimeStamp(obj, rclcpp::Time(base_objects.header.stamp));
-  }
-
-  output_list.objects.insert(
-    output_list.objects.begin(), base_objects.objects.begin(), base_objects.objects.end());
-  output_list.objects.insert(
-    output_list.objects.end(), new_objects.objects.begin(), new_objects.objects.end());
+  carma_perception_msgs::msg::ExternalObjectList output_list = base_objects;
+  appendSynchronized(output_list, std::move(new_objects.objects));
   return output_list;
 }
 
+void MotionComputationWorker::appendSynchronized(
+  carma_perception_msgs::msg::ExternalObjectList & base_objects,
+  std::vector<carma_perception_msgs::msg::ExternalObject> && new_objects) const
+{
+  const rclcpp::Time time_to_match(base_objects.header.stamp);
+
+  // interpolate and match timesteps
+  carma_wm::parallelFor(
+    new_objects.size(), max_prediction_threads_, MIN_OBJECTS_PER_THREAD,
+    [this, &new_objects, &time_to_match](size_t i) {
+      interpolateToTimeStamp(new_objects[i], time_to_match);
+    });
+
+  base_objects.objects.reserve(base_objects.objects.size() + new_objects.size());
+  base_objects.objects.insert(
+    base_objects.objects.end(), std::make_move_iterator(new_objects.begin()),
+    std::make_move_iterator(new_objects.end()));
+  new_objects.clear();
+}
+
 carma_perception_msgs::msg::ExternalObject MotionComputationWorker::matchAndInterpolateTimeStamp(
   carma_perception_msgs::msg::ExternalObject path, const rclcpp::Time & time_to_match) const
 {
-  carma_perception_msgs::msg::ExternalObject output = path;
-  // empty predictions
-  output.predictions = {};
-
-  // add the first point to start of the predictions to easily loop over
-  carma_perception_msgs::msg::PredictedState prev_state;
-  prev_state.header.stamp = output.header.stamp;
-  prev_state.predicted_position.orientation = output.pose.pose.orientation;
-  prev_state.predicted_velocity = output.velocity.twist;
-  prev_state.predicted_position.position.x = output.pose.pose.position.x;
-  prev_state.predicted_position.position.y = output.pose.pose.position.y;
-  prev_state.predicted_position.position.z = output.pose.pose.position.z;
-  path.predictions.insert(path.predictions.begin(), prev_state);
-
-  rclcpp::Time curr_time_to_match = time_to_match;
+  interpolateToTimeStamp(path, time_to_match);
+  return path;
+}
 
+void MotionComputationWorker::interpolateToTimeStamp(
+  carma_perception_msgs::msg::ExternalObject & path, const rclcpp::Time & time_to_match) const
+{
+  // the current state of the object precedes its first prediction
+  carma_perception_msgs::msg::PredictedState initial_state;
+  initial_state.header.stamp = path.header.stamp;
+  initial_state.predicted_position.orientation = path.pose.pose.orientation;
+  initial_state.predicted_velocity = path.velocity.twist;
+  initial_state.predicted_position.position = path.pose.pose.position;
+
+  // Find the first state at or after time_to_match and the state before it. The matched state
+  // becomes the body of the object and every later prediction is kept.
   // because of this logic, we would not encounter mobility path
   // that starts later than the time we are trying to match (which is starting
   // time of sensed objects)
-  bool is_first_point = true;
-  carma_perception_msgs::msg::PredictedState new_state;
-  for (auto const & curr_state : path.predictions) {
-    if (curr_time_to_match > curr_state.header.stamp) {
-      prev_state = curr_state;
-      continue;
-    }
-
-    if (is_first_point)  // we store in the body if it is the first point, not predictions
-    {
-      // reaching here means curr_state starts later than the time we are trying to match
-      // copy old unchanged parts
-      new_state.header.stamp = curr_time_to_match;
-      new_state.predicted_velocity = prev_state.predicted_velocity;
-      new_state.predicted_position.orientation = prev_state.predicted_position.orientation;
-
-      // interpolate position
-      rclcpp::Duration delta_t = rclcpp::Time(curr_state.header.stamp) - curr_time_to_match;
-      rclcpp::Duration pred_delta_t =
-        rclcpp::Time(curr_state.header.stamp) - rclcpp::Time(prev_state.header.stamp);
-      double ratio;
-      if (pred_delta_t.seconds() < 0.00000001) {  // Divide by zero check
-        // This can only happen if effectively all 3 points are on top of each other
-        // which is extremely unlikely
-        ratio = 0.0;
-      } else {
-        ratio = delta_t.seconds() / pred_delta_t.seconds();
+  const carma_perception_msgs::msg::PredictedState * prev_state = &initial_state;
+  const carma_perception_msgs::msg::PredictedState * curr_state = nullptr;
+  size_t kept_predictions_start = 0;
+
+  if (time_to_match > initial_state.header.stamp) {
+    for (size_t i = 0; i < path.predictions.size(); ++i) {
+      if (time_to_match > path.predictions[i].header.stamp) {
+        prev_state = &path.predictions[i];
+        continue;
       }
 
-      double delta_x =
-        curr_state.predicted_position.position.x - prev_state.predicted_position.position.x;
-      double delta_y =
-        curr_state.predicted_position.position.y - prev_state.predicted_position.position.y;
-      double delta_z =
-        curr_state.predicted_position.position.z - prev_state.predicted_position.position.z;
-      // we are "stepping back in time" to match the position
-      new_state.predicted_position.position.x =
-        curr_state.predicted_position.position.x - delta_x * ratio;
-      new_state.predicted_position.position.y =
-        curr_state.predicted_position.position.y - delta_y * ratio;
-      new_state.predicted_position.position.z =
-        curr_state.predicted_position.position.z - delta_z * ratio;
-
-      output.header.stamp = curr_time_to_match;
-      output.pose.pose.orientation = new_state.predicted_position.orientation;
-      output.velocity.twist = new_state.predicted_velocity;
-      output.pose.pose.position.x = new_state.predicted_position.position.x;
-      output.pose.pose.position.y = new_state.predicted_position.position.y;
-      output.pose.pose.position.z = new_state.predicted_position.position.z;
-      is_first_point = false;
-
-    } else {
-      output.predictions.push_back(curr_state);
+      curr_state = &path.predictions[i];
+      kept_predictions_start = i + 1;
+      break;
     }
+  } else {
+    curr_state = &initial_state;
+  }
+
+  if (!curr_state) {
+    // every state is before the time to match so there is nothing left to predict
+    path.predictions.clear();
+    return;
+  }
+
+  // interpolate position
+  rclcpp::Duration delta_t = rclcpp::Time(curr_state->header.stamp) - time_to_match;
+  rclcpp::Duration pred_delta_t =
+    rclcpp::Time(curr_state->header.stamp) - rclcpp::Time(prev_state->header.stamp);
+  double ratio;
+  if (pred_delta_t.seconds() < 0.00000001) {  // Divide by zero check
+    // This can only happen if effectively all 3 points are on top of each other
+    // which is extremely unlikely
+    ratio = 0.0;
+  } else {
+    ratio = delta_t.seconds() / pred_delta_t.seconds();
   }
 
-  return output;
+  double delta_x =
+    curr_state->predicted_position.position.x - prev_state->predicted_position.position.x;
+  double delta_y =
+    curr_state->predicted_position.position.y - prev_state->predicted_position.position.y;
+  double delta_z =
+    curr_state->predicted_position.position.z - prev_state->predicted_position.position.z;
+
+  // we are "stepping back in time" to match the position
+  geometry_msgs::msg::Point position;
+  position.x = curr_state->predicted_position.position.x - delta_x * ratio;
+  position.y = curr_state->predicted_position.position.y - delta_y * ratio;
+  position.z = curr_state->predicted_position.position.z - delta_z * ratio;
+
+  // copy old unchanged parts
+  path.header.stamp = time_to_match;
+  path.pose.pose.orientation = prev_state->predicted_position.orientation;
+  path.velocity.twist = prev_state->predicted_velocity;
+  path.pose.pose.position = position;
+
+  path.predictions.erase(
+    path.predictions.begin(), path.predictions.begin() + kept_predictions_start);
 }
 
 }  // namespace motion_computation
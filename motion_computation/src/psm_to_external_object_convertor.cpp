@@ -35,13 +35,39 @@ namespace motion_computation
 namespace conversion
 {
 
+uint32_t getObjectId(const carma_v2x_msgs::msg::PSM & in_msg)
+{
+  uint32_t id = 0;
+  for (int i = in_msg.id.id.size() - 1; i >= 0;
+       i--) {  // using signed iterator to handle empty case
+    // each byte of the psm id gets placed in one byte of the object id.
+    // This should result in very large numbers which will be unlikely to
+    // conflict with standard detections
+    id |= in_msg.id.id[i] << (8 * i);
+  }
+  return id;
+}
+
 void convert(
   const carma_v2x_msgs::msg::PSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
   const std::string & map_frame_id, double pred_period, double pred_step_size,
-
-  const lanelet::projection::LocalFrameProjector & map_projector,
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
   const tf2::Quaternion & ned_in_map_rotation,
   rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock)
+{
+  convert(
+    in_msg, out_msg, map_frame_id, pred_period, pred_step_size, map_projector, ned_in_map_rotation,
+    node_clock, node_clock->get_clock()->now());
+}
+
+void convert(
+  const carma_v2x_msgs::msg::PSM & in_msg, carma_perception_msgs::msg::ExternalObject & out_msg,
+  const std::string & map_frame_id, double pred_period, double pred_step_size,
+
+  const carma_wm::projection::GeoreferenceProjector & map_projector,
+  const tf2::Quaternion & ned_in_map_rotation,
+  rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock,
+  const rclcpp::Time & receipt_time)
 {
   /////// Dynamic Object /////////
   out_msg.dynamic_obj = true;  // If a PSM is sent then the object is dynamic
@@ -50,14 +76,7 @@ void convert(
 
   /////// Object Id /////////
   // Generate a unique object id from the psm id
-  out_msg.id = 0;
-  for (int i = in_msg.id.id.size() - 1; i >= 0;
-       i--) {  // using signed iterator to handle empty case
-    // each byte of the psm id gets placed in one byte of the object id.
-    // This should result in very large numbers which will be unlikely to
-    // conflict with standard detections
-    out_msg.id |= in_msg.id.id[i] << (8 * i);
-  }
+  out_msg.id = getObjectId(in_msg);
   out_msg.presence_vector |= carma_perception_msgs::msg::ExternalObject::ID_PRESENCE_VECTOR;
 
   /////// BSM Id /////////
@@ -68,7 +87,7 @@ void convert(
   /////// Timestamp /////////
   // Compute the timestamp
 
-  auto psm_timestamp = impl::get_psm_timestamp(in_msg, node_clock->get_clock());
+  auto psm_timestamp = impl::get_psm_timestamp(in_msg, node_clock->get_clock(), receipt_time);
   out_msg.header.stamp = builtin_interfaces::msg::Time(psm_timestamp);
   out_msg.header.frame_id = map_frame_id;
 
@@ -337,7 +356,7 @@ std::vector<geometry_msgs::msg::Pose> sample_2d_linear_motion(
 // NOTE heading will need to be set after calling this
 
 geometry_msgs::msg::PoseWithCovariance pose_from_gnss(
-  const lanelet::projection::LocalFrameProjector & projector,
+  const carma_wm::projection::GeoreferenceProjector & projector,
   const tf2::Quaternion & ned_in_map_rotation, const lanelet::GPSPoint & gps_point,
   const double & heading, const double lat_variance, const double lon_variance,
   const double heading_variance)
@@ -476,6 +495,13 @@ std::vector<carma_perception_msgs::msg::PredictedState> predicted_poses_to_predi
 
 rclcpp::Time get_psm_timestamp(
   const carma_v2x_msgs::msg::PSM & in_msg, rclcpp::Clock::SharedPtr clock)
+{
+  return get_psm_timestamp(in_msg, clock, clock->now());
+}
+
+rclcpp::Time get_psm_timestamp(
+  const carma_v2x_msgs::msg::PSM & in_msg, rclcpp::Clock::SharedPtr clock,
+  const rclcpp::Time & receipt_time)
 {
   boost::posix_time::ptime utc_time_of_current_psm;
 
@@ -534,8 +560,8 @@ rclcpp::Time get_psm_timestamp(
       "clock is exactly synced. This is NOT "
       "ADVISED.");
 
-    // Get the current ROS time
-    auto current_time = clock->now();
+    // Use the time the PSM was received as the current ROS time
+    const auto & current_time = receipt_time;
 
     // Convert the ros time to a boost duration
     boost::posix_time::time_duration duration_since_inception(
@@ -16,12 +16,14 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
+#include <array>
 #include <chrono>
 #include <future>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "motion_computation/impl/mobility_path_to_external_object_helpers.hpp"
 #include "motion_computation/message_conversions.hpp"
@@ -597,4 +599,209 @@ TEST(MotionComputationWorker, BSMtoExternalObject)
   ASSERT_NEAR(output.predictions[1].predicted_velocity.linear.x, 163.8, 0.1);
 }
 
+TEST(LatestMessageSlots, CoalesceAndDrop)
+{
+  LatestMessageSlots<std_msgs::msg::String> slots(2);
+  rclcpp::Time receipt_time(1, 0);
+
+  auto make_msg = [](const std::string & data) {
+    auto msg = std::make_unique<std_msgs::msg::String>();
+    msg->data = data;
+    return msg;
+  };
+
+  ASSERT_TRUE(slots.insert(7, make_msg("a1"), receipt_time));
+  ASSERT_TRUE(slots.insert(3, make_msg("b1"), receipt_time));
+  ASSERT_TRUE(slots.insert(7, make_msg("a2"), rclcpp::Time(2, 0)));  // Replaces a1
+  ASSERT_FALSE(slots.insert(9, make_msg("c1"), receipt_time));       // No free slot
+
+  ASSERT_EQ(2u, slots.size());
+  ASSERT_EQ(4u, slots.getStats().received + slots.getStats().dropped);
+  ASSERT_EQ(3u, slots.getStats().received);
+  ASSERT_EQ(1u, slots.getStats().coalesced);
+  ASSERT_EQ(1u, slots.getStats().dropped);
+
+  // Messages keep the order their objects first arrived in
+  auto messages = slots.take();
+  ASSERT_EQ(2u, messages.size());
+  ASSERT_EQ("a2", messages[0].msg->data);
+  ASSERT_EQ(rclcpp::Time(2, 0), messages[0].receipt_time);
+  ASSERT_EQ("b1", messages[1].msg->data);
+  ASSERT_TRUE(slots.empty());
+  ASSERT_EQ(2u, slots.getStats().converted);
+
+  // Taking the messages frees the slots
+  ASSERT_TRUE(slots.insert(9, make_msg("c2"), receipt_time));
+  slots.clear();
+  ASSERT_TRUE(slots.empty());
+  ASSERT_EQ(2u, slots.getStats().converted);
+}
+
+TEST(MotionComputationWorker, CoalesceMobilityPaths)
+{
+  auto node = std::make_shared<rclcpp::Node>("test_node");
+
+  carma_perception_msgs::msg::ExternalObjectList published;
+  MotionComputationWorker mcw(
+    [&](const carma_perception_msgs::msg::ExternalObjectList & obj_pub) { published = obj_pub; },
+    node->get_node_logging_interface(), node->get_node_clock_interface());
+
+  mcw.setDetectionInputFlags(false, false, false, true);  // MOBILITY_PATH_ONLY
+  mcw.setMaxV2XObjects(2);
+
+  // 1 to 1 transform
+  auto georeference_ptr = std::make_unique<std_msgs::msg::String>();
+  georeference_ptr->data = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
+  mcw.georeferenceCallback(move(georeference_ptr));
+
+  carma_v2x_msgs::msg::MobilityPath path;
+  path.m_header.sender_bsm_id = "FFFFFFFF";
+  path.m_header.timestamp = 1000;
+  carma_v2x_msgs::msg::LocationOffsetECEF offset;
+  offset.offset_x = 100;
+  for (size_t i = 0; i < 20; i++) {
+    path.trajectory.offsets.push_back(offset);
+  }
+
+  // Three paths from one vehicle, one from a second and one from a third which does not fit
+  for (int32_t ecef_x : {100, 200, 300}) {
+    path.m_header.sender_id = "veh_1";
+    path.trajectory.location.ecef_x = ecef_x;
+    mcw.mobilityPathCallback(std::make_unique<carma_v2x_msgs::msg::MobilityPath>(path));
+  }
+  path.m_header.sender_id = "veh_2";
+  mcw.mobilityPathCallback(std::make_unique<carma_v2x_msgs::msg::MobilityPath>(path));
+  path.m_header.sender_id = "veh_3";
+  mcw.mobilityPathCallback(std::make_unique<carma_v2x_msgs::msg::MobilityPath>(path));
+
+  // Nothing is converted before the sensor frame arrives
+  ASSERT_EQ(0u, mcw.getMobilityPathStats().converted);
+
+  auto obj_list = std::make_unique<carma_perception_msgs::msg::ExternalObjectList>();
+  obj_list->header.stamp = rclcpp::Time(1.0 * 1e9);
+  mcw.predictionLogic(move(obj_list));
+
+  ASSERT_EQ(2u, published.objects.size());
+  ASSERT_NEAR(3.0, published.objects[0].pose.pose.position.x, 0.01);  // Latest path of veh_1
+
+  const auto & stats = mcw.getMobilityPathStats();
+  ASSERT_EQ(4u, stats.received);
+  ASSERT_EQ(2u, stats.coalesced);
+  ASSERT_EQ(1u, stats.dropped);
+  ASSERT_EQ(2u, stats.converted);
+
+  // Slots are emptied by each sensor frame
+  obj_list = std::make_unique<carma_perception_msgs::msg::ExternalObjectList>();
+  mcw.predictionLogic(move(obj_list));
+  ASSERT_EQ(0u, published.objects.size());
+}
+
+TEST(MotionComputationWorker, PredictionLogicThreadCounts)
+{
+  auto node = std::make_shared<rclcpp::Node>("test_node");
+
+  // 200 sensed objects of mixed types and 100 mobility paths
+  constexpr size_t sensor_object_count = 200;
+  constexpr size_t mobility_path_count = 100;
+
+  carma_perception_msgs::msg::ExternalObjectList published;
+  MotionComputationWorker mcw(
+    [&](const carma_perception_msgs::msg::ExternalObjectList & obj_pub) { published = obj_pub; },
+    node->get_node_logging_interface(), node->get_node_clock_interface());
+
+  mcw.setDetectionInputFlags(true, false, false, true);  // enable sensors and paths
+  mcw.setPredictionTimeStep(0.2);
+  mcw.setPredictionPeriod(10.0);
+
+  // 1 to 1 transform
+  auto georeference_ptr = std::make_unique<std_msgs::msg::String>();
+  georeference_ptr->data = lanelet::projection::LocalFrameProjector::ECEF_PROJ_STR;
+  mcw.georeferenceCallback(move(georeference_ptr));
+
+  carma_perception_msgs::msg::ExternalObjectList sensor_list;
+  sensor_list.header.stamp = rclcpp::Time(1.6 * 1e9);
+  const std::array<uint8_t, 4> object_types = {
+    carma_perception_msgs::msg::ExternalObject::SMALL_VEHICLE,
+    carma_perception_msgs::msg::ExternalObject::PEDESTRIAN,
+    carma_perception_msgs::msg::ExternalObject::MOTORCYCLE,
+    carma_perception_msgs::msg::ExternalObject::UNKNOWN};
+
+  for (size_t i = 0; i < sensor_object_count; i++) {
+    carma_perception_msgs::msg::ExternalObject obj;
+    obj.header.stamp = sensor_list.header.stamp;
+    obj.id = i;
+    obj.object_type = object_types[i % object_types.size()];
+    obj.pose.pose.position.x = static_cast<double>(i);
+    obj.pose.pose.position.y = static_cast<double>(i % 7);
+    obj.pose.pose.orientation.w = 1;
+    obj.velocity.twist.linear.x = 5.0 + static_cast<double>(i % 10);
+    obj.velocity.twist.angular.z = 0.01 * static_cast<double>(i % 5);
+    sensor_list.objects.push_back(obj);
+  }
+
+  std::vector<carma_v2x_msgs::msg::MobilityPath> mobility_paths;
+  for (size_t i = 0; i < mobility_path_count; i++) {
+    carma_v2x_msgs::msg::MobilityPath path;
+    path.m_header.sender_id = "veh_" + std::to_string(i);
+    path.m_header.sender_bsm_id = "FFFFFFFF";
+    path.m_header.timestamp = 1000;
+    path.trajectory.location.ecef_x = 100 * static_cast<int32_t>(i);
+    path.trajectory.location.ecef_y = 0;
+    path.trajectory.location.ecef_z = 0;
+
+    carma_v2x_msgs::msg::LocationOffsetECEF offset;
+    offset.offset_x = 100;
+    for (size_t j = 0; j < 60; j++) {
+      path.trajectory.offsets.push_back(offset);
+    }
+    mobility_paths.push_back(path);
+  }
+
+  constexpr size_t cycles = 3;
+
+  // The objects published for each cycle with a single prediction thread
+  std::vector<carma_perception_msgs::msg::ExternalObjectList> single_thread_results;
+
+  for (size_t max_threads : {1u, 4u}) {
+    mcw.setMaxPredictionThreads(max_threads);
+
+    for (size_t i = 0; i < cycles; i++) {
+      for (const auto & path : mobility_paths) {
+        mcw.mobilityPathCallback(std::make_unique<carma_v2x_msgs::msg::MobilityPath>(path));
+      }
+
+      mcw.predictionLogic(
+        std::make_unique<carma_perception_msgs::msg::ExternalObjectList>(sensor_list));
+
+      ASSERT_EQ(published.objects.size(), sensor_object_count + mobility_path_count);
+      for (const auto & obj : published.objects) {
+        ASSERT_FALSE(obj.predictions.empty()) << "object " << obj.id;
+      }
+
+      if (max_threads == 1) {
+        single_thread_results.push_back(published);
+        continue;
+      }
+
+      // Predicting in parallel publishes the same objects in the same order with the same predictions
+      const auto & expected = single_thread_results[i];
+      for (size_t j = 0; j < expected.objects.size(); j++) {
+        const auto & expected_obj = expected.objects[j];
+        const auto & obj = published.objects[j];
+        ASSERT_EQ(expected_obj.id, obj.id) << "index " << j;
+        ASSERT_EQ(expected_obj.predictions.size(), obj.predictions.size()) << "object " << obj.id;
+        for (size_t k = 0; k < expected_obj.predictions.size(); k++) {
+          ASSERT_NEAR(
+            expected_obj.predictions[k].predicted_position.position.x,
+            obj.predictions[k].predicted_position.position.x, 0.000001);
+          ASSERT_NEAR(
+            expected_obj.predictions[k].predicted_position.position.y,
+            obj.predictions[k].predicted_position.position.y, 0.000001);
+        }
+      }
+    }
+  }
+}
+}
+
 }  // namespace motion_computation
@@ -16,6 +16,8 @@
  */
 
 #include <unordered_map>
+#include <vector>
+#include <chrono>
 #include <math.h>
 #include <rclcpp/rclcpp.hpp>
 #include <gtest/gtest_prod.h>
@@ -78,6 +80,8 @@ namespace plan_delegator
         double duration_to_signal_before_lane_change = 2.5; // (Seconds) If an upcoming lane change will begin in under this time threshold, a turn signal activation command will be published.
         int tactical_plugin_service_call_timeout = 100; // (Milliseconds) The maximum duration that Plan Delegator will wait after calling a tactical plugin's trajectory planning service; if trajectory 
                                                         // generation takes longer than this, then planning will immediately end for the current trajectory planning iteration.
+        bool enable_pipelined_trajectory_planning = false; // If true, trajectory planning requests for the maneuvers of a plan are dispatched concurrently, each seeded with
+                                                           // the planned start state of its maneuver, and the resulting trajectories are stitched in maneuver order.
         
         // Stream operator for this config
         friend std::ostream &operator<<(std::ostream &output, const Config &c)
@@ -89,6 +93,8 @@ namespace plan_delegator
             << "max_trajectory_duration: " << c.max_trajectory_duration << std::endl
             << "min_crawl_speed: " << c.min_crawl_speed << std::endl
             << "duration_to_signal_before_lane_change: " << c.duration_to_signal_before_lane_change << std::endl
+            << "tactical_plugin_service_call_timeout: " << c.tactical_plugin_service_call_timeout << std::endl
+            << "enable_pipelined_trajectory_planning: " << c.enable_pipelined_trajectory_planning << std::endl
             << "}" << std::endl;
         return output;
         }
@@ -102,6 +108,17 @@ namespace plan_delegator
         double starting_downtrack;  // The starting downtrack of the lane change
         bool is_right_lane_change;  // Flag to indicate whether lane change is a right lane change; false if it is a left lane change
     };
+
+    /**
+     * \brief Convenience struct for accumulating the end-to-end timing of trajectory planning ticks.
+     */
+    struct TrajPlanTickTiming
+    {
+        size_t ticks = 0;           // Number of ticks since the last timing summary
+        double total_ms = 0.0;      // Summed tick duration since the last timing summary (ms)
+        double max_ms = 0.0;        // Longest tick since the last timing summary (ms)
+        size_t service_calls = 0;   // Number of tactical plugin service calls since the last timing summary
+    };
     
     class PlanDelegator : public carma_ros2_utils::CarmaLifecycleNode
     {
@@ -152,6 +169,27 @@ namespace plan_delegator
              */
             std::shared_ptr<carma_planning_msgs::srv::PlanTrajectory::Request> composePlanTrajectoryRequest(const carma_planning_msgs::msg::TrajectoryPlan& latest_trajectory_plan, const uint16_t& current_maneuver_index) const;
 
+            /**
+             * \brief Generate new PlanTrajecory service request for a maneuver using the maneuver's planned starting state
+             * (start_dist, start_speed, start_time) instead of the output of the preceding tactical plugin. Used by the
+             * pipelined planning mode so that requests for several maneuvers can be in flight at once.
+             * \param maneuver_index The index of the maneuver in latest_maneuver_plan_ to plan
+             * \return a PlanTrajectoryRequest, or nullptr if the maneuver start could not be located on the route
+             */
+            std::shared_ptr<carma_planning_msgs::srv::PlanTrajectory::Request> composeManeuverStartRequest(uint16_t maneuver_index) const;
+
+            /**
+             * \brief Append a trajectory segment returned by a tactical plugin to a trajectory plan. When a route is loaded, leading segment
+             * points which are not ahead of the last point of the plan in route downtrack are dropped, so a segment planned from its maneuver
+             * start does not jump backwards when the previous segment ran past that start. Without a route, leading points which do not come
+             * after the last point of the plan in time are dropped instead. The appended points are shifted in time so the first of them is
+             * reached from the last point of the plan at the mean of the speeds on either side of the boundary.
+             * \param latest_trajectory_plan The trajectory plan to extend
+             * \param segment The trajectory returned by the tactical plugin
+             * \return The number of points appended
+             */
+            size_t stitchTrajectorySegment(carma_planning_msgs::msg::TrajectoryPlan& latest_trajectory_plan, const carma_planning_msgs::msg::TrajectoryPlan& segment) const;
+
             /**
              * \brief Lookup transfrom from front bumper to base link
              */
@@ -220,6 +258,18 @@ namespace plan_delegator
             // The latest turn signal command published to turn_signal_command_pub_.
             autoware_msgs::msg::LampCmd latest_turn_signal_command_;
 
+            // Number of tactical plugin service calls made during the latest trajectory planning iteration
+            size_t last_service_call_count_ = 0;
+
+            // Index of the last maneuver covered by the latest trajectory planned for each maneuver of the plan with id
+            // covered_maneuvers_plan_id_. Lets pipelined planning skip requests for maneuvers a plugin plans together with an earlier one
+            std::unordered_map<uint16_t, uint16_t> covered_maneuvers_;
+            std::string covered_maneuvers_plan_id_;
+
+            // Accumulated timing of onTrajPlanTick, summarized to the log every TICK_TIMING_LOG_PERIOD ticks
+            TrajPlanTickTiming tick_timing_;
+            static constexpr size_t TICK_TIMING_LOG_PERIOD = 100;
+
             /**
              * \brief Callback function for triggering trajectory planning
              */
@@ -249,6 +299,14 @@ namespace plan_delegator
              */
             carma_planning_msgs::msg::TrajectoryPlan planTrajectory();
 
+            /**
+             * \brief Plan trajectory based on latest maneuver plan by dispatching the service requests of all maneuvers within the
+             * trajectory horizon concurrently and stitching the responses in maneuver order
+             * \param current_downtrack The current downtrack of the vehicle along the route
+             * \return a TrajectoryPlan object which contains PlanTrajectory response from plugins
+             */
+            carma_planning_msgs::msg::TrajectoryPlan planTrajectoryPipelined(double current_downtrack);
+
             /**
              * \brief Function for generating a LaneChangeInformation object from a provided lane change maneuver.
              * \param lane_change_maneuver The lane change maneuver that a LaneChangeInformation object shall be generated from.
@@ -283,5 +341,7 @@ namespace plan_delegator
             FRIEND_TEST(TestPlanDelegator, TestPlanDelegator);
             FRIEND_TEST(TestPlanDelegator, TestLaneChangeInformation);
             FRIEND_TEST(TestPlanDelegator, TestUpcomingLaneChangeAndTurnSignals);
+            FRIEND_TEST(TestPlanDelegator, TestPipelinedPlanningHelpers);
+            FRIEND_TEST(TestPlanDelegator, TestPipelinedPlanningEndToEnd);
     };
 }
\ No newline at end of file
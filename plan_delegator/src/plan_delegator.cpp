@@ -15,6 +15,8 @@
  */
 
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 #include <carma_wm/Geometry.hpp>
 #include "plan_delegator.hpp"
 
@@ -143,6 +145,7 @@ namespace plan_delegator
         config_.min_crawl_speed = declare_parameter<double>("min_speed", config_.min_crawl_speed);
         config_.duration_to_signal_before_lane_change = declare_parameter<double>("duration_to_signal_before_lane_change", config_.duration_to_signal_before_lane_change);
         config_.tactical_plugin_service_call_timeout = declare_parameter<int>("tactical_plugin_service_call_timeout", config_.tactical_plugin_service_call_timeout);
+        config_.enable_pipelined_trajectory_planning = declare_parameter<bool>("enable_pipelined_trajectory_planning", config_.enable_pipelined_trajectory_planning);
     }
 
     carma_ros2_utils::CallbackReturn PlanDelegator::handle_on_configure(const rclcpp_lifecycle::State &)
@@ -157,6 +160,7 @@ namespace plan_delegator
         get_parameter<double>("min_speed", config_.min_crawl_speed);
         get_parameter<double>("duration_to_signal_before_lane_change", config_.duration_to_signal_before_lane_change);
         get_parameter<int>("tactical_plugin_service_call_timeout", config_.tactical_plugin_service_call_timeout);
+        get_parameter<bool>("enable_pipelined_trajectory_planning", config_.enable_pipelined_trajectory_planning);
 
         RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Done loading parameters: " << config_);
 
@@ -452,6 +456,133 @@ namespace plan_delegator
         return plan_req;
     }
 
+    std::shared_ptr<carma_planning_msgs::srv::PlanTrajectory::Request> PlanDelegator::composeManeuverStartRequest(uint16_t maneuver_index) const
+    {
+        const auto& maneuver = latest_maneuver_plan_.maneuvers[maneuver_index];
+
+        double start_dist = GET_MANEUVER_PROPERTY(maneuver, start_dist);
+        auto start_point = wm_->pointFromRouteTrackPos(carma_wm::TrackPos(start_dist, 0.0));
+        if (!start_point)
+        {
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"), "Could not locate start of maneuver " << maneuver_index << " at downtrack " << start_dist << " on the route");
+            return nullptr;
+        }
+
+        auto plan_req = std::make_shared<carma_planning_msgs::srv::PlanTrajectory::Request>();
+        plan_req->maneuver_plan = latest_maneuver_plan_;
+        plan_req->header.stamp = GET_MANEUVER_PROPERTY(maneuver, start_time);
+        plan_req->vehicle_state.x_pos_global = start_point->x();
+        plan_req->vehicle_state.y_pos_global = start_point->y();
+        plan_req->vehicle_state.longitudinal_vel = GET_MANEUVER_PROPERTY(maneuver, start_speed);
+        plan_req->maneuver_index_to_plan = maneuver_index;
+
+        // Approximate the heading at the maneuver start from the route direction
+        auto ahead_point = wm_->pointFromRouteTrackPos(carma_wm::TrackPos(start_dist + 1.0, 0.0));
+        if (ahead_point)
+        {
+            plan_req->vehicle_state.orientation = std::atan2(ahead_point->y() - start_point->y(), ahead_point->x() - start_point->x());
+        }
+
+        return plan_req;
+    }
+
+    namespace
+    {
+        // Below this speed in m/s the boundary between stitched segments is timed with the time step of the new segment instead
+        constexpr double MIN_BOUNDARY_SPEED = 0.1;
+
+        // Smallest time step in seconds between the last point of a trajectory and the first point stitched to it
+        constexpr double MIN_BOUNDARY_TIME_STEP = 0.01;
+
+        // Average speed between two trajectory points, or 0 if the second point does not come after the first in time
+        double pointToPointSpeed(const carma_planning_msgs::msg::TrajectoryPlanPoint& from, const carma_planning_msgs::msg::TrajectoryPlanPoint& to)
+        {
+            double time_diff = (rclcpp::Time(to.target_time) - rclcpp::Time(from.target_time)).seconds();
+            if (time_diff <= 0)
+            {
+                return 0;
+            }
+            return std::hypot(to.x - from.x, to.y - from.y) / time_diff;
+        }
+    }
+
+    size_t PlanDelegator::stitchTrajectorySegment(carma_planning_msgs::msg::TrajectoryPlan& latest_trajectory_plan, const carma_planning_msgs::msg::TrajectoryPlan& segment) const
+    {
+        if (latest_trajectory_plan.trajectory_points.empty())
+        {
+            latest_trajectory_plan.trajectory_points = segment.trajectory_points;
+            return segment.trajectory_points.size();
+        }
+
+        const auto last_point = latest_trajectory_plan.trajectory_points.back();
+        auto first_new_point = segment.trajectory_points.begin();
+
+        if (wm_ && wm_->getRoute())
+        {
+            // Segments planned from their maneuver start may begin behind where the previous segment ended.
+            // The points are visited in order along the route so a cursor avoids a full search for each of them
+            carma_wm::RouteTrackPosCursor cursor;
+            double last_downtrack = wm_->routeTrackPos(lanelet::BasicPoint2d(last_point.x, last_point.y), cursor).downtrack;
+            while (first_new_point != segment.trajectory_points.end()
+                && wm_->routeTrackPos(lanelet::BasicPoint2d(first_new_point->x, first_new_point->y), cursor).downtrack <= last_downtrack)
+            {
+                ++first_new_point;
+            }
+        }
+        else
+        {
+            rclcpp::Time last_time(last_point.target_time);
+            while (first_new_point != segment.trajectory_points.end() && rclcpp::Time(first_new_point->target_time) <= last_time)
+            {
+                ++first_new_point;
+            }
+        }
+
+        if (first_new_point == segment.trajectory_points.end())
+        {
+            return 0;
+        }
+
+        // The segment was timed from the planned start of its maneuver rather than from where the trajectory ends. It is shifted in
+        // time so that its first point is reached from the last point of the trajectory at the mean of the speeds on either side of
+        // the boundary, which keeps both time and speed continuous across segments
+        double previous_speed = 0;
+        if (latest_trajectory_plan.trajectory_points.size() > 1)
+        {
+            previous_speed = pointToPointSpeed(*(latest_trajectory_plan.trajectory_points.rbegin() + 1), last_point);
+        }
+
+        double segment_speed = 0;
+        double segment_step = 0;
+        auto neighbor_point = first_new_point == segment.trajectory_points.begin() ? std::next(first_new_point) : std::prev(first_new_point);
+        if (neighbor_point != segment.trajectory_points.end())
+        {
+            const auto& from = neighbor_point < first_new_point ? *neighbor_point : *first_new_point;
+            const auto& to = neighbor_point < first_new_point ? *first_new_point : *neighbor_point;
+            segment_speed = pointToPointSpeed(from, to);
+            segment_step = (rclcpp::Time(to.target_time) - rclcpp::Time(from.target_time)).seconds();
+        }
+
+        double boundary_speed = previous_speed > 0 && segment_speed > 0 ? (previous_speed + segment_speed) / 2.0 : std::max(previous_speed, segment_speed);
+        double boundary_distance = std::hypot(first_new_point->x - last_point.x, first_new_point->y - last_point.y);
+        double boundary_time = boundary_speed > MIN_BOUNDARY_SPEED ? boundary_distance / boundary_speed : segment_step;
+        boundary_time = std::max(boundary_time, MIN_BOUNDARY_TIME_STEP);
+
+        rclcpp::Time first_new_time = rclcpp::Time(last_point.target_time) + rclcpp::Duration::from_seconds(boundary_time);
+        rclcpp::Duration time_shift = first_new_time - rclcpp::Time(first_new_point->target_time);
+
+        size_t appended = std::distance(first_new_point, segment.trajectory_points.end());
+        latest_trajectory_plan.trajectory_points.reserve(latest_trajectory_plan.trajectory_points.size() + appended);
+        for (auto it = first_new_point; it != segment.trajectory_points.end(); ++it)
+        {
+            carma_planning_msgs::msg::TrajectoryPlanPoint point = *it;
+            point.target_time = rclcpp::Time(point.target_time) + time_shift;
+            latest_trajectory_plan.trajectory_points.push_back(point);
+        }
+
+        return appended;
+    }
+
     bool PlanDelegator::isTrajectoryLongEnough(const carma_planning_msgs::msg::TrajectoryPlan& plan) const noexcept
     {
         rclcpp::Duration time_diff = rclcpp::Time(plan.trajectory_points.back().target_time) - rclcpp::Time(plan.trajectory_points.front().target_time);
@@ -580,12 +711,45 @@ namespace plan_delegator
     carma_planning_msgs::msg::TrajectoryPlan PlanDelegator::planTrajectory()
     {
         carma_planning_msgs::msg::TrajectoryPlan latest_trajectory_plan;
+        last_service_call_count_ = 0;
         if(!guidance_engaged)
         {
             RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Guidance is not engaged. Plan delegator will not plan trajectory.");
             return latest_trajectory_plan;
         }
 
+        // Without maneuvers there is nothing to plan, and the vehicle downtrack may not be computable yet
+        if(latest_maneuver_plan_.maneuvers.empty())
+        {
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"No maneuver plan received yet. Plan delegator will not plan trajectory.");
+            return latest_trajectory_plan;
+        }
+
+        if(!wm_->getRoute())
+        {
+            RCLCPP_WARN_STREAM(rclcpp::get_logger("plan_delegator"),"Route has not yet been loaded. Plan delegator will not plan trajectory.");
+            return latest_trajectory_plan;
+        }
+
+        // The vehicle does not move while planning, so its downtrack only needs to be computed once
+        lanelet::BasicPoint2d current_loc(latest_pose_.pose.position.x, latest_pose_.pose.position.y);
+        double current_downtrack = 0;
+        try
+        {
+            current_downtrack = wm_->routeTrackPos(current_loc).downtrack;
+        }
+        catch(const std::invalid_argument& e)
+        {
+            RCLCPP_WARN_STREAM(rclcpp::get_logger("plan_delegator"),"Could not compute vehicle downtrack: " << e.what() << ". Plan delegator will not plan trajectory.");
+            return latest_trajectory_plan;
+        }
+        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"current_downtrack" << current_downtrack);
+
+        if (config_.enable_pipelined_trajectory_planning)
+        {
+            return planTrajectoryPipelined(current_downtrack);
+        }
+
         // Flag for the first received trajectory plan service response
         bool first_trajectory_plan = true;
 
@@ -606,9 +770,6 @@ namespace plan_delegator
                 ++current_maneuver_index;
                 continue;
             }
-            lanelet::BasicPoint2d current_loc(latest_pose_.pose.position.x, latest_pose_.pose.position.y);
-            double current_downtrack = wm_->routeTrackPos(current_loc).downtrack;
-            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"current_downtrack" << current_downtrack);
             double maneuver_end_dist = GET_MANEUVER_PROPERTY(maneuver, end_dist);
             RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"maneuver_end_dist" << maneuver_end_dist);
 
@@ -633,6 +794,7 @@ namespace plan_delegator
             auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan, current_maneuver_index);
 
             auto plan_response = client->async_send_request(plan_req);
+            ++last_service_call_count_;
 
             auto future_status = plan_response.wait_for(std::chrono::milliseconds(config_.tactical_plugin_service_call_timeout));
 
@@ -691,10 +853,161 @@ namespace plan_delegator
         return latest_trajectory_plan;
     }
 
+    carma_planning_msgs::msg::TrajectoryPlan PlanDelegator::planTrajectoryPipelined(double current_downtrack)
+    {
+        carma_planning_msgs::msg::TrajectoryPlan latest_trajectory_plan;
+
+        struct PendingRequest
+        {
+            uint16_t maneuver_index;
+            std::string planner;
+            std::shared_future<std::shared_ptr<carma_planning_msgs::srv::PlanTrajectory::Response>> response; // Not valid if the request was deferred
+        };
+        std::vector<PendingRequest> pending;
+
+        // The maneuvers each plugin covered are only known for the maneuver plan they were recorded for
+        if (covered_maneuvers_plan_id_ != latest_maneuver_plan_.maneuver_plan_id)
+        {
+            covered_maneuvers_.clear();
+            covered_maneuvers_plan_id_ = latest_maneuver_plan_.maneuver_plan_id;
+        }
+
+        // Dispatch a request for every maneuver that starts within the trajectory horizon. The first maneuver is planned from the
+        // current vehicle state and every following one from its planned start state, so none of them wait on another plugin.
+        // Maneuvers which the previous planning iteration found covered by the response for an earlier maneuver are deferred, and
+        // only requested if that response no longer covers them.
+        boost::optional<rclcpp::Time> horizon_start;
+        int expected_covered_maneuver = -1;
+        for (uint16_t i = 0; i < latest_maneuver_plan_.maneuvers.size(); ++i)
+        {
+            const auto& maneuver = latest_maneuver_plan_.maneuvers[i];
+
+            // ignore expired maneuvers
+            if(isManeuverExpired(maneuver, get_clock()->now()))
+            {
+                RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Dropping expired maneuver: " << GET_MANEUVER_PROPERTY(maneuver, parameters.maneuver_id));
+                continue;
+            }
+
+            // ignore maneuver that is passed.
+            if (current_downtrack > GET_MANEUVER_PROPERTY(maneuver, end_dist))
+            {
+                RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Dropping passed maneuver: " << GET_MANEUVER_PROPERTY(maneuver, parameters.maneuver_id));
+                continue;
+            }
+
+            rclcpp::Time maneuver_start(GET_MANEUVER_PROPERTY(maneuver, start_time));
+            if (horizon_start && (maneuver_start - *horizon_start).seconds() >= config_.max_trajectory_duration)
+            {
+                break;
+            }
+
+            std::string maneuver_planner = GET_MANEUVER_PROPERTY(maneuver, parameters.planning_tactical_plugin);
+
+            if (static_cast<int>(i) <= expected_covered_maneuver)
+            {
+                RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Deferring maneuver " << i << " which is expected to be covered by a previous trajectory");
+                pending.push_back({i, maneuver_planner, {}});
+                continue;
+            }
+
+            auto plan_req = pending.empty() ? composePlanTrajectoryRequest(latest_trajectory_plan, i) : composeManeuverStartRequest(i);
+            if (!plan_req)
+            {
+                // Following maneuvers can only be planned once this one has been, which the next planning iteration will do
+                break;
+            }
+
+            if (!horizon_start)
+            {
+                horizon_start = maneuver_start;
+            }
+
+            auto client = getPlannerClientByName(maneuver_planner);
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Dispatching maneuver " << i << " to planner: " << maneuver_planner);
+
+            pending.push_back({i, maneuver_planner, client->async_send_request(plan_req)});
+            ++last_service_call_count_;
+
+            auto covered = covered_maneuvers_.find(i);
+            if (covered != covered_maneuvers_.end())
+            {
+                expected_covered_maneuver = std::max<int>(expected_covered_maneuver, covered->second);
+            }
+        }
+
+        // All requests share one deadline since they are processed concurrently
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config_.tactical_plugin_service_call_timeout);
+
+        // Stitch the responses in maneuver order. Maneuvers already covered by an earlier response are skipped.
+        bool first_trajectory_plan = true;
+        int last_covered_maneuver = -1;
+        for (auto& request : pending)
+        {
+            if (static_cast<int>(request.maneuver_index) <= last_covered_maneuver)
+            {
+                RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Maneuver " << request.maneuver_index << " already covered by a previous trajectory");
+                continue;
+            }
+
+            if (!request.response.valid())
+            {
+                // The earlier response did not cover this maneuver after all, so it is planned from where the trajectory ends
+                RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Dispatching deferred maneuver " << request.maneuver_index << " to planner: " << request.planner);
+                auto plan_req = composePlanTrajectoryRequest(latest_trajectory_plan, request.maneuver_index);
+                request.response = getPlannerClientByName(request.planner)->async_send_request(plan_req);
+                ++last_service_call_count_;
+            }
+
+            if (request.response.wait_until(deadline) != std::future_status::ready)
+            {
+                RCLCPP_WARN_STREAM(rclcpp::get_logger("plan_delegator"),"Unsuccessful service call to trajectory planner:" << request.planner << " for plan ID " << std::string(latest_maneuver_plan_.maneuver_plan_id));
+                // if one service call fails, it should end plan immediately because it is there is no point to generate plan with empty space
+                break;
+            }
+
+            const auto& segment = request.response.get()->trajectory_plan;
+
+            // validate trajectory before add to the plan
+            if(!isTrajectoryValid(segment))
+            {
+                RCLCPP_WARN_STREAM(rclcpp::get_logger("plan_delegator"),"Found invalid trajectory with less than 2 trajectory points for " << std::string(latest_maneuver_plan_.maneuver_plan_id));
+                break;
+            }
+
+            size_t appended = stitchTrajectorySegment(latest_trajectory_plan, segment);
+            RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Appended " << appended << " points from planner: " << request.planner << ", new latest_trajectory_plan size: " << latest_trajectory_plan.trajectory_points.size());
+
+            // Assign the trajectory plan's initial longitudinal velocity based on the first tactical plugin's response
+            if(first_trajectory_plan)
+            {
+                latest_trajectory_plan.initial_longitudinal_velocity = segment.initial_longitudinal_velocity;
+                first_trajectory_plan = false;
+            }
+
+            // inlanecruising_plugin can plan a trajectory over contiguous LANE_FOLLOWING maneuvers
+            const auto& related_maneuvers = request.response.get()->related_maneuvers;
+            last_covered_maneuver = related_maneuvers.empty() ? request.maneuver_index : std::max<int>(request.maneuver_index, related_maneuvers.back());
+            covered_maneuvers_[request.maneuver_index] = static_cast<uint16_t>(last_covered_maneuver);
+
+            if(isTrajectoryLongEnough(latest_trajectory_plan))
+            {
+                RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Plan Trajectory completed for " << std::string(latest_maneuver_plan_.maneuver_plan_id));
+                break;
+            }
+        }
+
+        return latest_trajectory_plan;
+    }
+
     void PlanDelegator::onTrajPlanTick()
     {
+        auto tick_start = std::chrono::steady_clock::now();
+
         carma_planning_msgs::msg::TrajectoryPlan trajectory_plan = planTrajectory();
 
+        auto planning_end = std::chrono::steady_clock::now();
+
         // Check if planned trajectory is valid before send out
         if(isTrajectoryValid(trajectory_plan))
         {
@@ -705,6 +1018,27 @@ namespace plan_delegator
         {
             RCLCPP_WARN_STREAM(rclcpp::get_logger("plan_delegator"),"Planned trajectory is empty. It will not be published!");
         }
+
+        auto tick_end = std::chrono::steady_clock::now();
+        double planning_ms = std::chrono::duration<double, std::milli>(planning_end - tick_start).count();
+        double tick_ms = std::chrono::duration<double, std::milli>(tick_end - tick_start).count();
+
+        RCLCPP_DEBUG_STREAM(rclcpp::get_logger("plan_delegator"),"Trajectory planning tick took " << tick_ms << " ms (planning: " << planning_ms
+            << " ms) with " << last_service_call_count_ << " tactical plugin calls");
+
+        tick_timing_.ticks++;
+        tick_timing_.total_ms += tick_ms;
+        tick_timing_.max_ms = std::max(tick_timing_.max_ms, tick_ms);
+        tick_timing_.service_calls += last_service_call_count_;
+
+        if (tick_timing_.ticks >= TICK_TIMING_LOG_PERIOD)
+        {
+            RCLCPP_INFO_STREAM(rclcpp::get_logger("plan_delegator"),"Trajectory planning over last " << tick_timing_.ticks << " ticks: mean "
+                << tick_timing_.total_ms / tick_timing_.ticks << " ms, max " << tick_timing_.max_ms << " ms, mean tactical plugin calls per tick "
+                << static_cast<double>(tick_timing_.service_calls) / tick_timing_.ticks
+                << (config_.enable_pipelined_trajectory_planning ? " (pipelined)" : " (sequential)"));
+            tick_timing_ = TrajPlanTickTiming();
+        }
     }
 
     void PlanDelegator::lookupFrontBumperTransform()
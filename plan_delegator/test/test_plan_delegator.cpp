@@ -14,6 +14,7 @@
  * the License.
  */
 
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <carma_planning_msgs/msg/maneuver_plan.hpp>
@@ -372,6 +373,235 @@ namespace plan_delegator{
         ASSERT_EQ(pd->latest_turn_signal_command_.l, 0);
     }
 
+    TEST(TestPlanDelegator, TestPipelinedPlanningHelpers)
+    {
+        rclcpp::NodeOptions node_options;
+        auto pd = std::make_shared<plan_delegator::PlanDelegator>(node_options);
+
+        // Use Guidance Lib to create map
+        std::shared_ptr<carma_wm::CARMAWorldModel> cmw = std::make_shared<carma_wm::CARMAWorldModel>();
+        lanelet::LaneletMapPtr map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+        cmw->carma_wm::CARMAWorldModel::setMap(map);
+        carma_wm::test::setRouteByIds({1210, 1213}, cmw);
+        pd->wm_ = cmw;
+
+        carma_planning_msgs::msg::ManeuverPlan plan;
+        carma_planning_msgs::msg::Maneuver maneuver;
+        maneuver.type = maneuver.LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.parameters.planning_tactical_plugin = "plugin_A";
+        maneuver.lane_following_maneuver.start_dist = 0;
+        maneuver.lane_following_maneuver.end_dist = 30;
+        maneuver.lane_following_maneuver.start_speed = 5.0;
+        maneuver.lane_following_maneuver.start_time = rclcpp::Time(0, 0);
+        plan.maneuvers.push_back(maneuver);
+
+        maneuver.lane_following_maneuver.start_dist = 30;
+        maneuver.lane_following_maneuver.end_dist = 60;
+        maneuver.lane_following_maneuver.start_speed = 7.0;
+        maneuver.lane_following_maneuver.start_time = rclcpp::Time(5, 0);
+        plan.maneuvers.push_back(maneuver);
+
+        maneuver.lane_following_maneuver.start_dist = 500; // Past the end of the route
+        maneuver.lane_following_maneuver.end_dist = 530;
+        plan.maneuvers.push_back(maneuver);
+
+        pd->latest_maneuver_plan_ = plan;
+
+        // A request seeded from the planned start state of the second maneuver
+        auto req = pd->composeManeuverStartRequest(1);
+        ASSERT_TRUE(!!req);
+        EXPECT_EQ(1, req->maneuver_index_to_plan);
+        EXPECT_NEAR(7.0, req->vehicle_state.longitudinal_vel, 0.0001);
+        EXPECT_NEAR(5.0, rclcpp::Time(req->header.stamp).seconds(), 0.0001);
+        EXPECT_NEAR(30.0, cmw->routeTrackPos(lanelet::BasicPoint2d(req->vehicle_state.x_pos_global, req->vehicle_state.y_pos_global)).downtrack, 0.1);
+        EXPECT_NEAR(M_PI_2, req->vehicle_state.orientation, 0.05);
+
+        // The start of the third maneuver is not on the route
+        EXPECT_FALSE(!!pd->composeManeuverStartRequest(2));
+
+        // Stitching drops segment points that do not come after the end of the existing trajectory
+        carma_planning_msgs::msg::TrajectoryPlan traj_plan, segment;
+        for (int i = 0; i <= 5; i++)
+        {
+            carma_planning_msgs::msg::TrajectoryPlanPoint point;
+            point.y = i;
+            point.target_time = rclcpp::Time(i, 0);
+            traj_plan.trajectory_points.push_back(point);
+
+            point.y = i + 4;
+            point.target_time = rclcpp::Time(i + 4, 0);
+            segment.trajectory_points.push_back(point);
+        }
+
+        EXPECT_EQ(4u, pd->stitchTrajectorySegment(traj_plan, segment));
+        ASSERT_EQ(10u, traj_plan.trajectory_points.size());
+        for (size_t i = 0; i < traj_plan.trajectory_points.size(); i++)
+        {
+            EXPECT_NEAR(static_cast<double>(i), rclcpp::Time(traj_plan.trajectory_points[i].target_time).seconds(), 0.0001);
+        }
+
+        carma_planning_msgs::msg::TrajectoryPlan empty_plan;
+        EXPECT_EQ(segment.trajectory_points.size(), pd->stitchTrajectorySegment(empty_plan, segment));
+    }
+
+    TEST(TestPlanDelegator, TestPipelinedPlanningEndToEnd)
+    {
+        rclcpp::NodeOptions node_options;
+        auto pd = std::make_shared<plan_delegator::PlanDelegator>(node_options);
+        pd->config_.enable_pipelined_trajectory_planning = true;
+        pd->config_.tactical_plugin_service_call_timeout = 1000;
+        pd->guidance_engaged = true;
+
+        std::shared_ptr<carma_wm::CARMAWorldModel> cmw = std::make_shared<carma_wm::CARMAWorldModel>();
+        lanelet::LaneletMapPtr map = carma_wm::test::buildGuidanceTestMap(3.7, 25);
+        cmw->carma_wm::CARMAWorldModel::setMap(map);
+        pd->wm_ = cmw;
+
+        // Without a maneuver plan or a route nothing is planned, and the vehicle downtrack is not requested
+        EXPECT_TRUE(pd->planTrajectory().trajectory_points.empty());
+
+        // Lanelet 1210 is centered on x = 1.5 * 3.7 and the route runs along +y starting at y = 0
+        const double lane_center_x = 1.5 * 3.7;
+        rclcpp::Time start_time = pd->get_clock()->now();
+
+        carma_planning_msgs::msg::ManeuverPlan plan;
+        carma_planning_msgs::msg::Maneuver maneuver;
+        maneuver.type = maneuver.LANE_FOLLOWING;
+        maneuver.lane_following_maneuver.parameters.planning_tactical_plugin = "plugin_A";
+        maneuver.lane_following_maneuver.start_dist = 0;
+        maneuver.lane_following_maneuver.end_dist = 40;
+        maneuver.lane_following_maneuver.start_speed = 8.0;
+        maneuver.lane_following_maneuver.start_time = start_time;
+        maneuver.lane_following_maneuver.end_time = start_time + rclcpp::Duration(100, 0);
+        plan.maneuvers.push_back(maneuver);
+
+        maneuver.lane_following_maneuver.parameters.planning_tactical_plugin = "plugin_B";
+        maneuver.lane_following_maneuver.start_dist = 30;
+        maneuver.lane_following_maneuver.end_dist = 90;
+        maneuver.lane_following_maneuver.start_speed = 6.0;
+        maneuver.lane_following_maneuver.start_time = start_time + rclcpp::Duration(5, 0);
+        plan.maneuvers.push_back(maneuver);
+
+        pd->latest_maneuver_plan_ = plan;
+        EXPECT_TRUE(pd->planTrajectory().trajectory_points.empty());
+
+        carma_wm::test::setRouteByIds({1210, 1213}, cmw);
+
+        pd->latest_pose_.header.stamp = start_time;
+        pd->latest_pose_.pose.position.x = lane_center_x;
+        pd->latest_pose_.pose.position.y = 5.0;
+        pd->latest_twist_.twist.linear.x = 8.0;
+
+        // Each plugin plans along the lane center from the requested state at 1 second steps and reports the maneuvers from
+        // maneuver_index to last_related as covered.
+        // plugin_A runs past the start of the second maneuver, so plugin_B's segment starts behind the end of plugin_A's.
+        auto make_plugin = [&](const std::string& name, size_t point_count, uint16_t maneuver_index, std::shared_ptr<std::atomic<uint16_t>> last_related) {
+            auto node = std::make_shared<rclcpp::Node>(name);
+            auto srv = node->create_service<carma_planning_msgs::srv::PlanTrajectory>(
+                pd->config_.planning_topic_prefix + name + pd->config_.planning_topic_suffix,
+                [point_count, maneuver_index, last_related, lane_center_x](const std::shared_ptr<rmw_request_id_t>,
+                    carma_planning_msgs::srv::PlanTrajectory::Request::SharedPtr req,
+                    carma_planning_msgs::srv::PlanTrajectory::Response::SharedPtr res) {
+                    for (size_t i = 0; i < point_count; i++)
+                    {
+                        carma_planning_msgs::msg::TrajectoryPlanPoint point;
+                        point.x = lane_center_x;
+                        point.y = req->vehicle_state.y_pos_global + req->vehicle_state.longitudinal_vel * i;
+                        point.target_time = rclcpp::Time(req->header.stamp) + rclcpp::Duration(static_cast<int32_t>(i), 0);
+                        res->trajectory_plan.trajectory_points.push_back(point);
+                    }
+                    res->trajectory_plan.initial_longitudinal_velocity = req->vehicle_state.longitudinal_vel;
+                    for (uint16_t i = maneuver_index; i <= *last_related; i++)
+                    {
+                        res->related_maneuvers.push_back(i);
+                    }
+                });
+            return std::make_pair(node, srv);
+        };
+
+        auto a_last_related = std::make_shared<std::atomic<uint16_t>>(0);
+        auto plugin_a = make_plugin("plugin_A", 5, 0, a_last_related);
+        auto plugin_b = make_plugin("plugin_B", 8, 1, std::make_shared<std::atomic<uint16_t>>(1));
+
+        rclcpp::executors::MultiThreadedExecutor executor;
+        executor.add_node(pd->get_node_base_interface());
+        executor.add_node(plugin_a.first);
+        executor.add_node(plugin_b.first);
+        std::thread spin_thread([&executor]() { executor.spin(); });
+
+        // Give the clients time to discover the services
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        auto trajectory = pd->planTrajectory();
+
+        // Both plugins are called once, concurrently
+        EXPECT_EQ(2u, pd->last_service_call_count_);
+        EXPECT_NEAR(8.0, trajectory.initial_longitudinal_velocity, 0.0001);
+        EXPECT_TRUE(pd->isTrajectoryLongEnough(trajectory));
+
+        // plugin_A plans y = 5 to 37 and plugin_B y = 30 to 72 at 6 m/s. The points of plugin_B which are not ahead of y = 37 are dropped
+        ASSERT_EQ(11u, trajectory.trajectory_points.size());
+
+        // The first segment is kept whole
+        for (size_t i = 0; i < 5; i++)
+        {
+            EXPECT_NEAR(5.0 + 8.0 * i, trajectory.trajectory_points[i].y, 0.0001);
+            EXPECT_NEAR(static_cast<double>(i), (rclcpp::Time(trajectory.trajectory_points[i].target_time) - start_time).seconds(), 0.0001);
+        }
+
+        // The second segment is reached from y = 37 at the mean of both segment speeds and then keeps its own timing
+        double boundary_time = 4.0 + 5.0 / 7.0;
+        for (size_t i = 5; i < trajectory.trajectory_points.size(); i++)
+        {
+            EXPECT_NEAR(42.0 + 6.0 * (i - 5), trajectory.trajectory_points[i].y, 0.0001) << "point " << i;
+            EXPECT_NEAR(boundary_time + (i - 5), (rclcpp::Time(trajectory.trajectory_points[i].target_time) - start_time).seconds(), 0.0001) << "point " << i;
+        }
+
+        // The stitched trajectory moves forward in time and space and its speed stays between the speeds of the two segments
+        for (size_t i = 1; i < trajectory.trajectory_points.size(); i++)
+        {
+            const auto& prev = trajectory.trajectory_points[i - 1];
+            const auto& point = trajectory.trajectory_points[i];
+
+            double time_step = (rclcpp::Time(point.target_time) - rclcpp::Time(prev.target_time)).seconds();
+            ASSERT_GT(time_step, 0.0) << "point " << i;
+
+            double prev_downtrack = cmw->routeTrackPos(lanelet::BasicPoint2d(prev.x, prev.y)).downtrack;
+            double downtrack = cmw->routeTrackPos(lanelet::BasicPoint2d(point.x, point.y)).downtrack;
+            EXPECT_GT(downtrack, prev_downtrack) << "point " << i;
+            EXPECT_LE(downtrack - prev_downtrack, 8.0 + 0.0001) << "point " << i;
+
+            double speed = (downtrack - prev_downtrack) / time_step;
+            EXPECT_GE(speed, 6.0 - 0.0001) << "point " << i;
+            EXPECT_LE(speed, 8.0 + 0.0001) << "point " << i;
+        }
+
+        // Once plugin_A covers both maneuvers its response replaces plugin_B's, which is still requested as that is not yet known
+        *a_last_related = 1;
+        trajectory = pd->planTrajectory();
+        EXPECT_EQ(2u, pd->last_service_call_count_);
+        EXPECT_EQ(5u, trajectory.trajectory_points.size());
+
+        // The following iteration does not request the covered maneuver
+        trajectory = pd->planTrajectory();
+        EXPECT_EQ(1u, pd->last_service_call_count_);
+        EXPECT_EQ(5u, trajectory.trajectory_points.size());
+
+        // When plugin_A stops covering the second maneuver it is requested from the end of plugin_A's segment
+        *a_last_related = 0;
+        trajectory = pd->planTrajectory();
+        EXPECT_EQ(2u, pd->last_service_call_count_);
+        ASSERT_EQ(12u, trajectory.trajectory_points.size());
+        for (size_t i = 0; i < trajectory.trajectory_points.size(); i++)
+        {
+            EXPECT_NEAR(5.0 + 8.0 * i, trajectory.trajectory_points[i].y, 0.0001) << "point " << i;
+            EXPECT_NEAR(static_cast<double>(i), (rclcpp::Time(trajectory.trajectory_points[i].target_time) - start_time).seconds(), 0.0001) << "point " << i;
+        }
+
+        executor.cancel();
+        spin_thread.join();
+    }
+
 } // namespace plan_delegator
 
     /*!
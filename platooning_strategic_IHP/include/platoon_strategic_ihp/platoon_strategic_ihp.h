@@ -52,7 +52,7 @@
 #include <tf2_ros/transform_listener.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <std_msgs/msg/string.hpp>
 #include <rclcpp/time.hpp>
 
@@ -770,7 +770,7 @@ namespace platoon_strategic_ihp
             bool is_lanechange_possible(lanelet::Id start_lanelet_id, lanelet::Id target_lanelet_id);
 
             // Pointer for map projector
-            std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+            std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
             // flag to check if map is loaded
             bool map_loaded_ = false;
@@ -265,7 +265,7 @@ namespace platoon_strategic_ihp
     // Build map projector from proj string (georefernce).
     void PlatoonStrategicIHPPlugin::georeference_cb(const std_msgs::msg::String::UniquePtr msg) 
     {
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str()); 
+        map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data); 
     }
 
 
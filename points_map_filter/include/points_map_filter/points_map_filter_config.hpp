@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <vector>
+#include <string>
 
 namespace points_map_filter
 {
@@ -30,11 +31,27 @@ namespace points_map_filter
     //! The side length of the 2d cells which are used to discretize the filter space
     double cell_side_length = 3.0;
 
+    //! The storage used by the occupancy grid. One of "dense", "tiled", or "hash"
+    std::string lookup_grid_backend = "dense";
+
+    //! If true, clouds are filtered in place directly in the received message buffer instead of being converted to and from a PCL cloud
+    bool use_in_place_filter = true;
+
+    //! The maximum number of threads used to filter a single cloud in place
+    int max_filter_threads = 4;
+
+    //! The minimum number of points each filtering thread is given. Clouds with fewer than twice this many points are filtered on one thread.
+    int min_points_per_filter_thread = 50000;
+
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const Config &c)
     {
       output << "points_map_filter::Config { " << std::endl
            << "cell_side_length: " << c.cell_side_length << std::endl
+           << "lookup_grid_backend: " << c.lookup_grid_backend << std::endl
+           << "use_in_place_filter: " << c.use_in_place_filter << std::endl
+           << "max_filter_threads: " << c.max_filter_threads << std::endl
+           << "min_points_per_filter_thread: " << c.min_points_per_filter_thread << std::endl
            << "}" << std::endl;
       return output;
     }
@@ -18,7 +18,10 @@
 
 #include <rclcpp/rclcpp.hpp>
 #include <functional>
+#include <chrono>
+#include <memory>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <autoware_lanelet2_msgs/msg/map_bin.hpp>
 #include <lanelet2_core/LaneletMap.h>
 #include <carma_ros2_utils/carma_lifecycle_node.hpp>
@@ -46,6 +49,7 @@ namespace points_map_filter
 
     // Publishers
     carma_ros2_utils::PubPtr<sensor_msgs::msg::PointCloud2> filtered_points_pub_;
+    carma_ros2_utils::PubPtr<diagnostic_msgs::msg::DiagnosticArray> filter_metrics_pub_;
 
     // Node configuration
     Config config_;
@@ -55,8 +59,31 @@ namespace points_map_filter
 
     approximate_intersection::LookupGrid<PointT> lookup_grid_;
 
+    // The occupancy grid storage selected by config_.lookup_grid_backend
+    approximate_intersection::GridBackend lookup_grid_backend_ = approximate_intersection::GridBackend::DENSE;
+
     void recompute_lookup_grid();
 
+    /**
+     * \brief Filter a cloud by converting it to a PCL cloud and applying a FunctionFilter.
+     *        Used when the cloud cannot be filtered in place.
+     * 
+     * \param msg The cloud to filter
+     * 
+     * \return The filtered cloud
+     */
+    std::unique_ptr<sensor_msgs::msg::PointCloud2> filter_with_pcl(sensor_msgs::msg::PointCloud2::UniquePtr msg);
+
+    /**
+     * \brief Publish the latency and throughput of a filtered frame
+     * 
+     * \param input_points The number of points in the received cloud
+     * \param output_points The number of points retained by the filter
+     * \param latency The time taken to filter and publish the cloud
+     * \param in_place True if the cloud was filtered in place
+     */
+    void publish_filter_metrics(size_t input_points, size_t output_points, std::chrono::nanoseconds latency, bool in_place);
+
   public:
     /**
      * \brief Node constructor 
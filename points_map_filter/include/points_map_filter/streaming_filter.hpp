@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <approximate_intersection/lookup_grid.hpp>
+#include <pcl/point_types.h>
+
+namespace points_map_filter
+{
+
+  /**
+   * \brief Filters a PointCloud2 in place against a LookupGrid without converting it to a PCL cloud.
+   *        The x and y fields are read directly from the message buffer using their field offsets and the
+   *        points which intersect the grid are compacted to the front of the buffer in their original order.
+   *        On return the cloud is unorganized (height of 1) and contains only the retained points.
+   *        Every field of the input is kept with its original layout, so the output is not converted to XYZI.
+   *
+   *        The intersection checks of large clouds are split across threads. The compaction is a single pass
+   *        which moves contiguous runs of retained points.
+   * 
+   * \param cloud The cloud to filter. Must satisfy supports_in_place_filter.
+   * \param grid The grid to filter against
+   * \param max_threads The maximum number of threads to use for the intersection checks
+   * \param min_points_per_thread The minimum number of points assigned to each thread. Clouds with fewer points than twice this value are checked on the calling thread.
+   * 
+   * \throw std::invalid_argument if the cloud does not satisfy supports_in_place_filter
+   * 
+   * \return The number of points retained
+   */
+  size_t filter_cloud_in_place(sensor_msgs::msg::PointCloud2& cloud,
+                               const approximate_intersection::LookupGrid<pcl::PointXYZI>& grid,
+                               size_t max_threads, size_t min_points_per_thread);
+
+  /**
+   * \brief Check if a cloud can be filtered by filter_cloud_in_place
+   * 
+   * \param cloud The cloud to check
+   * 
+   * \return True if the cloud has FLOAT32 x and y fields in host byte order and its buffer size matches its dimensions
+   */
+  bool supports_in_place_filter(const sensor_msgs::msg::PointCloud2& cloud);
+
+} // points_map_filter
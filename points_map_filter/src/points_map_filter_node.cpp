@@ -14,6 +14,7 @@
  * the License.
  */
 #include "points_map_filter/points_map_filter_node.hpp"
+#include "points_map_filter/streaming_filter.hpp"
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
 #include <lanelet2_io/io_handlers/OsmFile.h>
@@ -47,6 +48,10 @@ namespace points_map_filter
 
     // Declare parameters
     config_.cell_side_length = declare_parameter<double>("cell_side_length", config_.cell_side_length);
+    config_.lookup_grid_backend = declare_parameter<std::string>("lookup_grid_backend", config_.lookup_grid_backend);
+    config_.use_in_place_filter = declare_parameter<bool>("use_in_place_filter", config_.use_in_place_filter);
+    config_.max_filter_threads = declare_parameter<int>("max_filter_threads", config_.max_filter_threads);
+    config_.min_points_per_filter_thread = declare_parameter<int>("min_points_per_filter_thread", config_.min_points_per_filter_thread);
   }
 
   rcl_interfaces::msg::SetParametersResult Node::parameter_update_callback(const std::vector<rclcpp::Parameter> &parameters)
@@ -76,6 +81,20 @@ namespace points_map_filter
 
     // Load parameters
     get_parameter<double>("cell_side_length", config_.cell_side_length);
+    get_parameter<std::string>("lookup_grid_backend", config_.lookup_grid_backend);
+    get_parameter<bool>("use_in_place_filter", config_.use_in_place_filter);
+    get_parameter<int>("max_filter_threads", config_.max_filter_threads);
+    get_parameter<int>("min_points_per_filter_thread", config_.min_points_per_filter_thread);
+
+    try
+    {
+      lookup_grid_backend_ = approximate_intersection::grid_backend_from_string(config_.lookup_grid_backend);
+    }
+    catch (const std::invalid_argument &e)
+    {
+      RCLCPP_ERROR_STREAM(get_logger(), e.what());
+      return CallbackReturn::FAILURE;
+    }
 
     // Register runtime parameter update callback
     add_on_set_parameters_callback(std::bind(&Node::parameter_update_callback, this, std_ph::_1));
@@ -99,12 +118,39 @@ namespace points_map_filter
 
     // Setup publishers
     filtered_points_pub_ = create_publisher<sensor_msgs::msg::PointCloud2>("filtered_points", 10);
+    filter_metrics_pub_ = create_publisher<diagnostic_msgs::msg::DiagnosticArray>("filter_metrics", 10);
 
     // Return success if everthing initialized successfully
     return CallbackReturn::SUCCESS;
   }
 
   void Node::points_callback(sensor_msgs::msg::PointCloud2::UniquePtr msg)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    size_t input_points = static_cast<size_t>(msg->width) * msg->height;
+    size_t output_points = 0;
+    bool in_place = config_.use_in_place_filter && supports_in_place_filter(*msg);
+
+    if (in_place)
+    {
+      // The received message is owned by this callback, so the filtered points are compacted in its buffer and the same message is published
+      output_points = filter_cloud_in_place(*msg, lookup_grid_,
+                                            static_cast<size_t>(std::max(1, config_.max_filter_threads)),
+                                            static_cast<size_t>(std::max(1, config_.min_points_per_filter_thread)));
+      filtered_points_pub_->publish(std::move(msg));
+    }
+    else
+    {
+      auto out_msg = filter_with_pcl(std::move(msg));
+      output_points = static_cast<size_t>(out_msg->width) * out_msg->height;
+      filtered_points_pub_->publish(std::move(out_msg));
+    }
+
+    publish_filter_metrics(input_points, output_points, std::chrono::steady_clock::now() - start, in_place);
+  }
+
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> Node::filter_with_pcl(sensor_msgs::msg::PointCloud2::UniquePtr msg)
   {
 
     const auto input_cloud = pcl::make_shared<CloudT>();
@@ -125,10 +171,46 @@ namespace points_map_filter
     // apply filter
     func_filter.filter(*filtered_cloud);
 
-    sensor_msgs::msg::PointCloud2 out_msg;
-    pcl::toROSMsg(*filtered_cloud, out_msg);
+    auto out_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+    pcl::toROSMsg(*filtered_cloud, *out_msg);
 
-    filtered_points_pub_->publish(out_msg);
+    return out_msg;
+  }
+
+  void Node::publish_filter_metrics(size_t input_points, size_t output_points, std::chrono::nanoseconds latency, bool in_place)
+  {
+    double latency_ms = std::chrono::duration<double, std::milli>(latency).count();
+    double points_per_sec = latency_ms > 0.0 ? input_points / (latency_ms / 1000.0) : 0.0;
+
+    RCLCPP_DEBUG_STREAM(get_logger(), "Filtered " << input_points << " points to " << output_points << " in " << latency_ms << " ms");
+
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.name = get_name();
+    status.message = in_place ? "in_place" : "pcl";
+
+    diagnostic_msgs::msg::KeyValue kv;
+    kv.key = "latency_ms";
+    kv.value = std::to_string(latency_ms);
+    status.values.push_back(kv);
+
+    kv.key = "input_points";
+    kv.value = std::to_string(input_points);
+    status.values.push_back(kv);
+
+    kv.key = "output_points";
+    kv.value = std::to_string(output_points);
+    status.values.push_back(kv);
+
+    kv.key = "points_per_sec";
+    kv.value = std::to_string(points_per_sec);
+    status.values.push_back(kv);
+
+    diagnostic_msgs::msg::DiagnosticArray metrics;
+    metrics.header.stamp = now();
+    metrics.status.push_back(status);
+
+    filter_metrics_pub_->publish(metrics);
   }
 
   namespace
@@ -201,10 +283,17 @@ namespace points_map_filter
 
     fromBinMsg(*msg, new_map);
 
+    if (new_map->pointLayer.empty())
+    {
+      RCLCPP_WARN_STREAM(get_logger(), "Received base map without points, keeping the previous lookup grid");
+      return;
+    }
+
     map_ = new_map;
 
     approximate_intersection::Config intersection_config;
     intersection_config.cell_side_length = config_.cell_side_length;
+    intersection_config.backend = lookup_grid_backend_;
 
     // TODO it would be great if lanelet2 already knew the map bounds and this iteration didn't need to happen twice
     double min_x = std::numeric_limits<double>::max();
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2022 LEIDOS.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include "points_map_filter/streaming_filter.hpp"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace points_map_filter
+{
+  namespace
+  {
+    //! Number of points gathered from the message buffer per batch intersection call
+    constexpr size_t GATHER_BLOCK_SIZE = 256;
+
+    /**
+     * \brief Find the byte offset of a FLOAT32 field
+     * 
+     * \return The offset, or -1 if the field is not present or is not a single FLOAT32 value
+     */
+    int64_t float_field_offset(const sensor_msgs::msg::PointCloud2& cloud, const std::string& name)
+    {
+      for (const auto& field : cloud.fields)
+      {
+        if (field.name == name)
+        {
+          if (field.datatype != sensor_msgs::msg::PointField::FLOAT32 || field.count != 1)
+          {
+            return -1;
+          }
+          return field.offset;
+        }
+      }
+      return -1;
+    }
+
+    bool host_is_big_endian()
+    {
+      const uint16_t value = 1;
+      uint8_t first_byte;
+      std::memcpy(&first_byte, &value, 1);
+      return first_byte == 0;
+    }
+
+    /**
+     * \brief Check the points [begin, end) of the cloud against the grid and write the result for each into keep
+     */
+    void check_points(const sensor_msgs::msg::PointCloud2& cloud, size_t x_offset, size_t y_offset,
+                      const approximate_intersection::LookupGrid<pcl::PointXYZI>& grid,
+                      size_t begin, size_t end, uint8_t* keep)
+    {
+      pcl::PointXYZI block[GATHER_BLOCK_SIZE];
+
+      for (size_t block_start = begin; block_start < end; block_start += GATHER_BLOCK_SIZE)
+      {
+        size_t block_size = std::min(GATHER_BLOCK_SIZE, end - block_start);
+
+        for (size_t i = 0; i < block_size; ++i)
+        {
+          size_t point = block_start + i;
+          const uint8_t* data = cloud.data.data() + (point / cloud.width) * cloud.row_step + (point % cloud.width) * cloud.point_step;
+          std::memcpy(&block[i].x, data + x_offset, sizeof(float));
+          std::memcpy(&block[i].y, data + y_offset, sizeof(float));
+        }
+
+        grid.intersects(block, block_size, keep + (block_start - begin));
+      }
+    }
+  }
+
+  bool supports_in_place_filter(const sensor_msgs::msg::PointCloud2& cloud)
+  {
+    int64_t x_offset = float_field_offset(cloud, "x");
+    int64_t y_offset = float_field_offset(cloud, "y");
+
+    return x_offset >= 0 && y_offset >= 0
+      && static_cast<size_t>(std::max(x_offset, y_offset)) + sizeof(float) <= cloud.point_step
+      && static_cast<size_t>(cloud.row_step) >= static_cast<size_t>(cloud.width) * cloud.point_step
+      && cloud.data.size() >= static_cast<size_t>(cloud.height) * cloud.row_step
+      && static_cast<bool>(cloud.is_bigendian) == host_is_big_endian();
+  }
+
+  size_t filter_cloud_in_place(sensor_msgs::msg::PointCloud2& cloud,
+                               const approximate_intersection::LookupGrid<pcl::PointXYZI>& grid,
+                               size_t max_threads, size_t min_points_per_thread)
+  {
+    if (!supports_in_place_filter(cloud))
+    {
+      throw std::invalid_argument("In place filtering requires a well formed cloud with FLOAT32 x and y fields in host byte order");
+    }
+
+    const size_t x_offset = float_field_offset(cloud, "x");
+    const size_t y_offset = float_field_offset(cloud, "y");
+    const size_t point_step = cloud.point_step;
+    const size_t point_count = static_cast<size_t>(cloud.width) * cloud.height;
+
+    std::vector<uint8_t> keep(point_count);
+
+    // Check intersections, splitting the cloud into contiguous chunks when it is large enough
+    size_t thread_count = std::max<size_t>(1, std::min(max_threads, point_count / std::max<size_t>(1, min_points_per_thread)));
+
+    if (thread_count <= 1)
+    {
+      check_points(cloud, x_offset, y_offset, grid, 0, point_count, keep.data());
+    }
+    else
+    {
+      size_t chunk_size = (point_count + thread_count - 1) / thread_count;
+      std::vector<std::future<void>> chunks;
+      chunks.reserve(thread_count - 1);
+
+      // The calling thread checks the first chunk
+      for (size_t begin = chunk_size; begin < point_count; begin += chunk_size)
+      {
+        size_t end = std::min(point_count, begin + chunk_size);
+        chunks.push_back(std::async(std::launch::async, check_points, std::cref(cloud), x_offset, y_offset,
+                                    std::cref(grid), begin, end, keep.data() + begin));
+      }
+
+      check_points(cloud, x_offset, y_offset, grid, 0, std::min(point_count, chunk_size), keep.data());
+
+      for (auto& chunk : chunks)
+      {
+        chunk.get();
+      }
+    }
+
+    // Compact the retained points to the front of the buffer. Runs of retained points are moved together.
+    // Rows are dense once compacted so padding between rows of organized clouds is dropped.
+    uint8_t* base = cloud.data.data();
+    size_t write = 0;
+    size_t point = 0;
+
+    while (point < point_count)
+    {
+      if (!keep[point])
+      {
+        ++point;
+        continue;
+      }
+
+      // Extend the run up to the end of the current row
+      size_t run_start = point;
+      size_t row_end = (point / cloud.width + 1) * cloud.width;
+      while (point < point_count && point < row_end && keep[point])
+      {
+        ++point;
+      }
+
+      size_t run_length = point - run_start;
+      const uint8_t* src = base + (run_start / cloud.width) * cloud.row_step + (run_start % cloud.width) * point_step;
+      uint8_t* dst = base + write * point_step;
+
+      if (src != dst)
+      {
+        std::memmove(dst, src, run_length * point_step);
+      }
+
+      write += run_length;
+    }
+
+    cloud.data.resize(write * point_step);
+    cloud.height = 1;
+    cloud.width = write;
+    cloud.row_step = write * point_step;
+
+    return write;
+  }
+
+} // points_map_filter
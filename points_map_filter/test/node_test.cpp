@@ -33,6 +33,7 @@
 #include <pcl/point_types.h>
 
 #include "points_map_filter/points_map_filter_node.hpp"
+#include "points_map_filter/streaming_filter.hpp"
 
 namespace {
 using namespace lanelet::units::literals;
@@ -330,6 +331,112 @@ TEST(Testpoints_map_filter, linker_test)
 
 }
 
+TEST(Testpoints_map_filter, in_place_filter_test)
+{
+    approximate_intersection::Config config;
+    config.min_x = -10;
+    config.max_x = 10;
+    config.min_y = -10;
+    config.max_y = 10;
+    config.cell_side_length = 1;
+
+    approximate_intersection::LookupGrid<pcl::PointXYZI> grid(config);
+
+    pcl::PointXYZI occupied;
+    occupied.x = 0.5;
+    occupied.y = 0.5;
+    grid.insert(occupied);
+
+    // Every third point lies in the occupied cell, the intensity records the original order
+    auto cloud = pcl::make_shared<pcl::PointCloud<pcl::PointXYZI>>();
+    for (size_t i = 0; i < 3000; i++) {
+        pcl::PointXYZI p;
+        p.x = (i % 3 == 0) ? 0.2 : 5.0;
+        p.y = 0.7;
+        p.z = 0;
+        p.intensity = i;
+        cloud->points.push_back(p);
+    }
+    cloud->width = cloud->points.size();
+    cloud->height = 1;
+
+    for (size_t threads : {1, 4}) {
+        sensor_msgs::msg::PointCloud2 msg;
+        pcl::toROSMsg(*cloud, msg);
+
+        ASSERT_TRUE(points_map_filter::supports_in_place_filter(msg));
+        ASSERT_EQ(1000u, points_map_filter::filter_cloud_in_place(msg, grid, threads, 100));
+        ASSERT_EQ(1000u, msg.width);
+        ASSERT_EQ(1u, msg.height);
+        ASSERT_EQ(msg.row_step * msg.height, msg.data.size());
+
+        pcl::PointCloud<pcl::PointXYZI> output;
+        pcl::fromROSMsg(msg, output);
+
+        ASSERT_EQ(1000u, output.points.size());
+        for (size_t i = 0; i < output.points.size(); i++) {
+            ASSERT_NEAR(0.2, output.points[i].x, 0.00001);
+            ASSERT_NEAR(i * 3.0, output.points[i].intensity, 0.00001);
+        }
+    }
+
+    // Clouds without FLOAT32 x and y fields are rejected
+    sensor_msgs::msg::PointCloud2 no_fields;
+    ASSERT_FALSE(points_map_filter::supports_in_place_filter(no_fields));
+    ASSERT_THROW(points_map_filter::filter_cloud_in_place(no_fields, grid, 1, 100), std::invalid_argument);
+}
+
+TEST(Testpoints_map_filter, in_place_filter_keeps_layout)
+{
+    approximate_intersection::Config config;
+    config.min_x = -10;
+    config.max_x = 10;
+    config.min_y = -10;
+    config.max_y = 10;
+    config.cell_side_length = 1;
+
+    approximate_intersection::LookupGrid<pcl::PointXYZI> grid(config);
+
+    pcl::PointXYZI occupied;
+    occupied.x = 0.5;
+    occupied.y = 0.5;
+    grid.insert(occupied);
+
+    // Unlike the PCL path, which always outputs XYZI, in place filtering keeps every field of the input
+    pcl::PointCloud<pcl::PointXYZINormal> cloud;
+    for (size_t i = 0; i < 10; i++) {
+        pcl::PointXYZINormal p;
+        p.x = (i % 2 == 0) ? 0.2 : 5.0;
+        p.y = 0.7;
+        p.z = 0;
+        p.intensity = i;
+        p.normal_x = 0.1 * i;
+        p.curvature = 2.0 * i;
+        cloud.points.push_back(p);
+    }
+    cloud.width = cloud.points.size();
+    cloud.height = 1;
+
+    sensor_msgs::msg::PointCloud2 msg;
+    pcl::toROSMsg(cloud, msg);
+    auto input_fields = msg.fields;
+    auto input_point_step = msg.point_step;
+
+    ASSERT_EQ(5u, points_map_filter::filter_cloud_in_place(msg, grid, 1, 100));
+    ASSERT_EQ(input_fields, msg.fields);
+    ASSERT_EQ(input_point_step, msg.point_step);
+
+    pcl::PointCloud<pcl::PointXYZINormal> output;
+    pcl::fromROSMsg(msg, output);
+
+    ASSERT_EQ(5u, output.points.size());
+    for (size_t i = 0; i < output.points.size(); i++) {
+        ASSERT_NEAR(i * 2.0, output.points[i].intensity, 0.00001);
+        ASSERT_NEAR(0.2 * i, output.points[i].normal_x, 0.00001);
+        ASSERT_NEAR(4.0 * i, output.points[i].curvature, 0.00001);
+    }
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -343,4 +450,4 @@ int main(int argc, char **argv)
     rclcpp::shutdown();
 
     return success;
-}
\ No newline at end of file
+}
@@ -28,7 +28,7 @@
 #include "std_msgs/msg/string.hpp"
 #include "port_drayage_plugin/port_drayage_state_machine.hpp"
 
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <boost/optional.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -133,7 +133,7 @@ namespace port_drayage_plugin
             std::function<void(carma_v2x_msgs::msg::MobilityOperation)> publish_mobility_operation_;
             std::function<void(carma_msgs::msg::UIInstructions)> publish_ui_instructions_;
             std::function<bool(std::shared_ptr<carma_planning_msgs::srv::SetActiveRoute::Request>)> call_set_active_route_service_;
-            std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_ = nullptr;
+            std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_ = nullptr;
             bool starting_at_staging_area_; // Flag indicating CMV's first destination; 'true' indicates Staging Area Entrance; 'false' indicates Port Entrance.
             bool enable_port_drayage_; // Flag to enable to port drayage operations. If false, state machine will remain in 'INACTIVE' state
 
@@ -410,7 +410,7 @@ namespace port_drayage_plugin
 
     void PortDrayageWorker::onNewGeoreference(std_msgs::msg::String::UniquePtr msg) {
         // Build projector from proj string
-        map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(msg->data.c_str());  
+        map_projector_ = carma_wm::projection::getGeoreferenceProjector(msg->data);
     }        
 
 
@@ -19,9 +19,11 @@
 #include <carma_ros2_utils/carma_lifecycle_node.hpp>
 #include <carma_wm/WMListener.hpp>
 #include <carma_wm/WorldModel.hpp>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp_lifecycle/lifecycle_publisher.hpp>
 
+#include <cstddef>
 #include <memory>
 
 namespace roadway_objects
@@ -43,13 +45,21 @@ public:
     -> carma_ros2_utils::CallbackReturn override;
 
 private:
+  auto publish_projection_metrics(
+    std::size_t object_count, std::size_t obstacle_count, double latency_ms) -> void;
+
   rclcpp::Subscription<carma_perception_msgs::msg::ExternalObjectList>::SharedPtr
     external_objects_sub_{nullptr};
 
   rclcpp_lifecycle::LifecyclePublisher<carma_perception_msgs::msg::RoadwayObstacleList>::SharedPtr
     roadway_obs_pub_{nullptr};
 
+  rclcpp_lifecycle::LifecyclePublisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr
+    projection_metrics_pub_{nullptr};
+
   std::shared_ptr<carma_wm::WMListener> wm_listener_{nullptr};
+
+  std::size_t max_projection_threads_{4U};
 };
 
 }  // namespace roadway_objects
@@ -14,7 +14,9 @@
 
 #include "roadway_objects/roadway_objects_component.hpp"
 
+#include <chrono>
 #include <memory>
+#include <string>
 
 namespace roadway_objects
 {
@@ -37,6 +39,19 @@ auto RoadwayObjectsNode::handle_on_configure(const rclcpp_lifecycle::State &)
   roadway_obs_pub_ =
     create_publisher<carma_perception_msgs::msg::RoadwayObstacleList>("roadway_objects", 10);
 
+  projection_metrics_pub_ =
+    create_publisher<diagnostic_msgs::msg::DiagnosticArray>("projection_metrics", 10);
+
+  declare_parameter("max_projection_threads", static_cast<int>(max_projection_threads_));
+
+  if (const auto value{get_parameter("max_projection_threads").as_int()}; value < 1) {
+    RCLCPP_WARN_STREAM(
+      get_logger(), "Parameter 'max_projection_threads' must be positive. Using "
+                      << max_projection_threads_ << " instead of " << value);
+  } else {
+    max_projection_threads_ = static_cast<std::size_t>(value);
+  }
+
   external_objects_sub_ = create_subscription<carma_perception_msgs::msg::ExternalObjectList>(
     "external_objects", 10,
     [this](const carma_perception_msgs::msg::ExternalObjectList::SharedPtr msg_ptr) {
@@ -49,8 +64,6 @@ auto RoadwayObjectsNode::handle_on_configure(const rclcpp_lifecycle::State &)
 auto RoadwayObjectsNode::publish_obstacles(
   const carma_perception_msgs::msg::ExternalObjectList & msg) -> void
 {
-  carma_perception_msgs::msg::RoadwayObstacleList obstacle_list;
-
   const auto map{wm_listener_->getWorldModel()->getMap()};
 
   if (map == nullptr) {
@@ -70,24 +83,47 @@ auto RoadwayObjectsNode::publish_obstacles(
     return;
   }
 
-  const auto world_model{wm_listener_->getWorldModel()};
-  for (auto object : msg.objects) {
-    const auto obstacle{world_model->toRoadwayObstacle(object)};
+  const auto start_time{std::chrono::steady_clock::now()};
 
-    if (!obstacle.has_value()) {
-      RCLCPP_DEBUG_STREAM(
-        get_logger(), "roadway_objects dropping detected object with id: "
-                        << object.id << " as it is off the road.");
+  const auto world_model{wm_listener_->getWorldModel()};
+  auto obstacle_list{world_model->toRoadwayObstacles(msg, max_projection_threads_)};
 
-      continue;
-    }
+  const auto latency{std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - start_time)};
 
-    obstacle_list.roadway_obstacles.emplace_back(obstacle.get());
-  }
+  publish_projection_metrics(
+    std::size(msg.objects), std::size(obstacle_list.roadway_obstacles), latency.count());
 
   roadway_obs_pub_->publish(obstacle_list);
 }
 
+auto RoadwayObjectsNode::publish_projection_metrics(
+  std::size_t object_count, std::size_t obstacle_count, double latency_ms) -> void
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string(get_name()) + "/projection";
+
+  diagnostic_msgs::msg::KeyValue kv;
+  kv.key = "objects";
+  kv.value = std::to_string(object_count);
+  status.values.push_back(kv);
+
+  kv.key = "off_road";
+  kv.value = std::to_string(object_count - obstacle_count);
+  status.values.push_back(kv);
+
+  kv.key = "latency_ms";
+  kv.value = std::to_string(latency_ms);
+  status.values.push_back(kv);
+
+  diagnostic_msgs::msg::DiagnosticArray metrics;
+  metrics.header.stamp = now();
+  metrics.status.push_back(status);
+
+  projection_metrics_pub_->publish(metrics);
+}
+
 }  // namespace roadway_objects
 
 #include "rclcpp_components/register_node_macro.hpp"
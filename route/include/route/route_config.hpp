@@ -32,6 +32,7 @@ namespace route
     double route_spin_rate = 10.0; // (Hz) Spin rate of the Route node
     int cte_max_count = 4; // Max number of consecutive timesteps outside of the route allowable before triggering a LEFT_ROUTE event
     std::string route_file_path = "NULL"; // Path to the directory that contains the route file(s) for CARMA
+    bool repair_route_on_invalidation = false; // If true rerouting after a route invalidation first attempts to reroute only the invalidated part of the previous route
 
     // Stream operator for this config
     friend std::ostream &operator<<(std::ostream &output, const Config &c)
@@ -42,6 +43,7 @@ namespace route
            << "route_spin_rate: " << c.route_spin_rate << std::endl
            << "cte_max_count: " << c.cte_max_count << std::endl
            << "route_file_path: " << c.route_file_path << std::endl
+           << "repair_route_on_invalidation: " << c.repair_route_on_invalidation << std::endl
            << "}" << std::endl;
       return output;
     }
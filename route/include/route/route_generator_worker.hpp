@@ -46,6 +46,7 @@
 #include <math.h>
 #include <unordered_set>
 #include <functional>
+#include <deque>
 #include <tf2_ros/transform_listener.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
@@ -105,6 +106,29 @@ namespace route {
                                                         const lanelet::LaneletMapConstPtr map_pointer,
                                                         const carma_wm::LaneletRoutingGraphConstPtr graph_pointer) const;
 
+        /**
+         * \brief Repair the previous route after it was invalidated by reusing its shortest path before and after the invalidated segment.
+         *        Only the segment between the first and the last lanelet transition which is no longer possible in the routing graph is searched again.
+         * \param previous_path The shortest path of the route which was invalidated
+         * \param start Lanelet 2D point in map frame of the current vehicle position
+         * \param destinations The remaining destination points in map frame. The last point is the final destination
+         * \param map_pointer A constant pointer to lanelet vector map
+         * \param graph_pointer A constant pointer to the updated lanelet vector map routing graph
+         * \return The repaired route. Empty if the start or final destination is not on the previous path, no step of the previous path was
+         *         invalidated or the invalidated segment cannot be reconnected
+         */
+        lanelet::Optional<lanelet::routing::Route> repairRoute(const lanelet::ConstLanelets& previous_path,
+                                                            const lanelet::BasicPoint2d& start,
+                                                            const std::vector<lanelet::BasicPoint2d>& destinations,
+                                                            const lanelet::LaneletMapConstPtr map_pointer,
+                                                            const carma_wm::LaneletRoutingGraphConstPtr graph_pointer) const;
+
+        /**
+         * \brief Set method for configurable parameter
+         * \param repair_route If true rerouting after a route invalidation first attempts to repair the previous route
+         */
+        void setRouteRepair(bool repair_route);
+
         /**
          * \brief Get_available_route service callback. Calls to this service will respond with a list of route names for user to select
          * \param req An empty carma_planning_msgs::srv::GetAvailableRoutes::Request
@@ -272,6 +296,24 @@ namespace route {
         // const pointer to world model object
         carma_wm::WorldModelConstPtr world_model_;
 
+        /**
+         * \brief Shortest path of a previously computed route. A route is reused only while the routing graph it was computed on is alive,
+         *        so any map update which changes routing invalidates the entry
+         */
+        struct RouteCacheEntry
+        {
+            std::weak_ptr<const lanelet::routing::RoutingGraph> graph;
+            lanelet::Ids request_lanelet_ids; // Start, via and end lanelet ids of the routing request
+            lanelet::Ids shortest_path_ids;
+        };
+
+        // Most recently used routes first
+        mutable std::deque<RouteCacheEntry> route_cache_;
+        static constexpr size_t ROUTE_CACHE_SIZE = 16;
+
+        // If true rerouting after a route invalidation first attempts to repair the previous route
+        bool repair_route_ = false;
+
         // route messages waiting to be updated and published
         carma_planning_msgs::msg::Route route_msg_;
         carma_planning_msgs::msg::RouteEvent route_event_msg_;
@@ -15,6 +15,8 @@
  */
 
 #include "route/route_generator_worker.hpp"
+#include <carma_wm/RoutingGraphAccessor.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 
 namespace route {
 
@@ -64,8 +66,198 @@ namespace route {
             auto via_lanelet_vector = lanelet::geometry::findNearest(map_pointer->laneletLayer, point, 1);
             via_lanelets_vector.emplace_back(lanelet::ConstLanelet(via_lanelet_vector[0].second.constData()));
         }
+        // ids of the lanelets which identify this routing request
+        lanelet::Ids request_lanelet_ids;
+        request_lanelet_ids.reserve(via_lanelets_vector.size() + 2);
+        request_lanelet_ids.push_back(start_lanelet.id());
+        for(const auto& llt : via_lanelets_vector)
+        {
+            request_lanelet_ids.push_back(llt.id());
+        }
+        request_lanelet_ids.push_back(end_lanelet.id());
+
+        // reuse a cached shortest path if this exact request was already routed on this graph
+        for(auto it = route_cache_.begin(); it != route_cache_.end(); it++)
+        {
+            if(it->graph.lock() != graph_pointer || it->request_lanelet_ids != request_lanelet_ids)
+            {
+                continue;
+            }
+
+            RouteCacheEntry entry = *it;
+            route_cache_.erase(it);
+
+            lanelet::ConstLanelets cached_path;
+            cached_path.reserve(entry.shortest_path_ids.size());
+            for(auto id : entry.shortest_path_ids)
+            {
+                if(!map_pointer->laneletLayer.exists(id))
+                {
+                    break;
+                }
+                cached_path.push_back(map_pointer->laneletLayer.get(id));
+            }
+
+            if(cached_path.size() == entry.shortest_path_ids.size())
+            {
+                auto cached_route = std::static_pointer_cast<const RoutingGraphAccessor>(graph_pointer)->getRouteFromShortestPath(cached_path);
+                if(cached_route)
+                {
+                    RCLCPP_DEBUG_STREAM(logger_->get_logger(), "Reusing cached shortest path of " << cached_path.size() << " lanelets");
+                    route_cache_.push_front(std::move(entry));
+                    return cached_route;
+                }
+            }
+            break;
+        }
+
         // routing
-        return graph_pointer->getRouteVia(start_lanelet, via_lanelets_vector, end_lanelet);
+        auto route = graph_pointer->getRouteVia(start_lanelet, via_lanelets_vector, end_lanelet);
+
+        if(route)
+        {
+            RouteCacheEntry entry;
+            entry.graph = graph_pointer;
+            entry.request_lanelet_ids = std::move(request_lanelet_ids);
+            for(const auto& llt : route->shortestPath())
+            {
+                entry.shortest_path_ids.push_back(llt.id());
+            }
+
+            route_cache_.push_front(std::move(entry));
+            if(route_cache_.size() > ROUTE_CACHE_SIZE)
+            {
+                route_cache_.pop_back();
+            }
+        }
+
+        return route;
+    }
+
+    lanelet::Optional<lanelet::routing::Route> RouteGeneratorWorker::repairRoute(const lanelet::ConstLanelets& previous_path,
+                                                                                 const lanelet::BasicPoint2d& start,
+                                                                                 const std::vector<lanelet::BasicPoint2d>& destinations,
+                                                                                 const lanelet::LaneletMapConstPtr map_pointer,
+                                                                                 const carma_wm::LaneletRoutingGraphConstPtr graph_pointer) const
+    {
+        if(previous_path.empty() || destinations.empty())
+        {
+            return {};
+        }
+
+        auto nearest_lanelet = [&map_pointer](const lanelet::BasicPoint2d& point) -> lanelet::Optional<lanelet::ConstLanelet>
+        {
+            auto nearest = lanelet::geometry::findNearest(map_pointer->laneletLayer, point, 1);
+            if(nearest.empty())
+            {
+                return {};
+            }
+            return lanelet::ConstLanelet(nearest[0].second.constData());
+        };
+
+        // the vehicle must still be on the previous path
+        auto start_lanelet = nearest_lanelet(start);
+        if(!start_lanelet)
+        {
+            return {};
+        }
+
+        auto start_it = std::find_if(previous_path.begin(), previous_path.end(),
+                                     [&start_lanelet](const lanelet::ConstLanelet& llt) { return llt.id() == start_lanelet->id(); });
+        if(start_it == previous_path.end())
+        {
+            RCLCPP_DEBUG_STREAM(logger_->get_logger(), "Lanelet " << start_lanelet->id() << " is not on the previous route, it cannot be repaired");
+            return {};
+        }
+
+        lanelet::ConstLanelets remaining(start_it, previous_path.end());
+
+        // the previous path must still end at the final destination
+        auto end_lanelet = nearest_lanelet(destinations.back());
+        if(!end_lanelet || end_lanelet->id() != remaining.back().id())
+        {
+            return {};
+        }
+
+        // index in the remaining path of each intermediate destination, in order
+        std::vector<std::pair<size_t, lanelet::ConstLanelet>> via_lanelets;
+        size_t search_from = 0;
+        for(size_t i = 0; i + 1 < destinations.size(); i++)
+        {
+            auto via_lanelet = nearest_lanelet(destinations[i]);
+            if(!via_lanelet)
+            {
+                return {};
+            }
+
+            auto via_it = std::find_if(remaining.begin() + search_from, remaining.end(),
+                                       [&via_lanelet](const lanelet::ConstLanelet& llt) { return llt.id() == via_lanelet->id(); });
+            if(via_it == remaining.end())
+            {
+                return {};
+            }
+
+            search_from = std::distance(remaining.begin(), via_it);
+            via_lanelets.emplace_back(search_from, *via_lanelet);
+        }
+
+        // find the span of steps which are no longer traversable
+        auto accessor = std::static_pointer_cast<const RoutingGraphAccessor>(graph_pointer);
+        bool broken = false;
+        size_t first_break = 0;
+        size_t last_break = 0;
+
+        for(size_t i = 0; i + 1 < remaining.size(); i++)
+        {
+            if(!accessor->canTraverse(remaining[i], remaining[i + 1]))
+            {
+                if(!broken)
+                {
+                    first_break = i;
+                }
+                last_break = i;
+                broken = true;
+            }
+        }
+
+        // the invalidation was not caused by the previous path becoming untraversable, so there is nothing to repair
+        if(!broken)
+        {
+            RCLCPP_DEBUG_STREAM(logger_->get_logger(), "No step of the previous route was invalidated, it cannot be repaired");
+            return {};
+        }
+
+        // route only the invalidated segment and keep the prefix and suffix
+        const auto& segment_start = remaining[first_break];
+        const auto& segment_end = remaining[last_break + 1];
+
+        lanelet::ConstLanelets segment_vias;
+        for(const auto& via : via_lanelets)
+        {
+            if(via.first > first_break && via.first < last_break + 1)
+            {
+                segment_vias.push_back(via.second);
+            }
+        }
+
+        auto segment = segment_vias.empty() ? graph_pointer->shortestPath(segment_start, segment_end)
+                                            : graph_pointer->shortestPathVia(segment_start, segment_vias, segment_end);
+        if(!segment)
+        {
+            RCLCPP_DEBUG_STREAM(logger_->get_logger(), "No path from lanelet " << segment_start.id() << " to lanelet " << segment_end.id() << ", the previous route cannot be repaired");
+            return {};
+        }
+
+        lanelet::ConstLanelets repaired_path(remaining.begin(), remaining.begin() + first_break);
+        repaired_path.insert(repaired_path.end(), segment->begin(), segment->end());
+        repaired_path.insert(repaired_path.end(), remaining.begin() + last_break + 2, remaining.end());
+
+        return accessor->getRouteFromShortestPath(repaired_path);
+    }
+
+    void RouteGeneratorWorker::setRouteRepair(bool repair_route)
+    {
+        repair_route_ = repair_route;
     }
 
     void RouteGeneratorWorker::setReroutingChecker(const std::function<bool()> inputFunction)
@@ -323,10 +515,11 @@ namespace route {
             throw std::invalid_argument("loadRouteDestinationsInMapFrame (using destination points array) before map projection was set");
         }
         
-        lanelet::projection::LocalFrameProjector projector(map_proj_.get().c_str()); // Build map projector
+        auto projector = carma_wm::projection::getGeoreferenceProjector(map_proj_.get()); // Shared map projector
 
         // Process each point in 'destinations'
-        std::vector<lanelet::BasicPoint3d> destination_points;
+        std::vector<lanelet::GPSPoint> coordinates;
+        coordinates.reserve(destinations.size());
         for (const auto& destination : destinations)
         {
             lanelet::GPSPoint coordinate;
@@ -342,10 +535,10 @@ namespace route {
                 coordinate.ele = 0.0;
             }
 
-            destination_points.emplace_back(projector.forward(coordinate));
+            coordinates.push_back(coordinate);
         }
 
-        return destination_points;
+        return projector->forward(coordinates);
     }
 
     std::vector<carma_v2x_msgs::msg::Position3D> RouteGeneratorWorker::loadRouteDestinationGpsPointsFromRouteId(const std::string& route_id) const
@@ -625,6 +818,20 @@ namespace route {
         
         RCLCPP_DEBUG_STREAM(logger_->get_logger(), "New destination_points_in_map.size:" << destination_points_in_map_.size());
 
+        if(repair_route_ && world_model_->getRoute())
+        {
+            const auto& previous_path = world_model_->getRoute()->shortestPath();
+            auto repaired_route = repairRoute(lanelet::ConstLanelets(previous_path.begin(), previous_path.end()), current_loc_, destination_points_in_map_,
+                                              world_model_->getMap(), world_model_->getMapRoutingGraph());
+            if(repaired_route)
+            {
+                RCLCPP_DEBUG_STREAM(logger_->get_logger(), "Repaired the previous route");
+                return repaired_route;
+            }
+
+            RCLCPP_DEBUG_STREAM(logger_->get_logger(), "Previous route could not be repaired, routing from the current location");
+        }
+
         auto route=routing(current_loc_, // Route from current location through future destinations
                             std::vector<lanelet::BasicPoint2d>(destination_points_in_map_.begin(), destination_points_in_map_.end() - 1),
                             destination_points_in_map_.back(),
@@ -35,6 +35,7 @@ namespace route
     config_.route_spin_rate = declare_parameter<double>("route_spin_rate", config_.route_spin_rate);
     config_.cte_max_count = declare_parameter<int>("cte_max_count", config_.cte_max_count);
     config_.route_file_path = declare_parameter<std::string>("route_file_path", config_.route_file_path);
+    config_.repair_route_on_invalidation = declare_parameter<bool>("repair_route_on_invalidation", config_.repair_route_on_invalidation);
   }
 
   rcl_interfaces::msg::SetParametersResult Route::parameter_update_callback(const std::vector<rclcpp::Parameter> &parameters)
@@ -45,10 +46,11 @@ namespace route
       {"route_spin_rate", config_.route_spin_rate}}, parameters);
     auto error_2 = update_params<int>({{"cte_max_count", config_.cte_max_count}}, parameters);
     auto error_3 = update_params<std::string>({{"route_file_path", config_.route_file_path}}, parameters);
+    auto error_4 = update_params<bool>({{"repair_route_on_invalidation", config_.repair_route_on_invalidation}}, parameters);
 
     rcl_interfaces::msg::SetParametersResult result;
 
-    result.successful = !error && !error_2 && !error_3;
+    result.successful = !error && !error_2 && !error_3 && !error_4;
 
     return result;
   }
@@ -66,6 +68,7 @@ namespace route
     get_parameter<double>("route_spin_rate", config_.route_spin_rate);
     get_parameter<int>("cte_max_count", config_.cte_max_count);
     get_parameter<std::string>("route_file_path", config_.route_file_path);
+    get_parameter<bool>("repair_route_on_invalidation", config_.repair_route_on_invalidation);
 
     RCLCPP_INFO_STREAM(get_logger(), "Loaded params: " << config_);
 
@@ -114,6 +117,7 @@ namespace route
     rg_worker_.setDowntrackDestinationRange(config_.destination_downtrack_range);
     rg_worker_.setCrosstrackErrorDistance(config_.max_crosstrack_error);
     rg_worker_.setCrosstrackErrorCountMax(config_.cte_max_count);
+    rg_worker_.setRouteRepair(config_.repair_route_on_invalidation);
     rg_worker_.setPublishers(route_event_pub_, route_state_pub_, route_pub_, route_marker_pub_);
     rg_worker_.initializeBumperTransformLookup();
 
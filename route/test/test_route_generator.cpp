@@ -596,6 +596,53 @@ TEST(RouteGeneratorTest, test_reroute_after_route_invalidation)
     ASSERT_EQ(route->shortestPath().size(), 4);
 }
 
+TEST(RouteGeneratorTest, test_repair_route)
+{
+    // Create a RouteGeneratorWorker for this test
+    auto node = std::make_shared<rclcpp::Node>("test_node");
+    rclcpp::node_interfaces::NodeClockInterface::SharedPtr clock = node->get_node_clock_interface();
+    tf2_ros::Buffer tf2_buffer(clock->get_clock());
+    route::RouteGeneratorWorker worker(tf2_buffer);
+    worker.setLoggerInterface(node->get_node_logging_interface());
+
+    auto cmw = carma_wm::test::getGuidanceTestMap();
+    auto map = cmw->getMap();
+    auto graph = cmw->getMapRoutingGraph();
+
+    lanelet::BasicPoint2d start_point{1.85, 10.0};
+    std::vector<lanelet::BasicPoint2d> dest_points = { {5.55, 90.0} };
+
+    // A previous path which is still traversable is not repaired, so the caller falls back to a full reroute
+    lanelet::ConstLanelets valid_path = { map->laneletLayer.get(1210), map->laneletLayer.get(1211),
+                                          map->laneletLayer.get(1212), map->laneletLayer.get(1213) };
+
+    ASSERT_FALSE(!!worker.repairRoute(valid_path, {5.55, 10.0}, dest_points, map, graph));
+
+    // Only the step which cannot be traversed anymore is rerouted
+    lanelet::ConstLanelets broken_path = { map->laneletLayer.get(1200), map->laneletLayer.get(1211),
+                                           map->laneletLayer.get(1212), map->laneletLayer.get(1213) };
+
+    auto route = worker.repairRoute(broken_path, start_point, dest_points, map, graph);
+    ASSERT_TRUE(!!route);
+    ASSERT_EQ(1200, route->shortestPath().front().id());
+    ASSERT_EQ(1213, route->shortestPath().back().id());
+    ASSERT_EQ(1212, route->shortestPath()[route->shortestPath().size() - 2].id());
+
+    // The previous path cannot be repaired if the vehicle has left it
+    ASSERT_FALSE(!!worker.repairRoute(broken_path, {1.85, 60.0}, dest_points, map, graph));
+
+    // Repeated routing requests on the same graph produce the same path
+    auto first_route = worker.routing(start_point, {}, dest_points.back(), map, graph);
+    auto second_route = worker.routing(start_point, {}, dest_points.back(), map, graph);
+    ASSERT_TRUE(!!first_route);
+    ASSERT_TRUE(!!second_route);
+    ASSERT_EQ(first_route->shortestPath().size(), second_route->shortestPath().size());
+    for (size_t i = 0; i < first_route->shortestPath().size(); i++)
+    {
+        ASSERT_EQ(first_route->shortestPath()[i].id(), second_route->shortestPath()[i].id());
+    }
+}
+
 TEST(RouteGeneratorTest, test_setReroutingChecker)
 {
     // Create a RouteGeneratorWorker for this test
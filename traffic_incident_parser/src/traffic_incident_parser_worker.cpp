@@ -18,6 +18,7 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <carma_ros2_utils/containers/containers.hpp>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <lanelet2_core/Attribute.h>
 #include <lanelet2_core/geometry/LineString.h>
 #include <lanelet2_core/primitives/Traits.h>
@@ -148,12 +149,12 @@ namespace traffic_incident_parser
 
     lanelet::BasicPoint2d TrafficIncidentParserWorker::getIncidentOriginPoint() const
     {
-        lanelet::projection::LocalFrameProjector projector(projection_msg_.c_str());
+        auto projector = carma_wm::projection::getGeoreferenceProjector(projection_msg_);
         lanelet::GPSPoint gps_point;
         gps_point.lat = latitude;
         gps_point.lon = longitude;
         gps_point.ele = 0;
-        auto local_point3d = projector.forward(gps_point);
+        auto local_point3d = projector->forward(gps_point);
         return {local_point3d.x(), local_point3d.y()};
     }
 
@@ -36,7 +36,7 @@
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <trajectory_utils/quintic_coefficient_calculator.hpp>
 #include <boost/property_tree/json_parser.hpp>
-#include <lanelet2_extension/projection/local_frame_projector.h>
+#include <carma_wm/GeoreferenceProjector.hpp>
 #include <carma_v2x_msgs/msg/location_ecef.hpp>
 #include <carma_v2x_msgs/msg/trajectory.hpp>
 #include <carma_v2x_msgs/msg/plan_type.hpp>
@@ -266,7 +266,7 @@ private:
   // BSM Message
   std::string host_bsm_id_;
 
-  std::shared_ptr<lanelet::projection::LocalFrameProjector> map_projector_;
+  std::shared_ptr<const carma_wm::projection::GeoreferenceProjector> map_projector_;
 
   std::string bsmIDtoString(carma_v2x_msgs::msg::BSMCoreData bsm_core)
   {
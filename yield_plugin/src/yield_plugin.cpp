@@ -771,7 +771,7 @@ namespace yield_plugin
 
   void YieldPlugin::set_georeference_string(const std::string& georeference)
   {
-    map_projector_ = std::make_shared<lanelet::projection::LocalFrameProjector>(georeference.c_str());  // Build projector from proj string
+    map_projector_ = carma_wm::projection::getGeoreferenceProjector(georeference);  // Build projector from proj string
   }
 
   void YieldPlugin::set_external_objects(const std::vector<carma_perception_msgs::msg::ExternalObject>& object_list)